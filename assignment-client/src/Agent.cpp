@@ -21,6 +21,7 @@
 
 #include <AnimationCacheScriptingInterface.h>
 #include <AssetClient.h>
+#include <AvatarFrameCodec.h>
 #include <AvatarHashMap.h>
 #include <AudioInjectorManager.h>
 #include <AssetClient.h>
@@ -433,6 +434,14 @@ void Agent::executeScript() {
             AvatarData::fromFrame(frame->data, *scriptedAvatar);
         });
 
+        static const FrameType AVATAR_BINARY_FRAME_TYPE = Frame::registerFrameType(AvatarData::BINARY_FRAME_NAME);
+        auto avatarFrameDecoder = std::make_shared<AvatarFrameDecoder>();
+        Frame::registerFrameHandler(AVATAR_BINARY_FRAME_TYPE, [scriptedAvatar, avatarFrameDecoder](Frame::ConstPointer frame) {
+            if (avatarFrameDecoder->decode(frame->data) == AvatarFrameDecoder::Decoded) {
+                scriptedAvatar->fromAvatarFrame(avatarFrameDecoder->getFrame(), avatarFrameDecoder->hasIdentity());
+            }
+        });
+
         using namespace recording;
         static const FrameType AUDIO_FRAME_TYPE = Frame::registerFrameType(AudioConstants::getAudioFrameName());
         Frame::registerFrameHandler(AUDIO_FRAME_TYPE, [this, &player, &scriptedAvatar](Frame::ConstPointer frame) {
@@ -527,6 +536,7 @@ void Agent::executeScript() {
 
         Frame::clearFrameHandler(AUDIO_FRAME_TYPE);
         Frame::clearFrameHandler(AVATAR_FRAME_TYPE);
+        Frame::clearFrameHandler(AVATAR_BINARY_FRAME_TYPE);
 
         if (recordingInterface->isPlaying()) {
             recordingInterface->stopPlaying();
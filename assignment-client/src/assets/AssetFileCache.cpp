@@ -0,0 +1,99 @@
+//
+//  AssetFileCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetFileCache.h"
+
+#include <QtCore/QFileInfo>
+
+using Lock = std::lock_guard<std::mutex>;
+
+void AssetFileCache::setMaxSize(size_t maxSize) {
+    Lock lock(_mutex);
+    _maxSize = maxSize;
+    evict();
+}
+
+storage::StoragePointer AssetFileCache::getFile(const QString& hash, const QString& filePath, bool& wasCached) {
+    {
+        Lock lock(_mutex);
+        auto it = _entriesByHash.find(hash);
+        if (it != _entriesByHash.end()) {
+            _entries.splice(_entries.begin(), _entries, it.value());
+            ++_numHits;
+            wasCached = true;
+            return it.value()->file;
+        }
+        ++_numMisses;
+    }
+    wasCached = false;
+
+    if (!QFileInfo::exists(filePath)) {
+        return nullptr;
+    }
+
+    // map the file outside of the lock, so that other threads can keep serving cached files meanwhile
+    auto file = std::make_shared<storage::FileStorage>(filePath, true);
+    if (!*file) {
+        return nullptr;
+    }
+
+    Lock lock(_mutex);
+    if (file->size() > _maxSize || _entriesByHash.contains(hash)) {
+        // too large to keep around, or another thread mapped it in the meantime
+        return file;
+    }
+    _entries.push_front({ hash, file });
+    _entriesByHash[hash] = _entries.begin();
+    _size += file->size();
+    evict();
+    return file;
+}
+
+void AssetFileCache::recordBytesServed(size_t numBytes, bool wasCached) {
+    Lock lock(_mutex);
+    _bytesServed += numBytes;
+    if (wasCached) {
+        _bytesServedFromMemory += numBytes;
+    }
+}
+
+void AssetFileCache::remove(const QString& hash) {
+    Lock lock(_mutex);
+    auto it = _entriesByHash.find(hash);
+    if (it != _entriesByHash.end()) {
+        _size -= it.value()->file->size();
+        _entries.erase(it.value());
+        _entriesByHash.erase(it);
+    }
+}
+
+void AssetFileCache::evict() {
+    while (_size > _maxSize && !_entries.empty()) {
+        const auto& entry = _entries.back();
+        _size -= entry.file->size();
+        _entriesByHash.remove(entry.hash);
+        _entries.pop_back();
+    }
+}
+
+QJsonObject AssetFileCache::getStatsObject() const {
+    static const double BYTES_PER_MEGABYTE = 1024.0 * 1024.0;
+
+    Lock lock(_mutex);
+    uint64_t numRequests = _numHits + _numMisses;
+
+    QJsonObject statsObject;
+    statsObject["1. Files"] = (qint64)_entries.size();
+    statsObject["2. Size (MB)"] = _size / BYTES_PER_MEGABYTE;
+    statsObject["3. Hit Ratio (%)"] = numRequests > 0 ? 100.0 * _numHits / numRequests : 0.0;
+    statsObject["4. Served (MB)"] = _bytesServed / BYTES_PER_MEGABYTE;
+    statsObject["5. Served From Memory (MB)"] = _bytesServedFromMemory / BYTES_PER_MEGABYTE;
+    return statsObject;
+}
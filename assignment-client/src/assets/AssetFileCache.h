@@ -0,0 +1,69 @@
+//
+//  AssetFileCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetFileCache_h
+#define hifi_AssetFileCache_h
+
+#include <list>
+#include <mutex>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+#include <shared/Storage.h>
+
+// Keeps the most recently requested asset files memory mapped, so that assets requested by many clients at once are
+// only read from disk once. Files are evicted least recently used first once the mapped files go over the maximum
+// size, files larger than that are mapped for the one request only.
+//
+// Asset files are named after the hash of their content and never change, so a mapping only goes stale when its file
+// is deleted. The cache is shared by the transfer task pool threads.
+class AssetFileCache {
+public:
+    static const size_t DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+
+    AssetFileCache(size_t maxSize = DEFAULT_MAX_SIZE) : _maxSize(maxSize) { }
+
+    void setMaxSize(size_t maxSize);
+
+    // returns the mapped file, or nullptr if it doesn't exist
+    storage::StoragePointer getFile(const QString& hash, const QString& filePath, bool& wasCached);
+
+    // accounts for bytes sent from a file returned by getFile
+    void recordBytesServed(size_t numBytes, bool wasCached);
+
+    // drops the mapping of a file, which must be done before deleting it
+    void remove(const QString& hash);
+
+    QJsonObject getStatsObject() const;
+
+private:
+    struct Entry {
+        QString hash;
+        storage::StoragePointer file;
+    };
+    using Entries = std::list<Entry>;
+
+    void evict();
+
+    mutable std::mutex _mutex;
+    size_t _maxSize;
+    size_t _size { 0 };
+    Entries _entries; // most recently used first
+    QHash<QString, Entries::iterator> _entriesByHash;
+
+    uint64_t _numHits { 0 };
+    uint64_t _numMisses { 0 };
+    uint64_t _bytesServed { 0 };
+    uint64_t _bytesServedFromMemory { 0 };
+};
+
+#endif // hifi_AssetFileCache_h
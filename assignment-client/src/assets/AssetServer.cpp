@@ -459,6 +459,13 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    // get the size of the memory mapped files kept around for repeated downloads
+    static const QString ASSETS_CACHE_SIZE_OPTION = "assets_cache_size";
+    static const size_t BYTES_PER_MEGABYTE = 1024 * 1024;
+    static const int DEFAULT_ASSETS_CACHE_SIZE_MB = (int)(AssetFileCache::DEFAULT_MAX_SIZE / BYTES_PER_MEGABYTE);
+    auto assetsCacheSize = assetServerObject[ASSETS_CACHE_SIZE_OPTION].toInt(DEFAULT_ASSETS_CACHE_SIZE_MB);
+    _fileCache->setMaxSize((size_t)std::max(assetsCacheSize, 0) * BYTES_PER_MEGABYTE);
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -540,7 +547,8 @@ void AssetServer::cleanupUnmappedFiles() {
                 }
             }
             if (!matched) {
-                // remove the unmapped file
+                // remove the unmapped file, which can't be mapped anymore while it gets deleted
+                _fileCache->remove(filename);
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
                 if (removeableFile.remove()) {
@@ -872,7 +880,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _fileCache);
     _transferTaskPool.start(task);
 }
 
@@ -965,6 +973,8 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    serverStats["Asset File Cache"] = _fileCache->getStatsObject();
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1177,7 +1187,8 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
 
         // we now have a set of hashes that are unmapped - we will delete those asset files
         for (auto& hash : hashesToCheckForDeletion) {
-            // remove the unmapped file
+            // remove the unmapped file, which can't be mapped anymore while it gets deleted
+            _fileCache->remove(hash);
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
             if (removeableFile.remove()) {
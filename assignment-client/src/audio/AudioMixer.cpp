@@ -85,13 +85,18 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     auto nodeList = DependencyManager::get<NodeList>();
     auto& packetReceiver = nodeList->getPacketReceiver();
 
-    // packets whose consequences are limited to their own node can be parallelized
-    packetReceiver.registerListenerForTypes({
+    // the audio streams are only queued to their node, they are taken off the node list thread by the dispatch workers
+    packetReceiver.registerConcurrentListenerForTypes({
             PacketType::MicrophoneAudioNoEcho,
             PacketType::MicrophoneAudioWithEcho,
             PacketType::InjectAudio,
+            PacketType::SilentAudioFrame },
+            PacketReceiver::makeSourcedListenerReference<AudioMixer>(this, &AudioMixer::queueAudioPacket)
+    );
+
+    // packets whose consequences are limited to their own node can be parallelized
+    packetReceiver.registerListenerForTypes({
             PacketType::AudioStreamStats,
-            PacketType::SilentAudioFrame,
             PacketType::NegotiateAudioFormat,
             PacketType::MuteEnvironment,
             PacketType::NodeIgnoreRequest,
@@ -132,7 +137,13 @@ void AudioMixer::queueAudioPacket(QSharedPointer<ReceivedMessage> message, Share
         _numSilentPackets++;
     }
 
-    getOrCreateClientData(node.data())->queuePacket(message, node);
+    // the dispatch workers and the node list thread may create the client data of the node too
+    AudioMixerClientData* clientData;
+    {
+        QMutexLocker locker(&node->getMutex());
+        clientData = getOrCreateClientData(node.data());
+    }
+    clientData->queuePacket(message, node);
 }
 
 void AudioMixer::queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> message) {
@@ -273,17 +284,11 @@ void AudioMixer::sendStatsPacket() {
         return;
     }
 
-#ifdef DEBUG_EVENT_QUEUE
-    QJsonObject qtStats;
-
-    _slavePool.queueStats(qtStats);
-    statsObject["audio_thread_event_queue"] = qtStats;
-#endif
-
     // general stats
     statsObject["useDynamicJitterBuffers"] = _numStaticJitterFrames == DISABLE_STATIC_JITTER_FRAMES;
 
     statsObject["threads"] = _slavePool.numThreads();
+    statsObject["thread_stats"] = _slavePool.takeThreadStats();
 
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
@@ -329,6 +334,7 @@ void AudioMixer::sendStatsPacket() {
     mixStats["1_hrtf_renders"] = (int)(_stats.hrtfRenders / (float)_numStatFrames);
     mixStats["1_hrtf_resets"] = (int)(_stats.hrtfResets / (float)_numStatFrames);
     mixStats["1_hrtf_updates"] = (int)(_stats.hrtfUpdates / (float)_numStatFrames);
+    mixStats["1_hrtf_renders_saved"] = (int)(_stats.hrtfRendersSaved / (float)_numStatFrames);
 
     mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
     mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
@@ -341,6 +347,10 @@ void AudioMixer::sendStatsPacket() {
     mixStats["3_active_to_skippped"] = (int)(_stats.activeToSkipped / (float)_numStatFrames);
     mixStats["3_active_to_inactive"] = (int)(_stats.activeToInactive / (float)_numStatFrames);
 
+    mixStats["4_premix_cells"] = (int)(_stats.premixCells / (float)_numStatFrames);
+    mixStats["4_premix_encodes"] = (int)(_stats.premixEncodes / (float)_numStatFrames);
+    mixStats["4_premix_renders"] = (int)(_stats.premixRenders / (float)_numStatFrames);
+
     mixStats["total_mixes"] = _stats.totalMixes;
     mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
 
@@ -462,8 +472,16 @@ void AudioMixer::start() {
             numToRetain = nodeList->size() * (1.0f - _throttlingRatio);
         }
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
-            // mix across slave threads
             auto mixTimer = _mixTiming.timer();
+
+            // premix distant sources for groups of listeners, unless throttling already drops them
+            if (numToRetain == -1) {
+                _workerSharedData.premix.build(cbegin, cend, _stats);
+            } else {
+                _workerSharedData.premix.clear();
+            }
+
+            // mix across slave threads
             _slavePool.mix(cbegin, cend, frame, numToRetain);
         });
 
@@ -556,6 +574,7 @@ void AudioMixer::clearDomainSettings() {
     _audioZones.clear();
     _zoneSettings.clear();
     _zoneReverbSettings.clear();
+    _workerSharedData.premix.setRadius(0.0f);
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
@@ -591,6 +610,17 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
         }
 
         qCDebug(audio) << "Throttle Start:" << _throttleStartTarget << "Throttle Backoff:" << _throttleBackoffTarget;
+
+        const QString PREMIX_RADIUS_KEY = "premix_radius";
+        const QString PREMIX_CELL_SIZE_KEY = "premix_cell_size";
+
+        auto& premix = _workerSharedData.premix;
+        premix.setRadius(audioThreadingGroupObject[PREMIX_RADIUS_KEY].toDouble(0.0));
+        premix.setCellSize(audioThreadingGroupObject[PREMIX_CELL_SIZE_KEY].toDouble(premix.getCellSize()));
+        if (premix.isEnabled()) {
+            qCDebug(audio) << "Premixing sources further than" << premix.getRadius() << "m from listener cells of"
+                << premix.getCellSize() << "m";
+        }
     }
 
     if (settingsObject.contains(AUDIO_BUFFER_GROUP_KEY)) {
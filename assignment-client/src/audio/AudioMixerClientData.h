@@ -12,6 +12,7 @@
 #ifndef hifi_AudioMixerClientData_h
 #define hifi_AudioMixerClientData_h
 
+#include <mutex>
 #include <queue>
 
 #if !defined(Q_MOC_RUN)
@@ -22,6 +23,7 @@
 #include <QtCore/QJsonObject>
 
 #include <AABox.h>
+#include <AudioFOA.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
 #include <UUIDHasher.h>
@@ -92,6 +94,18 @@ public:
 
     AudioLimiter audioLimiter;
 
+    // renderers for the premixed beds of this listener's cell, recreated after any frame mixed without them
+    struct PremixRenderer {
+        std::unique_ptr<AudioFOA> foa;
+        int numSilentFrames { 0 };
+    };
+    struct PremixRenderers {
+        PremixRenderer avatarBed;
+        PremixRenderer injectorBed;
+        unsigned int lastFrame { 0 };
+    };
+    PremixRenderers premixRenderers;
+
     void setupCodec(CodecPluginPointer codec, const QString& codecName);
     void cleanupCodec();
     void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
@@ -123,6 +137,7 @@ public:
         PositionalAudioStream* positionalStream;
         bool ignoredByListener { false };
         bool ignoringListener { false };
+        bool isPremixed { false };
 
         MixableStream(NodeIDStreamID nodeIDStreamID, PositionalAudioStream* positionalStream) :
             nodeStreamID(nodeIDStreamID), hrtf(new AudioHRTF), positionalStream(positionalStream) {};
@@ -175,7 +190,8 @@ private:
     struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
         QWeakPointer<Node> node;
     };
-    PacketQueue _packetQueue;
+    std::mutex _packetQueueMutex;
+    PacketQueue _packetQueue; // guarded by _packetQueueMutex
 
     AudioStreamVector _audioStreams; // microphone stream from avatar has a null stream ID
 
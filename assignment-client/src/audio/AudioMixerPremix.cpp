@@ -0,0 +1,171 @@
+//
+//  AudioMixerPremix.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerPremix.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <SharedUtil.h>
+
+#include "AudioMixerClientData.h"
+#include "AudioMixerSlave.h"
+
+static const float MIN_CELL_SIZE = 1.0f;
+
+// 21 bits per axis, offset so that negative cells pack as positive values
+static const int CELL_BITS = 21;
+static const int64_t CELL_OFFSET = 1 << (CELL_BITS - 1);
+static const int64_t CELL_MASK = (1 << CELL_BITS) - 1;
+
+static const int SAMPLES_PER_CHANNEL = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+void AudioMixerPremix::setRadius(float radius) {
+    _radius = std::max(radius, 0.0f);
+    setCellSize(_cellSize);
+}
+
+void AudioMixerPremix::setCellSize(float cellSize) {
+    // a listener must be within the radius of its cell's center, or its own nearby sources could end up in the beds
+    _cellSize = std::max(cellSize, MIN_CELL_SIZE);
+    if (_radius > 0.0f) {
+        _cellSize = std::min(_cellSize, _radius);
+    }
+}
+
+void AudioMixerPremix::clear() {
+    _cells.clear();
+    _cellIndexes.clear();
+}
+
+AudioMixerPremix::CellKey AudioMixerPremix::keyFor(const glm::vec3& position) const {
+    glm::ivec3 cell = glm::ivec3(glm::floor(position / _cellSize));
+    return (CellKey)(((int64_t)cell.x + CELL_OFFSET) & CELL_MASK)
+        | ((CellKey)(((int64_t)cell.y + CELL_OFFSET) & CELL_MASK) << CELL_BITS)
+        | ((CellKey)(((int64_t)cell.z + CELL_OFFSET) & CELL_MASK) << (2 * CELL_BITS));
+}
+
+bool AudioMixerPremix::isPremixable(const PositionalAudioStream& stream) const {
+    // stereo sources bypass the HRTF anyway, and repeated frames fade out on a per-listener basis
+    return !stream.isStereo() && stream.lastPopSucceeded();
+}
+
+bool AudioMixerPremix::isPremixed(const Cell& cell, const PositionalAudioStream& stream) const {
+    if (!isPremixable(stream)) {
+        return false;
+    }
+    glm::vec3 offset = stream.getPosition() - cell.center;
+    return glm::dot(offset, offset) > _radius * _radius;
+}
+
+const AudioMixerPremix::Cell* AudioMixerPremix::findCell(const glm::vec3& listenerPosition) const {
+    auto it = _cellIndexes.find(keyFor(listenerPosition));
+    return it != _cellIndexes.end() ? &_cells[it->second] : nullptr;
+}
+
+void AudioMixerPremix::build(ConstIter begin, ConstIter end, AudioMixerStats& stats) {
+    clear();
+    if (!isEnabled()) {
+        return;
+    }
+
+    // one cell per group of listeners
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!data || node->getType() != NodeType::Agent) {
+            return;
+        }
+        AvatarAudioStream* listenerStream = data->getAvatarAudioStream();
+        if (!listenerStream) {
+            return;
+        }
+
+        glm::vec3 position = listenerStream->getPosition();
+        auto result = _cellIndexes.emplace(keyFor(position), _cells.size());
+        if (result.second) {
+            _cells.emplace_back();
+            _cells.back().center = (glm::floor(position / _cellSize) + glm::vec3(0.5f)) * _cellSize;
+        }
+    });
+
+    // decode each audible source once
+    _sources.clear();
+    _sourceSamples.clear();
+    int16_t samples[SAMPLES_PER_CHANNEL];
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!data) {
+            return;
+        }
+
+        for (const auto& stream : data->getAudioStreams()) {
+            if (!isPremixable(*stream) || stream->getLastPopOutputLoudness() == 0.0f) {
+                continue;
+            }
+
+            AudioRingBuffer::ConstIterator output = stream->getLastPopOutput();
+            output.readSamples(samples, SAMPLES_PER_CHANNEL);
+
+            _sources.push_back({ stream.get(), _sourceSamples.size() });
+            _sourceSamples.insert(_sourceSamples.end(), samples, samples + SAMPLES_PER_CHANNEL);
+        }
+    });
+
+    // encode the distant sources of each cell, as heard from its center
+    _accumulation.resize(2 * BED_SAMPLES);
+    for (auto& cell : _cells) {
+        std::fill(_accumulation.begin(), _accumulation.end(), 0.0f);
+        bool hasAvatarAudio = false;
+        bool hasInjectorAudio = false;
+
+        for (const auto& source : _sources) {
+            glm::vec3 relativePosition = source.stream->getPosition() - cell.center;
+            if (glm::dot(relativePosition, relativePosition) <= _radius * _radius) {
+                continue;
+            }
+
+            float distance = glm::length(relativePosition);
+            float gain = computeGain(1.0f, 1.0f, cell.center, *source.stream, relativePosition, distance);
+            if (gain == 0.0f) {
+                continue;
+            }
+
+            // ambiX channel order is W, Y, Z, X, converted from Y-up (OpenGL) to Z-up (Ambisonic)
+            glm::vec3 direction = relativePosition / distance;
+            const float coefficients[4] = { gain, -direction.x * gain, direction.y * gain, -direction.z * gain };
+
+            bool isInjector = source.stream->getType() == PositionalAudioStream::Injector;
+            float* bed = &_accumulation[isInjector ? BED_SAMPLES : 0];
+            const float* input = &_sourceSamples[source.offset];
+            for (int i = 0; i < SAMPLES_PER_CHANNEL; ++i) {
+                bed[4 * i + 0] += input[i] * coefficients[0];
+                bed[4 * i + 1] += input[i] * coefficients[1];
+                bed[4 * i + 2] += input[i] * coefficients[2];
+                bed[4 * i + 3] += input[i] * coefficients[3];
+            }
+
+            (isInjector ? hasInjectorAudio : hasAvatarAudio) = true;
+            ++stats.premixEncodes;
+        }
+
+        auto convert = [](const float* input, Bed& bed, bool hasAudio) {
+            bed.hasAudio = hasAudio;
+            if (hasAudio) {
+                for (int i = 0; i < BED_SAMPLES; ++i) {
+                    bed.samples[i] = (int16_t)glm::clamp(std::lrint(input[i]), (long)INT16_MIN, (long)INT16_MAX);
+                }
+            }
+        };
+        convert(&_accumulation[0], cell.avatarBed, hasAvatarAudio);
+        convert(&_accumulation[BED_SAMPLES], cell.injectorBed, hasInjectorAudio);
+    }
+
+    stats.premixCells += (int)_cells.size();
+}
@@ -0,0 +1,94 @@
+//
+//  AudioMixerPremix.h
+//  assignment-client/src/audio
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerPremix_h
+#define hifi_AudioMixerPremix_h
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AudioConstants.h>
+#include <AudioFOA.h>
+#include <NodeList.h>
+#include <PositionalAudioStream.h>
+
+#include "AudioMixerStats.h"
+
+// Listener-clustered premix of distant sources.
+//
+// Listeners are grouped into cubic cells. Once per frame, every mono source further than the premix radius from a
+// cell's center is encoded into that cell's first-order ambisonic beds, as heard from the center. Listeners in the
+// cell then render the beds through a single AudioFOA each instead of running one HRTF per distant source, and only
+// mix the sources within the radius individually.
+class AudioMixerPremix {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    static const int BED_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC;
+    static_assert(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL == FOA_BLOCK, "beds are rendered one FOA block per frame");
+
+    // ambiX (ACN/SN3D) interleaved, world aligned
+    struct Bed {
+        int16_t samples[BED_SAMPLES];
+        bool hasAudio { false };
+    };
+
+    struct Cell {
+        glm::vec3 center;
+
+        // kept apart so that listeners can apply their own master avatar and injector gains
+        Bed avatarBed;
+        Bed injectorBed;
+    };
+
+    // a radius of 0 disables the premix
+    void setRadius(float radius);
+    float getRadius() const { return _radius; }
+    void setCellSize(float cellSize);
+    float getCellSize() const { return _cellSize; }
+
+    bool isEnabled() const { return _radius > 0.0f; }
+
+    // rebuilds the beds for this frame, must not run concurrently with the mix
+    void build(ConstIter begin, ConstIter end, AudioMixerStats& stats);
+    void clear();
+
+    // the cell of a listener, or nullptr if it had no cell built this frame
+    const Cell* findCell(const glm::vec3& listenerPosition) const;
+
+    // whether the stream is part of the cell's beds, and so must not be mixed individually by its listeners
+    bool isPremixed(const Cell& cell, const PositionalAudioStream& stream) const;
+
+private:
+    using CellKey = uint64_t;
+
+    CellKey keyFor(const glm::vec3& position) const;
+    bool isPremixable(const PositionalAudioStream& stream) const;
+
+    float _radius { 0.0f };
+    float _cellSize { 10.0f };
+
+    std::vector<Cell> _cells;
+    std::unordered_map<CellKey, size_t> _cellIndexes;
+
+    // scratch space for the decoded sources of a frame
+    struct Source {
+        const PositionalAudioStream* stream;
+        size_t offset;
+    };
+    std::vector<Source> _sources;
+    std::vector<float> _sourceSamples;
+    std::vector<float> _accumulation;
+};
+
+#endif // hifi_AudioMixerPremix_h
@@ -50,8 +50,6 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
 
 // mix helpers
 inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd);
-inline float computeGain(float masterAvatarGain, float masterInjectorGain, const AvatarAudioStream& listeningNodeStream,
-        const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance);
 inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition);
 
@@ -320,6 +318,31 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
     addStreams(*listener, *listenerData);
 
+    // the beds are shared by every listener of a cell, so listeners that need to leave some of their distant
+    // sources out (soloing, or ignore changes being applied this frame) mix everything individually
+    const AudioMixerPremix::Cell* premixCell = nullptr;
+    const auto& premix = _sharedData.premix;
+    if (!isThrottling && !isSoloing && premix.isEnabled() &&
+        listenerData->getNewIgnoredNodeIDs().empty() && listenerData->getNewIgnoringNodeIDs().empty()) {
+        premixCell = premix.findCell(listenerAudioStream->getPosition());
+    }
+
+    // neither can listeners with an ignored source in their beds, or one whose gain they adjusted, since the beds are
+    // only rendered with the master gains
+    if (premixCell) {
+        auto isPremixed = [&](const MixableStream& stream) {
+            return premix.isPremixed(*premixCell, *stream.positionalStream);
+        };
+        auto isAdjustedAndPremixed = [&](const MixableStream& stream) {
+            return stream.hrtf->hasGainAdjustment() && isPremixed(stream);
+        };
+        if (std::any_of(streams.skipped.begin(), streams.skipped.end(), isPremixed) ||
+            std::any_of(streams.active.begin(), streams.active.end(), isAdjustedAndPremixed) ||
+            std::any_of(streams.inactive.begin(), streams.inactive.end(), isAdjustedAndPremixed)) {
+            premixCell = nullptr;
+        }
+    }
+
     // Process skipped streams
     erase_if(streams.skipped, [&](MixableStream& stream) {
         if (shouldBeRemoved(stream, _sharedData)) {
@@ -387,8 +410,18 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
                 return true;
             }
 
-            addStream(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(), listenerData->getMasterInjectorGain(),
-                      isSoloing);
+            if (premixCell && premix.isPremixed(*premixCell, *stream.positionalStream)) {
+                // heard through the cell's beds, start from a clean HRTF if it comes back within the radius
+                if (!stream.isPremixed) {
+                    resetHRTFState(stream);
+                    stream.isPremixed = true;
+                }
+                ++stats.hrtfRendersSaved;
+            } else {
+                stream.isPremixed = false;
+                addStream(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(),
+                          listenerData->getMasterInjectorGain(), isSoloing);
+            }
 
             if (shouldBeInactive(stream)) {
                 // To reduce artifacts we still call render to flush the HRTF for every silent
@@ -423,6 +456,7 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
                 return true;
             }
 
+            stream.isPremixed = false;
             addStream(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(), listenerData->getMasterInjectorGain(),
                       isSoloing);
 
@@ -460,6 +494,10 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         });
     }
 
+    if (premixCell) {
+        addPremix(*premixCell, *listenerAudioStream, *listenerData);
+    }
+
     stats.skipped += (int)streams.skipped.size();
     stats.inactive += (int)streams.inactive.size();
     stats.active += (int)streams.active.size();
@@ -506,8 +544,8 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
     float distance = glm::max(glm::length(relativePosition), EPSILON);
     float gain = isEcho ? 1.0f
                         : (isSoloing ? masterAvatarGain
-                                     : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream, *streamToAdd,
-                                                   relativePosition, distance));
+                                     : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream.getPosition(),
+                                                   *streamToAdd, relativePosition, distance));
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
 
     const int HRTF_DATASET_INDEX = 1;
@@ -587,8 +625,8 @@ void AudioMixerSlave::updateHRTFParameters(AudioMixerClientData::MixableStream&
     glm::vec3 relativePosition = streamToAdd->getPosition() - listeningNodeStream.getPosition();
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
-    float gain = isEcho ? 1.0f : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream, *streamToAdd, 
-                                             relativePosition, distance);
+    float gain = isEcho ? 1.0f : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream.getPosition(),
+                                             *streamToAdd, relativePosition, distance);
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
 
     mixableStream.hrtf->setParameterHistory(azimuth, distance, gain);
@@ -601,6 +639,52 @@ void AudioMixerSlave::resetHRTFState(AudioMixerClientData::MixableStream& mixabl
     ++stats.hrtfResets;
 }
 
+void AudioMixerSlave::addPremix(const AudioMixerPremix::Cell& cell, AvatarAudioStream& listeningNodeStream,
+                                AudioMixerClientData& listenerData) {
+    auto& renderers = listenerData.premixRenderers;
+
+    // the renderers' history is stale if the beds were not rendered on the last frame,
+    // fresh renderers have nothing left to flush
+    const int NUM_FLUSH_FRAMES = (FOA_OVERLAP + FOA_BLOCK - 1) / FOA_BLOCK;
+    if (renderers.lastFrame + 1 != _frame) {
+        for (auto renderer : { &renderers.avatarBed, &renderers.injectorBed }) {
+            renderer->foa.reset(new AudioFOA);
+            renderer->numSilentFrames = NUM_FLUSH_FRAMES;
+        }
+    }
+    renderers.lastFrame = _frame;
+
+    // the beds are world aligned, so rotate them into the listener's frame
+    // converting from Y-up (OpenGL) to Z-up (Ambisonic) coordinate system
+    glm::quat relativeOrientation = glm::inverse(listeningNodeStream.getOrientation());
+    float qw = relativeOrientation.w;
+    float qx = -relativeOrientation.z;
+    float qy = -relativeOrientation.x;
+    float qz = relativeOrientation.y;
+
+    const int HRTF_DATASET_INDEX = 1;
+
+    auto render = [&](const AudioMixerPremix::Bed& bed, AudioMixerClientData::PremixRenderer& renderer, float gain) {
+        if (bed.hasAudio) {
+            renderer.numSilentFrames = 0;
+            memcpy(_premixSamples, bed.samples, sizeof(_premixSamples));
+        } else if (renderer.numSilentFrames < NUM_FLUSH_FRAMES) {
+            // flush the tail of the last audible bed
+            ++renderer.numSilentFrames;
+            memset(_premixSamples, 0, sizeof(_premixSamples));
+        } else {
+            return;
+        }
+
+        renderer.foa->render(_premixSamples, _mixSamples, HRTF_DATASET_INDEX, qw, qx, qy, qz, gain,
+                             AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        ++stats.premixRenders;
+    };
+
+    render(cell.avatarBed, renderers.avatarBed, listenerData.getMasterAvatarGain());
+    render(cell.injectorBed, renderers.injectorBed, listenerData.getMasterInjectorGain());
+}
+
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec) {
     auto audioPacket = NLPacket::create(type, size);
     audioPacket->writePrimitive(sequence);
@@ -728,7 +812,7 @@ float approximateGain(const AvatarAudioStream& listeningNodeStream, const Positi
 
 float computeGain(float masterAvatarGain,
                   float masterInjectorGain,
-                  const AvatarAudioStream& listeningNodeStream,
+                  const glm::vec3& listenerPosition,
                   const PositionalAudioStream& streamToAdd,
                   const glm::vec3& relativePosition,
                   float distance) {
@@ -765,7 +849,7 @@ float computeGain(float masterAvatarGain,
     float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
     for (const auto& settings : zoneSettings) {
         if (audioZones[settings.source].area.contains(streamToAdd.getPosition()) &&
-            audioZones[settings.listener].area.contains(listeningNodeStream.getPosition())) {
+            audioZones[settings.listener].area.contains(listenerPosition)) {
             attenuationPerDoublingInDistance = settings.coefficient;
             break;
         }
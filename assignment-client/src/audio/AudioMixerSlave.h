@@ -26,6 +26,7 @@
 #include <PositionalAudioStream.h>
 
 #include "AudioMixerClientData.h"
+#include "AudioMixerPremix.h"
 #include "AudioMixerStats.h"
 
 class AvatarAudioStream;
@@ -39,6 +40,7 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        AudioMixerPremix premix;
     };
 
     AudioMixerSlave(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -68,12 +70,15 @@ private:
                               float masterAvatarGain,
                               float masterInjectorGain);
     void resetHRTFState(AudioMixerClientData::MixableStream& mixableStream);
+    void addPremix(const AudioMixerPremix::Cell& cell, AvatarAudioStream& listeningNodeStream,
+                   AudioMixerClientData& listenerData);
 
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
 
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    int16_t _premixSamples[AudioMixerPremix::BED_SAMPLES];
 
     // frame state
     ConstIter _begin;
@@ -84,4 +89,8 @@ private:
     SharedData& _sharedData;
 };
 
+// gain of a source for a listener at listenerPosition, relativePosition being from the listener to the source
+float computeGain(float masterAvatarGain, float masterInjectorGain, const glm::vec3& listenerPosition,
+                  const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance);
+
 #endif // hifi_AudioMixerSlave_h
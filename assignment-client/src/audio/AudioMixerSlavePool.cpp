@@ -11,104 +11,42 @@
 
 #include "AudioMixerSlavePool.h"
 
-#include <QObject>
-
 #include <assert.h>
 #include <algorithm>
 
-#include <ThreadHelpers.h>
-
-void AudioMixerSlaveThread::run() {
-    while (true) {
-        wait();
-
-        // iterate over all available nodes
-        SharedNodePointer node;
-        while (try_pop(node)) {
-            (this->*_function)(node);
-        }
-
-        bool stopping = _stop;
-        notify(stopping);
-        if (stopping) {
-            return;
-        }
-    }
-}
-
-void AudioMixerSlaveThread::wait() {
-    {
-        Lock lock(_pool._mutex);
-        _pool._slaveCondition.wait(lock, [&] {
-            assert(_pool._numStarted <= _pool._numThreads);
-            return _pool._numStarted != _pool._numThreads;
-        });
-        ++_pool._numStarted;
-    }
-
-    if (_pool._configure) {
-        _pool._configure(*this);
-    }
-    _function = _pool._function;
-}
-
-void AudioMixerSlaveThread::notify(bool stopping) {
-    {
-        Lock lock(_pool._mutex);
-        assert(_pool._numFinished < _pool._numThreads);
-        ++_pool._numFinished;
-        if (stopping) {
-            ++_pool._numStopped;
-        }
-    }
-    _pool._poolCondition.notify_one();
-}
-
-bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
-}
-
 void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
-    _function = &AudioMixerSlave::processPackets;
-    _configure = [](AudioMixerSlave& slave) {};
-    run(begin, end);
+    run(begin, end, &AudioMixerSlave::processPackets, [](AudioMixerSlave& slave) {});
 }
 
 void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain) {
-    _function = &AudioMixerSlave::mix;
-    _configure = [=](AudioMixerSlave& slave) {
-        slave.configureMix(_begin, _end, frame, numToRetain);
-    };
-
-    run(begin, end);
-}
-
-void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
-    _begin = begin;
-    _end = end;
-
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
+    run(begin, end, &AudioMixerSlave::mix, [=](AudioMixerSlave& slave) {
+        slave.configureMix(begin, end, frame, numToRetain);
     });
+}
 
-    {
-        Lock lock(_mutex);
-
-        // run
-        _numStarted = _numFinished = 0;
-        _slaveCondition.notify_all();
+void AudioMixerSlavePool::run(ConstIter begin, ConstIter end, void (AudioMixerSlave::*function)(const SharedNodePointer& node),
+                              std::function<void(AudioMixerSlave&)> configure) {
+    auto nodeList = DependencyManager::get<NodeList>();
 
-        // wait
-        _poolCondition.wait(lock, [&] {
-            assert(_numFinished <= _numThreads);
-            return _numFinished == _numThreads;
-        });
+    WorkStealingPool::Job job;
+    job.numItems = std::distance(begin, end);
+    job.begin = [&](int worker) {
+        configure(*_slaves[worker]);
 
-        assert(_numStarted == _numThreads);
-    }
+        // unreliable packets sent while iterating are written in batches, if the node socket has batching enabled
+        nodeList->beginSendBatch();
+    };
+    job.run = [&](int worker, size_t first, size_t last) {
+        auto& slave = *_slaves[worker];
+        for (auto node = begin + first; node != begin + last; ++node) {
+            (slave.*function)(*node);
+        }
+    };
+    job.end = [&](int worker) {
+        nodeList->flushSendBatch();
+    };
 
-    assert(_queue.empty());
+    _workers.run(job);
 }
 
 void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> functor) {
@@ -117,18 +55,11 @@ void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> funct
     }
 }
 
-#ifdef DEBUG_EVENT_QUEUE
-void AudioMixerSlavePool::queueStats(QJsonObject& stats) {
-    unsigned i = 0;
-    for (auto& slave : _slaves) {
-        int queueSize = ::hifi::qt::getEventQueueSize(slave.get());
-        QString queueName = QString("audio_thread_event_queue_%1").arg(i);
-        stats[queueName] = queueSize;
-
-        i++;
-    }
+QJsonObject AudioMixerSlavePool::takeThreadStats() {
+    QJsonObject stats = _workers.getStatsObject();
+    _workers.resetStats();
+    return stats;
 }
-#endif // DEBUG_EVENT_QUEUE
 
 void AudioMixerSlavePool::setNumThreads(int numThreads) {
     // clamp to allowed size
@@ -155,50 +86,14 @@ void AudioMixerSlavePool::resize(int numThreads) {
 
     qDebug("%s: set %d threads (was %d)", __FUNCTION__, numThreads, _numThreads);
 
-    Lock lock(_mutex);
-
-    if (numThreads > _numThreads) {
-        // start new slaves
-        for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto slave = new AudioMixerSlaveThread(*this, _workerSharedData);
-            QObject::connect(slave, &QThread::started, [] { setThreadName("AudioMixerSlaveThread"); });
-            slave->start();
-            _slaves.emplace_back(slave);
-        }
-    } else if (numThreads < _numThreads) {
-        auto extraBegin = _slaves.begin() + numThreads;
-
-        // mark slaves to stop...
-        auto slave = extraBegin;
-        while (slave != _slaves.end()) {
-            (*slave)->_stop = true;
-            ++slave;
-        }
-
-        // ...cycle them until they do stop...
-        _numStopped = 0;
-        while (_numStopped != (_numThreads - numThreads)) {
-            _numStarted = _numFinished = _numStopped;
-            _slaveCondition.notify_all();
-            _poolCondition.wait(lock, [&] {
-                assert(_numFinished <= _numThreads);
-                return _numFinished == _numThreads;
-            });
-        }
-
-        // ...wait for threads to finish...
-        slave = extraBegin;
-        while (slave != _slaves.end()) {
-            QThread* thread = reinterpret_cast<QThread*>(slave->get());
-            static const int MAX_THREAD_WAIT_TIME = 10;
-            thread->wait(MAX_THREAD_WAIT_TIME);
-            ++slave;
-        }
+    // the first slave runs on the mixer's own thread, alongside the pool's workers
+    _workers.setNumWorkers(numThreads);
 
-        // ...and erase them
-        _slaves.erase(extraBegin, _slaves.end());
+    while ((int)_slaves.size() < numThreads) {
+        _slaves.emplace_back(new AudioMixerSlave(_workerSharedData));
     }
+    _slaves.resize(numThreads);
 
-    _numThreads = _numStarted = _numFinished = numThreads;
+    _numThreads = numThreads;
     assert(_numThreads == (int)_slaves.size());
 }
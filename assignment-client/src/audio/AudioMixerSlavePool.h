@@ -12,56 +12,25 @@
 #ifndef hifi_AudioMixerSlavePool_h
 #define hifi_AudioMixerSlavePool_h
 
-#include <condition_variable>
-#include <mutex>
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include <QThread>
-#include <shared/QtHelpers.h>
-#include <TBBHelpers.h>
+#include <QJsonObject>
 
-#include "AudioMixerSlave.h"
-
-class AudioMixerSlavePool;
-
-class AudioMixerSlaveThread : public QThread, public AudioMixerSlave {
-    Q_OBJECT
-    using ConstIter = NodeList::const_iterator;
-    using Mutex = std::mutex;
-    using Lock = std::unique_lock<Mutex>;
+#include <WorkStealingPool.h>
 
-public:
-    AudioMixerSlaveThread(AudioMixerSlavePool& pool, AudioMixerSlave::SharedData& sharedData)
-        : AudioMixerSlave(sharedData), _pool(pool) {}
-
-    void run() override final;
-
-private:
-    friend class AudioMixerSlavePool;
-
-    void wait();
-    void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
-
-    AudioMixerSlavePool& _pool;
-    void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
-    bool _stop { false };
-};
+#include "AudioMixerSlave.h"
 
-// Slave pool for audio mixers
+// Slave pool for audio mixers, each slave runs the nodes handed to one worker of a WorkStealingPool
 //   AudioMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AudioMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
-    using Mutex = std::mutex;
-    using Lock = std::unique_lock<Mutex>;
-    using ConditionVariable = std::condition_variable;
-
 public:
     using ConstIter = NodeList::const_iterator;
 
     AudioMixerSlavePool(AudioMixerSlave::SharedData& sharedData, int numThreads = QThread::idealThreadCount())
         : _workerSharedData(sharedData) { setNumThreads(numThreads); }
-    ~AudioMixerSlavePool() { resize(0); }
 
     // process packets on slave threads
     void processPackets(ConstIter begin, ConstIter end);
@@ -72,38 +41,20 @@ public:
     // iterate over all slaves
     void each(std::function<void(AudioMixerSlave& slave)> functor);
 
-#ifdef DEBUG_EVENT_QUEUE
-    void queueStats(QJsonObject& stats);
-#endif
+    // per thread utilization and work stealing stats, reset on every call
+    QJsonObject takeThreadStats();
 
     void setNumThreads(int numThreads);
     int numThreads() { return _numThreads; }
 
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, void (AudioMixerSlave::*function)(const SharedNodePointer& node),
+             std::function<void(AudioMixerSlave&)> configure);
     void resize(int numThreads);
 
-    std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
-
-    friend void AudioMixerSlaveThread::wait();
-    friend void AudioMixerSlaveThread::notify(bool stopping);
-    friend bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node);
-
-    // synchronization state
-    Mutex _mutex;
-    ConditionVariable _slaveCondition;
-    ConditionVariable _poolCondition;
-    void (AudioMixerSlave::*_function)(const SharedNodePointer& node);
-    std::function<void(AudioMixerSlave&)> _configure;
+    std::vector<std::unique_ptr<AudioMixerSlave>> _slaves;
+    WorkStealingPool _workers { "AudioMixerSlaveThread" };
     int _numThreads { 0 };
-    int _numStarted { 0 }; // guarded by _mutex
-    int _numFinished { 0 }; // guarded by _mutex
-    int _numStopped { 0 }; // guarded by _mutex
-
-    // frame state
-    Queue _queue;
-    ConstIter _begin;
-    ConstIter _end;
 
     AudioMixerSlave::SharedData& _workerSharedData;
 };
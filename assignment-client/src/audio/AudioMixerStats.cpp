@@ -21,6 +21,11 @@ void AudioMixerStats::reset() {
     hrtfRenders = 0;
     hrtfResets = 0;
     hrtfUpdates = 0;
+    hrtfRendersSaved = 0;
+
+    premixCells = 0;
+    premixEncodes = 0;
+    premixRenders = 0;
 
     manualStereoMixes = 0;
     manualEchoMixes = 0;
@@ -51,6 +56,11 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     hrtfRenders += otherStats.hrtfRenders;
     hrtfResets += otherStats.hrtfResets;
     hrtfUpdates += otherStats.hrtfUpdates;
+    hrtfRendersSaved += otherStats.hrtfRendersSaved;
+
+    premixCells += otherStats.premixCells;
+    premixEncodes += otherStats.premixEncodes;
+    premixRenders += otherStats.premixRenders;
 
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
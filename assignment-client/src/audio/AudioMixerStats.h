@@ -26,6 +26,11 @@ struct AudioMixerStats {
     int hrtfRenders { 0 };
     int hrtfResets { 0 };
     int hrtfUpdates { 0 };
+    int hrtfRendersSaved { 0 }; // distant streams heard through their listener's premixed beds
+
+    int premixCells { 0 };
+    int premixEncodes { 0 };
+    int premixRenders { 0 };
 
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
@@ -310,12 +310,18 @@ void AvatarMixer::start() {
 
         // process pending display names... this doesn't currently run on multiple threads, because it
         // side-effects the mixer's data, which is fine because it's a very low cost operation
+        // avatars' encode caches are reset for the frame here too, before the slaves broadcast
         {
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
                     if (node->getType() == NodeType::Agent) {
                         manageIdentityData(node);
+
+                        NodeData* nodeData = node->getLinkedData();
+                        if (nodeData) {
+                            static_cast<AvatarMixerClientData*>(nodeData)->getAvatar().beginEncodeFrame();
+                        }
                     }
 
                     ++_sumListeners;
@@ -334,6 +340,7 @@ void AvatarMixer::start() {
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
+                buildAvatarSpatialIndex(cbegin, cend);
                 _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
@@ -370,6 +377,44 @@ void AvatarMixer::start() {
 }
 
 
+void AvatarMixer::buildAvatarSpatialIndex(NodeList::const_iterator begin, NodeList::const_iterator end) {
+    auto& spatialIndex = _slaveSharedData.avatarSpatialIndex;
+    spatialIndex.grid.clear();
+    spatialIndex.heroes.clear();
+    spatialIndex.avatars.clear();
+
+    if (_spatialIndexMinAvatars <= 0) {
+        spatialIndex.isEnabled = false;
+        return;
+    }
+
+    for (auto it = begin; it != end; ++it) {
+        const Node* node = it->data();
+        if (node->getType() == NodeType::Agent && node->getLinkedData()) {
+            spatialIndex.avatars.push_back((SpatialHashGrid::Index)(it - begin));
+        }
+    }
+
+    spatialIndex.isEnabled = (int)spatialIndex.avatars.size() >= _spatialIndexMinAvatars;
+    if (!spatialIndex.isEnabled) {
+        return;
+    }
+
+    spatialIndex.radius = _spatialIndexRadius;
+    spatialIndex.numDistantSamples = _spatialIndexDistantSamples;
+    spatialIndex.grid.setCellSize(_spatialIndexRadius);
+
+    for (auto index : spatialIndex.avatars) {
+        auto nodeData = static_cast<const AvatarMixerClientData*>((begin + index)->data()->getLinkedData());
+        spatialIndex.grid.insert(index, nodeData->getPosition());
+        if (nodeData->getAvatar().getHasPriority()) {
+            spatialIndex.heroes.push_back(index);
+        }
+    }
+
+    spatialIndex.grid.build();
+}
+
 // NOTE: nodeData->getAvatar() might be side effected, must be called when access to node/nodeData
 // is guaranteed to not be accessed by other thread
 void AvatarMixer::manageIdentityData(const SharedNodePointer& node) {
@@ -765,16 +810,10 @@ void AvatarMixer::sendStatsPacket() {
 
     statsObject["broadcast_loop_rate"] = _loopRate.rate();
     statsObject["threads"] = _slavePool.numThreads();
+    statsObject["thread_stats"] = _slavePool.takeThreadStats();
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
 
-#ifdef DEBUG_EVENT_QUEUE
-    QJsonObject qtStats;
-
-    _slavePool.queueStats(qtStats);
-    statsObject["avatar_thread_event_queue"] = qtStats;
-#endif
-
     // this things all occur on the frequency of the tight loop
     int tightLoopFrames = _numTightLoopFrames;
     int tenTimesPerFrame = tightLoopFrames * 10;
@@ -850,6 +889,14 @@ void AvatarMixer::sendStatsPacket() {
     slavesAggregatObject["sent_5_averageTraitsBytes"] = TIGHT_LOOP_STAT(aggregateStats.numTraitsBytesSent);
     slavesAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
     slavesAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
+    slavesAggregatObject["encodeCache_1_hits"] = TIGHT_LOOP_STAT(aggregateStats.numEncodeCacheHits);
+    slavesAggregatObject["encodeCache_2_misses"] = TIGHT_LOOP_STAT(aggregateStats.numEncodeCacheMisses);
+    slavesAggregatObject["encodeCache_3_bypasses"] = TIGHT_LOOP_STAT(aggregateStats.numEncodeCacheBypasses);
+
+    float averageCandidates = aggregateStats.numSpatialIndexListeners ?
+        (float)aggregateStats.numSpatialIndexCandidates / (float)aggregateStats.numSpatialIndexListeners : 0.0f;
+    slavesAggregatObject["spatialIndex_1_listeners"] = TIGHT_LOOP_STAT(aggregateStats.numSpatialIndexListeners);
+    slavesAggregatObject["spatialIndex_2_averageCandidates"] = averageCandidates;
 
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
@@ -1041,6 +1088,32 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
         }
     }
 
+    {   // Sorting only nearby and a sample of distant avatars for each listener in crowded domains:
+        static const QString SPATIAL_INDEX_MIN_AVATARS_KEY = "spatial_index_min_avatars";
+        static const QString SPATIAL_INDEX_RADIUS_KEY = "spatial_index_radius";
+        static const QString SPATIAL_INDEX_DISTANT_SAMPLES_KEY = "spatial_index_distant_samples";
+
+        bool ok;
+        int minAvatars = avatarMixerGroupObject[SPATIAL_INDEX_MIN_AVATARS_KEY].toString().toInt(&ok);
+        if (ok) {
+            _spatialIndexMinAvatars = std::max(minAvatars, 0);
+        }
+        float radius = avatarMixerGroupObject[SPATIAL_INDEX_RADIUS_KEY].toString().toFloat(&ok);
+        if (ok && radius > 0.0f) {
+            _spatialIndexRadius = radius;
+        }
+        int distantSamples = avatarMixerGroupObject[SPATIAL_INDEX_DISTANT_SAMPLES_KEY].toString().toInt(&ok);
+        if (ok) {
+            _spatialIndexDistantSamples = std::max(distantSamples, 0);
+        }
+
+        if (_spatialIndexMinAvatars > 0) {
+            qCDebug(avatars) << "Avatar mixer will sort avatars within" << _spatialIndexRadius << "m of each listener, and"
+                << _spatialIndexDistantSamples << "others per frame, when there are at least"
+                << _spatialIndexMinAvatars << "avatars";
+        }
+    }
+
     const QString AVATARS_SETTINGS_KEY = "avatars";
 
     static const QString MIN_HEIGHT_OPTION = "min_avatar_height";
@@ -77,6 +77,8 @@ private:
 
     void manageIdentityData(const SharedNodePointer& node);
 
+    void buildAvatarSpatialIndex(NodeList::const_iterator begin, NodeList::const_iterator end);
+
     void optionallyReplicatePacket(ReceivedMessage& message, const Node& node);
 
     void setupEntityQuery();
@@ -98,6 +100,10 @@ private:
 
     float _maxKbpsPerNode = 0.0f;
 
+    // see AvatarSpatialIndex, disabled when the minimum number of avatars is 0
+    int _spatialIndexMinAvatars { 200 };
+    float _spatialIndexRadius { 50.0f };
+    int _spatialIndexDistantSamples { 20 };
     float _domainMinimumHeight { MIN_AVATAR_HEIGHT };
     float _domainMaximumHeight { MAX_AVATAR_HEIGHT };
 
@@ -127,6 +127,12 @@ public:
     void setLastOtherAvatarEncodeTime(NLPacket::LocalID otherAvatar, uint64_t time);
 
     QVector<JointData>& getLastOtherAvatarSentJoints(NLPacket::LocalID otherAvatar) { return _lastOtherAvatarSentJoints[otherAvatar]; }
+    // identifies the last sent joints when they came from MixerAvatar's encode cache, 0 otherwise
+    uint64_t& getLastOtherAvatarSentJointsVersion(NLPacket::LocalID otherAvatar) { return _lastOtherAvatarSentJointsVersions[otherAvatar]; }
+
+    // where this listener's rotating sample of distant avatars continues next frame
+    size_t getDistantAvatarCursor() const { return _distantAvatarCursor; }
+    void setDistantAvatarCursor(size_t cursor) { _distantAvatarCursor = cursor; }
 
     void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
     int processPackets(const SlaveSharedData& slaveSharedData); // returns number of packets processed
@@ -174,6 +180,8 @@ private:
     // sending to "this" node
     std::unordered_map<NLPacket::LocalID, uint64_t> _lastOtherAvatarEncodeTime;
     std::unordered_map<NLPacket::LocalID, QVector<JointData>> _lastOtherAvatarSentJoints;
+    std::unordered_map<NLPacket::LocalID, uint64_t> _lastOtherAvatarSentJointsVersions;
+    size_t _distantAvatarCursor { 0 };
 
     uint64_t _identityChangeTimestamp;
     bool _avatarSessionDisplayNameMustChange{ true };
@@ -12,8 +12,8 @@
 #include "AvatarMixerSlave.h"
 
 #include <algorithm>
-#include <random>
 #include <chrono>
+#include <iterator>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
@@ -311,16 +311,41 @@ namespace {
 
 }  // Close anonymous namespace.
 
+void AvatarMixerSlave::selectCandidateNodes(const Node* destinationNode, AvatarMixerClientData* destinationNodeData,
+                                            bool useSpatialIndex) {
+    _candidateNodes.clear();
+
+    const auto& spatialIndex = _sharedData->avatarSpatialIndex;
+    if (!useSpatialIndex || !spatialIndex.isEnabled) {
+        std::transform(_begin, _end, std::back_inserter(_candidateNodes), [](const SharedNodePointer& node) {
+            return node.data();
+        });
+        return;
+    }
+
+    // the avatars out of the radius are sampled a few at a time, so each is still considered every so many frames
+    size_t cursor = destinationNodeData->getDistantAvatarCursor();
+    spatialIndex.grid.selectCandidates(destinationNodeData->getPosition(), spatialIndex.radius, spatialIndex.heroes,
+                                       spatialIndex.avatars, (size_t)spatialIndex.numDistantSamples, cursor,
+                                       _candidateIndexes);
+    destinationNodeData->setDistantAvatarCursor(cursor);
+
+    for (auto index : _candidateIndexes) {
+        Node* candidateNode = (_begin + index)->data();
+        if (candidateNode != destinationNode) {
+            _candidateNodes.push_back(candidateNode);
+        }
+    }
+
+    _stats.numSpatialIndexListeners++;
+    _stats.numSpatialIndexCandidates += (int)_candidateNodes.size();
+}
+
 void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node) {
     const Node* destinationNode = node.data();
 
     auto nodeList = DependencyManager::get<NodeList>();
 
-    // setup for distributed random floating point values
-    std::random_device randomDevice;
-    std::mt19937 generator(randomDevice());
-    std::uniform_real_distribution<float> distribution;
-
     _stats.nodesBroadcastedTo++;
 
     AvatarMixerClientData* destinationNodeData = reinterpret_cast<AvatarMixerClientData*>(destinationNode->getLinkedData());
@@ -330,9 +355,6 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     const AvatarData& avatar = destinationNodeData->getAvatar();
     glm::vec3 destinationPosition = avatar.getClientGlobalPosition();
 
-    // reset the internal state for correct random number distribution
-    distribution.reset();
-
     // Estimate number to sort on number sent last frame (with min. of 20).
     const int numToSendEst = std::max(int(destinationNodeData->getNumAvatarsSentLastFrame() * 2.5f), 20);
 
@@ -384,10 +406,12 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge}
     };
 
-    avatarPriorityQueues[kNonhero].reserve(_end - _begin);
+    // with the PAL open, or just closed, every avatar has to be considered
+    selectCandidateNodes(destinationNode, destinationNodeData, !PALIsOpen && !PALWasOpen);
+
+    avatarPriorityQueues[kNonhero].reserve(_candidateNodes.size());
 
-    for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
-        Node* otherNodeRaw = (*listedNode).data();
+    for (Node* otherNodeRaw : _candidateNodes) {
         if (otherNodeRaw->getType() != NodeType::Agent
             || !otherNodeRaw->getLinkedData()
             || otherNodeRaw == destinationNode) {
@@ -548,7 +572,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
                 detail = PALIsOpen ? AvatarData::PALMinimum : AvatarData::MinimumData;
                 destinationNodeData->incrementAvatarOutOfView();
             } else if (!overBudget) {
-                detail = distribution(generator) < AVATAR_SEND_FULL_UPDATE_RATIO ? AvatarData::SendAllData : AvatarData::CullSmallData;
+                detail = sourceAvatar->isEncodeKeyFrame() ? AvatarData::SendAllData : AvatarData::CullSmallData;
                 destinationNodeData->incrementAvatarInView();
 
                 // If the time that the mixer sent AVATAR DATA about Avatar B to Node A is BEFORE OR EQUAL TO
@@ -563,32 +587,81 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             }
 
             QVector<JointData>& lastSentJointsForOther = destinationNodeData->getLastOtherAvatarSentJoints(sourceNode->getLocalID());
+            uint64_t& lastSentJointsVersionForOther =
+                destinationNodeData->getLastOtherAvatarSentJointsVersion(sourceNode->getLocalID());
 
             const bool distanceAdjust = true;
             const bool dropFaceTracking = false;
             AvatarDataPacket::SendStatus sendStatus;
             sendStatus.sendUUID = true;
 
-            do {
+            bool isShared = false;
+            if (detail != AvatarData::NoData) {
+                // most listeners get the same encoding of this avatar as some other listener this frame,
+                // in which case it is taken from the avatar's encode cache rather than serialized again
                 auto startSerialize = chrono::high_resolution_clock::now();
-                QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                    sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
-                    &lastSentJointsForOther, avatarSpaceAvailable);
+                QByteArray bytes;
+                bool wasCached = false;
+                isShared = sourceAvatar->toSharedByteArray(detail, lastEncodeForOther, destinationPosition,
+                    avatarPacketCapacity, lastSentJointsForOther, lastSentJointsVersionForOther, bytes, wasCached);
                 auto endSerialize = chrono::high_resolution_clock::now();
                 _stats.toByteArrayElapsedTime +=
                     (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
 
-                avatarPacket->write(bytes);
-                avatarSpaceAvailable -= bytes.size();
-                numAvatarDataBytes += bytes.size();
-                if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
-                    // Weren't able to fit everything.
-                    nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
-                    ++numPacketsSent;
-                    avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
-                    avatarSpaceAvailable = avatarPacketCapacity;
+                if (isShared) {
+                    if (wasCached) {
+                        _stats.numEncodeCacheHits++;
+                    } else {
+                        _stats.numEncodeCacheMisses++;
+                    }
+
+                    // a shared encoding can't be split, so it goes in the next packet if it doesn't fit in this one
+                    if (bytes.size() > avatarSpaceAvailable) {
+                        nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+                        ++numPacketsSent;
+                        avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                        avatarSpaceAvailable = avatarPacketCapacity;
+                    }
+
+                    avatarPacket->write(bytes);
+                    avatarSpaceAvailable -= bytes.size();
+                    numAvatarDataBytes += bytes.size();
+                    if (avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                        nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+                        ++numPacketsSent;
+                        avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                        avatarSpaceAvailable = avatarPacketCapacity;
+                    }
+                } else {
+                    _stats.numEncodeCacheBypasses++;
                 }
-            } while (!sendStatus);
+            }
+
+            if (!isShared) {
+                // encode for this listener alone, splitting the avatar across packets if need be
+                lastSentJointsVersionForOther = 0;
+
+                do {
+                    auto startSerialize = chrono::high_resolution_clock::now();
+                    QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
+                        sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
+                        &lastSentJointsForOther, avatarSpaceAvailable);
+                    auto endSerialize = chrono::high_resolution_clock::now();
+                    _stats.toByteArrayElapsedTime +=
+                        (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
+
+                    avatarPacket->write(bytes);
+                    avatarSpaceAvailable -= bytes.size();
+                    numAvatarDataBytes += bytes.size();
+                    if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                        // Weren't able to fit everything.
+                        nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+                        ++numPacketsSent;
+                        avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                        avatarSpaceAvailable = avatarPacketCapacity;
+                    }
+                } while (!sendStatus);
+            }
 
             if (detail != AvatarData::NoData) {
                 _stats.numOthersIncluded++;
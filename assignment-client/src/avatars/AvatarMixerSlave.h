@@ -13,6 +13,7 @@
 #define hifi_AvatarMixerSlave_h
 
 #include <NodeList.h>
+#include <SpatialHashGrid.h>
 
 class AvatarMixerClientData;
 
@@ -33,6 +34,11 @@ public:
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
     int numHeroesIncluded { 0 };
+    int numEncodeCacheHits { 0 };
+    int numEncodeCacheMisses { 0 };
+    int numEncodeCacheBypasses { 0 };
+    int numSpatialIndexListeners { 0 };
+    int numSpatialIndexCandidates { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -59,6 +65,11 @@ public:
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
         numHeroesIncluded = 0;
+        numEncodeCacheHits = 0;
+        numEncodeCacheMisses = 0;
+        numEncodeCacheBypasses = 0;
+        numSpatialIndexListeners = 0;
+        numSpatialIndexCandidates = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -83,6 +94,11 @@ public:
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
         numHeroesIncluded += rhs.numHeroesIncluded;
+        numEncodeCacheHits += rhs.numEncodeCacheHits;
+        numEncodeCacheMisses += rhs.numEncodeCacheMisses;
+        numEncodeCacheBypasses += rhs.numEncodeCacheBypasses;
+        numSpatialIndexListeners += rhs.numSpatialIndexListeners;
+        numSpatialIndexCandidates += rhs.numSpatialIndexCandidates;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -96,10 +112,24 @@ public:
 class EntityTree;
 using EntityTreePointer = std::shared_ptr<EntityTree>;
 
+// Avatar positions, rebuilt every frame when there are enough avatars for sorting all of them for every listener to be
+// too costly. Listeners then only consider the avatars within the radius, heroes, and a rotating sample of the rest.
+struct AvatarSpatialIndex {
+    bool isEnabled { false };
+    float radius { 0.0f };
+    int numDistantSamples { 0 };
+
+    // indexes are positions in the node range being broadcast to
+    SpatialHashGrid grid;
+    std::vector<SpatialHashGrid::Index> heroes;
+    std::vector<SpatialHashGrid::Index> avatars;
+};
+
 struct SlaveSharedData {
     QStringList skeletonURLWhitelist;
     QUrl skeletonReplacementURL;
     EntityTreePointer entityTree;
+    AvatarSpatialIndex avatarSpatialIndex;
 };
 
 class AvatarMixerSlave {
@@ -134,6 +164,9 @@ private:
     void broadcastAvatarDataToAgent(const SharedNodePointer& node);
     void broadcastAvatarDataToDownstreamMixer(const SharedNodePointer& node);
 
+    void selectCandidateNodes(const Node* destinationNode, AvatarMixerClientData* destinationNodeData,
+                              bool useSpatialIndex);
+
     // frame state
     ConstIter _begin;
     ConstIter _end;
@@ -145,6 +178,9 @@ private:
 
     AvatarMixerSlaveStats _stats;
     SlaveSharedData* _sharedData;
+
+    std::vector<Node*> _candidateNodes;
+    std::vector<SpatialHashGrid::Index> _candidateIndexes;
 };
 
 #endif // hifi_AvatarMixerSlave_h
@@ -14,121 +14,58 @@
 #include <assert.h>
 #include <algorithm>
 
-void AvatarMixerSlaveThread::run() {
-    while (true) {
-        wait();
-
-        // iterate over all available nodes
-        SharedNodePointer node;
-        while (try_pop(node)) {
-            (this->*_function)(node);
-        }
-
-        bool stopping = _stop;
-        notify(stopping);
-        if (stopping) {
-            return;
-        }
-    }
-}
-
-void AvatarMixerSlaveThread::wait() {
-    {
-        Lock lock(_pool._mutex);
-        _pool._slaveCondition.wait(lock, [&] {
-            assert(_pool._numStarted <= _pool._numThreads);
-            return _pool._numStarted != _pool._numThreads;
-        });
-        ++_pool._numStarted;
-    }
-    if (_pool._configure) {
-        _pool._configure(*this);
-    }
-    _function = _pool._function;
-}
-
-void AvatarMixerSlaveThread::notify(bool stopping) {
-    {
-        Lock lock(_pool._mutex);
-        assert(_pool._numFinished < _pool._numThreads);
-        ++_pool._numFinished;
-        if (stopping) {
-            ++_pool._numStopped;
-        }
-    }
-    _pool._poolCondition.notify_one();
-}
-
-bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
-}
-
 void AvatarMixerSlavePool::processIncomingPackets(ConstIter begin, ConstIter end) {
-    _function = &AvatarMixerSlave::processIncomingPackets;
-    _configure = [=](AvatarMixerSlave& slave) { 
+    run(begin, end, &AvatarMixerSlave::processIncomingPackets, [=](AvatarMixerSlave& slave) {
         slave.configure(begin, end);
-    };
-    run(begin, end);
+    });
 }
 
 void AvatarMixerSlavePool::broadcastAvatarData(ConstIter begin, ConstIter end, 
                                                p_high_resolution_clock::time_point lastFrameTimestamp,
                                                float maxKbpsPerNode, float throttlingRatio) {
-    _function = &AvatarMixerSlave::broadcastAvatarData;
-    _configure = [=](AvatarMixerSlave& slave) { 
+    run(begin, end, &AvatarMixerSlave::broadcastAvatarData, [=](AvatarMixerSlave& slave) {
         slave.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio,
             _priorityReservedFraction);
-   };
-    run(begin, end);
-}
-
-void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
-    _begin = begin;
-    _end = end;
-
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
     });
+}
 
-    {
-        Lock lock(_mutex);
-
-        // run
-        _numStarted = _numFinished = 0;
-        _slaveCondition.notify_all();
+void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end,
+                               void (AvatarMixerSlave::*function)(const SharedNodePointer& node),
+                               std::function<void(AvatarMixerSlave&)> configure) {
+    auto nodeList = DependencyManager::get<NodeList>();
 
-        // wait
-        _poolCondition.wait(lock, [&] {
-            assert(_numFinished <= _numThreads);
-            return _numFinished == _numThreads;
-        });
+    WorkStealingPool::Job job;
+    job.numItems = std::distance(begin, end);
+    job.begin = [&](int worker) {
+        configure(*_slaves[worker]);
 
-        assert(_numStarted == _numThreads);
-    }
+        // unreliable packets sent while iterating are written in batches, if the node socket has batching enabled
+        nodeList->beginSendBatch();
+    };
+    job.run = [&](int worker, size_t first, size_t last) {
+        auto& slave = *_slaves[worker];
+        for (auto node = begin + first; node != begin + last; ++node) {
+            (slave.*function)(*node);
+        }
+    };
+    job.end = [&](int worker) {
+        nodeList->flushSendBatch();
+    };
 
-    assert(_queue.empty());
+    _workers.run(job);
 }
 
-
 void AvatarMixerSlavePool::each(std::function<void(AvatarMixerSlave& slave)> functor) {
     for (auto& slave : _slaves) {
         functor(*slave.get());
     }
 }
 
-#ifdef DEBUG_EVENT_QUEUE
-void AvatarMixerSlavePool::queueStats(QJsonObject& stats) {
-    unsigned i = 0;
-    for (auto& slave : _slaves) {
-        int queueSize = ::hifi::qt::getEventQueueSize(slave.get());
-        QString queueName = QString("avatar_thread_event_queue_%1").arg(i);
-        stats[queueName] = queueSize;
-
-        i++;
-    }
+QJsonObject AvatarMixerSlavePool::takeThreadStats() {
+    QJsonObject stats = _workers.getStatsObject();
+    _workers.resetStats();
+    return stats;
 }
-#endif // DEBUG_EVENT_QUEUE
 
 void AvatarMixerSlavePool::setNumThreads(int numThreads) {
     // clamp to allowed size
@@ -155,49 +92,14 @@ void AvatarMixerSlavePool::resize(int numThreads) {
 
     qDebug("%s: set %d threads (was %d)", __FUNCTION__, numThreads, _numThreads);
 
-    Lock lock(_mutex);
-
-    if (numThreads > _numThreads) {
-        // start new slaves
-        for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto slave = new AvatarMixerSlaveThread(*this, _slaveSharedData);
-            slave->start();
-            _slaves.emplace_back(slave);
-        }
-    } else if (numThreads < _numThreads) {
-        auto extraBegin = _slaves.begin() + numThreads;
-
-        // mark slaves to stop...
-        auto slave = extraBegin;
-        while (slave != _slaves.end()) {
-            (*slave)->_stop = true;
-            ++slave;
-        }
-
-        // ...cycle them until they do stop...
-        _numStopped = 0;
-        while (_numStopped != (_numThreads - numThreads)) {
-            _numStarted = _numFinished = _numStopped;
-            _slaveCondition.notify_all();
-            _poolCondition.wait(lock, [&] {
-                assert(_numFinished <= _numThreads);
-                return _numFinished == _numThreads;
-            });
-        }
-
-        // ...wait for threads to finish...
-        slave = extraBegin;
-        while (slave != _slaves.end()) {
-            QThread* thread = reinterpret_cast<QThread*>(slave->get());
-            static const int MAX_THREAD_WAIT_TIME = 10;
-            thread->wait(MAX_THREAD_WAIT_TIME);
-            ++slave;
-        }
+    // the first slave runs on the mixer's own thread, alongside the pool's workers
+    _workers.setNumWorkers(numThreads);
 
-        // ...and erase them
-        _slaves.erase(extraBegin, _slaves.end());
+    while ((int)_slaves.size() < numThreads) {
+        _slaves.emplace_back(new AvatarMixerSlave(_slaveSharedData));
     }
+    _slaves.resize(numThreads);
 
-    _numThreads = _numStarted = _numFinished = numThreads;
+    _numThreads = numThreads;
     assert(_numThreads == (int)_slaves.size());
 }
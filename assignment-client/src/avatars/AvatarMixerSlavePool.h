@@ -12,59 +12,27 @@
 #ifndef hifi_AvatarMixerSlavePool_h
 #define hifi_AvatarMixerSlavePool_h
 
-#include <condition_variable>
-#include <mutex>
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include <QThread>
+#include <QJsonObject>
 
-#include <TBBHelpers.h>
 #include <NodeList.h>
-#include <shared/QtHelpers.h>
+#include <WorkStealingPool.h>
 
 #include "AvatarMixerSlave.h"
 
 
-class AvatarMixerSlavePool;
-
-class AvatarMixerSlaveThread : public QThread, public AvatarMixerSlave {
-    Q_OBJECT
-    using ConstIter = NodeList::const_iterator;
-    using Mutex = std::mutex;
-    using Lock = std::unique_lock<Mutex>;
-
-public:
-    AvatarMixerSlaveThread(AvatarMixerSlavePool& pool, SlaveSharedData* slaveSharedData) :
-        AvatarMixerSlave(slaveSharedData), _pool(pool) {};
-
-    void run() override final;
-
-private:
-    friend class AvatarMixerSlavePool;
-
-    void wait();
-    void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
-
-    AvatarMixerSlavePool& _pool;
-    void (AvatarMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
-    bool _stop { false };
-};
-
-// Slave pool for avatar mixers
+// Slave pool for avatar mixers, each slave runs the nodes handed to one worker of a WorkStealingPool
 //   AvatarMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AvatarMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
-    using Mutex = std::mutex;
-    using Lock = std::unique_lock<Mutex>;
-    using ConditionVariable = std::condition_variable;
-
 public:
     using ConstIter = NodeList::const_iterator;
 
     AvatarMixerSlavePool(SlaveSharedData* slaveSharedData, int numThreads = QThread::idealThreadCount()) :
         _slaveSharedData(slaveSharedData) { setNumThreads(numThreads); }
-    ~AvatarMixerSlavePool() { resize(0); }
 
     // Jobs the slave pool can do...
     void processIncomingPackets(ConstIter begin, ConstIter end);
@@ -74,9 +42,8 @@ public:
     // iterate over all slaves
     void each(std::function<void(AvatarMixerSlave& slave)> functor);
 
-#ifdef DEBUG_EVENT_QUEUE
-    void queueStats(QJsonObject& stats);
-#endif
+    // per thread utilization and work stealing stats, reset on every call
+    QJsonObject takeThreadStats();
 
     void setNumThreads(int numThreads);
     int numThreads() const { return _numThreads; }
@@ -85,35 +52,17 @@ public:
     float getPriorityReservedFraction() const { return  _priorityReservedFraction; }
 
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, void (AvatarMixerSlave::*function)(const SharedNodePointer& node),
+             std::function<void(AvatarMixerSlave&)> configure);
     void resize(int numThreads);
 
-    std::vector<std::unique_ptr<AvatarMixerSlaveThread>> _slaves;
-
-    friend void AvatarMixerSlaveThread::wait();
-    friend void AvatarMixerSlaveThread::notify(bool stopping);
-    friend bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node);
-
-    // synchronization state
-    Mutex _mutex;
-    ConditionVariable _slaveCondition;
-    ConditionVariable _poolCondition;
-    void (AvatarMixerSlave::*_function)(const SharedNodePointer& node);
-    std::function<void(AvatarMixerSlave&)> _configure;
+    std::vector<std::unique_ptr<AvatarMixerSlave>> _slaves;
+    WorkStealingPool _workers { "AvatarMixerSlaveThread" };
 
     // Set from Domain Settings:
     float _priorityReservedFraction { 0.4f };
     int _numThreads { 0 };
 
-    int _numStarted { 0 }; // guarded by _mutex
-    int _numFinished { 0 }; // guarded by _mutex
-    int _numStopped { 0 }; // guarded by _mutex
-
-    // frame state
-    Queue _queue;
-    ConstIter _begin;
-    ConstIter _end;
-
     SlaveSharedData* _slaveSharedData;
 };
 
@@ -11,6 +11,8 @@
 
 #include "MixerAvatar.h"
 
+#include <functional>
+
 #include <QRegularExpression>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -25,6 +27,7 @@
 #include <MetaverseAPI.h>
 #include <EntityItem.h>
 #include <EntityItemProperties.h>
+#include <SharedUtil.h>
 #include "ClientTraitsHandler.h"
 #include "AvatarLogging.h"
 
@@ -416,3 +419,107 @@ void MixerAvatar::stopChallengeTimer() {
         QMetaObject::invokeMethod(&_challengeTimer, &QTimer::stop);
     }
 }
+
+// versions of last sent joint data handed out by the encode cache, unique across all avatars so a listener's
+// version can't match another avatar's encoding when node local IDs are reused
+static std::atomic<uint64_t> nextSentJointsVersion { 1 };
+
+void MixerAvatar::beginEncodeFrame() {
+    for (auto& entry : _encodeCache) {
+        if (entry.state.load(std::memory_order_relaxed) != EncodeCacheEntry::Empty) {
+            entry.bytes.clear();
+            entry.sentJoints.clear();
+            entry.state.store(EncodeCacheEntry::Empty, std::memory_order_relaxed);
+        }
+    }
+
+    _isEncodeKeyFrame = randFloat() < AVATAR_SEND_FULL_UPDATE_RATIO;
+}
+
+bool MixerAvatar::toSharedByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime, glm::vec3 viewerPosition,
+                                    int maxDataSize, QVector<JointData>& lastSentJoints, uint64_t& lastSentJointsVersion,
+                                    QByteArray& bytes, bool& wasCached) const {
+    // encodes the way AvatarMixerSlave does for agents: with the session UUID, distance adjusted, with face tracking
+    const bool distanceAdjust = true;
+    const bool dropFaceTracking = false;
+
+    // MinimumData and PALMinimum don't include joints, SendAllData includes all of them,
+    // so only CullSmallData depends on what the listener was sent before
+    const bool cullSmallChanges = dataDetail == CullSmallData;
+    const bool includesJoints = cullSmallChanges || dataDetail == SendAllData;
+    if (cullSmallChanges && lastSentJointsVersion == 0) {
+        return false;
+    }
+
+    // everything else the encoding depends on is captured by the items it includes and the joint culling threshold
+    AvatarDataPacket::HasFlags wantedFlags = getWantedFlags(dataDetail, lastSentTime, dropFaceTracking);
+    float minRotationDOT = cullSmallChanges ? getDistanceBasedMinRotationDOT(viewerPosition) : 0.0f;
+    uint64_t keyVersion = cullSmallChanges ? lastSentJointsVersion : 0;
+
+    auto encode = [&](QByteArray& encodedBytes, QVector<JointData>& sentJoints, uint64_t& sentJointsVersion) {
+        if (cullSmallChanges) {
+            sentJoints = lastSentJoints;
+        }
+        AvatarDataPacket::SendStatus sendStatus;
+        sendStatus.sendUUID = true;
+        encodedBytes = toByteArray(dataDetail, lastSentTime, sentJoints, sendStatus, dropFaceTracking, distanceAdjust,
+                                   viewerPosition, &sentJoints);
+        sentJointsVersion = includesJoints ? nextSentJointsVersion++ : 0;
+    };
+
+    QByteArray encodedBytes;
+    QVector<JointData> sentJoints;
+    uint64_t sentJointsVersion = 0;
+    bool isEncoded = false;
+    wasCached = false;
+
+    size_t hash = (size_t)dataDetail;
+    hash = hash * 31 + wantedFlags;
+    hash = hash * 31 + std::hash<float>()(minRotationDOT);
+    hash = hash * 31 + std::hash<uint64_t>()(keyVersion);
+
+    // open addressing, entries are only ever added during a frame so the first empty entry ends the search
+    for (int i = 0; i < ENCODE_CACHE_SIZE && !isEncoded; ++i) {
+        auto& entry = _encodeCache[(hash + i) % ENCODE_CACHE_SIZE];
+
+        // on failure the compare exchange loads the state another slave left the entry in
+        int state = entry.state.load(std::memory_order_acquire);
+        if (state == EncodeCacheEntry::Empty
+            && entry.state.compare_exchange_strong(state, EncodeCacheEntry::Filling, std::memory_order_acq_rel)) {
+            entry.dataDetail = dataDetail;
+            entry.wantedFlags = wantedFlags;
+            entry.minRotationDOT = minRotationDOT;
+            entry.lastSentJointsVersion = keyVersion;
+            encode(entry.bytes, entry.sentJoints, entry.sentJointsVersion);
+            entry.state.store(EncodeCacheEntry::Ready, std::memory_order_release);
+        } else if (state == EncodeCacheEntry::Ready && entry.dataDetail == dataDetail
+                   && entry.wantedFlags == wantedFlags && entry.minRotationDOT == minRotationDOT
+                   && entry.lastSentJointsVersion == keyVersion) {
+            wasCached = true;
+        } else {
+            // a different encoding, or one still being filled which isn't waited for
+            continue;
+        }
+
+        encodedBytes = entry.bytes;
+        sentJoints = entry.sentJoints;
+        sentJointsVersion = entry.sentJointsVersion;
+        isEncoded = true;
+    }
+
+    if (!isEncoded) {
+        // no entry free for it this frame
+        encode(encodedBytes, sentJoints, sentJointsVersion);
+    }
+
+    if (encodedBytes.size() > maxDataSize) {
+        return false;
+    }
+
+    bytes = encodedBytes;
+    if (includesJoints) {
+        lastSentJoints = sentJoints;
+        lastSentJointsVersion = sentJointsVersion;
+    }
+    return true;
+}
@@ -14,6 +14,9 @@
 #ifndef hifi_MixerAvatar_h
 #define hifi_MixerAvatar_h
 
+#include <array>
+#include <atomic>
+
 #include <AvatarData.h>
 
 class ResourceRequest;
@@ -48,6 +51,22 @@ public:
     const QUuid& getScreenshareZone() const { return _screenshareZone; }
     void setScreenshareZone(QUuid zone) { _screenshareZone = zone; }
 
+    // Per-frame cache of this avatar's encoded data, shared by every slave thread that sends it to a listener.
+    // Must be called from the mixer thread before the slaves start broadcasting the frame.
+    void beginEncodeFrame();
+    // Frame in which every listener gets all of this avatar's data, rather than each picking its own frame at random,
+    // so that their last sent joints match and their CullSmallData updates can be shared afterwards.
+    bool isEncodeKeyFrame() const { return _isEncodeKeyFrame; }
+
+    // Encodes this avatar for a listener, reusing the encoding of any other listener that sent the same items with
+    // the same joint culling from the same last sent joints this frame. On success lastSentJoints and
+    // lastSentJointsVersion are updated to what the listener now has.
+    // Returns false, leaving the listener state untouched, if the encoding depends on last sent joints the cache can't
+    // identify (version 0) or doesn't fit in maxDataSize; the caller must then encode for the listener itself.
+    bool toSharedByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime, glm::vec3 viewerPosition, int maxDataSize,
+                           QVector<JointData>& lastSentJoints, uint64_t& lastSentJointsVersion,
+                           QByteArray& bytes, bool& wasCached) const;
+
 private:
     bool _needsHeroCheck { false };
     static const char* stateToName(VerifyState state);
@@ -73,6 +92,23 @@ private:
     bool _inScreenshareZone { false };
     QUuid _screenshareZone;
 
+    struct EncodeCacheEntry {
+        enum State { Empty, Filling, Ready };
+        std::atomic<int> state { Empty };
+
+        AvatarDataDetail dataDetail { NoData };
+        AvatarDataPacket::HasFlags wantedFlags { 0 };
+        float minRotationDOT { 0.0f };
+        uint64_t lastSentJointsVersion { 0 };
+
+        QByteArray bytes;
+        QVector<JointData> sentJoints;
+        uint64_t sentJointsVersion { 0 };
+    };
+    static constexpr int ENCODE_CACHE_SIZE = 32;
+    mutable std::array<EncodeCacheEntry, ENCODE_CACHE_SIZE> _encodeCache;
+    bool _isEncodeKeyFrame { false };
+
     bool generateFSTHash();
     bool validateFSTHash(const QString& publicKey) const;
     QByteArray canonicalJson(const QString fstFile);
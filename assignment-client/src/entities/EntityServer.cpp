@@ -347,6 +347,16 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
     }
     
     auto entityEditFilters = DependencyManager::get<EntityEditFilters>();
+
+    int filterWorkers;
+    if (readOptionInt("entityEditFilterWorkers", settingsSectionObject, filterWorkers)) {
+        entityEditFilters->setNumWorkers(filterWorkers);
+    }
+
+    int filterQueueLimit;
+    if (readOptionInt("entityEditFilterQueueLimit", settingsSectionObject, filterQueueLimit)) {
+        entityEditFilters->setMaxQueuedEdits(filterQueueLimit);
+    }
     
     QString filterURL;
     if (readOptionString("entityEditFilter", settingsSectionObject, filterURL) && !filterURL.isEmpty()) {
@@ -457,6 +467,48 @@ QString EntityServer::serverSubclassStats() {
     }
     statsString += "\r\n\r\n";
 
+    auto filterStats = DependencyManager::get<EntityEditFilters>()->getStats();
+    statsString += "<b>Entity Edit Filter Statistics</b>\r\n";
+    statsString += QString("               Filtered Edits: %1 edits\r\n")
+        .arg(locale.toString((uint)filterStats.queuedEdits).rightJustified(COLUMN_WIDTH, ' '));
+    statsString += QString("      Average Queue Wait Time: %1 usecs\r\n")
+        .arg(locale.toString((uint)(filterStats.queuedEdits == 0 ? 0 :
+            filterStats.totalQueueWaitUsecs / filterStats.queuedEdits)).rightJustified(COLUMN_WIDTH, ' '));
+    statsString += QString("              Max Queue Depth: %1 edits\r\n")
+        .arg(locale.toString((uint)filterStats.maxQueueDepth).rightJustified(COLUMN_WIDTH, ' '));
+    statsString += QString("    Rejected Over Queue Limit: %1 edits\r\n")
+        .arg(locale.toString((uint)filterStats.rejectedEdits).rightJustified(COLUMN_WIDTH, ' '));
+    statsString += "\r\n";
+
+    statsString += "----- Zone ID --------------------------    ---- Calls ----    -- Avg usecs --    -- Max usecs --\r\n";
+    QString bucketsHeader = "    ";
+    quint64 lowerLimit = 0;
+    for (auto limit : EntityEditFilters::LATENCY_BUCKET_LIMITS_USECS) {
+        bucketsHeader += QString("%1-%2").arg(lowerLimit).arg(limit).rightJustified(12, ' ');
+        lowerLimit = limit;
+    }
+    bucketsHeader += QString("%1+").arg(lowerLimit).rightJustified(12, ' ');
+    for (auto it = filterStats.zoneLatencies.cbegin(); it != filterStats.zoneLatencies.cend(); ++it) {
+        const auto& histogram = it.value();
+        // the global filter of the domain settings is under the null ID
+        statsString += (it.key().isInvalidID() ? QString("global").leftJustified(38, ' ') : it.key().toString());
+        statsString += "    ";
+        statsString += locale.toString((uint)histogram.calls).rightJustified(15, ' ');
+        statsString += "    ";
+        statsString += locale.toString((uint)(histogram.calls == 0 ? 0 : histogram.totalUsecs / histogram.calls)).rightJustified(15, ' ');
+        statsString += "    ";
+        statsString += locale.toString((uint)histogram.maxUsecs).rightJustified(15, ' ');
+        statsString += "\r\n" + bucketsHeader + "\r\n    ";
+        for (auto count : histogram.buckets) {
+            statsString += locale.toString((uint)count).rightJustified(12, ' ');
+        }
+        statsString += "\r\n";
+    }
+    if (filterStats.zoneLatencies.isEmpty()) {
+        statsString += "    no filtered edits... \r\n";
+    }
+    statsString += "\r\n\r\n";
+
     return statsString;
 }
 
@@ -362,6 +362,7 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
     nodeData->stats.encodeStarted();
     auto entityNode = _node.toStrongRef();
     auto entityNodeData = static_cast<EntityNodeData*>(entityNode->getLinkedData());
+    const EntityQueryFilter& queryFilter = entityNodeData->getQueryFilter(jsonFilters);
     while(!_sendQueue.empty()) {
         PrioritizedEntity queuedItem = _sendQueue.top();
         EntityItemPointer entity = queuedItem.getEntity();
@@ -369,11 +370,11 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
             const QUuid& entityID = entity->getID();
             // Only send entities that match the jsonFilters, but keep track of everything we've tried to send so we don't try to send it again;
             // also send if we previously matched since this represents change to a matched item.
-            bool entityMatchesFilters = entity->matchesJSONFilters(jsonFilters);
+            bool entityMatchesFilters = entity->matchesQueryFilter(queryFilter);
             bool entityPreviouslyMatchedFilter = entityNodeData->sentFilteredEntity(entityID);
 
             if (entityMatchesFilters || entityNodeData->isEntityFlaggedAsExtra(entityID) || entityPreviouslyMatchedFilter) {
-                if (!jsonFilters.isEmpty() && entityMatchesFilters) {
+                if (!queryFilter.isEmpty() && entityMatchesFilters) {
                     // Record explicitly filtered-in entity so that extra entities can be flagged.
                     entityNodeData->insertSentFilteredEntity(entityID);
                 }
@@ -22,6 +22,8 @@
 
 static QUuid DEFAULT_NODE_ID_REF;
 const quint64 TOO_LONG_SINCE_LAST_NACK = 1 * USECS_PER_SECOND;
+// bounds the time a burst of edits holds the write lock of the tree
+const size_t MAX_DECODED_EDITS_PER_BATCH = 500;
 
 OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServer) :
     _myServer(myServer),
@@ -42,6 +44,11 @@ void OctreeInboundPacketProcessor::resetStats() {
     _totalLockWaitTime = 0;
     _totalElementsInPacket = 0;
     _totalPackets = 0;
+    _totalEditBatches = 0;
+    _totalBatchedEdits = 0;
+    _totalBatchLockWaitTime = 0;
+    _totalBatchLockHoldTime = 0;
+    _maxBatchLockHoldTime = 0;
     _lastNackTime = usecTimestampNow();
 
     QWriteLocker locker(&_senderStatsLock);
@@ -76,6 +83,39 @@ void OctreeInboundPacketProcessor::midProcess() {
     }
 }
 
+void OctreeInboundPacketProcessor::postProcess() {
+    applyDecodedEdits();
+}
+
+void OctreeInboundPacketProcessor::applyDecodedEdits() {
+    if (_decodedEdits.empty()) {
+        return;
+    }
+
+    auto octree = _myServer->getOctree();
+    octree->prepareDecodedEdits(_decodedEdits);
+
+    quint64 startApply, startLock = usecTimestampNow();
+    octree->withWriteLock([&] {
+        startApply = usecTimestampNow();
+        for (auto& decodedEdit : _decodedEdits) {
+            octree->applyDecodedEdit(*decodedEdit);
+        }
+    });
+    quint64 lockHoldTime = usecTimestampNow() - startApply;
+
+    _totalEditBatches++;
+    _totalBatchedEdits += _decodedEdits.size();
+    _totalBatchLockWaitTime += startApply - startLock;
+    _totalBatchLockHoldTime += lockHoldTime;
+    if (lockHoldTime > _maxBatchLockHoldTime) {
+        _maxBatchLockHoldTime = lockHoldTime;
+    }
+
+    // released outside of the lock
+    _decodedEdits.clear();
+}
+
 void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     if (_shuttingDown) {
         qDebug() << "OctreeInboundPacketProcessor::processPacket() while shutting down... ignoring incoming packet";
@@ -92,7 +132,13 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
 
     // Ask our tree subclass if it can handle the incoming packet...
     PacketType packetType = message->getType();
-    
+    bool decodesEditsAhead = _myServer->getOctree()->decodesEditPacketType(packetType);
+
+    // whatever else the packet does happens after the edits decoded before it
+    if (!decodesEditsAhead) {
+        applyDecodedEdits();
+    }
+
     if (packetType == PacketType::ChallengeOwnership) {
         _myServer->getOctree()->withWriteLock([&] {
             _myServer->getOctree()->processChallengeOwnershipPacket(*message, sendingNode);
@@ -172,15 +218,26 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
 
             quint64 startProcess, startLock = usecTimestampNow();
             int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
-                startProcess = usecTimestampNow();
+            if (decodesEditsAhead) {
+                // decoded without the lock, applied with the other edits of the batch
+                startProcess = startLock;
+                OctreeDecodedEditPointer decodedEdit;
                 editDataBytesRead =
-                    _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
-            });
+                    _myServer->getOctree()->decodeEditPacketData(*message, editData, maxSize, sendingNode, decodedEdit);
+                if (decodedEdit) {
+                    _decodedEdits.push_back(std::move(decodedEdit));
+                }
+            } else {
+                _myServer->getOctree()->withWriteLock([&] {
+                    startProcess = usecTimestampNow();
+                    editDataBytesRead =
+                        _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
+                });
+            }
             quint64 endProcess = usecTimestampNow();
 
             if (debugProcessPacket) {
-                qDebug() << "OctreeInboundPacketProcessor::processPacket() after processEditPacketData()..."
+                qDebug() << "OctreeInboundPacketProcessor::processPacket() after processing edit data..."
                     << "editDataBytesRead=" << editDataBytesRead;
             }
 
@@ -220,6 +277,10 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
             }
         }
         trackInboundPacket(nodeUUID, sequence, transitTime, editsInPacket, processTime, lockWaitTime);
+
+        if (_decodedEdits.size() >= MAX_DECODED_EDITS_PER_BATCH) {
+            applyDecodedEdits();
+        }
     } else {
         qDebug("unknown packet ignored... packetType=%hhu", (unsigned char)packetType);
     }
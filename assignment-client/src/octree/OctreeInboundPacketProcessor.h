@@ -14,6 +14,9 @@
 #ifndef hifi_OctreeInboundPacketProcessor_h
 #define hifi_OctreeInboundPacketProcessor_h
 
+#include <vector>
+
+#include <Octree.h>
 #include <ReceivedPacketProcessor.h>
 
 #include "SequenceNumberStats.h"
@@ -70,6 +73,16 @@ public:
     quint64 getAverageLockWaitTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalLockWaitTime / _totalElementsInPacket; }
 
+    // edits decoded ahead are applied in batches, each holding the write lock of the tree once
+    quint64 getTotalEditBatches() const { return _totalEditBatches; }
+    float getAverageEditsPerBatch() const
+                { return _totalEditBatches == 0 ? 0.0f : (float)_totalBatchedEdits / _totalEditBatches; }
+    quint64 getAverageLockWaitTimePerBatch() const
+                { return _totalEditBatches == 0 ? 0 : _totalBatchLockWaitTime / _totalEditBatches; }
+    quint64 getAverageLockHoldTimePerBatch() const
+                { return _totalEditBatches == 0 ? 0 : _totalBatchLockHoldTime / _totalEditBatches; }
+    quint64 getMaxLockHoldTimePerBatch() const { return _maxBatchLockHoldTime; }
+
     void resetStats();
 
     NodeToSenderStatsMap getSingleSenderStats() { QReadLocker locker(&_senderStatsLock); return _singleSenderStats; }
@@ -83,9 +96,11 @@ protected:
     virtual uint32_t getMaxWait() const override;
     virtual void preProcess() override;
     virtual void midProcess() override;
+    virtual void postProcess() override;
 
 private:
     int sendNackPackets();
+    void applyDecodedEdits();
 
 private:
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
@@ -100,6 +115,13 @@ private:
     std::atomic<uint64_t> _totalElementsInPacket;
     std::atomic<uint64_t> _totalPackets;
     
+    std::vector<OctreeDecodedEditPointer> _decodedEdits;
+    std::atomic<uint64_t> _totalEditBatches { 0 };
+    std::atomic<uint64_t> _totalBatchedEdits { 0 };
+    std::atomic<uint64_t> _totalBatchLockWaitTime { 0 };
+    std::atomic<uint64_t> _totalBatchLockHoldTime { 0 };
+    std::atomic<uint64_t> _maxBatchLockHoldTime { 0 };
+
     NodeToSenderStatsMap _singleSenderStats;
     QReadWriteLock _senderStatsLock;
 
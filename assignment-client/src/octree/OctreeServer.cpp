@@ -657,6 +657,11 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         quint64 averageLockWaitTimePerElement = _octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
         quint64 totalElementsProcessed = _octreeInboundPacketProcessor->getTotalElementsProcessed();
         quint64 totalPacketsProcessed = _octreeInboundPacketProcessor->getTotalPacketsProcessed();
+        quint64 totalEditBatches = _octreeInboundPacketProcessor->getTotalEditBatches();
+        float averageEditsPerBatch = _octreeInboundPacketProcessor->getAverageEditsPerBatch();
+        quint64 averageLockWaitTimePerBatch = _octreeInboundPacketProcessor->getAverageLockWaitTimePerBatch();
+        quint64 averageLockHoldTimePerBatch = _octreeInboundPacketProcessor->getAverageLockHoldTimePerBatch();
+        quint64 maxLockHoldTimePerBatch = _octreeInboundPacketProcessor->getMaxLockHoldTimePerBatch();
 
         quint64 averageDecodeTime = _tree->getAverageDecodeTime();
         quint64 averageLookupTime = _tree->getAverageLookupTime();
@@ -693,6 +698,17 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString("  Average Wait Lock Time/Element: %1 usecs\r\n")
             .arg(locale.toString((uint)averageLockWaitTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
 
+        statsString += QString("              Total Edit Batches: %1 batches\r\n")
+            .arg(locale.toString((uint)totalEditBatches).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString().sprintf("             Average Edits/Batch: %f edits/batch\r\n",
+                                         (double)averageEditsPerBatch);
+        statsString += QString("    Average Wait Lock Time/Batch: %1 usecs\r\n")
+            .arg(locale.toString((uint)averageLockWaitTimePerBatch).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("    Average Hold Lock Time/Batch: %1 usecs\r\n")
+            .arg(locale.toString((uint)averageLockHoldTimePerBatch).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("        Max Hold Lock Time/Batch: %1 usecs\r\n")
+            .arg(locale.toString((uint)maxLockHoldTimePerBatch).rightJustified(COLUMN_WIDTH, ' '));
+
         statsString += QString("             Average Decode Time: %1 usecs\r\n")
             .arg(locale.toString((uint)averageDecodeTime).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("             Average Lookup Time: %1 usecs\r\n")
@@ -1060,6 +1076,18 @@ void OctreeServer::readConfiguration() {
 
         qDebug() << "persistInterval=" << _persistInterval.count();
 
+        readOptionBool(QString("persistJournal"), settingsSectionObject, _persistJournal);
+        qDebug() << "persistJournal=" << _persistJournal;
+
+        _persistCompactionInterval = OctreePersistThread::DEFAULT_COMPACTION_INTERVAL;
+        result = -1;
+        readOptionInt(QString("persistCompactionInterval"), settingsSectionObject, result);
+        if (result != -1) {
+            _persistCompactionInterval = std::chrono::milliseconds(result);
+        }
+
+        qDebug() << "persistCompactionInterval=" << _persistCompactionInterval.count();
+
         readOptionBool(QString("persistFileDownload"), settingsSectionObject, _persistFileDownload);
         qDebug() << "persistFileDownload=" << _persistFileDownload;
 
@@ -1191,6 +1219,9 @@ void OctreeServer::domainSettingsRequestComplete() {
         // now set up PersistThread
         _persistManager = new OctreePersistThread(_tree, _persistAbsoluteFilePath, _persistInterval, _debugTimestampNow,
                                                  _persistAsFileType);
+        if (_persistJournal) {
+            _persistManager->setJournaling(true, _persistCompactionInterval);
+        }
         _persistManager->moveToThread(&_persistThread);
         connect(&_persistThread, &QThread::finished, _persistManager, &QObject::deleteLater);
         connect(&_persistThread, &QThread::started, _persistManager, [this] {
@@ -1475,12 +1506,17 @@ void OctreeServer::sendStatsPacket() {
         dataArray2["1. packetQueue"] = (double)_octreeInboundPacketProcessor->packetsToProcessCount();
         dataArray2["2. totalPackets"] = (double)_octreeInboundPacketProcessor->getTotalPacketsProcessed();
         dataArray2["3. totalElements"] = (double)_octreeInboundPacketProcessor->getTotalElementsProcessed();
+        dataArray2["4. totalEditBatches"] = (double)_octreeInboundPacketProcessor->getTotalEditBatches();
+        dataArray2["5. avgEditsPerBatch"] = (double)_octreeInboundPacketProcessor->getAverageEditsPerBatch();
 
         timingArray2["1. avgTransitTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageTransitTimePerPacket();
         timingArray2["2. avgProcessTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageProcessTimePerPacket();
         timingArray2["3. avgLockWaitTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerPacket();
         timingArray2["4. avgProcessTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageProcessTimePerElement();
         timingArray2["5. avgLockWaitTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
+        timingArray2["6. avgLockWaitTimePerBatch"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerBatch();
+        timingArray2["7. avgLockHoldTimePerBatch"] = (double)_octreeInboundPacketProcessor->getAverageLockHoldTimePerBatch();
+        timingArray2["8. maxLockHoldTimePerBatch"] = (double)_octreeInboundPacketProcessor->getMaxLockHoldTimePerBatch();
     }
 
     QJsonObject statsObject3;
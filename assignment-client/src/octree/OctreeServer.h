@@ -197,6 +197,8 @@ protected:
 
     std::chrono::milliseconds _persistInterval;
     bool _persistFileDownload;
+    bool _persistJournal { false };
+    std::chrono::milliseconds _persistCompactionInterval;
     int _maxBackupVersions;
 
     time_t _started;
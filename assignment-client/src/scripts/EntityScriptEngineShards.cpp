@@ -0,0 +1,74 @@
+//
+//  EntityScriptEngineShards.cpp
+//  assignment-client/src/scripts
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptEngineShards.h"
+
+#include <algorithm>
+
+#include <SharedUtil.h>
+
+EntityScriptEngineShards::EntityScriptEngineShards(std::vector<ScriptEnginePointer> engines) :
+    _engines(std::move(engines)),
+    _lastIdleUsecs(_engines.size(), 0),
+    _lastStatsUsecs(usecTimestampNow())
+{
+    assert(!_engines.empty());
+    for (size_t i = 0; i < _engines.size(); ++i) {
+        _lastIdleUsecs[i] = _engines[i]->getIdleUsecs();
+    }
+}
+
+const ScriptEnginePointer& EntityScriptEngineShards::getEngineForEntity(const EntityItemID& entityID) const {
+    return _engines[qHash(entityID) % _engines.size()];
+}
+
+int EntityScriptEngineShards::getNumRunningEntityScripts() const {
+    int numRunningScripts = 0;
+    for (const auto& engine : _engines) {
+        numRunningScripts += engine->getNumRunningEntityScripts();
+    }
+    return numRunningScripts;
+}
+
+QList<EntityItemID> EntityScriptEngineShards::getListOfEntityScriptIDs() const {
+    QList<EntityItemID> entityIDs;
+    for (const auto& engine : _engines) {
+        entityIDs.append(engine->getListOfEntityScriptIDs());
+    }
+    return entityIDs;
+}
+
+QJsonObject EntityScriptEngineShards::getStatsObject() {
+    quint64 now = usecTimestampNow();
+    quint64 elapsedUsecs = now > _lastStatsUsecs ? now - _lastStatsUsecs : 0;
+    _lastStatsUsecs = now;
+
+    QJsonObject statsObject;
+    for (size_t i = 0; i < _engines.size(); ++i) {
+        quint64 idleUsecs = _engines[i]->getIdleUsecs();
+        quint64 idleElapsedUsecs = std::min(idleUsecs - _lastIdleUsecs[i], elapsedUsecs);
+        _lastIdleUsecs[i] = idleUsecs;
+
+        QJsonObject engineStats;
+        engineStats["number_running_scripts"] = _engines[i]->getNumRunningEntityScripts();
+        engineStats["load_percent"] = elapsedUsecs > 0 ? 100.0 * (elapsedUsecs - idleElapsedUsecs) / elapsedUsecs : 0.0;
+        statsObject[QString("engine_%1").arg(i)] = engineStats;
+    }
+    return statsObject;
+}
+
+void EntityScriptEngineShards::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                      const QStringList& params, const QUuid& remoteCallerID) {
+    getEngineForEntity(entityID)->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+}
+
+QFuture<QVariant> EntityScriptEngineShards::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    return getEngineForEntity(entityID)->getLocalEntityScriptDetails(entityID);
+}
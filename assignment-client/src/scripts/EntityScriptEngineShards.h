@@ -0,0 +1,50 @@
+//
+//  EntityScriptEngineShards.h
+//  assignment-client/src/scripts
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptEngineShards_h
+#define hifi_EntityScriptEngineShards_h
+
+#include <vector>
+
+#include <QtCore/QJsonObject>
+
+#include <EntitiesScriptEngineProvider.h>
+#include <ScriptEngine.h>
+
+// The script engines running the server entity scripts, each on its own thread.
+//
+// Every entity is assigned to one engine by the hash of its ID, so a busy entity script only holds back the scripts
+// sharing its engine. Calls to the methods of an entity script, from clients or from other entity scripts through the
+// EntityScriptingInterface, are routed to the engine running it.
+class EntityScriptEngineShards : public EntitiesScriptEngineProvider {
+public:
+    EntityScriptEngineShards(std::vector<ScriptEnginePointer> engines);
+
+    size_t getNumShards() const { return _engines.size(); }
+    const std::vector<ScriptEnginePointer>& getEngines() const { return _engines; }
+    const ScriptEnginePointer& getEngineForEntity(const EntityItemID& entityID) const;
+
+    int getNumRunningEntityScripts() const;
+    QList<EntityItemID> getListOfEntityScriptIDs() const;
+
+    // the running scripts and the busy time of each engine since the previous call
+    QJsonObject getStatsObject();
+
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params = QStringList(), const QUuid& remoteCallerID = QUuid()) override;
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
+private:
+    std::vector<ScriptEnginePointer> _engines;
+    std::vector<quint64> _lastIdleUsecs;
+    quint64 _lastStatsUsecs;
+};
+
+#endif // hifi_EntityScriptEngineShards_h
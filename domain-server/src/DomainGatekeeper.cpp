@@ -377,7 +377,11 @@ void DomainGatekeeper::updateNodePermissions() {
                                               connectingAddr.getAddress(), hardwareAddress, machineFingerprint);
         }
 
+        bool permissionsChanged = node->getPermissions().permissions != userPerms.permissions;
         node->setPermissions(userPerms);
+        if (permissionsChanged) {
+            emit updatedNode(node);
+        }
 
         if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
             qDebug() << "node" << node->getUUID() << "no longer has permission to connect.";
@@ -68,6 +68,7 @@ public slots:
 signals:
     void killNode(SharedNodePointer node);
     void connectedNode(SharedNodePointer node, quint64 requestReceiveTime);
+    void updatedNode(SharedNodePointer node);
 
 public slots:
     void updateNodePermissions();
@@ -217,6 +217,7 @@ DomainServer::DomainServer(int argc, char* argv[]) :
 
     // make sure we hear about newly connected nodes from our gatekeeper
     connect(&_gatekeeper, &DomainGatekeeper::connectedNode, this, &DomainServer::handleConnectedNode);
+    connect(&_gatekeeper, &DomainGatekeeper::updatedNode, this, &DomainServer::handleUpdatedNode);
 
     // if a connected node loses connection privileges, hang up on it
     connect(&_gatekeeper, &DomainGatekeeper::killNode, this, &DomainServer::handleKillNode);
@@ -704,6 +705,8 @@ bool DomainServer::isPacketVerified(const udt::Packet& packet) {
 void DomainServer::setupNodeListAndAssignments() {
     const QString CUSTOM_LOCAL_PORT_OPTION = "metaverse.local_port";
     static const QString ENABLE_PACKET_AUTHENTICATION = "metaverse.enable_packet_verification";
+    static const QString PACKET_AUTHENTICATION_METHOD = "metaverse.packet_verification_method";
+    static const QString SIPHASH_AUTHENTICATION_METHOD = "siphash";
 
     QVariant localPortValue = _settingsManager.valueOrDefaultValueForKeyPath(CUSTOM_LOCAL_PORT_OPTION);
     int domainServerPort = localPortValue.toInt();
@@ -772,6 +775,8 @@ void DomainServer::setupNodeListAndAssignments() {
 
     bool isAuthEnabled = _settingsManager.valueOrDefaultValueForKeyPath(ENABLE_PACKET_AUTHENTICATION).toBool();
     nodeList->setAuthenticatePackets(isAuthEnabled);
+    QString authMethod = _settingsManager.valueOrDefaultValueForKeyPath(PACKET_AUTHENTICATION_METHOD).toString();
+    nodeList->setAuthenticationMethod(authMethod == SIPHASH_AUTHENTICATION_METHOD ? HMACAuth::SIPHASH : HMACAuth::MD5);
 
     connect(nodeList.data(), &LimitedNodeList::nodeAdded, this, &DomainServer::nodeAdded);
     connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &DomainServer::nodeKilled);
@@ -1113,8 +1118,12 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
     // update this node's sockets in case they have changed
-    sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
-    sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+    if (sendingNode->getPublicSocket() != nodeRequestData.publicSockAddr ||
+        sendingNode->getLocalSocket() != nodeRequestData.localSockAddr) {
+        sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
+        sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+        handleUpdatedNode(sendingNode);
+    }
 
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
 
@@ -1132,7 +1141,12 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     }
 
     // update the NodeInterestSet in case there have been any changes
-    nodeData->setNodeInterestSet(safeInterestSet);
+    // the node hasn't heard about the nodes of its new types of interest, so it will need the whole list
+    auto knownListVersion = nodeRequestData.domainListVersion;
+    if (nodeData->getNodeInterestSet() != safeInterestSet) {
+        nodeData->setNodeInterestSet(safeInterestSet);
+        knownListVersion = DomainListChangeLog::NO_VERSION;
+    }
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
@@ -1140,7 +1154,8 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // client-side send time of last connect/domain list request
     nodeData->setLastDomainCheckinTimestamp(nodeRequestData.lastPingTimestamp);
 
-    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false);
+    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false,
+                         knownListVersion);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1218,64 +1233,115 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 reques
         newNode->setIsReplicated(true);
     }
 
-    // send out this node to our other connected nodes
+    // the nodes already connected hear about this one right away, and through their next lists if that gets lost
+    _domainListChangeLog.nodeChanged(newNode->getUUID(), newNode->getType());
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr &senderSockAddr, bool newConnection) {
+void DomainServer::handleUpdatedNode(SharedNodePointer node) {
+    // what the other nodes know about this one changed, send it with their next lists
+    _domainListChangeLog.nodeChanged(node->getUUID(), node->getType());
+}
+
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr &senderSockAddr,
+                                        bool newConnection, DomainListChangeLog::Version knownListVersion) {
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID +
         NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4;
 
-    // setup the extended header for the domain list packets
-    // this data is at the beginning of each of the domain list packets
-    QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
-    QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
-    extendedHeaderStream << limitedNodeList->getSessionUUID();
-    extendedHeaderStream << limitedNodeList->getSessionLocalID();
-    extendedHeaderStream << node->getUUID();
-    extendedHeaderStream << node->getLocalID();
-    extendedHeaderStream << node->getPermissions();
-    extendedHeaderStream << limitedNodeList->getAuthenticatePackets();
-    extendedHeaderStream << nodeData->getLastDomainCheckinTimestamp();
-    extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
-    extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
-    extendedHeaderStream << newConnection;
-    auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
-
-    // always send the node their own UUID back
-    QDataStream domainListStream(domainListPackets.get());
+    // unauthenticated nodes get an empty list, with no version so that they ask for the whole list again
+    auto listVersion = DomainListChangeLog::NO_VERSION;
+    std::vector<DomainListChangeLog::Change> changes;
+    bool isDelta = false;
+    if (nodeData->isAuthenticated()) {
+        listVersion = _domainListChangeLog.getVersion();
+        isDelta = !newConnection && _domainListChangeLog.getChangesSince(knownListVersion, changes);
+    }
 
     // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
     auto& nodeInterestSet = nodeData->getNodeInterestSet();
 
-    if (nodeInterestSet.size() > 0) {
+    auto createDomainListPackets = [&](bool isDeltaList) {
+        // setup the extended header for the domain list packets
+        // this data is at the beginning of each of the domain list packets
+        QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
+        QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
+
+        extendedHeaderStream << limitedNodeList->getSessionUUID();
+        extendedHeaderStream << limitedNodeList->getSessionLocalID();
+        extendedHeaderStream << node->getUUID();
+        extendedHeaderStream << node->getLocalID();
+        extendedHeaderStream << node->getPermissions();
+        extendedHeaderStream << limitedNodeList->getAuthenticatePackets();
+        extendedHeaderStream << (quint8)limitedNodeList->getAuthenticationMethod();
+        extendedHeaderStream << nodeData->getLastDomainCheckinTimestamp();
+        extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
+        extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
+        extendedHeaderStream << newConnection;
+        extendedHeaderStream << (quint8)(isDeltaList ? DomainListChangeLog::ListType::Delta : DomainListChangeLog::ListType::Full);
+        extendedHeaderStream << (isDeltaList ? knownListVersion : DomainListChangeLog::NO_VERSION);
+        extendedHeaderStream << listVersion;
+        auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
+
+        // always send the node their own UUID back
+        QDataStream domainListStream(domainListPackets.get());
+
+        if (nodeInterestSet.size() > 0 && isDeltaList) {
+            // only the nodes that changed since the list the node holds, each preceded by whether it was removed
+            for (const auto& change : changes) {
+                if (change.isRemoved) {
+                    if (nodeInterestSet.contains(change.nodeType)) {
+                        domainListPackets->startSegment();
+                        domainListStream << true << change.nodeID;
+                        domainListPackets->endSegment();
+                    }
+                    continue;
+                }
 
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
+                auto otherNode = limitedNodeList->nodeWithUUID(change.nodeID);
+                if (otherNode && otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
                     domainListPackets->startSegment();
-
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
-
-                    // pack the secret that these two nodes will use to communicate with each other
+                    domainListStream << false << *otherNode.data();
                     domainListStream << connectionSecretForNodes(node, otherNode);
-
-                    // we've added the node we wanted so end the segment now
                     domainListPackets->endSegment();
                 }
-            });
+            }
+        } else if (nodeInterestSet.size() > 0) {
+
+            // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
+            if (nodeData->isAuthenticated()) {
+                // if this authenticated node has any interest types, send back those nodes as well
+                limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
+                    if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+                        // since we're about to add a node to the packet we start a segment
+                        domainListPackets->startSegment();
+
+                        // don't send avatar nodes to other avatars, that will come from avatar mixer
+                        domainListStream << *otherNode.data();
+
+                        // pack the secret that these two nodes will use to communicate with each other
+                        domainListStream << connectionSecretForNodes(node, otherNode);
+
+                        // we've added the node we wanted so end the segment now
+                        domainListPackets->endSegment();
+                    }
+                });
+            }
         }
-    }
 
-    // send an empty list to the node, in case there were no other nodes
-    domainListPackets->closeCurrentPacket(true);
+        // send an empty list to the node, in case there were no other nodes
+        domainListPackets->closeCurrentPacket(true);
+        return domainListPackets;
+    };
+
+    auto domainListPackets = createDomainListPackets(isDelta);
+    if (isDelta && domainListPackets->getNumPackets() > 1) {
+        // the list is sent unreliably, the node couldn't tell which packets of a delta it missed, while a full list can
+        // be applied in parts
+        domainListPackets = createDomainListPackets(false);
+    }
 
     // write the PacketList to this node
     limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
@@ -3178,6 +3244,9 @@ void DomainServer::updateReplicatedNodes() {
                     << otherNode->getPermissions().getVerifiedUserName() << otherNode->getUUID();
             }
             otherNode->setIsReplicated(shouldReplicate);
+            if (isReplicated != shouldReplicate) {
+                handleUpdatedNode(otherNode);
+            }
         }
     );
 }
@@ -3210,6 +3279,8 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
     // if this peer connected via ICE then remove them from our ICE peers hash
     _gatekeeper.cleanupICEPeerForNode(node->getUUID());
 
+    _domainListChangeLog.nodeRemoved(node->getUUID(), node->getType());
+
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
 
     if (nodeData) {
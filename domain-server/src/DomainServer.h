@@ -25,6 +25,7 @@
 #include <QAbstractNativeEventFilter>
 
 #include <Assignment.h>
+#include <DomainListChangeLog.h>
 #include <HTTPSConnection.h>
 #include <LimitedNodeList.h>
 
@@ -118,6 +119,7 @@ private slots:
     void nodePingMonitor();
 
     void handleConnectedNode(SharedNodePointer newNode, quint64 requestReceiveTime);
+    void handleUpdatedNode(SharedNodePointer node);
     void handleTempDomainSuccess(QNetworkReply* requestReply);
     void handleTempDomainError(QNetworkReply* requestReply);
 
@@ -185,7 +187,8 @@ private:
     void handleKillNode(SharedNodePointer nodeToKill);
     void broadcastNodeDisconnect(const SharedNodePointer& disconnnectedNode);
 
-    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr& senderSockAddr, bool newConnection);
+    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr& senderSockAddr,
+                              bool newConnection, DomainListChangeLog::Version knownListVersion = DomainListChangeLog::NO_VERSION);
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
@@ -238,6 +241,9 @@ private:
     std::vector<QString> _replicatedUsernames;
 
     DomainGatekeeper _gatekeeper;
+
+    // lets nodes that check in be sent only the nodes that changed since their last list
+    DomainListChangeLog _domainListChangeLog;
     DomainServerExporter _exporter;
 
     HTTPManager _httpManager;
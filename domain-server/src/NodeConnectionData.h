@@ -29,6 +29,7 @@ public:
     HifiSockAddr senderSockAddr;
     QList<NodeType_t> interestList;
     QString placeName;
+    quint32 domainListVersion { 0 }; // version of the node list the node holds, list requests only
     QString hardwareAddress;
     QUuid machineFingerprint;
     QString SystemInfo;
@@ -311,15 +311,14 @@ MyAvatar::MyAvatar(QThread* thread) :
         if (recorder->isRecording()) {
             createRecordingIDs();
             setRecordingBasis();
+            _recordingFrameEncoder.reset();
         } else {
             clearRecordingBasis();
         }
     });
 
-    static const recording::FrameType AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
-    Frame::registerFrameHandler(AVATAR_FRAME_TYPE, [=](Frame::ConstPointer frame) {
-        static AvatarData dummyAvatar;
-        AvatarData::fromFrame(frame->data, dummyAvatar);
+    static AvatarData dummyAvatar;
+    auto playbackFrame = [=] {
         if (getRecordingBasis()) {
             dummyAvatar.setRecordingBasis(getRecordingBasis());
         } else {
@@ -359,6 +358,22 @@ MyAvatar::MyAvatar(QThread* thread) :
         if (jointData.length() > 0) {
             _skeletonModel->getRig().copyJointsFromJointData(jointData);
         }
+    };
+
+    static const recording::FrameType AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+    Frame::registerFrameHandler(AVATAR_FRAME_TYPE, [=](Frame::ConstPointer frame) {
+        AvatarData::fromFrame(frame->data, dummyAvatar);
+        playbackFrame();
+    });
+
+    static const recording::FrameType AVATAR_BINARY_FRAME_TYPE =
+        recording::Frame::registerFrameType(AvatarData::BINARY_FRAME_NAME);
+    Frame::registerFrameHandler(AVATAR_BINARY_FRAME_TYPE, [=](Frame::ConstPointer frame) {
+        static AvatarFrameDecoder decoder;
+        if (decoder.decode(frame->data) == AvatarFrameDecoder::Decoded) {
+            dummyAvatar.fromAvatarFrame(decoder.getFrame(), decoder.hasIdentity());
+            playbackFrame();
+        }
     });
 
     connect(&(_skeletonModel->getRig()), &Rig::onLoadComplete, this, &MyAvatar::onLoadComplete);
@@ -984,8 +999,8 @@ void MyAvatar::simulate(float deltaTime, bool inView) {
     // Record avatars movements.
     auto recorder = DependencyManager::get<recording::Recorder>();
     if (recorder->isRecording()) {
-        static const recording::FrameType FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
-        recorder->recordFrame(FRAME_TYPE, toFrame(*this));
+        static const recording::FrameType FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::BINARY_FRAME_NAME);
+        recorder->recordFrame(FRAME_TYPE, _recordingFrameEncoder.encode(*this));
     }
 
     locationChanged(true, true);
@@ -19,6 +19,7 @@
 #include <QUuid>
 
 #include <AvatarConstants.h>
+#include <AvatarFrameCodec.h>
 #include <avatars-renderer/Avatar.h>
 #include <avatars-renderer/ScriptAvatar.h>
 #include <controllers/Pose.h>
@@ -2685,6 +2686,7 @@ private:
     virtual int parseDataFromBuffer(const QByteArray& buffer) override;
     virtual glm::vec3 getSkeletonPosition() const override;
     int _skeletonModelChangeCount { 0 };
+    AvatarFrameEncoder _recordingFrameEncoder;
 
     void saveAvatarScale();
 
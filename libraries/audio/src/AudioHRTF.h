@@ -82,6 +82,7 @@ public:
     //
     void setGainAdjustment(float gain) { _gainAdjust = HRTF_GAIN * gain; };
     float getGainAdjustment() { return _gainAdjust; }
+    bool hasGainAdjustment() const { return _gainAdjust != HRTF_GAIN; }
 
     // clear internal state, but retain settings
     void reset() {
@@ -41,6 +41,7 @@
 #include <VariantMapToScriptValue.h>
 #include <BitVectorHelpers.h>
 
+#include "AvatarFrameCodec.h"
 #include "AvatarLogging.h"
 #include "AvatarTraits.h"
 #include "ClientTraitsHandler.h"
@@ -53,6 +54,7 @@ quint64 DEFAULT_FILTERED_LOG_EXPIRY = 2 * USECS_PER_SECOND;
 using namespace std;
 
 const QString AvatarData::FRAME_NAME = "com.highfidelity.recording.AvatarData";
+const QString AvatarData::BINARY_FRAME_NAME = "com.vircadia.recording.AvatarDataBinary";
 
 static const int TRANSLATION_COMPRESSION_RADIX = 14;
 static const int HAND_CONTROLLER_COMPRESSION_RADIX = 12;
@@ -272,6 +274,73 @@ float AvatarData::getDistanceBasedMinTranslationDistance(glm::vec3 viewerPositio
 }
 
 
+AvatarDataPacket::HasFlags AvatarData::getWantedFlags(AvatarDataDetail dataDetail, quint64 lastSentTime,
+                                                     bool dropFaceTracking) const {
+    bool sendAll = (dataDetail == SendAllData);
+    bool sendMinimum = (dataDetail == MinimumData);
+    bool sendPALMinimum = (dataDetail == PALMinimum);
+
+    lazyInitHeadData();
+
+    bool hasAvatarGlobalPosition = true; // always include global position
+    bool hasAvatarOrientation = false;
+    bool hasAvatarBoundingBox = false;
+    bool hasAvatarScale = false;
+    bool hasLookAtPosition = false;
+    bool hasAudioLoudness = false;
+    bool hasSensorToWorldMatrix = false;
+    bool hasJointData = false;
+    bool hasJointDefaultPoseFlags = false;
+    bool hasAdditionalFlags = false;
+
+    // local position, and parent info only apply to avatars that are parented. The local position
+    // and the parent info can change independently though, so we track their "changed since"
+    // separately
+    bool hasParentInfo = false;
+    bool hasAvatarLocalPosition = false;
+    bool hasHandControllers = false;
+
+    bool hasFaceTrackerInfo = false;
+
+    if (sendPALMinimum) {
+        hasAudioLoudness = true;
+    } else {
+        hasAvatarOrientation = sendAll || rotationChangedSince(lastSentTime);
+        hasAvatarBoundingBox = sendAll || avatarBoundingBoxChangedSince(lastSentTime);
+        hasAvatarScale = sendAll || avatarScaleChangedSince(lastSentTime);
+        hasLookAtPosition = sendAll || lookAtPositionChangedSince(lastSentTime);
+        hasAudioLoudness = sendAll || audioLoudnessChangedSince(lastSentTime);
+        hasSensorToWorldMatrix = sendAll || sensorToWorldMatrixChangedSince(lastSentTime);
+        hasAdditionalFlags = sendAll || additionalFlagsChangedSince(lastSentTime);
+        hasParentInfo = sendAll || parentInfoChangedSince(lastSentTime);
+        hasAvatarLocalPosition = hasParent() && (sendAll ||
+            tranlationChangedSince(lastSentTime) ||
+            parentInfoChangedSince(lastSentTime));
+        hasHandControllers = _controllerLeftHandMatrixCache.isValid() || _controllerRightHandMatrixCache.isValid();
+        hasFaceTrackerInfo = !dropFaceTracking && (getHasScriptedBlendshapes() || _headData->_hasInputDrivenBlendshapes) &&
+            (sendAll || faceTrackerInfoChangedSince(lastSentTime));
+        hasJointData = !sendMinimum;
+        hasJointDefaultPoseFlags = hasJointData;
+    }
+
+    return
+        (hasAvatarGlobalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION : 0)
+        | (hasAvatarBoundingBox ? AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX : 0)
+        | (hasAvatarOrientation ? AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION : 0)
+        | (hasAvatarScale ? AvatarDataPacket::PACKET_HAS_AVATAR_SCALE : 0)
+        | (hasLookAtPosition ? AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION : 0)
+        | (hasAudioLoudness ? AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS : 0)
+        | (hasSensorToWorldMatrix ? AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX : 0)
+        | (hasAdditionalFlags ? AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS : 0)
+        | (hasParentInfo ? AvatarDataPacket::PACKET_HAS_PARENT_INFO : 0)
+        | (hasAvatarLocalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION : 0)
+        | (hasHandControllers ? AvatarDataPacket::PACKET_HAS_HAND_CONTROLLERS : 0)
+        | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
+        | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0)
+        | (hasJointDefaultPoseFlags ? AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS : 0)
+        | (hasJointData ? AvatarDataPacket::PACKET_HAS_GRAB_JOINTS : 0);
+}
+
 // we want to track outbound data in this case...
 QByteArray AvatarData::toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking) {
     auto lastSentTime = _lastToByteArray;
@@ -290,8 +359,6 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     bool cullSmallChanges = (dataDetail == CullSmallData);
     bool sendAll = (dataDetail == SendAllData);
-    bool sendMinimum = (dataDetail == MinimumData);
-    bool sendPALMinimum = (dataDetail == PALMinimum);
 
     lazyInitHeadData();
     ASSERT(maxDataSize == 0 || (size_t)maxDataSize >= AvatarDataPacket::MIN_BULK_PACKET_SIZE);
@@ -341,67 +408,10 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     if (sendStatus.itemFlags == 0) {
         // New avatar ...
-        bool hasAvatarGlobalPosition = true; // always include global position
-        bool hasAvatarOrientation = false;
-        bool hasAvatarBoundingBox = false;
-        bool hasAvatarScale = false;
-        bool hasLookAtPosition = false;
-        bool hasAudioLoudness = false;
-        bool hasSensorToWorldMatrix = false;
-        bool hasJointData = false;
-        bool hasJointDefaultPoseFlags = false;
-        bool hasAdditionalFlags = false;
-
-        // local position, and parent info only apply to avatars that are parented. The local position
-        // and the parent info can change independently though, so we track their "changed since"
-        // separately
-        bool hasParentInfo = false;
-        bool hasAvatarLocalPosition = false;
-        bool hasHandControllers = false;
-
-        bool hasFaceTrackerInfo = false;
-
-        if (sendPALMinimum) {
-            hasAudioLoudness = true;
-        } else {
-            hasAvatarOrientation = sendAll || rotationChangedSince(lastSentTime);
-            hasAvatarBoundingBox = sendAll || avatarBoundingBoxChangedSince(lastSentTime);
-            hasAvatarScale = sendAll || avatarScaleChangedSince(lastSentTime);
-            hasLookAtPosition = sendAll || lookAtPositionChangedSince(lastSentTime);
-            hasAudioLoudness = sendAll || audioLoudnessChangedSince(lastSentTime);
-            hasSensorToWorldMatrix = sendAll || sensorToWorldMatrixChangedSince(lastSentTime);
-            hasAdditionalFlags = sendAll || additionalFlagsChangedSince(lastSentTime);
-            hasParentInfo = sendAll || parentInfoChangedSince(lastSentTime);
-            hasAvatarLocalPosition = hasParent() && (sendAll ||
-                tranlationChangedSince(lastSentTime) ||
-                parentInfoChangedSince(lastSentTime));
-            hasHandControllers = _controllerLeftHandMatrixCache.isValid() || _controllerRightHandMatrixCache.isValid();
-            hasFaceTrackerInfo = !dropFaceTracking && (getHasScriptedBlendshapes() || _headData->_hasInputDrivenBlendshapes) &&
-                (sendAll || faceTrackerInfoChangedSince(lastSentTime));
-            hasJointData = !sendMinimum;
-            hasJointDefaultPoseFlags = hasJointData;
-        }
-
-        wantedFlags =
-            (hasAvatarGlobalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION : 0)
-            | (hasAvatarBoundingBox ? AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX : 0)
-            | (hasAvatarOrientation ? AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION : 0)
-            | (hasAvatarScale ? AvatarDataPacket::PACKET_HAS_AVATAR_SCALE : 0)
-            | (hasLookAtPosition ? AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION : 0)
-            | (hasAudioLoudness ? AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS : 0)
-            | (hasSensorToWorldMatrix ? AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX : 0)
-            | (hasAdditionalFlags ? AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS : 0)
-            | (hasParentInfo ? AvatarDataPacket::PACKET_HAS_PARENT_INFO : 0)
-            | (hasAvatarLocalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION : 0)
-            | (hasHandControllers ? AvatarDataPacket::PACKET_HAS_HAND_CONTROLLERS : 0)
-            | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
-            | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0)
-            | (hasJointDefaultPoseFlags ? AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS : 0)
-            | (hasJointData ? AvatarDataPacket::PACKET_HAS_GRAB_JOINTS : 0);
-
-            sendStatus.itemFlags = wantedFlags;
-            sendStatus.rotationsSent = 0;
-            sendStatus.translationsSent = 0;
+        wantedFlags = getWantedFlags(dataDetail, lastSentTime, dropFaceTracking);
+        sendStatus.itemFlags = wantedFlags;
+        sendStatus.rotationsSent = 0;
+        sendStatus.translationsSent = 0;
     } else {  // Continuing avatar ...
         wantedFlags = sendStatus.itemFlags;
         if (wantedFlags & AvatarDataPacket::PACKET_HAS_GRAB_JOINTS) {
@@ -2679,11 +2689,7 @@ void AvatarData::avatarEntityDataToJson(QJsonObject& root) const {
     // overridden where needed
 }
 
-QJsonObject AvatarData::toJson() const {
-    QJsonObject root;
-
-    root[JSON_AVATAR_VERSION] = (int)JsonAvatarFrameVersion::ARKitBlendshapes;
-
+void AvatarData::recordedIdentityToJson(QJsonObject& root) const {
     if (!getSkeletonModelURL().isEmpty()) {
         root[JSON_AVATAR_BODY_MODEL] = getSkeletonModelURL().toString();
     }
@@ -2692,6 +2698,72 @@ QJsonObject AvatarData::toJson() const {
     }
 
     avatarEntityDataToJson(root);
+}
+
+void AvatarData::recordedSkeletonAndNameFromJson(const QJsonObject& json, bool useFrameSkeleton) {
+    if (json.contains(JSON_AVATAR_BODY_MODEL)) {
+        auto bodyModelURL = json[JSON_AVATAR_BODY_MODEL].toString();
+        if (useFrameSkeleton && bodyModelURL != getSkeletonModelURL().toString()) {
+            setSkeletonModelURL(bodyModelURL);
+        }
+    }
+
+    QString newDisplayName = "";
+    if (json.contains(JSON_AVATAR_DISPLAY_NAME)) {
+        newDisplayName = json[JSON_AVATAR_DISPLAY_NAME].toString();
+    }
+    if (newDisplayName != getDisplayName()) {
+        setDisplayName(newDisplayName);
+    }
+}
+
+void AvatarData::recordedAttachmentsFromJson(const QJsonObject& json) {
+    QVector<AttachmentData> attachments;
+    if (json.contains(JSON_AVATAR_ATTACHMENTS) && json[JSON_AVATAR_ATTACHMENTS].isArray()) {
+        QJsonArray attachmentsJson = json[JSON_AVATAR_ATTACHMENTS].toArray();
+        for (auto attachmentJson : attachmentsJson) {
+            AttachmentData attachment;
+            attachment.fromJson(attachmentJson.toObject());
+            attachments.push_back(attachment);
+        }
+    }
+    if (attachments != getAttachmentData()) {
+        setAttachmentData(attachments);
+    }
+
+    if (json.contains(JSON_AVATAR_ENTITIES) && json[JSON_AVATAR_ENTITIES].isArray()) {
+        QJsonArray attachmentsJson = json[JSON_AVATAR_ENTITIES].toArray();
+        for (auto attachmentJson : attachmentsJson) {
+            if (attachmentJson.isObject()) {
+                QVariantMap entityData = attachmentJson.toObject().toVariantMap();
+                QUuid id = entityData.value("id").toUuid();
+                QByteArray data = QByteArray::fromBase64(entityData.value("properties").toByteArray());
+                updateAvatarEntity(id, data);
+            }
+        }
+    }
+}
+
+void AvatarData::setRecordedTransform(const Transform& basis, const Transform& relativeTransform) {
+    // During playback you can either have the recording basis set to the avatar current state
+    // meaning that all playback is relative to this avatars starting position, or
+    // the basis can be loaded from the recording, meaning the playback is relative to the
+    // original avatar location
+    // The first is more useful for playing back recordings on your own avatar, while
+    // the latter is more useful for playing back other avatars within your scene.
+    auto worldTransform = basis.worldTransform(relativeTransform);
+    setWorldPosition(worldTransform.getTranslation());
+    glm::quat orientation = worldTransform.getRotation();
+    setWorldOrientation(orientation);
+    updateAttitude(orientation);
+}
+
+QJsonObject AvatarData::toJson() const {
+    QJsonObject root;
+
+    root[JSON_AVATAR_VERSION] = (int)JsonAvatarFrameVersion::ARKitBlendshapes;
+
+    recordedIdentityToJson(root);
 
     auto recordingBasis = getRecordingBasis();
     bool success;
@@ -2742,46 +2814,19 @@ void AvatarData::fromJson(const QJsonObject& json, bool useFrameSkeleton) {
         version = (int)JsonAvatarFrameVersion::JointRotationsInRelativeFrame;
     }
 
-    if (json.contains(JSON_AVATAR_BODY_MODEL)) {
-        auto bodyModelURL = json[JSON_AVATAR_BODY_MODEL].toString();
-        if (useFrameSkeleton && bodyModelURL != getSkeletonModelURL().toString()) {
-            setSkeletonModelURL(bodyModelURL);
-        }
-    }
-
-    QString newDisplayName = "";
-    if (json.contains(JSON_AVATAR_DISPLAY_NAME)) {
-        newDisplayName = json[JSON_AVATAR_DISPLAY_NAME].toString();
-    }
-    if (newDisplayName != getDisplayName()) {
-        setDisplayName(newDisplayName);
-    }
+    recordedSkeletonAndNameFromJson(json, useFrameSkeleton);
 
     auto currentBasis = getRecordingBasis();
     if (!currentBasis) {
         currentBasis = std::make_shared<Transform>(Transform::fromJson(json[JSON_AVATAR_BASIS]));
     }
 
-    glm::quat orientation;
     if (json.contains(JSON_AVATAR_RELATIVE)) {
-        // During playback you can either have the recording basis set to the avatar current state
-        // meaning that all playback is relative to this avatars starting position, or
-        // the basis can be loaded from the recording, meaning the playback is relative to the
-        // original avatar location
-        // The first is more useful for playing back recordings on your own avatar, while
-        // the latter is more useful for playing back other avatars within your scene.
-
-        auto relativeTransform = Transform::fromJson(json[JSON_AVATAR_RELATIVE]);
-        auto worldTransform = currentBasis->worldTransform(relativeTransform);
-        setWorldPosition(worldTransform.getTranslation());
-        orientation = worldTransform.getRotation();
+        setRecordedTransform(*currentBasis, Transform::fromJson(json[JSON_AVATAR_RELATIVE]));
     } else {
         // We still set the position in the case that there is no movement.
-        setWorldPosition(currentBasis->getTranslation());
-        orientation = currentBasis->getRotation();
+        setRecordedTransform(*currentBasis, Transform());
     }
-    setWorldOrientation(orientation);
-    updateAttitude(orientation);
 
     // Do after avatar orientation because head look-at needs avatar orientation.
     if (json.contains(JSON_AVATAR_HEAD)) {
@@ -2795,30 +2840,7 @@ void AvatarData::fromJson(const QJsonObject& json, bool useFrameSkeleton) {
         setTargetScale((float)json[JSON_AVATAR_SCALE].toDouble());
     }
 
-    QVector<AttachmentData> attachments;
-    if (json.contains(JSON_AVATAR_ATTACHMENTS) && json[JSON_AVATAR_ATTACHMENTS].isArray()) {
-        QJsonArray attachmentsJson = json[JSON_AVATAR_ATTACHMENTS].toArray();
-        for (auto attachmentJson : attachmentsJson) {
-            AttachmentData attachment;
-            attachment.fromJson(attachmentJson.toObject());
-            attachments.push_back(attachment);
-        }
-    }
-    if (attachments != getAttachmentData()) {
-        setAttachmentData(attachments);
-    }
-
-    if (json.contains(JSON_AVATAR_ENTITIES) && json[JSON_AVATAR_ENTITIES].isArray()) {
-        QJsonArray attachmentsJson = json[JSON_AVATAR_ENTITIES].toArray();
-        for (auto attachmentJson : attachmentsJson) {
-            if (attachmentJson.isObject()) {
-                QVariantMap entityData = attachmentJson.toObject().toVariantMap();
-                QUuid id = entityData.value("id").toUuid();
-                QByteArray data = QByteArray::fromBase64(entityData.value("properties").toByteArray());
-                updateAvatarEntity(id, data);
-            }
-        }
-    }
+    recordedAttachmentsFromJson(json);
 
     if (json.contains(JSON_AVATAR_JOINT_ARRAY)) {
         if (version == (int)JsonAvatarFrameVersion::JointRotationsInRelativeFrame) {
@@ -2841,6 +2863,60 @@ void AvatarData::fromJson(const QJsonObject& json, bool useFrameSkeleton) {
     }
 }
 
+AvatarFrame AvatarData::toAvatarFrame() const {
+    AvatarFrame frame;
+    recordedIdentityToJson(frame.identity);
+
+    auto recordingBasis = getRecordingBasis();
+    bool success;
+    Transform avatarTransform = getTransform(success);
+    if (!success) {
+        qCWarning(avatars) << "Warning -- AvatarData::toAvatarFrame couldn't get avatar transform";
+    }
+    avatarTransform.setScale(getDomainLimitedScale());
+    if (recordingBasis) {
+        frame.hasBasis = true;
+        frame.basis = *recordingBasis;
+        frame.relative = recordingBasis->relativeTransform(avatarTransform);
+    } else {
+        frame.relative = avatarTransform;
+    }
+
+    frame.scale = getDomainLimitedScale();
+    frame.joints = getRawJointData();
+
+    const HeadData* head = getHeadData();
+    if (head) {
+        head->toAvatarFrame(frame);
+    }
+    return frame;
+}
+
+void AvatarData::fromAvatarFrame(const AvatarFrame& frame, bool applyIdentity, bool useFrameSkeleton) {
+    if (applyIdentity) {
+        recordedSkeletonAndNameFromJson(frame.identity, useFrameSkeleton);
+    }
+
+    auto currentBasis = getRecordingBasis();
+    setRecordedTransform(currentBasis ? *currentBasis : (frame.hasBasis ? frame.basis : Transform()), frame.relative);
+
+    // Do after avatar orientation because head look-at needs avatar orientation.
+    if (frame.hasHead) {
+        if (!_headData) {
+            _headData = new HeadData(this);
+        }
+        _headData->fromAvatarFrame(frame);
+    }
+
+    setTargetScale(frame.scale);
+
+    if (applyIdentity) {
+        recordedAttachmentsFromJson(frame.identity);
+    }
+
+    setRawJointData(frame.joints);
+}
+
 // Every frame will store both a basis for the recording and a relative transform
 // This allows the application to decide whether playback should be relative to an avatar's
 // transform at the start of playback, or relative to the transform of the recorded
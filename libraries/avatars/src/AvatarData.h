@@ -447,6 +447,7 @@ Q_DECLARE_METATYPE(KillAvatarReason);
 class QDataStream;
 
 class AttachmentData;
+struct AvatarFrame;
 class Transform;
 using TransformPointer = std::shared_ptr<Transform>;
 
@@ -598,6 +599,7 @@ public:
     virtual QString getName() const override { return QString("Avatar:") + _displayName; }
 
     static const QString FRAME_NAME;
+    static const QString BINARY_FRAME_NAME; // written and read by the AvatarFrameEncoder and AvatarFrameDecoder
 
     static void fromFrame(const QByteArray& frameData, AvatarData& avatar, bool useFrameSkeleton = true);
     static QByteArray toFrame(const AvatarData& avatar);
@@ -1382,6 +1384,9 @@ public:
     virtual void avatarEntityDataToJson(QJsonObject& root) const;
     QJsonObject toJson() const;
     void fromJson(const QJsonObject& json, bool useFrameSkeleton = true);
+    AvatarFrame toAvatarFrame() const;
+    // the identity of the frame is only applied when applyIdentity is set, it rarely changes
+    void fromAvatarFrame(const AvatarFrame& frame, bool applyIdentity, bool useFrameSkeleton = true);
 
     glm::vec3 getClientGlobalPosition() const { return _globalPosition; }
     AABox getGlobalBoundingBox() const { return AABox(_globalPosition + _globalBoundingBoxOffset - _globalBoundingBoxDimensions, _globalBoundingBoxDimensions); }
@@ -1676,9 +1681,18 @@ protected:
     void insertRemovedEntityID(const QUuid entityID);
     void lazyInitHeadData() const;
 
+    // the parts of a recorded frame shared by the JSON and binary frame formats
+    void recordedIdentityToJson(QJsonObject& root) const;
+    void recordedSkeletonAndNameFromJson(const QJsonObject& json, bool useFrameSkeleton);
+    void recordedAttachmentsFromJson(const QJsonObject& json);
+    void setRecordedTransform(const Transform& basis, const Transform& relativeTransform);
+
     float getDistanceBasedMinRotationDOT(glm::vec3 viewerPosition) const;
     float getDistanceBasedMinTranslationDistance(glm::vec3 viewerPosition) const;
 
+    // the items toByteArray includes for a new avatar, given the time the receiver was last sent this avatar
+    AvatarDataPacket::HasFlags getWantedFlags(AvatarDataDetail dataDetail, quint64 lastSentTime, bool dropFaceTracking) const;
+
     bool avatarBoundingBoxChangedSince(quint64 time) const { return _avatarBoundingBoxChanged >= time; }
     bool avatarScaleChangedSince(quint64 time) const { return _avatarScaleChanged >= time; }
     bool lookAtPositionChangedSince(quint64 time) const { return _headData->lookAtPositionChangedSince(time); }
@@ -0,0 +1,393 @@
+//
+//  AvatarFrameCodec.cpp
+//  libraries/avatars/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarFrameCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QJsonDocument>
+
+#include <GLMHelpers.h>
+
+#include "AvatarData.h"
+
+// frame layout:
+//   uint8 version, uint8 flags, uint32 sequence
+//   [IDENTITY] uint32 size, binary JSON
+//   [BASIS] transform
+//   transform relative, float scale
+//   uint16 numJoints, float maxTranslationDimension
+//   [not KEYFRAME] one bit per joint, set when the joint changed
+//   quantized rotation and translation of each joint in the frame
+//   two bits per joint, rotation then translation is default pose
+//   [HEAD_ORIENTATION] quantized orientation
+//   [LOOK_AT] vec3 relative look at
+//   [HEAD] uint8 numBlendshapes, then uint8 index and fixed point coefficient of each
+enum class AvatarFrameVersion : uint8_t {
+    Initial = 1
+};
+static const uint8_t CURRENT_AVATAR_FRAME_VERSION = (uint8_t)AvatarFrameVersion::Initial;
+
+static const uint8_t KEYFRAME_FLAG = 1 << 0;
+static const uint8_t IDENTITY_FLAG = 1 << 1;
+static const uint8_t BASIS_FLAG = 1 << 2;
+static const uint8_t HEAD_FLAG = 1 << 3;
+static const uint8_t HEAD_ORIENTATION_FLAG = 1 << 4;
+static const uint8_t LOOK_AT_FLAG = 1 << 5;
+
+static const int JOINT_ROTATION_SIZE = 6;
+static const int QUANTIZED_JOINT_SIZE = JOINT_ROTATION_SIZE + 6;
+static const int TRANSLATION_COMPRESSION_RADIX = 14;
+static const int BLENDSHAPE_COMPRESSION_RADIX = 12;
+static const float MIN_TRANSLATION_DIMENSION = 0.001f;
+// translations can grow this much before a keyframe is needed to quantize them again
+static const float TRANSLATION_DIMENSION_HEADROOM = 1.25f;
+static const int MAX_ENCODED_BLENDSHAPES = 255;
+
+const int AvatarFrameEncoder::DEFAULT_KEYFRAME_INTERVAL = 30;
+
+template <typename T>
+static void append(QByteArray& data, const T& value) {
+    data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void appendTransform(QByteArray& data, const Transform& transform) {
+    append(data, transform.getTranslation());
+    append(data, transform.getRotation());
+    append(data, transform.getScale());
+}
+
+static void quantizeJoint(const JointData& joint, float maxTranslationDimension, uint8_t* destination) {
+    packOrientationQuatToSixBytes(destination, joint.rotation);
+    packFloatVec3ToSignedTwoByteFixed(destination + JOINT_ROTATION_SIZE, joint.translation / maxTranslationDimension,
+                                      TRANSLATION_COMPRESSION_RADIX);
+}
+
+class AvatarFrameReader {
+public:
+    AvatarFrameReader(const QByteArray& data) : _position(data.constData()), _end(data.constData() + data.size()) {}
+
+    template <typename T>
+    bool read(T& value) {
+        const char* source = take(sizeof(T));
+        if (!source) {
+            return false;
+        }
+        memcpy(&value, source, sizeof(T));
+        return true;
+    }
+
+    bool readTransform(Transform& transform) {
+        glm::vec3 translation;
+        glm::quat rotation;
+        glm::vec3 scale;
+        if (!read(translation) || !read(rotation) || !read(scale)) {
+            return false;
+        }
+        transform.setTranslation(translation);
+        transform.setRotation(rotation);
+        transform.setScale(scale);
+        return true;
+    }
+
+    const char* take(size_t size) {
+        if ((size_t)(_end - _position) < size) {
+            return nullptr;
+        }
+        const char* result = _position;
+        _position += size;
+        return result;
+    }
+
+private:
+    const char* _position;
+    const char* _end;
+};
+
+AvatarFrameEncoder::AvatarFrameEncoder(int keyframeInterval) : _keyframeInterval(std::max(keyframeInterval, 1)) {
+}
+
+void AvatarFrameEncoder::reset() {
+    _hasPreviousFrame = false;
+    _framesSinceKeyframe = 0;
+    _sequence = 0;
+}
+
+QByteArray AvatarFrameEncoder::encode(const AvatarData& avatar) {
+    return encode(avatar.toAvatarFrame());
+}
+
+QByteArray AvatarFrameEncoder::encode(const AvatarFrame& frame) {
+    int numJoints = frame.joints.size();
+
+    float maxTranslationDimension = MIN_TRANSLATION_DIMENSION;
+    for (const auto& joint : frame.joints) {
+        maxTranslationDimension = glm::max(maxTranslationDimension, fabsf(joint.translation.x));
+        maxTranslationDimension = glm::max(maxTranslationDimension, fabsf(joint.translation.y));
+        maxTranslationDimension = glm::max(maxTranslationDimension, fabsf(joint.translation.z));
+    }
+
+    bool isKeyframe = !_hasPreviousFrame || _framesSinceKeyframe >= _keyframeInterval ||
+        _previousJoints.size() != (size_t)(numJoints * QUANTIZED_JOINT_SIZE) ||
+        maxTranslationDimension > _maxTranslationDimension || frame.hasBasis != _previousHasBasis;
+    if (isKeyframe) {
+        _maxTranslationDimension = maxTranslationDimension * TRANSLATION_DIMENSION_HEADROOM;
+        _framesSinceKeyframe = 0;
+    }
+
+    std::vector<uint8_t> joints(numJoints * QUANTIZED_JOINT_SIZE);
+    for (int i = 0; i < numJoints; i++) {
+        quantizeJoint(frame.joints[i], _maxTranslationDimension, &joints[i * QUANTIZED_JOINT_SIZE]);
+    }
+
+    QByteArray identity = QJsonDocument(frame.identity).toBinaryData();
+    bool writeIdentity = isKeyframe || identity != _previousIdentity;
+    bool writeBasis = frame.hasBasis && (isKeyframe || frame.basis != _previousBasis);
+
+    uint8_t flags = 0;
+    flags |= isKeyframe ? KEYFRAME_FLAG : 0;
+    flags |= writeIdentity ? IDENTITY_FLAG : 0;
+    flags |= writeBasis ? BASIS_FLAG : 0;
+    flags |= frame.hasHead ? HEAD_FLAG : 0;
+    flags |= (frame.hasHead && frame.hasHeadOrientation) ? HEAD_ORIENTATION_FLAG : 0;
+    flags |= (frame.hasHead && frame.hasLookAt) ? LOOK_AT_FLAG : 0;
+
+    QByteArray data;
+    data.reserve(64 + (writeIdentity ? identity.size() : 0) + numJoints * (QUANTIZED_JOINT_SIZE + 1));
+    append(data, CURRENT_AVATAR_FRAME_VERSION);
+    append(data, flags);
+    append(data, _sequence);
+
+    if (writeIdentity) {
+        append(data, (uint32_t)identity.size());
+        data.append(identity);
+    }
+    if (writeBasis) {
+        appendTransform(data, frame.basis);
+    }
+    appendTransform(data, frame.relative);
+    append(data, frame.scale);
+
+    append(data, (uint16_t)numJoints);
+    append(data, _maxTranslationDimension);
+    if (isKeyframe) {
+        data.append(reinterpret_cast<const char*>(joints.data()), (int)joints.size());
+    } else {
+        QByteArray changedBits((numJoints + 7) / 8, 0);
+        QByteArray changedJoints;
+        for (int i = 0; i < numJoints; i++) {
+            const uint8_t* joint = &joints[i * QUANTIZED_JOINT_SIZE];
+            if (memcmp(joint, &_previousJoints[i * QUANTIZED_JOINT_SIZE], QUANTIZED_JOINT_SIZE) != 0) {
+                changedBits[i / 8] = changedBits[i / 8] | (1 << (i % 8));
+                changedJoints.append(reinterpret_cast<const char*>(joint), QUANTIZED_JOINT_SIZE);
+            }
+        }
+        data.append(changedBits);
+        data.append(changedJoints);
+    }
+
+    QByteArray defaultPoseBits((2 * numJoints + 7) / 8, 0);
+    for (int i = 0; i < numJoints; i++) {
+        const JointData& joint = frame.joints[i];
+        if (joint.rotationIsDefaultPose) {
+            defaultPoseBits[(2 * i) / 8] = defaultPoseBits[(2 * i) / 8] | (1 << ((2 * i) % 8));
+        }
+        if (joint.translationIsDefaultPose) {
+            defaultPoseBits[(2 * i + 1) / 8] = defaultPoseBits[(2 * i + 1) / 8] | (1 << ((2 * i + 1) % 8));
+        }
+    }
+    data.append(defaultPoseBits);
+
+    if (frame.hasHead) {
+        if (frame.hasHeadOrientation) {
+            uint8_t orientation[JOINT_ROTATION_SIZE];
+            packOrientationQuatToSixBytes(orientation, frame.headOrientation);
+            data.append(reinterpret_cast<const char*>(orientation), JOINT_ROTATION_SIZE);
+        }
+        if (frame.hasLookAt) {
+            append(data, frame.relativeLookAt);
+        }
+
+        QByteArray blendshapes;
+        uint8_t numBlendshapes = 0;
+        for (int i = 0; i < frame.blendshapes.size() && i <= MAX_ENCODED_BLENDSHAPES && numBlendshapes < MAX_ENCODED_BLENDSHAPES; i++) {
+            if (frame.blendshapes[i] != 0.0f) {
+                uint8_t coefficient[sizeof(int16_t)];
+                packFloatScalarToSignedTwoByteFixed(coefficient, frame.blendshapes[i], BLENDSHAPE_COMPRESSION_RADIX);
+                append(blendshapes, (uint8_t)i);
+                blendshapes.append(reinterpret_cast<const char*>(coefficient), sizeof(int16_t));
+                numBlendshapes++;
+            }
+        }
+        append(data, numBlendshapes);
+        data.append(blendshapes);
+    }
+
+    _hasPreviousFrame = true;
+    _framesSinceKeyframe++;
+    _sequence++;
+    _previousIdentity = identity;
+    _previousHasBasis = frame.hasBasis;
+    _previousBasis = frame.basis;
+    _previousJoints.swap(joints);
+    return data;
+}
+
+QByteArray AvatarFrameEncoder::convertLegacyFrame(const QByteArray& legacyFrameData, AvatarData& avatar) {
+    QJsonObject json = QJsonDocument::fromBinaryData(legacyFrameData).object();
+
+    // with the basis of the frame, the relative transform comes back out of the avatar as it was recorded
+    static const QString JSON_AVATAR_BASIS = QStringLiteral("basisTransform");
+    if (json.contains(JSON_AVATAR_BASIS)) {
+        avatar.setRecordingBasis(std::make_shared<Transform>(Transform::fromJson(json[JSON_AVATAR_BASIS])));
+    } else {
+        avatar.clearRecordingBasis();
+    }
+    avatar.fromJson(json);
+
+    // the avatar entities of the frame are only kept by the avatars that have entities of their own
+    AvatarFrame frame = avatar.toAvatarFrame();
+    static const QString JSON_AVATAR_ENTITIES = QStringLiteral("attachedEntities");
+    static const QString JSON_AVATAR_ATTACHMENTS = QStringLiteral("attachments");
+    for (const auto& key : { JSON_AVATAR_ENTITIES, JSON_AVATAR_ATTACHMENTS }) {
+        if (json.contains(key)) {
+            frame.identity[key] = json[key];
+        }
+    }
+    return encode(frame);
+}
+
+void AvatarFrameDecoder::reset() {
+    _hasFrame = false;
+    _hasIdentity = false;
+}
+
+AvatarFrameDecoder::Result AvatarFrameDecoder::decode(const QByteArray& frameData) {
+    AvatarFrameReader reader(frameData);
+    uint8_t version;
+    uint8_t flags;
+    uint32_t sequence;
+    if (!reader.read(version) || version != CURRENT_AVATAR_FRAME_VERSION || !reader.read(flags) || !reader.read(sequence)) {
+        return Invalid;
+    }
+
+    bool isKeyframe = flags & KEYFRAME_FLAG;
+    if (!isKeyframe && (!_hasFrame || sequence != _sequence + 1)) {
+        return Skipped;
+    }
+
+    // the state is only partly updated by a frame that fails to decode, it waits for the next keyframe
+    _hasFrame = false;
+
+    _hasIdentity = flags & IDENTITY_FLAG;
+    if (_hasIdentity) {
+        uint32_t identitySize;
+        const char* identity;
+        if (!reader.read(identitySize) || !(identity = reader.take(identitySize))) {
+            return Invalid;
+        }
+        _frame.identity = QJsonDocument::fromBinaryData(QByteArray::fromRawData(identity, identitySize)).object();
+    }
+
+    if (flags & BASIS_FLAG) {
+        if (!reader.readTransform(_frame.basis)) {
+            return Invalid;
+        }
+        _frame.hasBasis = true;
+    } else if (isKeyframe) {
+        _frame.hasBasis = false;
+    }
+
+    uint16_t numJoints;
+    if (!reader.readTransform(_frame.relative) || !reader.read(_frame.scale) ||
+        !reader.read(numJoints) || !reader.read(_maxTranslationDimension)) {
+        return Invalid;
+    }
+
+    auto decodeJoint = [&](int index) {
+        const char* quantizedJoint = reader.take(QUANTIZED_JOINT_SIZE);
+        if (!quantizedJoint) {
+            return false;
+        }
+        JointData& joint = _frame.joints[index];
+        const uint8_t* source = reinterpret_cast<const uint8_t*>(quantizedJoint);
+        unpackOrientationQuatFromSixBytes(source, joint.rotation);
+        unpackFloatVec3FromSignedTwoByteFixed(source + JOINT_ROTATION_SIZE, joint.translation, TRANSLATION_COMPRESSION_RADIX);
+        joint.translation *= _maxTranslationDimension;
+        return true;
+    };
+
+    if (isKeyframe) {
+        _frame.joints.resize(numJoints);
+        for (int i = 0; i < numJoints; i++) {
+            if (!decodeJoint(i)) {
+                return Invalid;
+            }
+        }
+    } else {
+        const char* changedBits = reader.take((numJoints + 7) / 8);
+        if (numJoints != _frame.joints.size() || !changedBits) {
+            return Invalid;
+        }
+        for (int i = 0; i < numJoints; i++) {
+            if ((changedBits[i / 8] & (1 << (i % 8))) && !decodeJoint(i)) {
+                return Invalid;
+            }
+        }
+    }
+
+    const char* defaultPoseBits = reader.take((2 * numJoints + 7) / 8);
+    if (!defaultPoseBits) {
+        return Invalid;
+    }
+    for (int i = 0; i < numJoints; i++) {
+        JointData& joint = _frame.joints[i];
+        joint.rotationIsDefaultPose = defaultPoseBits[(2 * i) / 8] & (1 << ((2 * i) % 8));
+        joint.translationIsDefaultPose = defaultPoseBits[(2 * i + 1) / 8] & (1 << ((2 * i + 1) % 8));
+    }
+
+    _frame.hasHead = flags & HEAD_FLAG;
+    _frame.hasHeadOrientation = flags & HEAD_ORIENTATION_FLAG;
+    _frame.hasLookAt = flags & LOOK_AT_FLAG;
+    _frame.blendshapes.fill(0.0f);
+    if (_frame.hasHead) {
+        if (_frame.hasHeadOrientation) {
+            const char* orientation = reader.take(JOINT_ROTATION_SIZE);
+            if (!orientation) {
+                return Invalid;
+            }
+            unpackOrientationQuatFromSixBytes(reinterpret_cast<const uint8_t*>(orientation), _frame.headOrientation);
+        }
+        if (_frame.hasLookAt && !reader.read(_frame.relativeLookAt)) {
+            return Invalid;
+        }
+
+        uint8_t numBlendshapes;
+        if (!reader.read(numBlendshapes)) {
+            return Invalid;
+        }
+        for (int i = 0; i < numBlendshapes; i++) {
+            uint8_t index;
+            int16_t coefficient;
+            if (!reader.read(index) || !reader.read(coefficient)) {
+                return Invalid;
+            }
+            if (index >= _frame.blendshapes.size()) {
+                _frame.blendshapes.resize(index + 1);
+            }
+            unpackFloatScalarFromSignedTwoByteFixed(&coefficient, &_frame.blendshapes[index], BLENDSHAPE_COMPRESSION_RADIX);
+        }
+    }
+
+    _sequence = sequence;
+    _hasFrame = true;
+    return Decoded;
+}
@@ -0,0 +1,102 @@
+//
+//  AvatarFrameCodec.h
+//  libraries/avatars/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarFrameCodec_h
+#define hifi_AvatarFrameCodec_h
+
+#include <stdint.h>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QVector>
+
+#include <JointData.h>
+#include <Transform.h>
+
+class AvatarData;
+
+// The state of an avatar kept in a recording frame, the same as in the JSON of AvatarData::toJson()
+struct AvatarFrame {
+    QJsonObject identity; // skeleton model, display name and attached entities, in their JSON form
+    bool hasBasis { false };
+    Transform basis;
+    Transform relative;
+    float scale { 1.0f };
+    QVector<JointData> joints;
+
+    bool hasHead { false };
+    bool hasHeadOrientation { false };
+    glm::quat headOrientation;
+    bool hasLookAt { false };
+    glm::vec3 relativeLookAt;
+    QVector<float> blendshapes; // summed coefficients, by blendshape index
+};
+
+// Writes the frames of AvatarData::BINARY_FRAME_NAME.  Joints are quantized like in the avatar data packets, and
+// a frame only holds the joints and identity that changed since the previous one, except for a keyframe every
+// keyframeInterval frames, which holds everything.
+class AvatarFrameEncoder {
+public:
+    static const int DEFAULT_KEYFRAME_INTERVAL;
+
+    AvatarFrameEncoder(int keyframeInterval = DEFAULT_KEYFRAME_INTERVAL);
+
+    // the next frame is a keyframe, for the start of a recording
+    void reset();
+
+    QByteArray encode(const AvatarFrame& frame);
+    QByteArray encode(const AvatarData& avatar);
+
+    // re-encodes a frame of the legacy JSON format, played back on the avatar
+    QByteArray convertLegacyFrame(const QByteArray& legacyFrameData, AvatarData& avatar);
+
+private:
+    int _keyframeInterval;
+    int _framesSinceKeyframe { 0 };
+    bool _hasPreviousFrame { false };
+    uint32_t _sequence { 0 };
+
+    QByteArray _previousIdentity;
+    bool _previousHasBasis { false };
+    Transform _previousBasis;
+    float _maxTranslationDimension { 0.0f };
+    std::vector<uint8_t> _previousJoints; // quantized rotation then translation of each joint
+};
+
+// Reads the frames of AvatarData::BINARY_FRAME_NAME, keeping the state that the following frames change.
+class AvatarFrameDecoder {
+public:
+    enum Result {
+        Decoded,
+        Skipped, // relative to a frame that wasn't decoded, such as after a seek, until the next keyframe
+        Invalid
+    };
+
+    Result decode(const QByteArray& frameData);
+    void reset();
+
+    const AvatarFrame& getFrame() const { return _frame; }
+
+    // whether the last frame decoded holds the identity, keyframes always do
+    bool hasIdentity() const { return _hasIdentity; }
+
+private:
+    AvatarFrame _frame;
+    bool _hasFrame { false };
+    bool _hasIdentity { false };
+    uint32_t _sequence { 0 };
+    float _maxTranslationDimension { 0.0f };
+};
+
+#endif // hifi_AvatarFrameCodec_h
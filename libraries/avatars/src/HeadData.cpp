@@ -11,6 +11,7 @@
 
 #include "HeadData.h"
 
+#include <algorithm>
 #include <mutex>
 
 #include <QtCore/QJsonObject>
@@ -21,6 +22,7 @@
 #include <shared/JSONHelpers.h>
 
 #include "AvatarData.h"
+#include "AvatarFrameCodec.h"
 
 HeadData::HeadData(AvatarData* owningAvatar) :
     _baseYaw(0.0f),
@@ -202,6 +204,52 @@ void HeadData::fromJson(const QJsonObject& json) {
     }
 }
 
+// the same as toJson(), with the blendshapes by index
+void HeadData::toAvatarFrame(AvatarFrame& frame) const {
+    frame.hasHead = true;
+    int numBlendshapes = std::max(_blendshapeCoefficients.size(), _transientBlendshapeCoefficients.size());
+    frame.blendshapes.fill(0.0f, numBlendshapes);
+    for (int i = 0; i < _blendshapeCoefficients.size(); i++) {
+        frame.blendshapes[i] += _blendshapeCoefficients[i];
+    }
+    for (int i = 0; i < _transientBlendshapeCoefficients.size(); i++) {
+        frame.blendshapes[i] += _transientBlendshapeCoefficients[i];
+    }
+
+    frame.headOrientation = getRawOrientation();
+    frame.hasHeadOrientation = frame.headOrientation != quat();
+
+    auto lookat = getLookAtPosition();
+    frame.hasLookAt = lookat != vec3();
+    if (frame.hasLookAt) {
+        frame.relativeLookAt = glm::inverse(_owningAvatar->getWorldOrientation()) *
+            (lookat - _owningAvatar->getWorldPosition());
+    }
+}
+
+void HeadData::fromAvatarFrame(const AvatarFrame& frame) {
+    // like in fromJson(), the blendshapes that are off in the frame are left alone
+    for (int i = 0; i < frame.blendshapes.size(); i++) {
+        if (frame.blendshapes[i] != 0.0f) {
+            if (_blendshapeCoefficients.size() <= i) {
+                _blendshapeCoefficients.resize(i + 1);
+            }
+            if (_transientBlendshapeCoefficients.size() <= i) {
+                _transientBlendshapeCoefficients.resize(i + 1);
+            }
+            _blendshapeCoefficients[i] = frame.blendshapes[i];
+        }
+    }
+
+    if (frame.hasLookAt && glm::length2(frame.relativeLookAt) > 0.01f) {
+        setLookAtPosition((_owningAvatar->getWorldOrientation() * frame.relativeLookAt) + _owningAvatar->getWorldPosition());
+    }
+
+    if (frame.hasHeadOrientation) {
+        setHeadOrientation(frame.headOrientation);
+    }
+}
+
 bool HeadData::getProceduralAnimationFlag(ProceduralAnimationType type) const {
     return _userProceduralAnimationFlags[(int)type];
 }
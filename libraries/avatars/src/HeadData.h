@@ -31,6 +31,7 @@ const float MIN_HEAD_ROLL = -50.0f;
 const float MAX_HEAD_ROLL = 50.0f;
 
 class AvatarData;
+struct AvatarFrame;
 class QJsonObject;
 
 class HeadData {
@@ -101,6 +102,8 @@ public:
 
     QJsonObject toJson() const;
     void fromJson(const QJsonObject& json);
+    void toAvatarFrame(AvatarFrame& frame) const;
+    void fromAvatarFrame(const AvatarFrame& frame);
 
 protected:
     // degrees
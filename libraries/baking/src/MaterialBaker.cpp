@@ -142,6 +142,9 @@ void MaterialBaker::processMaterial() {
                                 &TextureBaker::deleteLater
                             };
                             textureBaker->setMapChannel(mapChannel);
+                            if (content.isEmpty()) {
+                                _externalTextures.insert(textureKey);
+                            }
                             connect(textureBaker.data(), &TextureBaker::finished, this, &MaterialBaker::handleFinishedTextureBaker);
                             _textureBakers.insert(textureKey, textureBaker);
                             textureBaker->moveToThread(_getNextOvenWorkerThreadOperator ? _getNextOvenWorkerThreadOperator() : thread());
@@ -171,6 +174,9 @@ void MaterialBaker::handleFinishedTextureBaker() {
 
     if (baker) {
         TextureKey textureKey = { baker->getTextureURL(), baker->getTextureType() };
+        if (_externalTextures.contains(textureKey)) {
+            _externalTextureHashes.insert(baker->getTextureURL(), baker->getOriginalTextureHash());
+        }
         if (!baker->hasErrors()) {
             // this TextureBaker is done and everything went according to plan
             qCDebug(material_baking) << "Re-writing texture references to" << baker->getTextureURL();
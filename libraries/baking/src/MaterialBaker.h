@@ -37,6 +37,9 @@ public:
 
     NetworkMaterialResourcePointer getNetworkMaterialResource() const { return _materialResource; }
 
+    // the textures that were referenced by URL rather than embedded, with the hash of the content they were baked from
+    const QHash<QUrl, QByteArray>& getExternalTextureHashes() const { return _externalTextureHashes; }
+
     static void setNextOvenWorkerThreadOperator(std::function<QThread*()> getNextOvenWorkerThreadOperator) { _getNextOvenWorkerThreadOperator = getNextOvenWorkerThreadOperator; }
 
 public slots:
@@ -62,6 +65,8 @@ private:
 
     QHash<TextureKey, QSharedPointer<TextureBaker>> _textureBakers;
     QMultiHash<TextureKey, std::shared_ptr<NetworkMaterial>> _materialsNeedingRewrite;
+    QSet<TextureKey> _externalTextures;
+    QHash<QUrl, QByteArray> _externalTextureHashes;
 
     QString _bakedOutputDir;
     QString _textureOutputDir;
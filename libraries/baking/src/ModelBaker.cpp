@@ -134,8 +134,12 @@ void ModelBaker::initializeOutputDirs() {
 }
 
 void ModelBaker::saveSourceModel() {
-    // check if the FBX is local or first needs to be downloaded
-    if (_modelURL.isLocalFile()) {
+    // check if the FBX was already loaded, is local, or first needs to be downloaded
+    if (!_sourceContent.isEmpty()) {
+        QByteArray content;
+        content.swap(_sourceContent);
+        writeSourceCopy(content);
+    } else if (_modelURL.isLocalFile()) {
         // load up the local file
         QFile localModelURL { _modelURL.toLocalFile() };
 
@@ -180,31 +184,34 @@ void ModelBaker::handleModelNetworkReply() {
 
     if (requestReply->error() == QNetworkReply::NoError) {
         qCDebug(model_baking) << "Downloaded" << _modelURL;
+        writeSourceCopy(requestReply->readAll());
+    } else {
+        // add an error to our list stating that the model could not be downloaded
+        handleError("Failed to download " + _modelURL.toString());
+    }
+}
 
-        // grab the contents of the reply and make a copy in the output folder
-        QFile copyOfOriginal(_originalOutputModelPath);
+void ModelBaker::writeSourceCopy(const QByteArray& content) {
+    // make a copy of the model in the output folder
+    QFile copyOfOriginal(_originalOutputModelPath);
 
-        qDebug(model_baking) << "Writing copy of original model file to" << _originalOutputModelPath << copyOfOriginal.fileName();
+    qDebug(model_baking) << "Writing copy of original model file to" << _originalOutputModelPath << copyOfOriginal.fileName();
 
-        if (!copyOfOriginal.open(QIODevice::WriteOnly)) {
-            // add an error to the error list for this model stating that a duplicate of the original model could not be made
-            handleError("Could not create copy of " + _modelURL.toString() + " (Failed to open " + _originalOutputModelPath + ")");
-            return;
-        }
-        if (copyOfOriginal.write(requestReply->readAll()) == -1) {
-            handleError("Could not create copy of " + _modelURL.toString() + " (Failed to write)");
-            return;
-        }
+    if (!copyOfOriginal.open(QIODevice::WriteOnly)) {
+        // add an error to the error list for this model stating that a duplicate of the original model could not be made
+        handleError("Could not create copy of " + _modelURL.toString() + " (Failed to open " + _originalOutputModelPath + ")");
+        return;
+    }
+    if (copyOfOriginal.write(content) == -1) {
+        handleError("Could not create copy of " + _modelURL.toString() + " (Failed to write)");
+        return;
+    }
 
-        // close that file now that we are done writing to it
-        copyOfOriginal.close();
+    // close that file now that we are done writing to it
+    copyOfOriginal.close();
 
-        // emit our signal to start the import of the model source copy
-        emit modelLoaded();
-    } else {
-        // add an error to our list stating that the model could not be downloaded
-        handleError("Failed to download " + _modelURL.toString());
-    }
+    // emit our signal to start the import of the model source copy
+    emit modelLoaded();
 }
 
 void ModelBaker::bakeSourceCopy() {
@@ -283,6 +290,7 @@ void ModelBaker::handleFinishedMaterialBaker() {
     auto baker = qobject_cast<MaterialBaker*>(sender());
 
     if (baker) {
+        addDependencies(*baker);
         if (!baker->hasErrors()) {
             // this MaterialBaker is done and everything went according to plan
             qCDebug(model_baking) << "Adding baked material to FST mapping " << baker->getBakedMaterialData();
@@ -311,6 +319,13 @@ void ModelBaker::handleFinishedMaterialBaker() {
     bakeMaterialMap();
 }
 
+void ModelBaker::addDependencies(const MaterialBaker& materialBaker) {
+    const auto& textureHashes = materialBaker.getExternalTextureHashes();
+    for (auto it = textureHashes.begin(); it != textureHashes.end(); ++it) {
+        _dependencyHashes.insert(it.key(), it.value());
+    }
+}
+
 void ModelBaker::bakeMaterialMap() {
     if (!_materialMapping.empty()) {
         // TODO:  The existing material map must be baked in order, so we do it all on this thread to preserve the order.
@@ -331,6 +346,7 @@ void ModelBaker::handleFinishedMaterialMapBaker() {
     auto baker = qobject_cast<MaterialBaker*>(sender());
 
     if (baker) {
+        addDependencies(*baker);
         if (!baker->hasErrors()) {
             // this MaterialBaker is done and everything went according to plan
             qCDebug(model_baking) << "Adding baked material to FST mapping " << baker->getBakedMaterialData();
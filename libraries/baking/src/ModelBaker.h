@@ -44,6 +44,8 @@ public:
     void setOutputURLSuffix(const QUrl& urlSuffix);
     void setMappingURL(const QUrl& mappingURL);
     void setMapping(const hifi::VariantHash& mapping);
+    // the content of the model when the caller already loaded it, so that it isn't read or downloaded again
+    void setSourceContent(const QByteArray& content) { _sourceContent = content; }
 
     void initializeOutputDirs();
 
@@ -54,6 +56,12 @@ public:
     QUrl getOriginalInputModelURL() const { return _originalInputModelURL; }
     virtual QUrl getFullOutputMappingURL() const;
     QUrl getBakedModelURL() const { return _bakedModelURL; }
+    QString getBakedOutputDir() const { return _bakedOutputDir; }
+    QString getOriginalOutputModelPath() const { return _originalOutputModelPath; }
+
+    // the files outside of the model that went into its bake, such as its external textures, with the SHA-256 of their
+    // content, empty for the ones that couldn't be loaded
+    const QHash<QUrl, QByteArray>& getDependencyHashes() const { return _dependencyHashes; }
 
 signals:
     void modelLoaded();
@@ -78,6 +86,7 @@ protected:
     QString _originalOutputModelPath;
     QString _outputMappingURL;
     QUrl _bakedModelURL;
+    QHash<QUrl, QByteArray> _dependencyHashes;
 
 protected slots:
     void handleModelNetworkReply();
@@ -89,8 +98,11 @@ private:
     void outputUnbakedFST();
     void outputBakedFST();
     void bakeMaterialMap();
+    void writeSourceCopy(const QByteArray& content);
+    void addDependencies(const MaterialBaker& materialBaker);
 
     bool _hasBeenBaked { false };
+    QByteArray _sourceContent;
 
     hfm::Model::Pointer _hfmModel;
     MaterialMapping _materialMapping;
@@ -149,6 +149,7 @@ void TextureBaker::processTexture() {
             return;
         }
         // IMPORTANT: _originalTexture is empty past this point
+        _originalTextureHash = QCryptographicHash::hash(_originalTexture, QCryptographicHash::Sha256);
         _originalTexture.clear();
         _outputFiles.push_back(originalCopyFilePath);
         meta.original = _originalCopyFilePath.fileName();
@@ -36,6 +36,8 @@ public:
                  const QByteArray& textureContent = QByteArray());
 
     const QByteArray& getOriginalTexture() const { return _originalTexture; }
+    // SHA-256 of the texture that was baked, empty if it couldn't be loaded
+    QByteArray getOriginalTextureHash() const { return _originalTextureHash; }
 
     QUrl getTextureURL() const { return _textureURL; }
 
@@ -46,6 +48,7 @@ public:
     virtual void setWasAborted(bool wasAborted) override;
 
     static void setCompressionEnabled(bool enabled) { _compressionEnabled = enabled; }
+    static bool isCompressionEnabled() { return _compressionEnabled; }
 
     void setMapChannel(graphics::Material::MapChannel mapChannel) { _mapChannel = mapChannel; }
     graphics::Material::MapChannel getMapChannel() const { return _mapChannel; }
@@ -67,6 +70,7 @@ private:
 
     QUrl _textureURL;
     QByteArray _originalTexture;
+    QByteArray _originalTextureHash;
     image::TextureUsage::Type _textureType;
     graphics::Material::MapChannel _mapChannel;
     bool _mapChannelSet { false };
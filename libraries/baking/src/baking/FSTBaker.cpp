@@ -11,6 +11,9 @@
 
 #include "FSTBaker.h"
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+
 #include <PathUtils.h>
 #include <NetworkAccessManager.h>
 
@@ -105,6 +108,15 @@ void FSTBaker::handleModelBakerEnded() {
         _outputFiles.push_back(outputFile);
     }
 
+    // the model the FST names is a dependency of its bake, like the model's own external textures
+    const auto& dependencyHashes = _modelBaker->getDependencyHashes();
+    for (auto it = dependencyHashes.begin(); it != dependencyHashes.end(); ++it) {
+        _dependencyHashes.insert(it.key(), it.value());
+    }
+    QFile modelFile(_modelBaker->getOriginalOutputModelPath());
+    _dependencyHashes.insert(_modelBaker->getModelURL(), modelFile.open(QIODevice::ReadOnly) ?
+        QCryptographicHash::hash(modelFile.readAll(), QCryptographicHash::Sha256) : QByteArray());
+
 }
 
 void FSTBaker::handleModelBakerAborted() {
@@ -11,10 +11,91 @@
 
 #include "EntityEditFilters.h"
 
+#include <algorithm>
+
 #include <QUrl>
 
 #include <ResourceManager.h>
 #include <shared/ScriptInitializerMixin.h>
+#include <SharedUtil.h>
+#include <ThreadHelpers.h>
+
+const std::array<quint64, EntityEditFilters::NUM_LATENCY_BUCKETS - 1> EntityEditFilters::LATENCY_BUCKET_LIMITS_USECS {{
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000
+}};
+const int EntityEditFilters::NUM_LATENCY_BUCKETS;
+const int EntityEditFilters::DEFAULT_NUM_WORKERS = 2;
+const int EntityEditFilters::DEFAULT_MAX_QUEUED_EDITS = 1000;
+
+// Copied from ScriptEngine.cpp. We should make this a class method for reuse.
+// Note: I've deliberately stopped short of using ScriptEngine instead of QScriptEngine, as that is out of project scope at this point.
+static bool hasCorrectSyntax(const QScriptProgram& program) {
+    const auto syntaxCheck = QScriptEngine::checkSyntax(program.sourceCode());
+    if (syntaxCheck.state() != QScriptSyntaxCheckResult::Valid) {
+        const auto error = syntaxCheck.errorMessage();
+        const auto line = QString::number(syntaxCheck.errorLineNumber());
+        const auto column = QString::number(syntaxCheck.errorColumnNumber());
+        const auto message = QString("[SyntaxError] %1 in %2:%3(%4)").arg(error, program.fileName(), line, column);
+        qCritical() << qPrintable(message);
+        return false;
+    }
+    return true;
+}
+static bool hadUncaughtExceptions(QScriptEngine& engine, const QString& fileName) {
+    if (engine.hasUncaughtException()) {
+        const auto backtrace = engine.uncaughtExceptionBacktrace();
+        const auto exception = engine.uncaughtException().toString();
+        const auto line = QString::number(engine.uncaughtExceptionLineNumber());
+        engine.clearExceptions();
+
+        static const QString SCRIPT_EXCEPTION_FORMAT = "[UncaughtException] %1 in %2:%3";
+        auto message = QString(SCRIPT_EXCEPTION_FORMAT).arg(exception, fileName, line);
+        if (!backtrace.empty()) {
+            static const auto lineSeparator = "\n    ";
+            message += QString("\n[Backtrace]%1%2").arg(lineSeparator, backtrace.join(lineSeparator));
+        }
+        qCritical() << qPrintable(message);
+        return true;
+    }
+    return false;
+}
+
+// creates an engine and evaluates the filter script in it, returns null if the script throws
+static QScriptEngine* createFilterEngine(const EntityItemID& entityID, const QString& urlString, const QString& scriptContents) {
+    QScriptEngine* engine = new QScriptEngine();
+    engine->setObjectName("filter:" + entityID.toString());
+    engine->setProperty("type", "edit_filter");
+    engine->setProperty("fileName", urlString);
+    engine->setProperty("entityID", entityID);
+    engine->globalObject().setProperty("Script", engine->newQObject(engine));
+    DependencyManager::get<ScriptInitializers>()->runScriptInitializers(engine);
+    engine->evaluate(scriptContents, urlString);
+    if (hadUncaughtExceptions(*engine, urlString)) {
+        delete engine;
+        return nullptr;
+    }
+
+    auto global = engine->globalObject();
+    auto entitiesObject = engine->newObject();
+    entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
+    entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
+    entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
+    entitiesObject.setProperty("DELETE_FILTER_TYPE", EntityTree::FilterType::Delete);
+    global.setProperty("Entities", entitiesObject);
+    return engine;
+}
+
+EntityEditFilters::EntityEditFilters() {
+    startWorkers(DEFAULT_NUM_WORKERS);
+}
+
+EntityEditFilters::EntityEditFilters(EntityTreePointer tree) : _tree(tree) {
+    startWorkers(DEFAULT_NUM_WORKERS);
+}
+
+EntityEditFilters::~EntityEditFilters() {
+    stopWorkers();
+}
 
 QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
     QList<EntityItemID> zones;
@@ -42,14 +123,203 @@ QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
     return zones;
 }
 
+bool EntityEditFilters::hasFilters() {
+    QReadLocker locker(&_lock);
+    return !_filterDataMap.isEmpty();
+}
+
 bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut,
         bool& wasChanged, EntityTree::FilterType filterType, EntityItemID& itemID, const EntityItemPointer& existingEntity) {
-    
+    std::vector<FilterRequest> requests(1);
+    FilterRequest& request = requests.front();
+    request.position = position;
+    request.propertiesIn = &propertiesIn;
+    request.propertiesOut = &propertiesOut;
+    request.filterType = filterType;
+    request.entityID = itemID;
+    request.existingEntity = existingEntity;
+    request.wasChanged = wasChanged;
+
+    filterBatch(requests);
+
+    wasChanged = request.wasChanged;
+    return request.accepted;
+}
+
+void EntityEditFilters::filterBatch(std::vector<FilterRequest>& requests) {
+    if (requests.empty()) {
+        return;
+    }
+
+    // without any filter every edit is accepted as is
+    if (!hasFilters()) {
+        for (auto& request : requests) {
+            request.accepted = true;
+        }
+        return;
+    }
+
+    QReadLocker workersLocker(&_workersLock);
+    PendingBatch batch;
+    std::unique_lock<std::mutex> batchLock(batch.mutex);
+
+    quint64 rejectedEdits = 0;
+    quint64 queueDepth = 0;
+    {
+        std::lock_guard<std::mutex> queueLock(_queueMutex);
+        quint64 now = usecTimestampNow();
+        int maxQueuedEdits = _maxQueuedEdits;
+        for (auto& request : requests) {
+            if (maxQueuedEdits > 0 && _queue.size() >= (size_t)maxQueuedEdits) {
+                // the filters are behind, treat the edit as if they had rejected it
+                request.accepted = false;
+                rejectedEdits++;
+                continue;
+            }
+            _queue.push_back({ &request, &batch, now });
+            batch.remaining++;
+        }
+        queueDepth = _queue.size();
+    }
+    _queueCondition.notify_all();
+
+    {
+        std::lock_guard<std::mutex> statsLock(_statsMutex);
+        _stats.rejectedEdits += rejectedEdits;
+        _stats.maxQueueDepth = std::max(_stats.maxQueueDepth, queueDepth);
+    }
+
+    batch.done.wait(batchLock, [&] { return batch.remaining == 0; });
+}
+
+void EntityEditFilters::setNumWorkers(int numWorkers) {
+    QWriteLocker workersLocker(&_workersLock);
+    stopWorkers();
+    startWorkers(numWorkers);
+}
+
+void EntityEditFilters::startWorkers(int numWorkers) {
+    numWorkers = std::max(numWorkers, 1);
+    for (int i = 0; i < numWorkers; ++i) {
+        _workers.emplace_back([this, i] {
+            setThreadName("EntityEditFilter " + std::to_string(i));
+            runWorker();
+        });
+    }
+}
+
+void EntityEditFilters::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> queueLock(_queueMutex);
+        _stopWorkers = true;
+    }
+    _queueCondition.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+    _workers.clear();
+
+    std::lock_guard<std::mutex> queueLock(_queueMutex);
+    _stopWorkers = false;
+}
+
+void EntityEditFilters::runWorker() {
+    // the engines are created, used and destroyed on this thread only
+    FilterEngines engines;
+    quint64 enginesVersion = 0;
+
+    while (true) {
+        QueuedRequest queued;
+        {
+            std::unique_lock<std::mutex> queueLock(_queueMutex);
+            _queueCondition.wait(queueLock, [&] { return _stopWorkers || !_queue.empty(); });
+            // the queued edits are still filtered when stopping, their batches are waited on
+            if (_queue.empty()) {
+                break;
+            }
+            queued = _queue.front();
+            _queue.pop_front();
+        }
+
+        quint64 filtersVersion = _filtersVersion;
+        if (filtersVersion != enginesVersion) {
+            // drop the engines of the filters that were removed or replaced
+            QReadLocker locker(&_lock);
+            for (auto it = engines.begin(); it != engines.end();) {
+                auto filterData = _filterDataMap.constFind(it.key());
+                if (filterData == _filterDataMap.constEnd() || filterData->generation != it->generation) {
+                    it = engines.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            enginesVersion = filtersVersion;
+        }
+
+        quint64 queueWait = usecTimestampNow() - queued.queuedAt;
+        runFilters(*queued.request, engines);
+
+        {
+            std::lock_guard<std::mutex> statsLock(_statsMutex);
+            _stats.queuedEdits++;
+            _stats.totalQueueWaitUsecs += queueWait;
+        }
+
+        // notified with the lock held, the batch is gone as soon as its waiter wakes up
+        std::lock_guard<std::mutex> batchLock(queued.batch->mutex);
+        if (--queued.batch->remaining == 0) {
+            queued.batch->done.notify_one();
+        }
+    }
+}
+
+EntityEditFilters::FilterEngine& EntityEditFilters::getFilterEngine(FilterEngines& engines, const EntityItemID& id,
+                                                                    const FilterData& filterData) {
+    FilterEngine& filterEngine = engines[id];
+    if (filterEngine.generation != filterData.generation) {
+        filterEngine.filterFn = QScriptValue();
+        filterEngine.engine.reset(createFilterEngine(id, filterData.scriptURL, filterData.scriptContents));
+        if (filterEngine.engine) {
+            filterEngine.filterFn = filterEngine.engine->globalObject().property("filter");
+            if (!filterEngine.filterFn.isFunction()) {
+                filterEngine.filterFn = QScriptValue();
+                filterEngine.engine.reset();
+            }
+        }
+        filterEngine.generation = filterData.generation;
+    }
+    return filterEngine;
+}
+
+void EntityEditFilters::recordLatency(const EntityItemID& id, quint64 usecs) {
+    size_t bucket = std::upper_bound(LATENCY_BUCKET_LIMITS_USECS.begin(), LATENCY_BUCKET_LIMITS_USECS.end(), usecs) -
+        LATENCY_BUCKET_LIMITS_USECS.begin();
+
+    std::lock_guard<std::mutex> statsLock(_statsMutex);
+    LatencyHistogram& histogram = _stats.zoneLatencies[id];
+    histogram.buckets[bucket]++;
+    histogram.calls++;
+    histogram.totalUsecs += usecs;
+    histogram.maxUsecs = std::max(histogram.maxUsecs, usecs);
+}
+
+EntityEditFilters::Stats EntityEditFilters::getStats() {
+    std::lock_guard<std::mutex> statsLock(_statsMutex);
+    return _stats;
+}
+
+void EntityEditFilters::runFilters(FilterRequest& request, FilterEngines& engines) {
+    EntityItemProperties& propertiesIn = *request.propertiesIn;
+    EntityItemProperties& propertiesOut = *request.propertiesOut;
+    bool& wasChanged = request.wasChanged;
+    const EntityItemPointer& existingEntity = request.existingEntity;
+    request.accepted = false;
+
     // get the ids of all the zones (plus the global entity edit filter) that the position
     // lies within
-    auto zoneIDs = getZonesByPosition(position);
+    auto zoneIDs = getZonesByPosition(request.position);
     for (auto id : zoneIDs) {
-        if (!itemID.isInvalidID() && id == itemID) {
+        if (!request.entityID.isInvalidID() && id == request.entityID) {
             continue;
         }
         
@@ -60,23 +330,32 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
     
         if (filterData.valid()) {
             if (filterData.rejectAll) {
-                return false;
+                return;
             }
 
             // check to see if this filter wants to filter this message type
+            EntityTree::FilterType filterType = request.filterType;
             if ((!filterData.wantsToFilterEdit && filterType == EntityTree::FilterType::Edit) ||
                 (!filterData.wantsToFilterPhysics && filterType == EntityTree::FilterType::Physics) ||
                 (!filterData.wantsToFilterDelete && filterType == EntityTree::FilterType::Delete) ||
                 (!filterData.wantsToFilterAdd && filterType == EntityTree::FilterType::Add)) {
 
                 wasChanged = false;
-                return true; // accept the message
+                request.accepted = true; // accept the message
+                return;
             }
 
+            FilterEngine& filterEngine = getFilterEngine(engines, id, filterData);
+            if (!filterEngine.engine) {
+                return;
+            }
+            QScriptEngine* engine = filterEngine.engine.get();
+            quint64 startFilter = usecTimestampNow();
+
             auto oldProperties = propertiesIn.getDesiredProperties();
             auto specifiedProperties = propertiesIn.getChangedProperties();
             propertiesIn.setDesiredProperties(specifiedProperties);
-            QScriptValue inputValues = propertiesIn.copyToScriptValue(filterData.engine, false, true, true);
+            QScriptValue inputValues = propertiesIn.copyToScriptValue(engine, false, true, true);
             propertiesIn.setDesiredProperties(oldProperties);
 
             auto in = QJsonValue::fromVariant(inputValues.toVariant()); // grab json copy now, because the inputValues might be side effected by the filter.
@@ -88,7 +367,7 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
             // get the current properties for then entity and include them for the filter call
             if (existingEntity && filterData.wantsOriginalProperties) {
                 auto currentProperties = existingEntity->getProperties(filterData.includedOriginalProperties);
-                QScriptValue currentValues = currentProperties.copyToScriptValue(filterData.engine, false, true, true);
+                QScriptValue currentValues = currentProperties.copyToScriptValue(engine, false, true, true);
                 args << currentValues;
             }
 
@@ -98,17 +377,17 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 auto zoneEntity = _tree->findEntityByEntityItemID(id);
                 if (zoneEntity) {
                     auto zoneProperties = zoneEntity->getProperties(filterData.includedZoneProperties);
-                    QScriptValue zoneValues = zoneProperties.copyToScriptValue(filterData.engine, false, true, true);
+                    QScriptValue zoneValues = zoneProperties.copyToScriptValue(engine, false, true, true);
 
                     if (filterData.wantsZoneBoundingBox) {
                         bool success = true;
                         AABox aaBox = zoneEntity->getAABox(success);
                         if (success) {
-                            QScriptValue boundingBox = filterData.engine->newObject();
-                            QScriptValue bottomRightNear = vec3ToScriptValue(filterData.engine, aaBox.getCorner());
-                            QScriptValue topFarLeft = vec3ToScriptValue(filterData.engine, aaBox.calcTopFarLeft());
-                            QScriptValue center = vec3ToScriptValue(filterData.engine, aaBox.calcCenter());
-                            QScriptValue boundingBoxDimensions = vec3ToScriptValue(filterData.engine, aaBox.getDimensions());
+                            QScriptValue boundingBox = engine->newObject();
+                            QScriptValue bottomRightNear = vec3ToScriptValue(engine, aaBox.getCorner());
+                            QScriptValue topFarLeft = vec3ToScriptValue(engine, aaBox.calcTopFarLeft());
+                            QScriptValue center = vec3ToScriptValue(engine, aaBox.calcCenter());
+                            QScriptValue boundingBoxDimensions = vec3ToScriptValue(engine, aaBox.getDimensions());
                             boundingBox.setProperty("brn", bottomRightNear);
                             boundingBox.setProperty("tfl", topFarLeft);
                             boundingBox.setProperty("center", center);
@@ -129,10 +408,12 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 }
             }
 
-            QScriptValue result = filterData.filterFn.call(_nullObjectForFilter, args);
+            QScriptValue result = filterEngine.filterFn.call(QScriptValue(), args);
+            bool hadExceptions = hadUncaughtExceptions(*engine, filterData.scriptURL);
+            recordLatency(id, usecTimestampNow() - startFilter);
 
-            if (filterData.uncaughtExceptions()) {
-                return false;
+            if (hadExceptions) {
+                return;
             }
 
             if (result.isObject()) {
@@ -148,7 +429,7 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
 
                 // if the filter returned false, then it's authoritative
                 if (!result.toBool()) {
-                    return false;
+                    return;
                 }
 
                 // otherwise, assume it wants to pass all properties
@@ -156,21 +437,20 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 wasChanged = false;
                 
             } else {
-                return false;
+                return;
             }
         }
     }
     // if we made it here, 
-    return true;
+    request.accepted = true;
 }
 
 void EntityEditFilters::removeFilter(EntityItemID entityID) {
-    QWriteLocker writeLock(&_lock);
-    FilterData filterData = _filterDataMap.value(entityID);
-    if (filterData.valid()) {
-        delete filterData.engine;
+    {
+        QWriteLocker writeLock(&_lock);
+        _filterDataMap.remove(entityID);
     }
-    _filterDataMap.remove(entityID);
+    _filtersVersion++;
 }
 
 void EntityEditFilters::addFilter(EntityItemID entityID, QString filterURL) {
@@ -198,8 +478,10 @@ void EntityEditFilters::addFilter(EntityItemID entityID, QString filterURL) {
     filterData.rejectAll = true;
 
     _lock.lockForWrite();
+    filterData.generation = _nextGeneration++;
     _filterDataMap.insert(entityID, filterData);
     _lock.unlock();
+    _filtersVersion++;
    
     auto scriptRequest = DependencyManager::get<ResourceManager>()->createResourceRequest(
         this, scriptURL, true, -1, "EntityEditFilters::addFilter");
@@ -215,39 +497,6 @@ void EntityEditFilters::addFilter(EntityItemID entityID, QString filterURL) {
     qDebug() << "script request sent for entity " << entityID;
 }
 
-// Copied from ScriptEngine.cpp. We should make this a class method for reuse.
-// Note: I've deliberately stopped short of using ScriptEngine instead of QScriptEngine, as that is out of project scope at this point.
-static bool hasCorrectSyntax(const QScriptProgram& program) {
-    const auto syntaxCheck = QScriptEngine::checkSyntax(program.sourceCode());
-    if (syntaxCheck.state() != QScriptSyntaxCheckResult::Valid) {
-        const auto error = syntaxCheck.errorMessage();
-        const auto line = QString::number(syntaxCheck.errorLineNumber());
-        const auto column = QString::number(syntaxCheck.errorColumnNumber());
-        const auto message = QString("[SyntaxError] %1 in %2:%3(%4)").arg(error, program.fileName(), line, column);
-        qCritical() << qPrintable(message);
-        return false;
-    }
-    return true;
-}
-static bool hadUncaughtExceptions(QScriptEngine& engine, const QString& fileName) {
-    if (engine.hasUncaughtException()) {
-        const auto backtrace = engine.uncaughtExceptionBacktrace();
-        const auto exception = engine.uncaughtException().toString();
-        const auto line = QString::number(engine.uncaughtExceptionLineNumber());
-        engine.clearExceptions();
-
-        static const QString SCRIPT_EXCEPTION_FORMAT = "[UncaughtException] %1 in %2:%3";
-        auto message = QString(SCRIPT_EXCEPTION_FORMAT).arg(exception, fileName, line);
-        if (!backtrace.empty()) {
-            static const auto lineSeparator = "\n    ";
-            message += QString("\n[Backtrace]%1%2").arg(lineSeparator, backtrace.join(lineSeparator));
-        }
-        qCritical() << qPrintable(message);
-        return true;
-    }
-    return false;
-}
-
 void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
     qDebug() << "script request completed for entity " << entityID;
     auto scriptRequest = qobject_cast<ResourceRequest*>(sender());
@@ -257,58 +506,39 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
         qInfo() << "Downloaded script:" << scriptContents;
         QScriptProgram program(scriptContents, urlString);
         if (hasCorrectSyntax(program)) {
-            // create a QScriptEngine for this script
-            QScriptEngine* engine = new QScriptEngine();
-            engine->setObjectName("filter:" + entityID.toString());
-            engine->setProperty("type", "edit_filter");
-            engine->setProperty("fileName", urlString);
-            engine->setProperty("entityID", entityID);
-            engine->globalObject().setProperty("Script", engine->newQObject(engine));
-            DependencyManager::get<ScriptInitializers>()->runScriptInitializers(engine);
-            engine->evaluate(scriptContents, urlString);
-            if (!hadUncaughtExceptions(*engine, urlString)) {
-                // put the engine in the engine map (so we don't leak them, etc...)
+            // the workers evaluate the script in engines of their own, this one is only asked for the options of the filter
+            std::unique_ptr<QScriptEngine> engine(createFilterEngine(entityID, urlString, scriptContents));
+            if (engine) {
                 FilterData filterData;
-                filterData.engine = engine;
+                filterData.scriptURL = urlString;
+                filterData.scriptContents = scriptContents;
                 filterData.rejectAll = false;
-                
-                // define the uncaughtException function
-                QScriptEngine& engineRef = *engine;
-                filterData.uncaughtExceptions = [&engineRef, urlString]() { return hadUncaughtExceptions(engineRef, urlString); };
 
                 // now get the filter function
-                auto global = engine->globalObject();
-                auto entitiesObject = engine->newObject();
-                entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
-                entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
-                entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
-                entitiesObject.setProperty("DELETE_FILTER_TYPE", EntityTree::FilterType::Delete);
-                global.setProperty("Entities", entitiesObject);
-                filterData.filterFn = global.property("filter");
-                if (!filterData.filterFn.isFunction()) {
+                QScriptValue filterFn = engine->globalObject().property("filter");
+                if (!filterFn.isFunction()) {
                     qDebug() << "Filter function specified but not found. Will reject all edits for those without lock rights.";
-                    delete engine;
                     filterData.rejectAll=true;
                 }
 
                 // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterAddValue = filterData.filterFn.property("wantsToFilterAdd");
+                QScriptValue wantsToFilterAddValue = filterFn.property("wantsToFilterAdd");
                 filterData.wantsToFilterAdd = wantsToFilterAddValue.isBool() ? wantsToFilterAddValue.toBool() : true;
 
                 // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterEditValue = filterData.filterFn.property("wantsToFilterEdit");
+                QScriptValue wantsToFilterEditValue = filterFn.property("wantsToFilterEdit");
                 filterData.wantsToFilterEdit = wantsToFilterEditValue.isBool() ? wantsToFilterEditValue.toBool() : true;
 
                 // if the wantsToFilterPhysics is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterPhysicsValue = filterData.filterFn.property("wantsToFilterPhysics");
+                QScriptValue wantsToFilterPhysicsValue = filterFn.property("wantsToFilterPhysics");
                 filterData.wantsToFilterPhysics = wantsToFilterPhysicsValue.isBool() ? wantsToFilterPhysicsValue.toBool() : true;
 
                 // if the wantsToFilterDelete is a boolean evaluate as a boolean, otherwise assume false
-                QScriptValue wantsToFilterDeleteValue = filterData.filterFn.property("wantsToFilterDelete");
+                QScriptValue wantsToFilterDeleteValue = filterFn.property("wantsToFilterDelete");
                 filterData.wantsToFilterDelete = wantsToFilterDeleteValue.isBool() ? wantsToFilterDeleteValue.toBool() : false;
 
                 // check to see if the filterFn has properties asking for Original props
-                QScriptValue wantsOriginalPropertiesValue = filterData.filterFn.property("wantsOriginalProperties");
+                QScriptValue wantsOriginalPropertiesValue = filterFn.property("wantsOriginalProperties");
                 // if the wantsOriginalProperties is a boolean, or a string, or list of strings, then evaluate as follows:
                 //   - boolean - true  - include all original properties
                 //               false - no properties at all
@@ -329,7 +559,7 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
                 }
 
                 // check to see if the filterFn has properties asking for Zone props
-                QScriptValue wantsZonePropertiesValue = filterData.filterFn.property("wantsZoneProperties");
+                QScriptValue wantsZonePropertiesValue = filterFn.property("wantsZoneProperties");
                 // if the wantsZoneProperties is a boolean, or a string, or list of strings, then evaluate as follows:
                 //   - boolean - true  - include all Zone properties
                 //               false - no properties at all
@@ -371,8 +601,10 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
                 }
 
                 _lock.lockForWrite();
+                filterData.generation = _nextGeneration++;
                 _filterDataMap.insert(entityID, filterData);
                 _lock.unlock();
+                _filtersVersion++;
 
                 qDebug() << "script request filter processed for entity id " << entityID;
                 
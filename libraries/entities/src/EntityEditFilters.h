@@ -13,21 +13,35 @@
 
 #include <QObject>
 #include <QMap>
+#include <QHash>
 #include <QScriptValue>
 #include <QScriptEngine>
 #include <glm/glm.hpp>
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "EntityItemID.h"
 #include "EntityItemProperties.h"
 #include "EntityTree.h"
 
+// The filter scripts run on a pool of worker threads, each evaluating its own copy of every filter in its own
+// QScriptEngine, so that the edits of a batch are filtered in parallel and before the tree is locked.
 class EntityEditFilters : public QObject, public Dependency {
     Q_OBJECT
 public:
     struct FilterData {
-        QScriptValue filterFn;
+        QString scriptURL;
+        QString scriptContents;
+        quint64 generation { 0 }; // the worker engines of older generations are stale
+
         bool wantsOriginalProperties { false };
         bool wantsZoneProperties { false };
 
@@ -40,23 +54,64 @@ public:
         EntityPropertyFlags includedZoneProperties;
         bool wantsZoneBoundingBox { false };
 
-        std::function<bool()> uncaughtExceptions;
-        QScriptEngine* engine;
-        bool rejectAll;
-        
-        FilterData(): engine(nullptr), rejectAll(false) {};
-        bool valid() { return (rejectAll || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
+        bool rejectAll { false };
+
+        bool valid() { return (rejectAll || !scriptContents.isEmpty()); }
+    };
+
+    // an edit to filter, propertiesIn and propertiesOut are changed by the filters in place
+    struct FilterRequest {
+        glm::vec3 position;
+        EntityItemProperties* propertiesIn { nullptr };
+        EntityItemProperties* propertiesOut { nullptr };
+        EntityTree::FilterType filterType { EntityTree::FilterType::Edit };
+        EntityItemID entityID;
+        EntityItemPointer existingEntity;
+        bool wasChanged { false };
+        bool accepted { false };
+    };
+
+    static const int NUM_LATENCY_BUCKETS = 9;
+    static const std::array<quint64, NUM_LATENCY_BUCKETS - 1> LATENCY_BUCKET_LIMITS_USECS;
+    static const int DEFAULT_NUM_WORKERS;
+    static const int DEFAULT_MAX_QUEUED_EDITS;
+
+    // the time taken by the calls to the filter of one zone, the last bucket counts the calls over all the limits
+    struct LatencyHistogram {
+        std::array<quint64, NUM_LATENCY_BUCKETS> buckets {};
+        quint64 calls { 0 };
+        quint64 totalUsecs { 0 };
+        quint64 maxUsecs { 0 };
+    };
+
+    struct Stats {
+        QHash<EntityItemID, LatencyHistogram> zoneLatencies; // the global filter is under the null ID
+        quint64 queuedEdits { 0 };
+        quint64 totalQueueWaitUsecs { 0 };
+        quint64 rejectedEdits { 0 }; // over the queueing limit
+        quint64 maxQueueDepth { 0 };
     };
 
-    EntityEditFilters() {};
-    EntityEditFilters(EntityTreePointer tree ): _tree(tree) {};
+    EntityEditFilters();
+    EntityEditFilters(EntityTreePointer tree);
+    ~EntityEditFilters();
 
     void addFilter(EntityItemID entityID, QString filterURL);
     void removeFilter(EntityItemID entityID);
+    bool hasFilters();
 
     bool filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, 
                 EntityTree::FilterType filterType, EntityItemID& entityID, const EntityItemPointer& existingEntity);
 
+    // filters the requests on the workers and returns once they are all done
+    void filterBatch(std::vector<FilterRequest>& requests);
+
+    void setNumWorkers(int numWorkers);
+    // the edits queued for the workers beyond this number are rejected, 0 for no limit
+    void setMaxQueuedEdits(int maxQueuedEdits) { _maxQueuedEdits = maxQueuedEdits; }
+
+    Stats getStats();
+
 signals:
     void filterAdded(EntityItemID id, bool success);
 
@@ -64,14 +119,53 @@ private slots:
     void scriptRequestFinished(EntityItemID entityID);
     
 private:
+    // the engine a worker evaluated a filter in
+    struct FilterEngine {
+        std::shared_ptr<QScriptEngine> engine;
+        QScriptValue filterFn;
+        quint64 generation { 0 };
+    };
+    using FilterEngines = QHash<EntityItemID, FilterEngine>;
+
+    struct PendingBatch {
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t remaining { 0 };
+    };
+
+    struct QueuedRequest {
+        FilterRequest* request;
+        PendingBatch* batch;
+        quint64 queuedAt;
+    };
+
     QList<EntityItemID> getZonesByPosition(glm::vec3& position);
 
+    void startWorkers(int numWorkers);
+    void stopWorkers();
+    void runWorker();
+    void runFilters(FilterRequest& request, FilterEngines& engines);
+    FilterEngine& getFilterEngine(FilterEngines& engines, const EntityItemID& id, const FilterData& filterData);
+    void recordLatency(const EntityItemID& id, quint64 usecs);
+
     EntityTreePointer _tree {};
     bool _rejectAll {false};
-    QScriptValue _nullObjectForFilter{};
     
     QReadWriteLock _lock;
     QMap<EntityItemID, FilterData> _filterDataMap;
+    quint64 _nextGeneration { 1 }; // guarded by _lock
+    std::atomic<quint64> _filtersVersion { 0 }; // changes with each filter added or removed
+
+    std::mutex _queueMutex;
+    std::condition_variable _queueCondition;
+    std::deque<QueuedRequest> _queue; // guarded by _queueMutex
+    bool _stopWorkers { false }; // guarded by _queueMutex
+    QReadWriteLock _workersLock; // held for writing to replace the workers
+    std::vector<std::thread> _workers;
+    std::atomic<int> _maxQueuedEdits { DEFAULT_MAX_QUEUED_EDITS };
+
+    std::mutex _statsMutex;
+    Stats _stats; // guarded by _statsMutex
 };
 
 #endif //hifi_EntityEditFilters_h
@@ -2701,6 +2701,10 @@ void EntityItem::globalizeProperties(EntityItemProperties& properties, const QSt
 
 
 bool EntityItem::matchesJSONFilters(const QJsonObject& jsonFilters) const {
+    return matchesQueryFilter(EntityQueryFilter(jsonFilters));
+}
+
+bool EntityItem::matchesQueryFilter(const EntityQueryFilter& filter) const {
 
     // The intention for the query JSON filter and this method is to be flexible to handle a variety of filters for
     // ALL entity properties. Some work will need to be done to the property system so that it can be more flexible
@@ -2709,24 +2713,18 @@ bool EntityItem::matchesJSONFilters(const QJsonObject& jsonFilters) const {
     // currently the only property filter we handle in EntityItem is '+' for serverScripts
     // which means that we only handle a filtered query asking for entities where the serverScripts property is non-default
 
-    static const QString SERVER_SCRIPTS_PROPERTY = "serverScripts";
-    static const QString ENTITY_TYPE_PROPERTY = "type";
-
-    foreach(const auto& property, jsonFilters.keys()) {
-        if (property == SERVER_SCRIPTS_PROPERTY && jsonFilters[property] == EntityQueryFilterSymbol::NonDefault) {
+    switch (filter.getPropertyTest()) {
+        case EntityQueryFilter::PropertyTest::NonDefaultServerScripts:
             // check if this entity has a non-default value for serverScripts
-            if (_serverScripts != ENTITY_ITEM_DEFAULT_SERVER_SCRIPTS) {
-                return true;
-            } else {
-                return false;
-            }
-        } else if (property == ENTITY_TYPE_PROPERTY) {
-            return (jsonFilters[property] == EntityTypes::getEntityTypeName(getType()) );
-        }
+            return _serverScripts != ENTITY_ITEM_DEFAULT_SERVER_SCRIPTS;
+        case EntityQueryFilter::PropertyTest::Type:
+            return getType() == filter.getType();
+        case EntityQueryFilter::PropertyTest::NoMatch:
+            return false;
+        default:
+            // the json filter syntax did not match what we expected, return a match
+            return true;
     }
-
-    // the json filter syntax did not match what we expected, return a match
-    return true;
 }
 
 quint64 EntityItem::getLastSimulated() const {
@@ -33,6 +33,7 @@
 #include "EntityItemID.h"
 #include "EntityItemPropertiesDefaults.h"
 #include "EntityPropertyFlags.h"
+#include "EntityQueryFilter.h"
 #include "EntityTypes.h"
 #include "SimulationOwner.h"
 #include "EntityDynamicInterface.h"
@@ -532,7 +533,8 @@ public:
     QUuid getLastEditedBy() const { return _lastEditedBy; }
     void setLastEditedBy(QUuid value) { _lastEditedBy = value; }
 
-    virtual bool matchesJSONFilters(const QJsonObject& jsonFilters) const;
+    bool matchesJSONFilters(const QJsonObject& jsonFilters) const;
+    virtual bool matchesQueryFilter(const EntityQueryFilter& filter) const;
 
     virtual bool getMeshes(MeshProxyList& result) { return true; }
 
@@ -28,3 +28,11 @@ bool EntityNodeData::isEntityFlaggedAsExtra(const QUuid& entityID) const {
 
     return false;
 }
+
+const EntityQueryFilter& EntityNodeData::getQueryFilter(const QJsonObject& jsonParameters) {
+    if (jsonParameters != _queryFilterParameters) {
+        _queryFilterParameters = jsonParameters;
+        _queryFilter = EntityQueryFilter(jsonParameters);
+    }
+    return _queryFilter;
+}
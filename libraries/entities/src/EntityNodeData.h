@@ -16,6 +16,8 @@
 
 #include <OctreeQueryNode.h>
 
+#include "EntityQueryFilter.h"
+
 namespace EntityJSONQueryProperties {
     static const QString SERVER_SCRIPTS_PROPERTY = "serverScripts";
     static const QString FLAGS_PROPERTY = "flags";
@@ -44,11 +46,17 @@ public:
     bool isEntityFlaggedAsExtra(const QUuid& entityID) const;
     void resetFlaggedExtraEntities() { _previousFlaggedExtraEntities = _flaggedExtraEntities; _flaggedExtraEntities.clear(); }
 
+    // the JSON parameters compiled for matching entities, only recompiled when the parameters change
+    // this can only be called from the OctreeSendThread for the given Node
+    const EntityQueryFilter& getQueryFilter(const QJsonObject& jsonParameters);
+
 private:
     quint64 _lastDeletedEntitiesSentAt { usecTimestampNow() };
     QSet<QUuid> _sentFilteredEntities;
     QHash<QUuid, QSet<QUuid>> _flaggedExtraEntities;
     QHash<QUuid, QSet<QUuid>> _previousFlaggedExtraEntities;
+    QJsonObject _queryFilterParameters;
+    EntityQueryFilter _queryFilter;
 };
 
 #endif // hifi_EntityNodeData_h
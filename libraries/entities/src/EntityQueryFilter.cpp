@@ -0,0 +1,44 @@
+//
+//  EntityQueryFilter.cpp
+//  libraries/entities/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityQueryFilter.h"
+
+#include "EntityNodeData.h"
+#include "EntityTree.h"
+
+static const QString ENTITY_TYPE_PROPERTY = "type";
+static const QString AVATAR_PRIORITY_PROPERTY = "avatarPriority";
+
+EntityQueryFilter::EntityQueryFilter(const QJsonObject& jsonFilters) :
+    _isEmpty(jsonFilters.isEmpty())
+{
+    _wantsAvatarPriorityZones = jsonFilters[AVATAR_PRIORITY_PROPERTY].toBool();
+
+    // keys are iterated in order, and the first property test found decides
+    for (auto it = jsonFilters.constBegin(); it != jsonFilters.constEnd(); ++it) {
+        if (it.key() == EntityJSONQueryProperties::SERVER_SCRIPTS_PROPERTY &&
+            it.value() == QJsonValue(EntityQueryFilterSymbol::NonDefault)) {
+            _propertyTest = PropertyTest::NonDefaultServerScripts;
+            break;
+        } else if (it.key() == ENTITY_TYPE_PROPERTY) {
+            _propertyTest = PropertyTest::NoMatch;
+            if (it.value().isString()) {
+                // a name that doesn't map back to itself, like a misspelled type, can't match any entity
+                QString typeName = it.value().toString();
+                EntityTypes::EntityType type = EntityTypes::getEntityTypeFromName(typeName);
+                if (EntityTypes::getEntityTypeName(type) == typeName) {
+                    _propertyTest = PropertyTest::Type;
+                    _type = type;
+                }
+            }
+            break;
+        }
+    }
+}
@@ -0,0 +1,49 @@
+//
+//  EntityQueryFilter.h
+//  libraries/entities/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityQueryFilter_h
+#define hifi_EntityQueryFilter_h
+
+#include <QtCore/QJsonObject>
+
+#include "EntityTypes.h"
+
+// The JSON filter of an entity query, compiled once into the tests that EntityItem::matchesQueryFilter() runs per entity.
+//
+// The filter syntax is the one matchesJSONFilters() has always handled: the first of "serverScripts": "+" or "type"
+// found in key order decides the match, zones also match { "avatarPriority": true } when they set either mode, and
+// anything else matches every entity.
+class EntityQueryFilter {
+public:
+    enum class PropertyTest : uint8_t {
+        None,
+        NonDefaultServerScripts,
+        Type,
+        NoMatch // a "type" that isn't a string, or isn't the name of an entity type
+    };
+
+    EntityQueryFilter() { }
+    EntityQueryFilter(const QJsonObject& jsonFilters);
+
+    // no parameters at all, every entity matches without being explicitly filtered in
+    bool isEmpty() const { return _isEmpty; }
+
+    PropertyTest getPropertyTest() const { return _propertyTest; }
+    EntityTypes::EntityType getType() const { return _type; }
+    bool wantsAvatarPriorityZones() const { return _wantsAvatarPriorityZones; }
+
+private:
+    bool _isEmpty { true };
+    PropertyTest _propertyTest { PropertyTest::None };
+    EntityTypes::EntityType _type { EntityTypes::Unknown };
+    bool _wantsAvatarPriorityZones { false };
+};
+
+#endif // hifi_EntityQueryFilter_h
@@ -84,6 +84,7 @@ OctreeElementPointer EntityTree::createNewElement(unsigned char* octalCode) {
 
 void EntityTree::eraseDomainAndNonOwnedEntities() {
     emit clearingEntities();
+    journalClearedEntities();
 
     if (_simulation) {
         // local-entities are not in the simulation, so we clear ALL
@@ -135,6 +136,7 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
 
 void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     emit clearingEntities();
+    journalClearedEntities();
 
     if (_simulation) {
         _simulation->clearEntities();
@@ -305,6 +307,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
+    journalChangedEntity(entity->getEntityItemID());
 
     // find and hook up any entities with this entity as a (previously) missing parent
     fixupNeedsParentFixups();
@@ -371,6 +374,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                     emit editingEntityPointer(entity);
                 }
                 _isDirty = true;
+                journalChangedEntity(entity->getEntityItemID());
             }
         }
     } else {
@@ -506,6 +510,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
         }
 
         _isDirty = true;
+        journalChangedEntity(entity->getEntityItemID());
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -745,6 +750,7 @@ void EntityTree::deleteEntitiesByPointer(const std::vector<EntityItemPointer>& e
     for (auto entity : entities) {
         if (entity->getElement()) {
             theOperator.addEntityToDeleteList(entity);
+            journalDeletedEntity(entity->getEntityItemID());
             emit deletingEntity(entity->getID());
             emit deletingEntityPointer(entity.get());
         }
@@ -1808,8 +1814,6 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     }
 
     int processedBytes = 0;
-    bool isAdd = false;
-    bool isClone = false;
     // we handle these types of "edit" packets
     switch (message.getType()) {
         case PacketType::EntityErase: {
@@ -1819,314 +1823,417 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
         }
 
         case PacketType::EntityClone:
-            isClone = true; // fall through to next case
-            // FALLTHRU
         case PacketType::EntityAdd:
-            isAdd = true;  // fall through to next case
-            // FALLTHRU
         case PacketType::EntityPhysics:
         case PacketType::EntityEdit: {
-            quint64 startDecode = 0, endDecode = 0;
-            quint64 startLookup = 0, endLookup = 0;
-            quint64 startUpdate = 0, endUpdate = 0;
-            quint64 startCreate = 0, endCreate = 0;
-            quint64 startFilter = 0, endFilter = 0;
-            quint64 startLogging = 0, endLogging = 0;
-
-            bool suppressDisallowedClientScript = false;
-            bool suppressDisallowedServerScript = false;
-            bool suppressDisallowedPrivateUserData = false;
-            bool isPhysics = message.getType() == PacketType::EntityPhysics;
-
-            _totalEditMessages++;
-
-            EntityItemID entityItemID;
-            EntityItemProperties properties;
-            startDecode = usecTimestampNow();
-
-            bool validEditPacket = false;
-            EntityItemID entityIDToClone;
-            EntityItemPointer entityToClone;
-            if (isClone) {
-                QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
-                validEditPacket = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, entityIDToClone, entityItemID);
-                if (validEditPacket) {
-                    entityToClone = findEntityByEntityItemID(entityIDToClone);
-                    if (entityToClone) {
-                        properties = entityToClone->getProperties();
-                    }
-                }
-            } else {
-                validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, entityItemID, properties);
-            }
+            EntityDecodedEdit edit;
+            processedBytes = decodeEntityEdit(message.getType(), editData, maxLength, senderNode, edit);
+            applyEntityEdit(edit);
+            break;
+        }
+
+        default:
+            processedBytes = 0;
+            break;
+    }
+    return processedBytes;
+}
 
-            endDecode = usecTimestampNow();
 
-            EntityItemPointer existingEntity;
-            if (!isAdd) {
-                // search for the entity by EntityItemID
-                startLookup = usecTimestampNow();
-                existingEntity = findEntityByEntityItemID(entityItemID);
-                endLookup = usecTimestampNow();
-                if (!existingEntity) {
-                    // this is not an add-entity operation, and we don't know about the identified entity.
-                    validEditPacket = false;
-                }
+bool EntityTree::decodesEditPacketType(PacketType packetType) const {
+    // erases are applied as they come, they are small and don't go through the edit filters
+    switch (packetType) {
+        case PacketType::EntityClone:
+        case PacketType::EntityAdd:
+        case PacketType::EntityPhysics:
+        case PacketType::EntityEdit:
+            return true;
+        default:
+            return false;
+    }
+}
+
+int EntityTree::decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                     const SharedNodePointer& senderNode, OctreeDecodedEditPointer& decodedEdit) {
+    if (!getIsServer() || !decodesEditPacketType(message.getType())) {
+        return 0;
+    }
+
+    std::unique_ptr<EntityDecodedEdit> edit(new EntityDecodedEdit());
+    int processedBytes = decodeEntityEdit(message.getType(), editData, maxLength, senderNode, *edit);
+    decodedEdit = std::move(edit);
+    return processedBytes;
+}
+
+// runs the edit filters on the edits of the batch in parallel, before the tree is locked to apply them
+void EntityTree::prepareDecodedEdits(std::vector<OctreeDecodedEditPointer>& decodedEdits) {
+    if (!DependencyManager::isSet<EntityEditFilters>()) {
+        return;
+    }
+    auto entityEditFilters = DependencyManager::get<EntityEditFilters>();
+    if (!entityEditFilters->hasFilters()) {
+        return;
+    }
+
+    std::vector<EntityDecodedEdit*> filteredEdits;
+    std::vector<EntityEditFilters::FilterRequest> requests;
+    for (auto& decodedEdit : decodedEdits) {
+        auto& edit = static_cast<EntityDecodedEdit&>(*decodedEdit);
+        bool isAdd = edit.type == PacketType::EntityAdd;
+        bool isPhysics = edit.type == PacketType::EntityPhysics;
+
+        // clones are filtered once the entity they clone is looked up, and (un)lock rights bypass the filter
+        if (!edit.isValid || edit.type == PacketType::EntityClone || (!isPhysics && edit.senderNode->isAllowedEditor())) {
+            continue;
+        }
+
+        EntityItemPointer existingEntity;
+        if (!isAdd) {
+            existingEntity = findEntityByEntityItemID(edit.entityItemID);
+            if (!existingEntity) {
+                continue; // rejected when applied
             }
+        }
 
-            if (validEditPacket && !_entityScriptSourceWhitelist.isEmpty()) {
+        EntityEditFilters::FilterRequest request;
+        request.position = existingEntity ? existingEntity->getWorldPosition() : edit.properties.getPosition();
+        request.propertiesIn = &edit.properties;
+        request.propertiesOut = &edit.properties;
+        request.filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
+        request.entityID = existingEntity ? existingEntity->getEntityItemID() : EntityItemID();
+        request.existingEntity = existingEntity;
+        requests.push_back(request);
+        filteredEdits.push_back(&edit);
+    }
 
-                bool wasDeletedBecauseOfClientScript = false;
+    entityEditFilters->filterBatch(requests);
 
-                // check the client entity script to make sure its URL is in the whitelist
-                if (!properties.getScript().isEmpty()) {
-                    bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        filteredEdits[i]->isFiltered = true;
+        filteredEdits[i]->isAcceptedByFilters = requests[i].accepted;
+        filteredEdits[i]->wasChangedByFilters = requests[i].wasChanged;
+    }
+}
 
-                    if (!clientScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set entity script not on whitelist, edit rejected";
-                        }
+// NOTE: Caller must lock the tree before calling this.
+void EntityTree::applyDecodedEdit(OctreeDecodedEdit& decodedEdit) {
+    applyEntityEdit(static_cast<EntityDecodedEdit&>(decodedEdit));
+}
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                            validEditPacket = false;
-                            wasDeletedBecauseOfClientScript = true;
-                        } else {
-                            suppressDisallowedClientScript = true;
-                        }
-                    }
-                }
+// only reads the packet and the rights of the sender, so that it can be called without the tree lock
+int EntityTree::decodeEntityEdit(PacketType type, const unsigned char* editData, int maxLength,
+                                 const SharedNodePointer& senderNode, EntityDecodedEdit& edit) {
+    int processedBytes = 0;
+    edit.type = type;
+    edit.senderNode = senderNode;
 
-                // check all server entity scripts to make sure their URLs are in the whitelist
-                if (!properties.getServerScripts().isEmpty()) {
-                    bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+    _totalEditMessages++;
 
-                    if (!serverScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set server entity script not on whitelist, edit rejected";
-                        }
+    quint64 startDecode = usecTimestampNow();
+    if (type == PacketType::EntityClone) {
+        QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
+        edit.isValid = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, edit.entityIDToClone, edit.entityItemID);
+    } else {
+        edit.isValid = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, edit.entityItemID, edit.properties);
+    }
+    _totalDecodeTime += usecTimestampNow() - startDecode;
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            // Make sure we didn't already need to send back a delete because the client script failed
-                            // the whitelist check
-                            if (!wasDeletedBecauseOfClientScript) {
-                                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                                validEditPacket = false;
-                            }
-                        } else {
-                            suppressDisallowedServerScript = true;
-                        }
-                    }
-                }
-            }
+    // the properties of a clone are those of the entity it clones, only known once it is looked up in the tree
+    if (type != PacketType::EntityClone) {
+        validateEntityEdit(edit);
+    }
+    return processedBytes;
+}
+
+void EntityTree::validateEntityEdit(EntityDecodedEdit& edit) {
+    bool isClone = edit.type == PacketType::EntityClone;
+    bool isAdd = isClone || edit.type == PacketType::EntityAdd;
+    const SharedNodePointer& senderNode = edit.senderNode;
+    const EntityItemID& entityItemID = edit.entityItemID;
+    EntityItemProperties& properties = edit.properties;
+
+    if (edit.isValid && !_entityScriptSourceWhitelist.isEmpty()) {
+
+        bool wasDeletedBecauseOfClientScript = false;
 
-            if (!properties.getPrivateUserData().isEmpty() && validEditPacket && !senderNode->getCanGetAndSetPrivateUserData()) {
+        // check the client entity script to make sure its URL is in the whitelist
+        if (!properties.getScript().isEmpty()) {
+            bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
+
+            if (!clientScriptPassedWhitelist) {
                 if (wantEditLogging()) {
                     qCDebug(entities) << "User [" << senderNode->getUUID()
-                        << "] is attempting to set private user data but user isn't allowed; edit rejected...";
+                        << "] attempting to set entity script not on whitelist, edit rejected";
                 }
 
                 // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
                 if (isAdd) {
                     QWriteLocker locker(&_recentlyDeletedEntitiesLock);
                     _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    validEditPacket = false;
+                    edit.isValid = false;
+                    wasDeletedBecauseOfClientScript = true;
                 } else {
-                    suppressDisallowedPrivateUserData = true;
+                    edit.suppressDisallowedClientScript = true;
                 }
             }
+        }
 
-            if (!isClone) {
-                if ((isAdd || properties.lifetimeChanged()) &&
-                    ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
-                    (!senderNode->getCanRezCertified() && senderNode->getCanRezTmpCertified()))) {
-                    // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
-                    if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
-                        properties.getLifetime() > _maxTmpEntityLifetime) {
-                        properties.setLifetime(_maxTmpEntityLifetime);
-                        bumpTimestamp(properties);
-                    }
+        // check all server entity scripts to make sure their URLs are in the whitelist
+        if (!properties.getServerScripts().isEmpty()) {
+            bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+
+            if (!serverScriptPassedWhitelist) {
+                if (wantEditLogging()) {
+                    qCDebug(entities) << "User [" << senderNode->getUUID()
+                        << "] attempting to set server entity script not on whitelist, edit rejected";
                 }
 
-                if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
-                    // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
-                    // clear the locked property and allow the unlocked entity to be created.
-                    properties.setLocked(false);
-                    bumpTimestamp(properties);
+                // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+                if (isAdd) {
+                    // Make sure we didn't already need to send back a delete because the client script failed
+                    // the whitelist check
+                    if (!wasDeletedBecauseOfClientScript) {
+                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+                        edit.isValid = false;
+                    }
+                } else {
+                    edit.suppressDisallowedServerScript = true;
                 }
             }
+        }
+    }
 
-            // If we got a valid edit packet, then it could be a new entity or it could be an update to
-            // an existing entity... handle appropriately
-            if (validEditPacket) {
-                startFilter = usecTimestampNow();
-                bool wasChanged = false;
-                // Having (un)lock rights bypasses the filter, unless it's a physics result.
-                FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
-                bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
-                if (!allowed) {
-                    // the update failed and we need to convey that fact to the sender
-                    // our method is to re-assert the current properties and bump the lastEdited timestamp
-                    auto timestamp = properties.getLastEdited();
-                    properties = EntityItemProperties();
-                    properties.setLastEdited(timestamp);
-                }
-                if (!allowed || wasChanged) {
-                    bumpTimestamp(properties);
-                    // For now, free ownership on any modification.
-                    properties.clearSimulationOwner();
-                }
-                endFilter = usecTimestampNow();
+    if (!properties.getPrivateUserData().isEmpty() && edit.isValid && !senderNode->getCanGetAndSetPrivateUserData()) {
+        if (wantEditLogging()) {
+            qCDebug(entities) << "User [" << senderNode->getUUID()
+                << "] is attempting to set private user data but user isn't allowed; edit rejected...";
+        }
 
-                if (existingEntity && !isAdd) {
+        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+        if (isAdd) {
+            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+            edit.isValid = false;
+        } else {
+            edit.suppressDisallowedPrivateUserData = true;
+        }
+    }
 
-                    if (suppressDisallowedClientScript) {
-                        bumpTimestamp(properties);
-                        properties.setScript(existingEntity->getScript());
-                    }
+    if (!isClone) {
+        if ((isAdd || properties.lifetimeChanged()) &&
+            ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
+            (!senderNode->getCanRezCertified() && senderNode->getCanRezTmpCertified()))) {
+            // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
+            if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
+                properties.getLifetime() > _maxTmpEntityLifetime) {
+                properties.setLifetime(_maxTmpEntityLifetime);
+                bumpTimestamp(properties);
+            }
+        }
 
-                    if (suppressDisallowedServerScript) {
-                        bumpTimestamp(properties);
-                        properties.setServerScripts(existingEntity->getServerScripts());
-                    }
+        if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
+            // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
+            // clear the locked property and allow the unlocked entity to be created.
+            properties.setLocked(false);
+            bumpTimestamp(properties);
+        }
+    }
+}
 
-                    if (suppressDisallowedPrivateUserData) {
-                        bumpTimestamp(properties);
-                        properties.setPrivateUserData(existingEntity->getPrivateUserData());
+// NOTE: Caller must lock the tree before calling this.
+void EntityTree::applyEntityEdit(EntityDecodedEdit& edit) {
+    quint64 startLookup = 0, endLookup = 0;
+    quint64 startUpdate = 0, endUpdate = 0;
+    quint64 startCreate = 0, endCreate = 0;
+    quint64 startFilter = 0, endFilter = 0;
+    quint64 startLogging = 0, endLogging = 0;
+
+    bool isClone = edit.type == PacketType::EntityClone;
+    bool isAdd = isClone || edit.type == PacketType::EntityAdd;
+    bool isPhysics = edit.type == PacketType::EntityPhysics;
+    const SharedNodePointer& senderNode = edit.senderNode;
+    const EntityItemID& entityItemID = edit.entityItemID;
+    const EntityItemID& entityIDToClone = edit.entityIDToClone;
+    EntityItemProperties& properties = edit.properties;
+
+    EntityItemPointer entityToClone;
+    EntityItemPointer existingEntity;
+    if (edit.isValid) {
+        // search for the entity by EntityItemID
+        startLookup = usecTimestampNow();
+        if (isClone) {
+            entityToClone = findEntityByEntityItemID(entityIDToClone);
+        } else if (!isAdd) {
+            existingEntity = findEntityByEntityItemID(entityItemID);
+        }
+        endLookup = usecTimestampNow();
+
+        if (isClone) {
+            if (entityToClone) {
+                properties = entityToClone->getProperties();
+            }
+            validateEntityEdit(edit);
+        } else if (!isAdd && !existingEntity) {
+            // this is not an add-entity operation, and we don't know about the identified entity.
+            edit.isValid = false;
+        }
+    }
+
+    // If we got a valid edit packet, then it could be a new entity or it could be an update to
+    // an existing entity... handle appropriately
+    if (edit.isValid) {
+        startFilter = usecTimestampNow();
+        bool wasChanged = edit.wasChangedByFilters;
+        // Having (un)lock rights bypasses the filter, unless it's a physics result.
+        FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
+        bool allowed = (!isPhysics && senderNode->isAllowedEditor()) ||
+            (edit.isFiltered ? edit.isAcceptedByFilters : filterProperties(existingEntity, properties, properties, wasChanged, filterType));
+        if (!allowed) {
+            // the update failed and we need to convey that fact to the sender
+            // our method is to re-assert the current properties and bump the lastEdited timestamp
+            auto timestamp = properties.getLastEdited();
+            properties = EntityItemProperties();
+            properties.setLastEdited(timestamp);
+        }
+        if (!allowed || wasChanged) {
+            bumpTimestamp(properties);
+            // For now, free ownership on any modification.
+            properties.clearSimulationOwner();
+        }
+        endFilter = usecTimestampNow();
+
+        if (existingEntity && !isAdd) {
+
+            if (edit.suppressDisallowedClientScript) {
+                bumpTimestamp(properties);
+                properties.setScript(existingEntity->getScript());
+            }
+
+            if (edit.suppressDisallowedServerScript) {
+                bumpTimestamp(properties);
+                properties.setServerScripts(existingEntity->getServerScripts());
+            }
+
+            if (edit.suppressDisallowedPrivateUserData) {
+                bumpTimestamp(properties);
+                properties.setPrivateUserData(existingEntity->getPrivateUserData());
+            }
+
+            // if the EntityItem exists, then update it
+            startLogging = usecTimestampNow();
+            if (wantEditLogging()) {
+                qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                qCDebug(entities) << "   properties:" << properties;
+            }
+            if (wantTerseEditLogging()) {
+                QList<QString> changedProperties = properties.listChangedProperties();
+                fixupTerseEditLogging(properties, changedProperties);
+                qCDebug(entities) << senderNode->getUUID() << "edit" <<
+                    existingEntity->getDebugName() << changedProperties;
+            }
+            endLogging = usecTimestampNow();
+
+            startUpdate = usecTimestampNow();
+            if (!isPhysics) {
+                properties.setLastEditedBy(senderNode->getUUID());
+            }
+            updateEntity(existingEntity, properties, senderNode);
+            existingEntity->markAsChangedOnServer();
+            endUpdate = usecTimestampNow();
+            _totalUpdates++;
+        } else if (isAdd) {
+            bool failedAdd = !allowed;
+            bool isCertified = !properties.getCertificateID().isEmpty();
+            bool isCloneable = properties.getCloneable();
+            int cloneLimit = properties.getCloneLimit();
+            if (!allowed) {
+                qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
+            } else if (!isClone && !isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
+                failedAdd = true;
+                qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
+                    << "] attempted to add an uncertified entity with ID:" << entityItemID;
+            } else if (!isClone && isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
+                failedAdd = true;
+                qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
+                    << "] attempted to add a certified entity with ID:" << entityItemID;
+            } else if (isClone && isCertified && !properties.getCertificateType().contains(DOMAIN_UNLIMITED)) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone certified entity from entity ID:" << entityIDToClone;
+            } else if (isClone && !isCloneable) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
+            } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
+            } else {
+                if (isClone) {
+                    properties.convertToCloneProperties(entityIDToClone);
+                }
+
+                // this is a new entity... assign a new entityID
+                properties.setLastEditedBy(senderNode->getUUID());
+                startCreate = usecTimestampNow();
+                EntityItemPointer newEntity = addEntity(entityItemID, properties);
+                endCreate = usecTimestampNow();
+                _totalCreates++;
+
+                if (newEntity && isCertified && getIsServer()) {
+                    if (!properties.verifyStaticCertificateProperties()) {
+                        qCDebug(entities) << "User" << senderNode->getUUID()
+                            << "attempted to add a certified entity with ID" << entityItemID << "which failed"
+                            << "static certificate verification.";
+                        // Delete the entity we just added if it doesn't pass static certificate verification
+                        deleteEntity(entityItemID, true);
+                    } else {
+                        validatePop(properties.getCertificateID(), entityItemID, senderNode);
                     }
+                }
+
+                if (newEntity && isClone) {
+                    entityToClone->addCloneID(newEntity->getEntityItemID());
+                    newEntity->setCloneOriginID(entityIDToClone);
+                }
 
-                    // if the EntityItem exists, then update it
+                if (newEntity) {
+                    newEntity->markAsChangedOnServer();
+                    notifyNewlyCreatedEntity(*newEntity, senderNode);
+                    
                     startLogging = usecTimestampNow();
                     if (wantEditLogging()) {
-                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
+                                          << newEntity->getEntityItemID();
                         qCDebug(entities) << "   properties:" << properties;
                     }
                     if (wantTerseEditLogging()) {
                         QList<QString> changedProperties = properties.listChangedProperties();
                         fixupTerseEditLogging(properties, changedProperties);
-                        qCDebug(entities) << senderNode->getUUID() << "edit" <<
-                            existingEntity->getDebugName() << changedProperties;
+                        qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
                     }
                     endLogging = usecTimestampNow();
 
-                    startUpdate = usecTimestampNow();
-                    if (!isPhysics) {
-                        properties.setLastEditedBy(senderNode->getUUID());
-                    }
-                    updateEntity(existingEntity, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
-                    endUpdate = usecTimestampNow();
-                    _totalUpdates++;
-                } else if (isAdd) {
-                    bool failedAdd = !allowed;
-                    bool isCertified = !properties.getCertificateID().isEmpty();
-                    bool isCloneable = properties.getCloneable();
-                    int cloneLimit = properties.getCloneLimit();
-                    if (!allowed) {
-                        qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
-                    } else if (!isClone && !isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add an uncertified entity with ID:" << entityItemID;
-                    } else if (!isClone && isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add a certified entity with ID:" << entityItemID;
-                    } else if (isClone && isCertified && !properties.getCertificateType().contains(DOMAIN_UNLIMITED)) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone certified entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && !isCloneable) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
-                    } else {
-                        if (isClone) {
-                            properties.convertToCloneProperties(entityIDToClone);
-                        }
-
-                        // this is a new entity... assign a new entityID
-                        properties.setLastEditedBy(senderNode->getUUID());
-                        startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
-                        endCreate = usecTimestampNow();
-                        _totalCreates++;
-
-                        if (newEntity && isCertified && getIsServer()) {
-                            if (!properties.verifyStaticCertificateProperties()) {
-                                qCDebug(entities) << "User" << senderNode->getUUID()
-                                    << "attempted to add a certified entity with ID" << entityItemID << "which failed"
-                                    << "static certificate verification.";
-                                // Delete the entity we just added if it doesn't pass static certificate verification
-                                deleteEntity(entityItemID, true);
-                            } else {
-                                validatePop(properties.getCertificateID(), entityItemID, senderNode);
-                            }
-                        }
-
-                        if (newEntity && isClone) {
-                            entityToClone->addCloneID(newEntity->getEntityItemID());
-                            newEntity->setCloneOriginID(entityIDToClone);
-                        }
-
-                        if (newEntity) {
-                            newEntity->markAsChangedOnServer();
-                            notifyNewlyCreatedEntity(*newEntity, senderNode);
-                            
-                            startLogging = usecTimestampNow();
-                            if (wantEditLogging()) {
-                                qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
-                                                  << newEntity->getEntityItemID();
-                                qCDebug(entities) << "   properties:" << properties;
-                            }
-                            if (wantTerseEditLogging()) {
-                                QList<QString> changedProperties = properties.listChangedProperties();
-                                fixupTerseEditLogging(properties, changedProperties);
-                                qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
-                            }
-                            endLogging = usecTimestampNow();
-
-                        } else {
-                            failedAdd = true;
-                            qCDebug(entities) << "Add entity failed ID:" << entityItemID;
-                        }
-                    }
-                    if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
-                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    }
                 } else {
-                    HIFI_FCDEBUG(entities(), "Edit failed. [" << message.getType() <<"] " <<
-                            "entity id:" << entityItemID << 
-                            "existingEntity pointer:" << existingEntity.get());
+                    failedAdd = true;
+                    qCDebug(entities) << "Add entity failed ID:" << entityItemID;
                 }
             }
-
-
-            _totalDecodeTime += endDecode - startDecode;
-            _totalLookupTime += endLookup - startLookup;
-            _totalUpdateTime += endUpdate - startUpdate;
-            _totalCreateTime += endCreate - startCreate;
-            _totalLoggingTime += endLogging - startLogging;
-            _totalFilterTime += endFilter - startFilter;
-
-            break;
+            if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
+                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+            }
+        } else {
+            HIFI_FCDEBUG(entities(), "Edit failed. [" << edit.type <<"] " <<
+                    "entity id:" << entityItemID << 
+                    "existingEntity pointer:" << existingEntity.get());
         }
-
-        default:
-            processedBytes = 0;
-            break;
     }
-    return processedBytes;
-}
 
+    _totalLookupTime += endLookup - startLookup;
+    _totalUpdateTime += endUpdate - startUpdate;
+    _totalCreateTime += endCreate - startCreate;
+    _totalLoggingTime += endLogging - startLogging;
+    _totalFilterTime += endFilter - startFilter;
+}
 
 void EntityTree::notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode) {
     _newlyCreatedHooksLock.lockForRead();
@@ -3172,6 +3279,161 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
     return success;
 }
 
+void EntityTree::setJournalingEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(_journalLock);
+    _isJournaling = enabled;
+    _journalNeedsSnapshot = false;
+    _journalChangedIDs.clear();
+    _journalDeletedIDs.clear();
+}
+
+void EntityTree::journalChangedEntity(const EntityItemID& id) {
+    std::lock_guard<std::mutex> lock(_journalLock);
+    if (_isJournaling) {
+        _journalDeletedIDs.remove(id);
+        _journalChangedIDs.insert(id);
+    }
+}
+
+void EntityTree::journalDeletedEntity(const EntityItemID& id) {
+    std::lock_guard<std::mutex> lock(_journalLock);
+    if (_isJournaling) {
+        _journalChangedIDs.remove(id);
+        _journalDeletedIDs.insert(id);
+    }
+}
+
+void EntityTree::journalClearedEntities() {
+    std::lock_guard<std::mutex> lock(_journalLock);
+    if (_isJournaling) {
+        // wiping the tree is cheaper to persist as a snapshot than as a delete per entity
+        _journalNeedsSnapshot = true;
+        _journalChangedIDs.clear();
+        _journalDeletedIDs.clear();
+    }
+}
+
+void EntityTree::clearJournalChanges() {
+    std::lock_guard<std::mutex> lock(_journalLock);
+    _journalNeedsSnapshot = false;
+    _journalChangedIDs.clear();
+    _journalDeletedIDs.clear();
+}
+
+bool EntityTree::takeJournalRecords(std::vector<OctreeJournal::Record>& records) {
+    QSet<EntityItemID> changedIDs;
+    QSet<EntityItemID> deletedIDs;
+    {
+        std::lock_guard<std::mutex> lock(_journalLock);
+        if (!_isJournaling || _journalNeedsSnapshot) {
+            return false;
+        }
+        changedIDs.swap(_journalChangedIDs);
+        deletedIDs.swap(_journalDeletedIDs);
+    }
+
+    for (const auto& id : deletedIDs) {
+        records.push_back({ OctreeJournal::Operation::Delete, id, QByteArray() });
+    }
+
+    if (changedIDs.isEmpty()) {
+        return true;
+    }
+
+    // entities are journaled the same way writeToMap() saves them in a snapshot
+    QScriptEngine scriptEngine;
+    QSet<EntityItemID> unresolvedIDs;
+    withReadLock([&] {
+        for (const auto& id : changedIDs) {
+            EntityItemPointer entity = findEntityByEntityItemID(id);
+            if (!entity) {
+                // deleted since, the delete will be in the next batch
+                continue;
+            }
+            if (!entity->isParentIDValid()) {
+                // like snapshots, wait for the parent to be known before saving the entity
+                unresolvedIDs.insert(id);
+                continue;
+            }
+
+            QVariantMap entityMap = EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, entity->getProperties()).toVariant().toMap();
+            QByteArray payload;
+            QDataStream stream(&payload, QIODevice::WriteOnly);
+            stream << entityMap;
+            records.push_back({ OctreeJournal::Operation::Upsert, id, payload });
+        }
+    });
+
+    if (!unresolvedIDs.isEmpty()) {
+        std::lock_guard<std::mutex> lock(_journalLock);
+        for (const auto& id : unresolvedIDs) {
+            if (!_journalDeletedIDs.contains(id)) {
+                _journalChangedIDs.insert(id);
+            }
+        }
+    }
+    return true;
+}
+
+bool EntityTree::applyJournalRecords(const std::vector<OctreeJournal::Record>& records) {
+    // only the last record of each entity matters
+    QHash<EntityItemID, const OctreeJournal::Record*> lastRecords;
+    for (const auto& record : records) {
+        lastRecords[EntityItemID(record.id)] = &record;
+    }
+
+    // journaled entities are replaced as a whole, so that properties back to their defaults are reset as well
+    std::vector<EntityItemPointer> entitiesToDelete;
+    for (auto it = lastRecords.cbegin(); it != lastRecords.cend(); ++it) {
+        EntityItemPointer entity = findEntityByEntityItemID(it.key());
+        if (entity) {
+            entitiesToDelete.push_back(entity);
+        }
+    }
+    if (!entitiesToDelete.empty()) {
+        deleteEntitiesByPointer(entitiesToDelete);
+    }
+
+    QScriptEngine scriptEngine;
+    bool success = true;
+    for (auto it = lastRecords.cbegin(); it != lastRecords.cend(); ++it) {
+        const OctreeJournal::Record& record = *it.value();
+        if (record.operation != OctreeJournal::Operation::Upsert) {
+            continue;
+        }
+
+        QVariantMap entityMap;
+        QDataStream stream(record.payload);
+        stream >> entityMap;
+        if (stream.status() != QDataStream::Ok) {
+            qCDebug(entities) << "Failed to decode journaled entity" << it.key();
+            success = false;
+            continue;
+        }
+
+        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+        EntityItemProperties properties;
+        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+
+        EntityItemPointer entity = addEntity(it.key(), properties);
+        if (!entity) {
+            qCDebug(entities) << "adding journaled Entity failed:" << it.key() << properties.getType();
+            success = false;
+            continue;
+        }
+
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            EntityItemPointer cloneOrigin = findEntityByID(cloneOriginID);
+            if (cloneOrigin) {
+                cloneOrigin->addCloneID(entity->getEntityItemID());
+            }
+        }
+    }
+
+    return success;
+}
+
 bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
     QScriptEngine scriptEngine;
     RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
@@ -46,6 +46,24 @@ public:
     QHash<EntityItemID, EntityItemID>* map;
 };
 
+// An entity add, clone or edit read from an edit packet, with the result of the checks against the rights of its sender
+class EntityDecodedEdit : public OctreeDecodedEdit {
+public:
+    PacketType type { PacketType::Unknown };
+    SharedNodePointer senderNode;
+    EntityItemID entityItemID;
+    EntityItemID entityIDToClone;
+    EntityItemProperties properties;
+    bool isValid { false };
+    bool suppressDisallowedClientScript { false };
+    bool suppressDisallowedServerScript { false };
+    bool suppressDisallowedPrivateUserData { false };
+    // set when the edit went through the edit filters before the tree was locked
+    bool isFiltered { false };
+    bool isAcceptedByFilters { false };
+    bool wasChangedByFilters { false };
+};
+
 class EntityTree : public Octree, public SpatialParentTree {
     Q_OBJECT
 public:
@@ -90,6 +108,11 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual bool decodesEditPacketType(PacketType packetType) const override;
+    virtual int decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                     const SharedNodePointer& senderNode, OctreeDecodedEditPointer& decodedEdit) override;
+    virtual void prepareDecodedEdits(std::vector<OctreeDecodedEditPointer>& decodedEdits) override;
+    virtual void applyDecodedEdit(OctreeDecodedEdit& decodedEdit) override;
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
@@ -199,6 +222,11 @@ public:
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
 
+    virtual void setJournalingEnabled(bool enabled) override;
+    virtual bool takeJournalRecords(std::vector<OctreeJournal::Record>& records) override;
+    virtual void clearJournalChanges() override;
+    virtual bool applyJournalRecords(const std::vector<OctreeJournal::Record>& records) override;
+
 
     glm::vec3 getContentsDimensions();
     float getContentsLargestDimension();
@@ -308,6 +336,11 @@ protected:
 
     bool isScriptInWhitelist(const QString& scriptURL);
 
+    int decodeEntityEdit(PacketType type, const unsigned char* editData, int maxLength,
+                         const SharedNodePointer& senderNode, EntityDecodedEdit& edit);
+    void validateEntityEdit(EntityDecodedEdit& edit);
+    void applyEntityEdit(EntityDecodedEdit& edit);
+
     QReadWriteLock _newlyCreatedHooksLock;
     QVector<NewlyCreatedEntityHook*> _newlyCreatedHooks;
 
@@ -327,6 +360,17 @@ protected:
         _deletedEntityItemIDs << id;
     }
 
+    // server side changes since the last journal write, only tracked when persisting to a journal
+    void journalChangedEntity(const EntityItemID& id);
+    void journalDeletedEntity(const EntityItemID& id);
+    void journalClearedEntities();
+
+    std::mutex _journalLock;
+    bool _isJournaling { false };
+    bool _journalNeedsSnapshot { false };
+    QSet<EntityItemID> _journalChangedIDs;
+    QSet<EntityItemID> _journalDeletedIDs;
+
     mutable QReadWriteLock _entityMapLock;
     QHash<EntityItemID, EntityItemPointer> _entityMap;
 
@@ -469,17 +469,15 @@ void ZoneEntityItem::fetchCollisionGeometryResource() {
     }
 }
 
-bool ZoneEntityItem::matchesJSONFilters(const QJsonObject& jsonFilters) const {
+bool ZoneEntityItem::matchesQueryFilter(const EntityQueryFilter& filter) const {
     // currently the only property filter we handle in ZoneEntityItem is value of avatarPriority
 
-    static const QString AVATAR_PRIORITY_PROPERTY = "avatarPriority";
-
     // If set match zones of interest to avatar mixer:
-    if (jsonFilters.contains(AVATAR_PRIORITY_PROPERTY) && jsonFilters[AVATAR_PRIORITY_PROPERTY].toBool()
-        && (_avatarPriority != COMPONENT_MODE_INHERIT || _screenshare != COMPONENT_MODE_INHERIT)) {
+    if (filter.wantsAvatarPriorityZones() &&
+        (_avatarPriority != COMPONENT_MODE_INHERIT || _screenshare != COMPONENT_MODE_INHERIT)) {
         return true;
     }
 
     // Chain to base:
-    return EntityItem::matchesJSONFilters(jsonFilters);
+    return EntityItem::matchesQueryFilter(filter);
 }
@@ -346,6 +346,8 @@ public:
         KtxStorage(const storage::StoragePointer& storage);
         KtxStorage(const std::string& filename);
         KtxStorage(const cache::FilePointer& file);
+        // uses a descriptor of the file known beforehand, without parsing the file again
+        KtxStorage(const cache::FilePointer& file, const ktx::KTXDescriptor& descriptor);
         PixelsPointer getMipFace(uint16 level, uint8 face = 0) const override;
         Size getMipFaceSize(uint16 level, uint8 face = 0) const override;
         bool isMipAvailable(uint16 level, uint8 face = 0) const override;
@@ -548,6 +550,7 @@ public:
     void setKtxBacking(const storage::StoragePointer& storage);
     void setKtxBacking(const std::string& filename);
     void setKtxBacking(const cache::FilePointer& cacheEntry);
+    void setKtxBacking(const cache::FilePointer& cacheEntry, const ktx::KTXDescriptor& descriptor);
 
     // Usage is a a set of flags providing Semantic about the usage of the Texture.
     void setUsage(const Usage& usage) { _usage = usage; }
@@ -584,6 +587,7 @@ public:
     static TexturePointer build(const ktx::KTXDescriptor& descriptor);
     static TexturePointer unserialize(const std::string& ktxFile);
     static TexturePointer unserialize(const cache::FilePointer& cacheEntry, const std::string& source = std::string());
+    static TexturePointer unserialize(const cache::FilePointer& cacheEntry, const ktx::KTXDescriptor& descriptor, const std::string& source = std::string());
 
     static bool evalKTXFormat(const Element& mipFormat, const Element& texelFormat, ktx::Header& header);
     static bool evalTextureFormat(const ktx::Header& header, Element& mipFormat, Element& texelFormat);
@@ -216,6 +216,32 @@ KtxStorage::KtxStorage(const std::string& filename) : _filename(filename) {
     }
 }
 
+KtxStorage::KtxStorage(const cache::FilePointer& cacheEntry, const ktx::KTXDescriptor& descriptor) :
+    _filename(cacheEntry->getFilepath()),
+    _cacheEntry(cacheEntry) {
+    _ktxDescriptor.reset(new ktx::KTXDescriptor(descriptor));
+    if (_ktxDescriptor->images.size() < _ktxDescriptor->header.numberOfMipmapLevels) {
+        qWarning() << "Bad images found in ktx";
+    }
+
+    _offsetToMinMipKV = _ktxDescriptor->getValueOffsetForKey(ktx::HIFI_MIN_POPULATED_MIP_KEY);
+    _minMipLevelAvailable = 0;
+    if (_offsetToMinMipKV) {
+        // only the first page of the file gets read, the mips are mapped when they are requested
+        std::lock_guard<std::mutex> lock(*_cacheFileMutex);
+        auto file = maybeOpenFile();
+        if (file && file->size() > ktx::KTX_HEADER_SIZE + _offsetToMinMipKV) {
+            _minMipLevelAvailable = *(file->data() + ktx::KTX_HEADER_SIZE + _offsetToMinMipKV);
+        }
+    }
+
+    Format mipFormat = Format::COLOR_BGRA_32;
+    Format texelFormat = Format::COLOR_SRGBA_32;
+    if (Texture::evalTextureFormat(_ktxDescriptor->header, mipFormat, texelFormat)) {
+        _format = mipFormat;
+    }
+}
+
 // maybeOpenFile should be called with _cacheFileMutex already held to avoid modifying the file from multiple threads
 std::shared_ptr<storage::FileStorage> KtxStorage::maybeOpenFile() const {
     // Try to get the shared_ptr
@@ -351,6 +377,21 @@ bool validKtx(const std::string& filename) {
     return validKtx(storage);
 }
 
+// cheap check of a descriptor against the file it describes, in place of parsing the file
+bool validKtx(const cache::FilePointer& cacheEntry, const ktx::KTXDescriptor& descriptor) {
+    if (descriptor.images.size() < descriptor.header.numberOfMipmapLevels) {
+        return false;
+    }
+    for (const auto& image : descriptor.images) {
+        for (const auto& faceOffset : image._faceOffsets) {
+            if (faceOffset == 0 || faceOffset + image._faceSize > cacheEntry->getLength()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 void Texture::setKtxBacking(const storage::StoragePointer& storage) {
     // Check the KTX file for validity before using it as backing storage
     if (!validKtx(storage)) {
@@ -381,6 +422,15 @@ void Texture::setKtxBacking(const cache::FilePointer& cacheEntry) {
     setStorage(newBacking);
 }
 
+void Texture::setKtxBacking(const cache::FilePointer& cacheEntry, const ktx::KTXDescriptor& descriptor) {
+    if (!validKtx(cacheEntry, descriptor)) {
+        return;
+    }
+
+    auto newBacking = std::unique_ptr<Storage>(new KtxStorage(cacheEntry, descriptor));
+    setStorage(newBacking);
+}
+
 
 ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
     ktx::Header header;
@@ -589,6 +639,22 @@ TexturePointer Texture::unserialize(const cache::FilePointer& cacheEntry, const
     return texture;
 }
 
+TexturePointer Texture::unserialize(const cache::FilePointer& cacheEntry, const ktx::KTXDescriptor& descriptor, const std::string& source) {
+    if (!validKtx(cacheEntry, descriptor)) {
+        return nullptr;
+    }
+
+    auto texture = build(descriptor);
+    if (texture) {
+        texture->setKtxBacking(cacheEntry, descriptor);
+        if (texture->source().empty()) {
+            texture->setSource(source);
+        }
+    }
+
+    return texture;
+}
+
 TexturePointer Texture::unserialize(const std::string& ktxfile) {
     std::unique_ptr<ktx::KTX> ktxPointer = ktx::KTX::create(std::make_shared<storage::FileStorage>(ktxfile.c_str()));
     if (!ktxPointer) {
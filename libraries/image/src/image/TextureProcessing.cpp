@@ -13,7 +13,12 @@
 
 #include <glm/gtc/packing.hpp>
 
+#include <condition_variable>
+#include <mutex>
+
 #include <QtCore/QtGlobal>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QUrl>
 #include <QRgb>
 #include <QBuffer>
@@ -500,23 +505,93 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
     }
 };
 
+// the threads helping with compressions, shared by all of them
+static QThreadPool& getCompressionThreadPool() {
+    static QThreadPool threadPool;
+    return threadPool;
+}
+static std::atomic<int> textureCompressionThreadCount { QThread::idealThreadCount() };
+
+void setTextureCompressionThreadCount(int threadCount) {
+    textureCompressionThreadCount = std::max(threadCount, 0);
+    getCompressionThreadPool().setMaxThreadCount(std::max(threadCount, 1));
+}
+
+int getTextureCompressionThreadCount() {
+    return textureCompressionThreadCount;
+}
+
 #if defined(NVTT_API)
-class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
+// Spreads the tasks of a compression over the threads of a pool shared by all compressions. The calling thread runs
+// tasks too, and only gets help from the pool threads that are free, so it never waits on other compressions and
+// many textures compressed at once don't use more threads than the pool has.
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
     }
 
     const std::atomic<bool>& _abortProcessing;
 
     void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
-            if (!_abortProcessing.load()) {
-                task(context, i);
-            } else {
+        auto batch = std::make_shared<Batch>(task, context, count, _abortProcessing);
+
+        int numHelpers = std::min(count - 1, (int)textureCompressionThreadCount);
+        auto& threadPool = getCompressionThreadPool();
+        for (int i = 0; i < numHelpers; ++i) {
+            auto helper = new Helper(batch);
+            if (!threadPool.tryStart(helper)) {
+                delete helper;
                 break;
             }
         }
+
+        batch->run();
+        batch->wait();
     }
+
+private:
+    struct Batch {
+        Batch(nvtt::Task* task, void* context, int count, const std::atomic<bool>& abortProcessing) :
+            task(task), context(context), count(count), abortProcessing(abortProcessing) {}
+
+        // the task and its context can only be used while the dispatching thread waits, so a helper stops touching
+        // them as soon as there are no tasks left to pick up
+        void run() {
+            int index;
+            while ((index = nextIndex++) < count) {
+                if (!abortProcessing.load()) {
+                    task(context, index);
+                }
+                if (++numDone == count) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    condition.notify_all();
+                }
+            }
+        }
+
+        void wait() {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return numDone.load() == count; });
+        }
+
+        nvtt::Task* task;
+        void* context;
+        const int count;
+        const std::atomic<bool>& abortProcessing;
+        std::atomic<int> nextIndex { 0 };
+        std::atomic<int> numDone { 0 };
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    class Helper : public QRunnable {
+    public:
+        Helper(const std::shared_ptr<Batch>& batch) : _batch(batch) {}
+        void run() override { _batch->run(); }
+
+    private:
+        std::shared_ptr<Batch> _batch;
+    };
 };
 #endif
 
@@ -622,7 +697,7 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     surface.setAlphaMode(nvtt::AlphaMode_None);
     surface.setWrapMode(nvtt::WrapMode_Mirror);
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
+    ParallelTaskDispatcher dispatcher(abortProcessing);
     nvtt::Compressor compressor;
     context.setTaskDispatcher(&dispatcher);
 
@@ -759,8 +834,9 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
         MyErrorHandler errorHandler;
         outputOptions.setErrorHandler(&errorHandler);
 
-        SequentialTaskDispatcher dispatcher(abortProcessing);
+        ParallelTaskDispatcher dispatcher(abortProcessing);
         nvtt::Compressor context;
+        context.setTaskDispatcher(&dispatcher);
 
         context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
         if (buildMips) {
@@ -125,6 +125,11 @@ gpu::TexturePointer processImage(std::shared_ptr<QIODevice> content, const std::
                                  int maxNumPixels, TextureUsage::Type textureType,
                                  bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false);
 
+// The number of threads shared by all the textures being compressed at once, on top of the threads compressing them.
+// Defaults to the number of cores, 0 compresses each texture on its own thread only.
+void setTextureCompressionThreadCount(int threadCount);
+int getTextureCompressionThreadCount();
+
 void convertToTextureWithMips(gpu::Texture* texture, Image&& image, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false, int face = -1);
 void convertToTexture(gpu::Texture* texture, Image&& image, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false, int face = -1, int mipLevel = 0);
 
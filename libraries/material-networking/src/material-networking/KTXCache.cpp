@@ -11,7 +11,16 @@
 
 #include "KTXCache.h"
 
+#include <algorithm>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+
+#include <NumericalConstants.h>
 #include <SettingHandle.h>
+#include <shared/Storage.h>
 #include <ktx/KTX.h>
 
 using File = cache::File;
@@ -23,10 +32,84 @@ const int KTXCache::CURRENT_VERSION = 0x01;
 const int KTXCache::INVALID_VERSION = 0x00;
 const char* KTXCache::SETTING_VERSION_NAME = "hifi.ktx.cache_version";
 
+const int KTXCache::DEFAULT_MAX_SIZE_MB = 5 * 1024;
+const char* KTXCache::SETTING_MAX_SIZE_NAME = "hifi.ktx.cache_max_size_mb";
+
+const char* KTXCache::INDEX_FILENAME = "ktx_index";
+const quint32 KTXCache::INDEX_VERSION = 1;
+
+// the descriptor is written as the beginning of the KTX file, its header and key values, followed by the layout of its images
+static void writeDescriptor(QDataStream& stream, const ktx::KTXDescriptor& descriptor) {
+    QByteArray metadata(sizeof(ktx::Header) + ktx::KeyValue::serializedKeyValuesByteSize(descriptor.keyValues), 0);
+    memcpy(metadata.data(), &descriptor.header, sizeof(ktx::Header));
+    ktx::KTX::writeKeyValues(reinterpret_cast<ktx::Byte*>(metadata.data()) + sizeof(ktx::Header),
+                             metadata.size() - sizeof(ktx::Header), descriptor.keyValues);
+    stream << metadata;
+
+    stream << (quint32)descriptor.images.size();
+    for (const auto& image : descriptor.images) {
+        stream << (quint32)image._numFaces << (quint64)image._imageOffset << (quint32)image._faceSize << (quint32)image._padding;
+        for (const auto& faceOffset : image._faceOffsets) {
+            stream << (quint64)faceOffset;
+        }
+    }
+}
+
+static KTXCache::DescriptorPointer readDescriptor(QDataStream& stream) {
+    QByteArray metadata;
+    quint32 numImages { 0 };
+    stream >> metadata >> numImages;
+    auto metadataBytes = reinterpret_cast<const ktx::Byte*>(metadata.constData());
+    if (stream.status() != QDataStream::Ok || !ktx::KTX::checkHeaderFromStorage(metadata.size(), metadataBytes)) {
+        return nullptr;
+    }
+
+    ktx::Header header;
+    memcpy(&header, metadataBytes, sizeof(ktx::Header));
+    if ((size_t)metadata.size() != sizeof(ktx::Header) + header.bytesOfKeyValueData || numImages != header.getNumberOfLevels()) {
+        return nullptr;
+    }
+    auto keyValues = ktx::KTX::parseKeyValues(header.bytesOfKeyValueData, metadataBytes + sizeof(ktx::Header));
+
+    ktx::ImageDescriptors images;
+    for (quint32 i = 0; i < numImages; ++i) {
+        quint32 numFaces { 0 };
+        quint64 imageOffset { 0 };
+        quint32 faceSize { 0 };
+        quint32 padding { 0 };
+        stream >> numFaces >> imageOffset >> faceSize >> padding;
+        if (numFaces != 1 && numFaces != ktx::NUM_CUBEMAPFACES) {
+            return nullptr;
+        }
+
+        ktx::ImageHeader::FaceOffsets faceOffsets(numFaces);
+        for (auto& faceOffset : faceOffsets) {
+            quint64 offset { 0 };
+            stream >> offset;
+            faceOffset = offset;
+        }
+        images.emplace_back(ktx::ImageHeader(numFaces == ktx::NUM_CUBEMAPFACES, imageOffset, faceSize, padding), faceOffsets);
+    }
+    if (stream.status() != QDataStream::Ok) {
+        return nullptr;
+    }
+
+    return std::make_shared<const ktx::KTXDescriptor>(header, keyValues, images);
+}
+
 KTXCache::KTXCache(const std::string& dir, const std::string& ext) :
     FileCache(dir, ext) { }
 
+KTXCache::~KTXCache() {
+    saveIndex();
+}
+
 void KTXCache::initialize() {
+    // known before restoring the files, to evict the ones over budget in a single pass
+    Setting::Handle<int> maxSizeHandle(SETTING_MAX_SIZE_NAME, DEFAULT_MAX_SIZE_MB);
+    setMaxSize(MB_TO_BYTES(std::max(maxSizeHandle.get(), 0)));
+
+    loadIndex();
     FileCache::initialize();
     Setting::Handle<int> cacheVersionHandle(SETTING_VERSION_NAME, INVALID_VERSION);
     auto cacheVersion = cacheVersionHandle.get();
@@ -34,11 +117,131 @@ void KTXCache::initialize() {
         wipe();
         cacheVersionHandle.set(CURRENT_VERSION);
     }
+
+    // entries of files that are gone
+    std::lock_guard<std::mutex> lock(_indexMutex);
+    _persistedIndex.clear();
+    _isIndexLoaded = true;
+}
+
+std::string KTXCache::getIndexFilepath() const {
+    return getDirpath() + "/" + INDEX_FILENAME;
+}
+
+void KTXCache::loadIndex() {
+    QFile file(QString::fromStdString(getIndexFilepath()));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    quint32 version { 0 };
+    quint32 numEntries { 0 };
+    stream >> version >> numEntries;
+    if (version != INDEX_VERSION) {
+        return;
+    }
+
+    Index index;
+    for (quint32 i = 0; i < numEntries; ++i) {
+        QByteArray key;
+        quint64 length { 0 };
+        qint64 lastUsed { 0 };
+        stream >> key >> length >> lastUsed;
+
+        auto descriptor = readDescriptor(stream);
+        if (!descriptor) {
+            qCWarning(file_cache) << "Invalid KTX cache index, the cached files will be parsed again";
+            return;
+        }
+        index[key.toStdString()] = { (size_t)length, lastUsed, descriptor };
+    }
+
+    std::lock_guard<std::mutex> lock(_indexMutex);
+    _persistedIndex = std::move(index);
+}
+
+void KTXCache::saveIndex() {
+    std::lock_guard<std::mutex> lock(_indexMutex);
+    if (!_isIndexLoaded) {
+        // would replace the index of the last session before having read it
+        return;
+    }
+
+    QSaveFile file(QString::fromStdString(getIndexFilepath()));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(file_cache) << "Could not write KTX cache index" << file.fileName();
+        return;
+    }
+
+    QDataStream stream(&file);
+    quint32 numEntries = (quint32)std::count_if(_index.cbegin(), _index.cend(), [](const Index::value_type& entry) {
+        return (bool)entry.second.descriptor;
+    });
+    stream << INDEX_VERSION << numEntries;
+    for (const auto& entry : _index) {
+        if (entry.second.descriptor) {
+            stream << QByteArray::fromStdString(entry.first) << (quint64)entry.second.length << (qint64)entry.second.lastUsed;
+            writeDescriptor(stream, *entry.second.descriptor);
+        }
+    }
+
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        qCWarning(file_cache) << "Could not write KTX cache index" << file.fileName();
+    }
 }
 
+FilePointer KTXCache::getFile(const Key& key, DescriptorPointer& descriptor) {
+    descriptor.reset();
+    auto file = FileCache::getFile(key);
+    if (!file) {
+        return file;
+    }
+
+    auto now = QDateTime::currentMSecsSinceEpoch();
+    {
+        std::lock_guard<std::mutex> lock(_indexMutex);
+        auto it = _index.find(key);
+        if (it != _index.end() && it->second.descriptor) {
+            it->second.lastUsed = now;
+            descriptor = it->second.descriptor;
+            return file;
+        }
+    }
+
+    // first use of the file since it was written, or since the index was lost
+    auto ktxPointer = ktx::KTX::create(std::make_shared<storage::FileStorage>(file->getFilepath().c_str()));
+    if (ktxPointer) {
+        descriptor = std::make_shared<const ktx::KTXDescriptor>(ktxPointer->toDescriptor());
+
+        std::lock_guard<std::mutex> lock(_indexMutex);
+        _index[key] = { file->getLength(), now, descriptor };
+    }
+    return file;
+}
 
 std::unique_ptr<File> KTXCache::createFile(Metadata&& metadata, const std::string& filepath) {
     qCInfo(file_cache) << "Wrote KTX" << metadata.key.c_str();
-    return FileCache::createFile(std::move(metadata), filepath);
+
+    int64_t lastUsed { 0 };
+    {
+        std::lock_guard<std::mutex> lock(_indexMutex);
+        auto it = _persistedIndex.find(metadata.key);
+        if (it != _persistedIndex.end()) {
+            if (it->second.length == metadata.length) {
+                lastUsed = it->second.lastUsed;
+                _index[metadata.key] = std::move(it->second);
+            }
+            _persistedIndex.erase(it);
+        } else {
+            // written again, the entry of the previous file doesn't describe it
+            _index.erase(metadata.key);
+        }
+    }
+    return std::unique_ptr<File>(new KTXFile(std::move(metadata), filepath, lastUsed));
 }
 
+KTXFile::KTXFile(Metadata&& metadata, const std::string& filepath, int64_t lastUsed) :
+    cache::File(std::move(metadata), filepath) {
+    setLastUsed(lastUsed);
+}
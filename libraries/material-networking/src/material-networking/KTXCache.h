@@ -12,17 +12,23 @@
 #ifndef hifi_KTXCache_h
 #define hifi_KTXCache_h
 
+#include <mutex>
+#include <unordered_map>
+
 #include <QUrl>
 
 #include <shared/FileCache.h>
 
 namespace ktx {
     class KTX;
+    struct KTXDescriptor;
 }
 
 class KTXFile;
 using KTXFilePointer = std::shared_ptr<KTXFile>;
 
+// Keeps an index of the cached KTX files next to them, with the descriptor of their images and when they were last used,
+// so that cached textures can be used without parsing their file and are evicted least recently used first across sessions
 class KTXCache : public cache::FileCache {
     Q_OBJECT
 
@@ -33,12 +39,52 @@ public:
     static const int INVALID_VERSION;
     static const char* SETTING_VERSION_NAME;
 
+    // maximum size of the cache on disk, in MB
+    static const int DEFAULT_MAX_SIZE_MB;
+    static const char* SETTING_MAX_SIZE_NAME;
+
+    // the index doesn't end with the extension of the cached files, so the FileCache ignores it
+    static const char* INDEX_FILENAME;
+    static const quint32 INDEX_VERSION;
+
+    using DescriptorPointer = std::shared_ptr<const ktx::KTXDescriptor>;
+
     KTXCache(const std::string& dir, const std::string& ext);
+    ~KTXCache();
 
     void initialize() override;
 
+    using FileCache::getFile;
+    // also returns the descriptor of the images of the file, the file is only parsed if it isn't indexed yet
+    // the descriptor is null if the file isn't a valid KTX
+    cache::FilePointer getFile(const Key& key, DescriptorPointer& descriptor);
+
+    // writes the index of the cached files, done on destruction
+    void saveIndex();
+
 protected:
     std::unique_ptr<cache::File> createFile(Metadata&& metadata, const std::string& filepath) override final;
+
+private:
+    struct IndexEntry {
+        size_t length { 0 };
+        int64_t lastUsed { 0 };
+        DescriptorPointer descriptor;
+    };
+    using Index = std::unordered_map<Key, IndexEntry>;
+
+    std::string getIndexFilepath() const;
+    void loadIndex();
+
+    std::mutex _indexMutex;
+    Index _persistedIndex; // entries of the last session, moved to _index as their files get restored
+    Index _index;
+    bool _isIndexLoaded { false };
+};
+
+class KTXFile : public cache::File {
+public:
+    KTXFile(Metadata&& metadata, const std::string& filepath, int64_t lastUsed);
 };
 
 #endif // hifi_KTXCache_h
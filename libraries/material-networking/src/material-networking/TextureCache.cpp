@@ -971,9 +971,10 @@ void NetworkTexture::handleFinishedInitialLoad() {
         gpu::TexturePointer texture = textureCache->getTextureByHash(hash);
 
         if (!texture) {
-            auto ktxFile = textureCache->_ktxCache->getFile(hash);
-            if (ktxFile) {
-                texture = gpu::Texture::unserialize(ktxFile);
+            KTXCache::DescriptorPointer ktxDescriptor;
+            auto ktxFile = textureCache->_ktxCache->getFile(hash, ktxDescriptor);
+            if (ktxFile && ktxDescriptor) {
+                texture = gpu::Texture::unserialize(ktxFile, *ktxDescriptor);
                 if (texture) {
                     texture = textureCache->cacheTextureByHash(hash, texture);
                     if (texture->source().empty()) {
@@ -1233,9 +1234,12 @@ void ImageReader::read() {
 
         // If there is no live texture, check if there's an existing KTX file
         if (!texture) {
-            auto ktxFile = textureCache->_ktxCache->getFile(hash);
+            KTXCache::DescriptorPointer ktxDescriptor;
+            auto ktxFile = textureCache->_ktxCache->getFile(hash, ktxDescriptor);
             if (ktxFile) {
-                texture = gpu::Texture::unserialize(ktxFile, _url.toString().toStdString());
+                if (ktxDescriptor) {
+                    texture = gpu::Texture::unserialize(ktxFile, *ktxDescriptor, _url.toString().toStdString());
+                }
                 if (texture) {
                     texture = textureCache->cacheTextureByHash(hash, texture);
                 } else {
@@ -0,0 +1,53 @@
+//
+//  DomainListChangeLog.cpp
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListChangeLog.h"
+
+#include <QtCore/QHash>
+
+void DomainListChangeLog::append(const QUuid& nodeID, NodeType_t nodeType, bool isRemoved) {
+    // skip NO_VERSION when wrapping around, nodes that still hold an old version will get a full list
+    if (++_version == NO_VERSION) {
+        ++_version;
+        _entries.clear();
+    }
+
+    _entries.push_back({ { nodeID, nodeType, isRemoved }, _version });
+    while (_entries.size() > _maxEntries) {
+        _entries.pop_front();
+    }
+}
+
+bool DomainListChangeLog::getChangesSince(Version version, std::vector<Change>& changes) const {
+    if (version == NO_VERSION || version > _version) {
+        return false;
+    }
+    if (version == _version) {
+        return true;
+    }
+
+    // the entries hold consecutive versions, so the ones after the given version start at a known offset
+    if (_entries.empty() || version < _entries.front().version - 1) {
+        return false;
+    }
+    size_t first = version - (_entries.front().version - 1);
+
+    // only the latest change of each node matters, at the position it was made
+    QHash<QUuid, size_t> latestEntries;
+    for (size_t i = first; i < _entries.size(); ++i) {
+        latestEntries[_entries[i].change.nodeID] = i;
+    }
+    for (size_t i = first; i < _entries.size(); ++i) {
+        if (latestEntries.value(_entries[i].change.nodeID) == i) {
+            changes.push_back(_entries[i].change);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,74 @@
+//
+//  DomainListChangeLog.h
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListChangeLog_h
+#define hifi_DomainListChangeLog_h
+
+#include <deque>
+#include <vector>
+
+#include <QtCore/QUuid>
+
+#include "NodeType.h"
+
+// Versioned history of the changes made to the domain-server's node list.
+//
+// Every node that is added, updated or removed bumps the version of the list. A node that reports the version of the
+// list it last applied can then be sent only the nodes that changed since, as long as the log still reaches back that
+// far, instead of the whole list. Only the most recent entries are kept, older versions get a full list.
+class DomainListChangeLog {
+public:
+    using Version = quint32;
+
+    // the version of a list that was never received, only a full list can follow it
+    static const Version NO_VERSION = 0;
+
+    // whether a DomainList packet holds the whole list, or the changes from the base version in its header
+    enum class ListType : quint8 {
+        Full = 0,
+        Delta
+    };
+
+    struct Change {
+        QUuid nodeID;
+        NodeType_t nodeType;
+        bool isRemoved;
+    };
+
+    static const size_t DEFAULT_MAX_ENTRIES = 4096;
+
+    DomainListChangeLog(size_t maxEntries = DEFAULT_MAX_ENTRIES) : _maxEntries(maxEntries) { }
+
+    Version getVersion() const { return _version; }
+
+    // records that a node was added to the list, or that what the list holds about it changed
+    void nodeChanged(const QUuid& nodeID, NodeType_t nodeType) { append(nodeID, nodeType, false); }
+    void nodeRemoved(const QUuid& nodeID, NodeType_t nodeType) { append(nodeID, nodeType, true); }
+
+    // fills the latest change of every node touched since the given version, oldest first
+    // returns false when the changes can't be rebuilt from that version, and a full list is needed
+    bool getChangesSince(Version version, std::vector<Change>& changes) const;
+
+    size_t getNumEntries() const { return _entries.size(); }
+
+private:
+    struct Entry {
+        Change change;
+        Version version;
+    };
+
+    void append(const QUuid& nodeID, NodeType_t nodeType, bool isRemoved);
+
+    size_t _maxEntries;
+    std::deque<Entry> _entries;
+    Version _version { NO_VERSION };
+};
+
+#endif // hifi_DomainListChangeLog_h
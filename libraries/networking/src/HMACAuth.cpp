@@ -16,6 +16,7 @@
 
 #include <QUuid>
 #include "NetworkLogging.h"
+#include "SipHash.h"
 #include <cassert>
 
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
@@ -43,6 +44,22 @@ HMACAuth::~HMACAuth() {
 #endif
 
 bool HMACAuth::setKey(const char* keyValue, int keyLen) {
+    QMutexLocker lock(&_lock);
+    _key = QByteArray(keyValue, keyLen);
+    return initKey();
+}
+
+bool HMACAuth::setAuthMethod(AuthMethod authMethod) {
+    QMutexLocker lock(&_lock);
+    if (_authMethod == authMethod) {
+        return true;
+    }
+    _authMethod = authMethod;
+    _sipData.clear();
+    return _key.isNull() || initKey();
+}
+
+bool HMACAuth::initKey() {
     const EVP_MD* sslStruct = nullptr;
 
     switch (_authMethod) {
@@ -66,12 +83,19 @@ bool HMACAuth::setKey(const char* keyValue, int keyLen) {
         sslStruct = EVP_ripemd160();
         break;
 
+    case SIPHASH: {
+        uint64_t k0, k1;
+        SipHash::keyFromBytes(reinterpret_cast<const unsigned char*>(_key.constData()), (size_t)_key.length(), k0, k1);
+        _sipKey0 = k0;
+        _sipKey1 = k1;
+        return true;
+    }
+
     default:
         return false;
     }
 
-    QMutexLocker lock(&_lock);
-    return (bool) HMAC_Init_ex(_hmacContext, keyValue, keyLen, sslStruct, nullptr);
+    return (bool) HMAC_Init_ex(_hmacContext, _key.constData(), _key.length(), sslStruct, nullptr);
 }
 
 bool HMACAuth::setKey(const QUuid& uidKey) {
@@ -81,14 +105,26 @@ bool HMACAuth::setKey(const QUuid& uidKey) {
 
 bool HMACAuth::addData(const char* data, int dataLen) {
     QMutexLocker lock(&_lock);
+    if (_authMethod == SIPHASH) {
+        _sipData.append(data, dataLen);
+        return true;
+    }
     return (bool) HMAC_Update(_hmacContext, reinterpret_cast<const unsigned char*>(data), dataLen);
 }
 
 HMACAuth::HMACHash HMACAuth::result() {
+    QMutexLocker lock(&_lock);
+    if (_authMethod == SIPHASH) {
+        HMACHash hashValue(SipHash::HASH_SIZE);
+        SipHash::hash128(_sipKey0, _sipKey1, reinterpret_cast<const unsigned char*>(_sipData.constData()),
+                         (size_t)_sipData.length(), &hashValue[0]);
+        _sipData.clear();
+        return hashValue;
+    }
+
     HMACHash hashValue(EVP_MAX_MD_SIZE);
     unsigned int hashLen;
-    QMutexLocker lock(&_lock);
-    
+
     auto hmacResult = HMAC_Final(_hmacContext, &hashValue[0], &hashLen);
     
     if (hmacResult) {
@@ -105,6 +141,13 @@ HMACAuth::HMACHash HMACAuth::result() {
 }
 
 bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen) {
+    if (_authMethod == SIPHASH) {
+        hashResult.resize(SipHash::HASH_SIZE);
+        SipHash::hash128(_sipKey0, _sipKey1, reinterpret_cast<const unsigned char*>(data), (size_t)dataLen,
+                         &hashResult[0]);
+        return true;
+    }
+
     QMutexLocker lock(&_lock);
     if (!addData(data, dataLen)) {
         qCWarning(networking) << "Error occured calling HMACAuth::addData()";
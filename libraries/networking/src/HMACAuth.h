@@ -12,15 +12,22 @@
 #ifndef hifi_HMACAuth_h
 #define hifi_HMACAuth_h
 
+#include <atomic>
 #include <vector>
 #include <memory>
+#include <QtCore/QByteArray>
 #include <QtCore/QMutex>
 
 class QUuid;
 
 class HMACAuth {
 public:
-    enum AuthMethod { MD5, SHA1, SHA224, SHA256, RIPEMD160 };
+    // SIPHASH is SipHash-2-4 with a 128 bit output rather than an HMAC, it has the size of an MD5 hash so it fits the
+    // same packet header field
+    enum AuthMethod { MD5, SHA1, SHA224, SHA256, RIPEMD160, SIPHASH };
+    // whether a method received from the network can sign packets, the hashes of the others don't fit the
+    // NUM_BYTES_MD5_HASH bytes of the verification hash in the packet header
+    static bool isValidAuthMethod(int authMethod) { return authMethod == MD5 || authMethod == SIPHASH; }
     using HMACHash = std::vector<unsigned char>;
     
     explicit HMACAuth(AuthMethod authMethod = MD5);
@@ -28,7 +35,13 @@ public:
 
     bool setKey(const char* keyValue, int keyLen);
     bool setKey(const QUuid& uidKey);
+    // Switch to another method, keeping the key.
+    bool setAuthMethod(AuthMethod authMethod);
+    AuthMethod getAuthMethod() const { return _authMethod; }
+
     // Calculate complete hash in one.
+    // With SIPHASH this takes no lock, so that threads sending to or receiving from the same node don't wait on each
+    // other - a hash calculated while the key changes doesn't match either key.
     bool calculateHash(HMACHash& hashResult, const char* data, int dataLen);
 
     // Append to data to be hashed.
@@ -39,9 +52,16 @@ public:
     HMACHash result();
 
 private:
+    bool initKey();
+
     QMutex _lock { QMutex::Recursive };
     struct hmac_ctx_st* _hmacContext;
-    AuthMethod _authMethod;
+    std::atomic<AuthMethod> _authMethod;
+    QByteArray _key;
+
+    std::atomic<uint64_t> _sipKey0 { 0 };
+    std::atomic<uint64_t> _sipKey1 { 0 };
+    QByteArray _sipData;
 };
 
 #endif  // hifi_HMACAuth_h
@@ -354,7 +354,7 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
                     expectedHash = NLPacket::hashForPacketAndHMAC(packet, *sourceNodeHMACAuth);
                 }
 
-                // check if the HMAC-md5 hash in the header matches the hash we would expect
+                // check if the verification hash in the header matches the hash we would expect
                 if (!sourceNodeHMACAuth || packetHeaderHash != expectedHash) {
                     static QMultiMap<QUuid, PacketType> hashDebugSuppressMap;
 
@@ -385,6 +385,15 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
     return false;
 }
 
+void LimitedNodeList::setAuthenticationMethod(HMACAuth::AuthMethod authenticationMethod) {
+    if (_authenticationMethod.exchange(authenticationMethod) != authenticationMethod) {
+        qCDebug(networking) << "Authenticating packets with method" << authenticationMethod;
+        eachNode([authenticationMethod](const SharedNodePointer& node) {
+            node->setAuthenticationMethod(authenticationMethod);
+        });
+    }
+}
+
 void LimitedNodeList::fillPacketHeader(const NLPacket& packet, HMACAuth* hmacAuth) {
     if (!PacketTypeEnum::getNonSourcedPackets().contains(packet.getType())) {
         packet.writeSourceID(getSessionLocalID());
@@ -596,7 +605,9 @@ void LimitedNodeList::eraseAllNodes(QString reason) {
     {
         // iterate the current nodes - grab them so we can emit that they are dying
         // and then remove them from the hash
+        auto lockStart = usecTimestampNow();
         QWriteLocker writeLocker(&_nodeMutex);
+        recordNodeWriteLock(lockStart);
 
         if (_nodeHash.size() > 0) {
             qCDebug(networking) << "LimitedNodeList::eraseAllNodes() removing all nodes from NodeList:" << reason;
@@ -609,6 +620,7 @@ void LimitedNodeList::eraseAllNodes(QString reason) {
         _localIDMap.clear();
         _nodeHash.clear();
     }
+    updateNodeSnapshot();
 
     foreach(const SharedNodePointer& killedNode, killedNodes) {
         handleNodeKill(killedNode);
@@ -630,10 +642,13 @@ bool LimitedNodeList::killNodeWithUUID(const QUuid& nodeUUID, ConnectionID newCo
 
     if (matchingNode) {
         {
+            auto lockStart = usecTimestampNow();
             QWriteLocker writeLocker(&_nodeMutex);
+            recordNodeWriteLock(lockStart);
             _localIDMap.unsafe_erase(matchingNode->getLocalID());
             _nodeHash.unsafe_erase(matchingNode->getUUID());
         }
+        updateNodeSnapshot();
 
         handleNodeKill(matchingNode, newConnectionID);
         return true;
@@ -679,6 +694,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         matchingNode->setPublicSocket(publicSocket);
         matchingNode->setLocalSocket(localSocket);
         matchingNode->setPermissions(permissions);
+        matchingNode->setAuthenticationMethod(_authenticationMethod);
         matchingNode->setConnectionSecret(connectionSecret);
         matchingNode->setIsReplicated(isReplicated);
         matchingNode->setIsUpstream(isUpstream || NodeType::isUpstream(nodeType));
@@ -690,10 +706,13 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
     auto removeOldNode = [&](auto node) {
         if (node) {
             {
+                auto lockStart = usecTimestampNow();
                 QWriteLocker writeLocker(&_nodeMutex);
+                recordNodeWriteLock(lockStart);
                 _localIDMap.unsafe_erase(node->getLocalID());
                 _nodeHash.unsafe_erase(node->getUUID());
             }
+            updateNodeSnapshot();
             handleNodeKill(node);
         }
     };
@@ -718,6 +737,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
     Node* newNode = new Node(uuid, nodeType, publicSocket, localSocket);
     newNode->setIsReplicated(isReplicated);
     newNode->setIsUpstream(isUpstream || NodeType::isUpstream(nodeType));
+    newNode->setAuthenticationMethod(_authenticationMethod);
     newNode->setConnectionSecret(connectionSecret);
     newNode->setPermissions(permissions);
     newNode->setLocalID(localID);
@@ -738,6 +758,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         _nodeHash.insert({ newNode->getUUID(), newNodePointer });
         _localIDMap.insert({ localID, newNodePointer });
     }
+    updateNodeSnapshot();
 
     qCDebug(networking) << "Added" << *newNode;
 
@@ -913,6 +934,10 @@ void LimitedNodeList::removeSilentNodes() {
         node->getMutex().unlock();
     });
 
+    if (!killedNodes.isEmpty()) {
+        updateNodeSnapshot();
+    }
+
     foreach(const SharedNodePointer& killedNode, killedNodes) {
         auto now = usecTimestampNow();
         qCDebug(networking_ice) << "Removing silent node" << *killedNode << "\n"
@@ -1285,23 +1310,58 @@ void LimitedNodeList::sendPeerQueryToIceServer(const HifiSockAddr& iceServerSock
 }
 
 SharedNodePointer LimitedNodeList::findNodeWithAddr(const HifiSockAddr& addr) {
-    QReadLocker locker(&_nodeMutex);
-    auto it = std::find_if(std::begin(_nodeHash), std::end(_nodeHash), [&addr](const UUIDNodePair& pair) {
-        return pair.second->getPublicSocket() == addr
-            || pair.second->getLocalSocket() == addr
-            || pair.second->getSymmetricSocket() == addr;
+    return nodeMatchingPredicate([&addr](const SharedNodePointer& node) {
+        return node->getPublicSocket() == addr
+            || node->getLocalSocket() == addr
+            || node->getSymmetricSocket() == addr;
     });
-    return (it != std::end(_nodeHash)) ? it->second : SharedNodePointer();
 }
 
 bool LimitedNodeList::sockAddrBelongsToNode(const HifiSockAddr& sockAddr) {
-    QReadLocker locker(&_nodeMutex);
-    auto it = std::find_if(std::begin(_nodeHash), std::end(_nodeHash), [&sockAddr](const UUIDNodePair& pair) {
-        return pair.second->getPublicSocket() == sockAddr
-            || pair.second->getLocalSocket() == sockAddr
-            || pair.second->getSymmetricSocket() == sockAddr;
-    });
-    return it != std::end(_nodeHash);
+    return !findNodeWithAddr(sockAddr).isNull();
+}
+
+void LimitedNodeList::updateNodeSnapshot() {
+    auto start = usecTimestampNow();
+
+    // serializes the writers, so that the last snapshot stored is built after the last change to the node hash
+    std::lock_guard<std::mutex> snapshotLock(_nodeSnapshotMutex);
+
+    auto snapshot = std::make_shared<NodeSnapshot>();
+    {
+        QReadLocker readLocker(&_nodeMutex);
+        snapshot->reserve(_nodeHash.size());
+        for (const auto& pair : _nodeHash) {
+            snapshot->push_back(pair.second);
+        }
+    }
+
+    // readers holding the previous snapshot keep it alive until they are done with it
+    std::atomic_store(&_nodeSnapshot, NodeSnapshotPointer(std::move(snapshot)));
+
+    ++_nodeSnapshotUpdates;
+    _nodeSnapshotUpdateUsecs += usecTimestampNow() - start;
+}
+
+void LimitedNodeList::recordNodeWriteLock(quint64 lockStartUsecs) {
+    uint64_t waitUsecs = usecTimestampNow() - lockStartUsecs;
+    ++_nodeWriteLocks;
+    _nodeWriteLockWaitUsecs += waitUsecs;
+
+    // only called with the write lock held, so there is no other writer to race with
+    if (waitUsecs > _maxNodeWriteLockWaitUsecs) {
+        _maxNodeWriteLockWaitUsecs = waitUsecs;
+    }
+}
+
+LimitedNodeList::NodeRegistryStats LimitedNodeList::sampleNodeRegistryStats() {
+    NodeRegistryStats stats;
+    stats.snapshotUpdates = _nodeSnapshotUpdates.exchange(0);
+    stats.snapshotUpdateUsecs = _nodeSnapshotUpdateUsecs.exchange(0);
+    stats.writeLocks = _nodeWriteLocks.exchange(0);
+    stats.writeLockWaitUsecs = _nodeWriteLockWaitUsecs.exchange(0);
+    stats.maxWriteLockWaitUsecs = _maxNodeWriteLockWaitUsecs.exchange(0);
+    return stats;
 }
 
 void LimitedNodeList::sendPacketToIceServer(PacketType packetType, const HifiSockAddr& iceServerSockAddr,
@@ -17,6 +17,7 @@
 #include <stdint.h>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 
@@ -168,7 +169,7 @@ public:
 
     std::function<void(Node*)> linkedDataCreateCallback;
 
-    size_t size() const { QReadLocker readLock(&_nodeMutex); return _nodeHash.size(); }
+    size_t size() const { return getNodeSnapshot()->size(); }
 
     SharedNodePointer nodeWithUUID(const QUuid& nodeUUID);
     SharedNodePointer nodeWithLocalID(Node::LocalID localID) const;
@@ -207,10 +208,15 @@ public:
     using value_type = SharedNodePointer;
     using const_iterator = std::vector<value_type>::const_iterator;
 
-    // Cede control of iteration under a single read lock (e.g. for use by thread pools)
-    // Use this for nested loops instead of taking nested read locks!
-    //   This allows multiple threads (i.e. a thread pool) to share a lock
-    //   without deadlocking when a dying node attempts to acquire a write lock
+    // The nodes are iterated from an immutable snapshot of the node hash, replaced as a whole whenever a node is added
+    // or removed. Iterating takes no lock, so mixer threads never wait on nodes joining or leaving, but a node removed
+    // while a loop runs may still be visited by it.
+    using NodeSnapshot = std::vector<SharedNodePointer>;
+    using NodeSnapshotPointer = std::shared_ptr<const NodeSnapshot>;
+    NodeSnapshotPointer getNodeSnapshot() const { return std::atomic_load(&_nodeSnapshot); }
+
+    // Cede control of iteration over a single snapshot (e.g. for use by thread pools)
+    // Use this for nested loops so that every level sees the same nodes
     template<typename NestedNodeLambda>
     void nestedEach(NestedNodeLambda functor,
                     int* lockWaitOut = nullptr,
@@ -219,29 +225,16 @@ public:
         quint64 start, endTransform, endFunctor;
 
         start = usecTimestampNow();
-        std::vector<SharedNodePointer> nodes;
-        {
-            QReadLocker readLock(&_nodeMutex);
-            auto endLock = usecTimestampNow();
-            if (lockWaitOut) {
-                *lockWaitOut = (endLock - start);
-            }
-
-            // Size of _nodeHash could change at any time,
-            // so reserve enough memory for the current size
-            // and then back insert all the nodes found
-            nodes.reserve(_nodeHash.size());
-            std::transform(_nodeHash.cbegin(), _nodeHash.cend(), std::back_inserter(nodes), [&](const NodeHash::value_type& it) {
-                return it.second;
-            });
-
-            endTransform = usecTimestampNow();
-            if (nodeTransformOut) {
-                *nodeTransformOut = (endTransform - endLock);
-            }
+        auto nodes = getNodeSnapshot();
+        endTransform = usecTimestampNow();
+        if (lockWaitOut) {
+            *lockWaitOut = 0;
+        }
+        if (nodeTransformOut) {
+            *nodeTransformOut = (endTransform - start);
         }
 
-        functor(nodes.cbegin(), nodes.cend());
+        functor(nodes->cbegin(), nodes->cend());
         endFunctor = usecTimestampNow();
         if (functorOut) {
             *functorOut = (endFunctor - endTransform);
@@ -250,30 +243,30 @@ public:
 
     template<typename NodeLambda>
     void eachNode(NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto nodes = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
+        for (const auto& node : *nodes) {
+            functor(node);
         }
     }
 
     template<typename PredLambda, typename NodeLambda>
     void eachMatchingNode(PredLambda predicate, NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto nodes = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                functor(it->second);
+        for (const auto& node : *nodes) {
+            if (predicate(node)) {
+                functor(node);
             }
         }
     }
 
     template<typename BreakableNodeLambda>
     void eachNodeBreakable(BreakableNodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto nodes = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (!functor(it->second)) {
+        for (const auto& node : *nodes) {
+            if (!functor(node)) {
                 break;
             }
         }
@@ -281,27 +274,33 @@ public:
 
     template<typename PredLambda>
     SharedNodePointer nodeMatchingPredicate(const PredLambda predicate) {
-        QReadLocker readLock(&_nodeMutex);
+        auto nodes = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                return it->second;
+        for (const auto& node : *nodes) {
+            if (predicate(node)) {
+                return node;
             }
         }
 
         return SharedNodePointer();
     }
 
-    // This is unsafe because it does not take a lock
-    // Must only be called when you know that a read lock on the node mutex is held
-    // and will be held for the duration of your iteration
+    // Kept for the callers that used to iterate under a read lock they already held,
+    // it is now the same as eachNode
     template<typename NodeLambda>
     void unsafeEachNode(NodeLambda functor) {
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
-        }
+        eachNode(functor);
     }
 
+    struct NodeRegistryStats {
+        uint64_t snapshotUpdates { 0 };
+        uint64_t snapshotUpdateUsecs { 0 };
+        uint64_t writeLocks { 0 };
+        uint64_t writeLockWaitUsecs { 0 };
+        uint64_t maxWriteLockWaitUsecs { 0 };
+    };
+    NodeRegistryStats sampleNodeRegistryStats();
+
     void putLocalPortIntoSharedMemory(const QString key, QObject* parent, quint16 localPort);
     bool getLocalServerPortFromSharedMemory(const QString key, quint16& localPort);
 
@@ -311,6 +310,15 @@ public:
 
     udt::Socket::StatsVector sampleStatsForAllConnections() { return _nodeSocket.sampleStatsForAllConnections(); }
 
+    bool isBatchedReceiveEnabled() const { return _nodeSocket.isBatchedReceiveEnabled(); }
+    udt::Socket::ReceiveBatchStats sampleReceiveBatchStats() { return _nodeSocket.sampleReceiveBatchStats(); }
+
+    // unreliable packets sent from the calling thread between these calls are written in batches, if enabled
+    void beginSendBatch() { _nodeSocket.beginSendBatch(); }
+    void flushSendBatch() { _nodeSocket.flushSendBatch(); }
+    bool isBatchedSendEnabled() const { return _nodeSocket.isBatchedSendEnabled(); }
+    udt::Socket::SendBatchStats sampleSendBatchStats() { return _nodeSocket.sampleSendBatchStats(); }
+
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
 
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
@@ -320,6 +328,9 @@ public:
     bool isPacketVerified(const udt::Packet& packet) { return isPacketVerifiedWithSource(packet); }
     void setAuthenticatePackets(bool useAuthentication) { _useAuthentication = useAuthentication; }
     bool getAuthenticatePackets() const { return _useAuthentication; }
+    // the domain server picks the method, and the nodes switch to it with their first domain list
+    void setAuthenticationMethod(HMACAuth::AuthMethod authenticationMethod);
+    HMACAuth::AuthMethod getAuthenticationMethod() const { return _authenticationMethod; }
 
     void setFlagTimeForConnectionStep(bool flag) { _flagTimeForConnectionStep = flag; }
     bool isFlagTimeForConnectionStep() { return _flagTimeForConnectionStep; }
@@ -438,8 +449,20 @@ protected:
     void removeDelayedAdd(QUuid nodeUUID);
     bool isDelayedNode(QUuid nodeUUID);
 
+    // rebuilds the node snapshot from the node hash, call after adding or removing nodes without the node mutex held
+    void updateNodeSnapshot();
+    void recordNodeWriteLock(quint64 lockStartUsecs);
+
+    // the node hash is only locked by writers and by lookups by UUID, readers iterate the snapshot
     NodeHash _nodeHash;
     mutable QReadWriteLock _nodeMutex { QReadWriteLock::Recursive };
+    NodeSnapshotPointer _nodeSnapshot { std::make_shared<NodeSnapshot>() };
+    std::mutex _nodeSnapshotMutex;
+    std::atomic<uint64_t> _nodeSnapshotUpdates { 0 };
+    std::atomic<uint64_t> _nodeSnapshotUpdateUsecs { 0 };
+    std::atomic<uint64_t> _nodeWriteLocks { 0 };
+    std::atomic<uint64_t> _nodeWriteLockWaitUsecs { 0 };
+    std::atomic<uint64_t> _maxNodeWriteLockWaitUsecs { 0 };
     udt::Socket _nodeSocket;
     QUdpSocket* _dtlsSocket { nullptr };
     HifiSockAddr _localSockAddr;
@@ -447,6 +470,7 @@ protected:
     HifiSockAddr _stunSockAddr { STUN_SERVER_HOSTNAME, STUN_SERVER_PORT };
     bool _hasTCPCheckedLocalSocket { false };
     bool _useAuthentication { true };
+    std::atomic<HMACAuth::AuthMethod> _authenticationMethod { HMACAuth::MD5 };
 
     PacketReceiver* _packetReceiver;
 
@@ -465,7 +489,9 @@ protected:
 
     template<typename IteratorLambda>
     void eachNodeHashIterator(IteratorLambda functor) {
+        auto lockStart = usecTimestampNow();
         QWriteLocker writeLock(&_nodeMutex);
+        recordNodeWriteLock(lockStart);
         NodeHash::iterator it = _nodeHash.begin();
 
         while (it != _nodeHash.end()) {
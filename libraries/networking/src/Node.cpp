@@ -213,13 +213,22 @@ void Node::setConnectionSecret(const QUuid& connectionSecret) {
     }
 
     if (!_authenticateHash) {
-        _authenticateHash.reset(new HMACAuth());
+        _authenticateHash.reset(new HMACAuth(_authenticationMethod));
     }
 
     _connectionSecret = connectionSecret;
     _authenticateHash->setKey(_connectionSecret);
 }
 
+void Node::setAuthenticationMethod(HMACAuth::AuthMethod authenticationMethod) {
+    _authenticationMethod = authenticationMethod;
+
+    // the hash is switched in place, other threads may be using it
+    if (_authenticateHash) {
+        _authenticateHash->setAuthMethod(authenticationMethod);
+    }
+}
+
 void Node::updateStats(Stats stats) {
     _stats = stats;
 }
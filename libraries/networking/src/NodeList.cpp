@@ -307,6 +307,9 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
         _domainHandler.softReset(reason);
     }
 
+    // the next domain list has to be a full one
+    _domainListVersion = DomainListChangeLog::NO_VERSION;
+
     // refresh the owner UUID to the NULL UUID
     setSessionUUID(QUuid());
     setSessionLocalID(Node::NULL_LOCAL_ID);
@@ -490,6 +493,11 @@ void NodeList::sendDomainServerCheckIn() {
         packetStream << _ownerType.load() << publicSockAddr << localSockAddr << _nodeTypesOfInterest.toList();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
+        if (domainPacketType == PacketType::DomainListRequest) {
+            // the version of the list we hold, so that the domain-server only sends what changed since
+            packetStream << _domainListVersion.load();
+        }
+
         if (!domainIsConnected) {
 
             // Metaverse account.
@@ -729,6 +737,8 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     // Is packet authentication enabled?
     bool isAuthenticated;
     packetStream >> isAuthenticated;
+    quint8 authenticationMethod;
+    packetStream >> authenticationMethod;
 
     qint64 now = qint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
 
@@ -744,6 +754,11 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     bool newConnection;
     packetStream >> newConnection;
 
+    quint8 listType;
+    DomainListChangeLog::Version baseListVersion;
+    DomainListChangeLog::Version listVersion;
+    packetStream >> listType >> baseListVersion >> listVersion;
+
     if (newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
@@ -822,10 +837,60 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
 
     setPermissions(newPermissions);
     setAuthenticatePackets(isAuthenticated);
+    setDomainAuthenticationMethod(authenticationMethod);
+
+    applyDomainList(packetStream, message->getSize(), newConnection, listType, baseListVersion, listVersion);
+}
+
+void NodeList::applyDomainList(QDataStream& packetStream, qint64 size, bool newConnection, quint8 listType,
+        DomainListChangeLog::Version baseListVersion, DomainListChangeLog::Version listVersion) {
+    auto currentListVersion = newConnection ? DomainListChangeLog::NO_VERSION : _domainListVersion.load();
+    if (listType == (quint8)DomainListChangeLog::ListType::Delta) {
+        // the other packets of the delta just applied, if it didn't fit in one, have the same versions
+        bool isPartOfLastDelta = listVersion == currentListVersion && baseListVersion == _lastDeltaBaseVersion &&
+            _lastDeltaBaseVersion != DomainListChangeLog::NO_VERSION;
+        if (baseListVersion == currentListVersion || isPartOfLastDelta) {
+            parseDomainListChanges(packetStream, size);
+            _lastDeltaBaseVersion = baseListVersion;
+            _domainListVersion = listVersion;
+        } else if (listVersion > currentListVersion) {
+            // we missed the changes this one builds on, ask for the whole list with the next check-in
+            _lastDeltaBaseVersion = DomainListChangeLog::NO_VERSION;
+            _domainListVersion = DomainListChangeLog::NO_VERSION;
+        }
+    } else if (listVersion == DomainListChangeLog::NO_VERSION || listVersion >= currentListVersion) {
+        // pull each node in the packet
+        while (packetStream.device()->pos() < size) {
+            parseNodeFromPacketStream(packetStream);
+        }
+        _lastDeltaBaseVersion = DomainListChangeLog::NO_VERSION;
+        _domainListVersion = listVersion;
+    }
+    // otherwise this is a full list that arrived after newer changes, which it would undo
+}
 
-    // pull each node in the packet
-    while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+void NodeList::setDomainAuthenticationMethod(quint8 authenticationMethod) {
+    if (HMACAuth::isValidAuthMethod(authenticationMethod)) {
+        setAuthenticationMethod((HMACAuth::AuthMethod)authenticationMethod);
+    } else {
+        qCWarning(networking) << "Ignoring packet authentication method" << authenticationMethod
+            << "from the domain, keeping the current one";
+    }
+}
+
+void NodeList::parseDomainListChanges(QDataStream& packetStream, qint64 size) {
+    while (packetStream.device()->pos() < size) {
+        bool isRemoved;
+        packetStream >> isRemoved;
+
+        if (isRemoved) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            killNodeWithUUID(nodeUUID);
+            removeDelayedAdd(nodeUUID);
+        } else {
+            parseNodeFromPacketStream(packetStream);
+        }
     }
 }
 
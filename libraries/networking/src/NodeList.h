@@ -33,6 +33,7 @@
 #include <SettingHandle.h>
 
 #include "DomainHandler.h"
+#include "DomainListChangeLog.h"
 #include "LimitedNodeList.h"
 #include "Node.h"
 
@@ -47,6 +48,7 @@ using NodeSharedReceivedMessagePair = std::pair<SharedNodePointer, QSharedPointe
 
 class Application;
 class Assignment;
+class NodeListTests;
 
 class NodeList : public LimitedNodeList {
     Q_OBJECT
@@ -148,6 +150,8 @@ private slots:
     void maybeSendIgnoreSetToNode(SharedNodePointer node);
 
 private:
+    friend class ::NodeListTests;
+
     NodeList() : LimitedNodeList(INVALID_PORT, INVALID_PORT) { assert(false); } // Not implemented, needed for DependencyManager templates compile
     NodeList(char ownerType, int socketListenPort = INVALID_PORT, int dtlsListenPort = INVALID_PORT);
     NodeList(NodeList const&) = delete; // Don't implement, needed to avoid copies of singleton
@@ -161,6 +165,12 @@ private:
     void sendDSPathQuery(const QString& newPath);
 
     void parseNodeFromPacketStream(QDataStream& packetStream);
+    void parseDomainListChanges(QDataStream& packetStream, qint64 size);
+    // applies the nodes of a DomainList packet following its header, a full list or the changes since its base version
+    void applyDomainList(QDataStream& packetStream, qint64 size, bool newConnection, quint8 listType,
+        DomainListChangeLog::Version baseListVersion, DomainListChangeLog::Version listVersion);
+    // the methods that don't sign packets in the verification hash of their header are ignored
+    void setDomainAuthenticationMethod(quint8 authenticationMethod);
 
     void pingPunchForInactiveNode(const SharedNodePointer& node);
 
@@ -168,6 +178,8 @@ private:
 
     std::atomic<NodeType_t> _ownerType;
     NodeSet _nodeTypesOfInterest;
+    std::atomic<DomainListChangeLog::Version> _domainListVersion { DomainListChangeLog::NO_VERSION };
+    DomainListChangeLog::Version _lastDeltaBaseVersion { DomainListChangeLog::NO_VERSION }; // of the delta that led to it
     DomainHandler _domainHandler;
     HifiSockAddr _assignmentServerSocket;
     bool _isShuttingDown { false };
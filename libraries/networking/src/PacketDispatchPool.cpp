@@ -0,0 +1,125 @@
+//
+//  PacketDispatchPool.cpp
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketDispatchPool.h"
+
+#include <algorithm>
+#include <future>
+
+#include <ThreadHelpers.h>
+
+using Lock = std::unique_lock<std::mutex>;
+
+template <typename T>
+static void updateMax(std::atomic<T>& maximum, T value) {
+    T current = maximum;
+    while (value > current && !maximum.compare_exchange_weak(current, value)) { }
+}
+
+PacketDispatchPool::PacketDispatchPool(const std::string& name, int numWorkers) {
+    numWorkers = std::max(numWorkers, 1);
+    for (int i = 0; i < numWorkers; ++i) {
+        _workers.push_back(std::unique_ptr<Worker>(new Worker()));
+        Worker* worker = _workers.back().get();
+        worker->thread = std::thread([this, worker, name, i] {
+            setThreadName(name + " " + std::to_string(i));
+            runWorker(*worker);
+        });
+    }
+}
+
+PacketDispatchPool::~PacketDispatchPool() {
+    // packets still queued are dropped, like the PacketReceiver does when it is told to
+    for (auto& worker : _workers) {
+        {
+            Lock lock(worker->mutex);
+            worker->stop = true;
+        }
+        worker->condition.notify_one();
+    }
+    for (auto& worker : _workers) {
+        worker->thread.join();
+    }
+}
+
+void PacketDispatchPool::dispatch(size_t shard, PacketType type, Task task) {
+    Worker& worker = *_workers[shard % _workers.size()];
+    size_t queueDepth;
+    {
+        Lock lock(worker.mutex);
+        worker.queue.push_back({ std::move(task), type, Clock::now() });
+        queueDepth = worker.queue.size();
+    }
+    if (queueDepth == 1) {
+        worker.condition.notify_one();
+    }
+    updateMax(_typeCounters[(uint8_t)type].maxQueueDepth, (uint32_t)queueDepth);
+}
+
+void PacketDispatchPool::flush() {
+    std::vector<std::future<void>> flushed;
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        auto promise = std::make_shared<std::promise<void>>();
+        flushed.push_back(promise->get_future());
+        Worker& worker = *_workers[i];
+        {
+            Lock lock(worker.mutex);
+            // typed Unknown to keep it out of the stats
+            worker.queue.push_back({ [promise] { promise->set_value(); }, PacketType::Unknown, Clock::now() });
+        }
+        worker.condition.notify_one();
+    }
+    for (auto& future : flushed) {
+        future.wait();
+    }
+}
+
+void PacketDispatchPool::runWorker(Worker& worker) {
+    std::deque<Item> items;
+    while (true) {
+        {
+            Lock lock(worker.mutex);
+            worker.condition.wait(lock, [&] { return worker.stop || !worker.queue.empty(); });
+            if (worker.stop) {
+                return;
+            }
+            items.swap(worker.queue);
+        }
+
+        for (auto& item : items) {
+            if (item.type != PacketType::Unknown) {
+                auto latency = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - item.queueTime).count();
+                auto& counters = _typeCounters[(uint8_t)item.type];
+                ++counters.packets;
+                counters.latencyUsecs += latency;
+                updateMax(counters.maxLatencyUsecs, latency);
+            }
+            item.task();
+        }
+        items.clear();
+    }
+}
+
+PacketDispatchPool::StatsVector PacketDispatchPool::sampleStats() {
+    StatsVector stats;
+    for (size_t type = 0; type < _typeCounters.size(); ++type) {
+        auto& counters = _typeCounters[type];
+        if (counters.packets == 0 && counters.maxQueueDepth == 0) {
+            continue;
+        }
+        TypeStats typeStats;
+        typeStats.packets = counters.packets.exchange(0);
+        typeStats.latencyUsecs = counters.latencyUsecs.exchange(0);
+        typeStats.maxLatencyUsecs = counters.maxLatencyUsecs.exchange(0);
+        typeStats.maxQueueDepth = counters.maxQueueDepth.exchange(0);
+        stats.emplace_back((PacketType)type, typeStats);
+    }
+    return stats;
+}
@@ -0,0 +1,89 @@
+//
+//  PacketDispatchPool.h
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketDispatchPool_h
+#define hifi_PacketDispatchPool_h
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <PortableHighResolutionClock.h>
+
+#include "udt/PacketHeaders.h"
+
+// Workers that packets are handed to by the PacketReceiver, for listeners that can take them concurrently.
+//
+// Each task goes to the worker of its shard, and the tasks of a shard run one at a time in the order they were queued.
+// Sharding by sender keeps the packets of a sender in order while different senders are handled in parallel.
+class PacketDispatchPool {
+public:
+    using Task = std::function<void()>;
+
+    struct TypeStats {
+        uint64_t packets { 0 };
+        uint64_t latencyUsecs { 0 }; // from the packet being queued to its listener being called
+        uint64_t maxLatencyUsecs { 0 };
+        uint32_t maxQueueDepth { 0 }; // of the worker queue the packet joined
+    };
+    using StatsVector = std::vector<std::pair<PacketType, TypeStats>>;
+
+    PacketDispatchPool(const std::string& name, int numWorkers);
+    ~PacketDispatchPool();
+
+    int getNumWorkers() const { return (int)_workers.size(); }
+
+    void dispatch(size_t shard, PacketType type, Task task);
+
+    // blocks until the tasks queued before the call have run, must not be called from a task
+    void flush();
+
+    // the stats of the packet types dispatched since the last sample
+    StatsVector sampleStats();
+
+private:
+    using Clock = p_high_resolution_clock;
+
+    struct Item {
+        Task task;
+        PacketType type;
+        Clock::time_point queueTime;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<Item> queue; // guarded by mutex
+        bool stop { false }; // guarded by mutex
+        std::thread thread;
+    };
+
+    struct TypeCounters {
+        std::atomic<uint64_t> packets { 0 };
+        std::atomic<uint64_t> latencyUsecs { 0 };
+        std::atomic<uint64_t> maxLatencyUsecs { 0 };
+        std::atomic<uint32_t> maxQueueDepth { 0 };
+    };
+
+    void runWorker(Worker& worker);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::array<TypeCounters, 256> _typeCounters;
+};
+
+#endif // hifi_PacketDispatchPool_h
@@ -12,6 +12,9 @@
 
 #include "PacketReceiver.h"
 
+#include <algorithm>
+#include <thread>
+
 #include <QtCore/QMetaObject>
 #include <QtCore/QMutexLocker>
 
@@ -20,7 +23,12 @@
 #include "NodeList.h"
 #include "SharedUtil.h"
 
-PacketReceiver::PacketReceiver(QObject* parent) : QObject(parent) {
+static const int MAX_DEFAULT_DISPATCH_WORKERS = 4;
+
+PacketReceiver::PacketReceiver(QObject* parent) :
+    QObject(parent),
+    _numDispatchWorkers(std::max(1, std::min(MAX_DEFAULT_DISPATCH_WORKERS, (int)std::thread::hardware_concurrency() / 2)))
+{
     qRegisterMetaType<QSharedPointer<NLPacket>>();
     qRegisterMetaType<QSharedPointer<NLPacketList>>();
     qRegisterMetaType<QSharedPointer<ReceivedMessage>>();
@@ -84,6 +92,38 @@ bool PacketReceiver::registerListener(PacketType type, const ListenerReferencePo
     }
 }
 
+bool PacketReceiver::registerConcurrentListener(PacketType type, const ListenerReferencePointer& listener) {
+    Q_ASSERT_X(listener, "PacketReceiver::registerConcurrentListener", "No listener to register");
+
+    if (matchingMethodForListener(type, listener)) {
+        qCDebug(networking) << "Registering a concurrent packet listener for packet list type" << type;
+        registerVerifiedListener(type, listener, false, true);
+        return true;
+    } else {
+        qCWarning(networking) << "FAILED to Register a concurrent packet listener for packet list type" << type;
+        return false;
+    }
+}
+
+bool PacketReceiver::registerConcurrentListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener) {
+    Q_ASSERT_X(!types.empty(), "PacketReceiver::registerConcurrentListenerForTypes", "No types to register");
+
+    bool success = true;
+    for (auto type : types) {
+        success = registerConcurrentListener(type, listener) && success;
+    }
+    return success;
+}
+
+PacketDispatchPool::StatsVector PacketReceiver::sampleDispatchStats() {
+    PacketDispatchPool* dispatchPool;
+    {
+        QMutexLocker locker(&_packetListenerLock);
+        dispatchPool = _dispatchPool.get();
+    }
+    return dispatchPool ? dispatchPool->sampleStats() : PacketDispatchPool::StatsVector();
+}
+
 bool PacketReceiver::matchingMethodForListener(PacketType type, const ListenerReferencePointer& listener) const {
     Q_ASSERT_X(listener, "PacketReceiver::matchingMethodForListener", "No listener to call");
 
@@ -99,22 +139,28 @@ bool PacketReceiver::matchingMethodForListener(PacketType type, const ListenerRe
     return true;
 }
 
-void PacketReceiver::registerVerifiedListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending) {
+void PacketReceiver::registerVerifiedListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending,
+                                              bool isConcurrent) {
     Q_ASSERT_X(listener, "PacketReceiver::registerVerifiedListener", "No listener to register");
     QMutexLocker locker(&_packetListenerLock);
 
+    if (isConcurrent && !_dispatchPool) {
+        _dispatchPool.reset(new PacketDispatchPool("Packet Dispatch", _numDispatchWorkers));
+    }
+
     if (_messageListenerMap.contains(type)) {
         qCWarning(networking) << "Registering a packet listener for packet type" << type
             << "that will remove a previously registered listener";
     }
     
     // add the mapping
-    _messageListenerMap[type] = { listener, deliverPending };
+    _messageListenerMap[type] = { listener, deliverPending, isConcurrent };
 }
 
 void PacketReceiver::unregisterListener(QObject* listener) {
     Q_ASSERT_X(listener, "PacketReceiver::unregisterListener", "No listener to unregister");
     
+    PacketDispatchPool* dispatchPool = nullptr;
     {
         QMutexLocker packetListenerLocker(&_packetListenerLock);
         
@@ -122,13 +168,21 @@ void PacketReceiver::unregisterListener(QObject* listener) {
         auto it = _messageListenerMap.begin();
         
         while (it != _messageListenerMap.end()) {
-            if (it.value().listener->getObject() == listener) {
+            if (it.value().listener && it.value().listener->getObject() == listener) {
+                if (it.value().isConcurrent) {
+                    dispatchPool = _dispatchPool.get();
+                }
                 it = _messageListenerMap.erase(it);
             } else {
                 ++it;
             }
         }
     }
+
+    // the workers may still be delivering packets to it, wait for them to be done before the listener goes away
+    if (dispatchPool) {
+        dispatchPool->flush();
+    }
     
     QMutexLocker directConnectSetLocker(&_directConnectSetMutex);
     _directlyConnectedObjects.remove(listener);
@@ -202,6 +256,21 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
         if ((listener.deliverPending && !justReceived) || (!listener.deliverPending && !receivedMessage->isComplete())) {
             return;
         }
+
+        if (listener.isConcurrent) {
+            // the packets of a sender all go to the same worker, to be handled in order
+            auto sourceID = receivedMessage->getSourceID();
+            size_t shard = sourceID != Node::NULL_LOCAL_ID ? (size_t)sourceID
+                                                           : std::hash<HifiSockAddr>()(receivedMessage->getSenderSockAddr());
+            auto listenerReference = listener.listener;
+            _dispatchPool->dispatch(shard, receivedMessage->getType(), [listenerReference, receivedMessage, matchingNode] {
+                if (!listenerReference->invokeDirectly(receivedMessage, matchingNode)) {
+                    qCDebug(networking).nospace() << "Error delivering packet " << receivedMessage->getType()
+                        << " to concurrent listener";
+                }
+            });
+            return;
+        }
             
         bool success = false;
 
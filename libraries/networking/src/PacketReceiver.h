@@ -13,6 +13,7 @@
 #ifndef hifi_PacketReceiver_h
 #define hifi_PacketReceiver_h
 
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
@@ -25,6 +26,7 @@
 
 #include "NLPacket.h"
 #include "NLPacketList.h"
+#include "PacketDispatchPool.h"
 #include "ReceivedMessage.h"
 #include "udt/PacketHeaders.h"
 
@@ -74,6 +76,17 @@ public:
     // for the message is received.
     bool registerListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending = false);
     bool registerListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener);
+
+    // A concurrent listener is called on one of the dispatch workers rather than on its object's thread, with complete
+    // messages only. The messages of a sender are delivered in order, but those of different senders concurrently, so
+    // the listener must be thread-safe. Packets of the same sender handled by other listeners aren't ordered with these.
+    bool registerConcurrentListener(PacketType type, const ListenerReferencePointer& listener);
+    bool registerConcurrentListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener);
+
+    // the number of dispatch workers, to set before the first concurrent listener is registered
+    void setNumDispatchWorkers(int numWorkers) { _numDispatchWorkers = numWorkers; }
+    PacketDispatchPool::StatsVector sampleDispatchStats();
+
     void unregisterListener(QObject* listener);
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
@@ -110,6 +123,7 @@ private:
     struct Listener {
         ListenerReferencePointer listener;
         bool deliverPending;
+        bool isConcurrent;
     };
 
     void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
@@ -120,7 +134,8 @@ private:
     void registerDirectListener(PacketType type, const ListenerReferencePointer& listener);
 
     bool matchingMethodForListener(PacketType type, const ListenerReferencePointer& listener) const;
-    void registerVerifiedListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending = false);
+    void registerVerifiedListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending = false,
+                                  bool isConcurrent = false);
 
     QMutex _packetListenerLock;
     QHash<PacketType, Listener> _messageListenerMap;
@@ -129,6 +144,9 @@ private:
     QMutex _directConnectSetMutex;
     QSet<QObject*> _directlyConnectedObjects;
 
+    int _numDispatchWorkers;
+    std::unique_ptr<PacketDispatchPool> _dispatchPool; // created with the first concurrent listener
+
     std::unordered_map<std::pair<HifiSockAddr, udt::Packet::MessageNumber>, QSharedPointer<ReceivedMessage>> _pendingMessages;
     
     friend class EntityEditPacketSender;
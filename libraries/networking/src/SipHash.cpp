@@ -0,0 +1,92 @@
+//
+//  SipHash.cpp
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SipHash.h"
+
+static inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t readLittleEndian(const unsigned char* bytes) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+static inline void writeLittleEndian(uint64_t value, unsigned char* bytes) {
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+namespace {
+    struct SipState {
+        uint64_t v0, v1, v2, v3;
+
+        void round() {
+            v0 += v1; v1 = rotateLeft(v1, 13); v1 ^= v0; v0 = rotateLeft(v0, 32);
+            v2 += v3; v3 = rotateLeft(v3, 16); v3 ^= v2;
+            v0 += v3; v3 = rotateLeft(v3, 21); v3 ^= v0;
+            v2 += v1; v1 = rotateLeft(v1, 17); v1 ^= v2; v2 = rotateLeft(v2, 32);
+        }
+
+        void compress(uint64_t message) {
+            v3 ^= message;
+            round();
+            round();
+            v0 ^= message;
+        }
+
+        uint64_t finalize() {
+            round();
+            round();
+            round();
+            round();
+            return v0 ^ v1 ^ v2 ^ v3;
+        }
+    };
+}
+
+void SipHash::keyFromBytes(const unsigned char* keyBytes, size_t keyLength, uint64_t& k0, uint64_t& k1) {
+    // shorter keys are padded with zeros, longer ones cut to the first 16 bytes
+    unsigned char paddedKey[KEY_SIZE] = { 0 };
+    for (size_t i = 0; i < keyLength && i < KEY_SIZE; ++i) {
+        paddedKey[i] = keyBytes[i];
+    }
+    k0 = readLittleEndian(paddedKey);
+    k1 = readLittleEndian(paddedKey + 8);
+}
+
+void SipHash::hash128(uint64_t k0, uint64_t k1, const unsigned char* data, size_t dataLength, unsigned char* hashResult) {
+    SipState state {
+        0x736f6d6570736575ULL ^ k0,
+        0x646f72616e646f6dULL ^ k1 ^ 0xee,
+        0x6c7967656e657261ULL ^ k0,
+        0x7465646279746573ULL ^ k1
+    };
+
+    const size_t fullBlocksLength = dataLength - (dataLength % 8);
+    for (size_t offset = 0; offset < fullBlocksLength; offset += 8) {
+        state.compress(readLittleEndian(data + offset));
+    }
+
+    uint64_t lastBlock = (uint64_t)dataLength << 56;
+    for (size_t i = 0; i < dataLength % 8; ++i) {
+        lastBlock |= (uint64_t)data[fullBlocksLength + i] << (8 * i);
+    }
+    state.compress(lastBlock);
+
+    state.v2 ^= 0xee;
+    writeLittleEndian(state.finalize(), hashResult);
+    state.v1 ^= 0xdd;
+    writeLittleEndian(state.finalize(), hashResult + 8);
+}
@@ -0,0 +1,27 @@
+//
+//  SipHash.h
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SipHash_h
+#define hifi_SipHash_h
+
+#include <cstddef>
+#include <cstdint>
+
+// SipHash-2-4 with a 128 bit output, a keyed hash fast enough on short inputs to authenticate every packet.
+// See https://131002.net/siphash/ - the key is the two little-endian 64 bit halves of the 16 byte key.
+namespace SipHash {
+    static const size_t KEY_SIZE = 16;
+    static const size_t HASH_SIZE = 16;
+
+    void keyFromBytes(const unsigned char* keyBytes, size_t keyLength, uint64_t& k0, uint64_t& k1);
+    void hash128(uint64_t k0, uint64_t k1, const unsigned char* data, size_t dataLength, unsigned char* hashResult);
+}
+
+#endif // hifi_SipHash_h
@@ -14,6 +14,7 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
+#include <QtCore/QMetaEnum>
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
@@ -119,8 +120,50 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     ioStats["outbound_kbps"] = nodeList->getOutboundKbps();
     ioStats["outbound_pps"] = nodeList->getOutboundPPS();
 
+    if (nodeList->isBatchedReceiveEnabled()) {
+        auto batchStats = nodeList->sampleReceiveBatchStats();
+        ioStats["receive_batches"] = (double)batchStats.batches;
+        ioStats["receive_batched_datagrams"] = (double)batchStats.datagrams;
+        ioStats["receive_largest_batch"] = batchStats.largestBatch;
+        ioStats["receive_avg_batch_size"] = batchStats.batches > 0 ?
+            (double)batchStats.datagrams / (double)batchStats.batches : 0.0;
+    }
+
+    if (nodeList->isBatchedSendEnabled()) {
+        auto batchStats = nodeList->sampleSendBatchStats();
+        ioStats["send_batches"] = (double)batchStats.batches;
+        ioStats["send_batched_datagrams"] = (double)batchStats.datagrams;
+        ioStats["send_batch_syscalls"] = (double)batchStats.systemCalls;
+        ioStats["send_batch_failed_datagrams"] = (double)batchStats.failedDatagrams;
+    }
+
     statsObject["io_stats"] = ioStats;
 
+    auto registryStats = nodeList->sampleNodeRegistryStats();
+    QJsonObject registryStatsObject;
+    registryStatsObject["snapshot_updates"] = (double)registryStats.snapshotUpdates;
+    registryStatsObject["snapshot_update_usecs"] = (double)registryStats.snapshotUpdateUsecs;
+    registryStatsObject["write_locks"] = (double)registryStats.writeLocks;
+    registryStatsObject["write_lock_wait_usecs"] = (double)registryStats.writeLockWaitUsecs;
+    registryStatsObject["max_write_lock_wait_usecs"] = (double)registryStats.maxWriteLockWaitUsecs;
+    statsObject["node_registry"] = registryStatsObject;
+
+    auto dispatchStats = nodeList->getPacketReceiver().sampleDispatchStats();
+    if (!dispatchStats.empty()) {
+        QMetaEnum packetTypeEnum = PacketTypeEnum::staticMetaObject.enumerator(PacketTypeEnum::staticMetaObject.enumeratorOffset());
+        QJsonObject dispatchStatsObject;
+        for (const auto& typeStats : dispatchStats) {
+            const auto& stats = typeStats.second;
+            QJsonObject typeStatsObject;
+            typeStatsObject["packets"] = (double)stats.packets;
+            typeStatsObject["avg_latency_usecs"] = stats.packets > 0 ? (double)stats.latencyUsecs / (double)stats.packets : 0.0;
+            typeStatsObject["max_latency_usecs"] = (double)stats.maxLatencyUsecs;
+            typeStatsObject["max_queue_depth"] = (double)stats.maxQueueDepth;
+            dispatchStatsObject[packetTypeEnum.valueToKey((int)typeStats.first)] = typeStatsObject;
+        }
+        statsObject["packet_dispatch"] = dispatchStatsObject;
+    }
+
     QJsonObject assignmentStats;
     assignmentStats["numQueuedCheckIns"] = _numQueuedCheckIns;
 
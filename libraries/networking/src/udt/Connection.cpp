@@ -24,6 +24,7 @@
 #include "ControlPacket.h"
 #include "Packet.h"
 #include "PacketList.h"
+#include "SendQueueScheduler.h"
 #include "Socket.h"
 #include <Trace.h>
 
@@ -67,6 +68,17 @@ Connection::~Connection() {
 }
 
 void Connection::stopSendQueue() {
+    if (_sendQueue && _sendQueue->isScheduled()) {
+        _sendQueue->stop();
+
+        _lastMessageNumber = _sendQueue->getCurrentMessageNumber();
+
+        // once the scheduler lets go of it no other thread can touch the send queue
+        SendQueueScheduler::getInstance().remove(_sendQueue.get());
+        _sendQueue.reset();
+        return;
+    }
+
     if (auto sendQueue = _sendQueue.release()) {
         // grab the send queue thread so we can wait on it
         QThread* sendQueueThread = sendQueue->thread();
@@ -386,7 +386,14 @@ enum class DomainListVersion : PacketVersion {
     GetMachineFingerprintFromUUIDSupport,
     AuthenticationOptional,
     HasTimestamp,
-    HasConnectReason
+    HasConnectReason,
+    HasDeltaLists,
+    HasAuthenticationMethod
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    PreListVersion = 22,
+    HasListVersion
 };
 
 enum class AudioVersion : PacketVersion {
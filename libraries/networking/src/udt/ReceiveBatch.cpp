@@ -0,0 +1,124 @@
+//
+//  ReceiveBatch.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReceiveBatch.h"
+
+#include <algorithm>
+#include <vector>
+
+#if defined(Q_OS_LINUX)
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#endif
+
+#include "Constants.h"
+
+using namespace udt;
+
+#if defined(Q_OS_LINUX)
+
+struct ReceiveBatch::Ring {
+    std::unique_ptr<char[]> buffers;
+    std::vector<mmsghdr> headers;
+    std::vector<iovec> vectors;
+    std::vector<sockaddr_storage> addresses;
+};
+
+bool ReceiveBatch::isSupported() {
+    return true;
+}
+
+ReceiveBatch::ReceiveBatch(int batchSize) :
+    _capacity(std::max(batchSize, 1)),
+    _ring(new Ring())
+{
+    // one contiguous block for the whole ring, each slot is large enough for any udt packet
+    _ring->buffers.reset(new char[_capacity * MAX_PACKET_SIZE]);
+    _ring->headers.resize(_capacity);
+    _ring->vectors.resize(_capacity);
+    _ring->addresses.resize(_capacity);
+
+    for (int i = 0; i < _capacity; ++i) {
+        _ring->vectors[i].iov_base = _ring->buffers.get() + (i * MAX_PACKET_SIZE);
+        _ring->vectors[i].iov_len = MAX_PACKET_SIZE;
+    }
+}
+
+int ReceiveBatch::receive(qintptr socketDescriptor) {
+    // the kernel overwrites the name and message lengths, so they are reset before every batch
+    for (int i = 0; i < _capacity; ++i) {
+        auto& header = _ring->headers[i];
+        memset(&header, 0, sizeof(mmsghdr));
+        header.msg_hdr.msg_name = &_ring->addresses[i];
+        header.msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+        header.msg_hdr.msg_iov = &_ring->vectors[i];
+        header.msg_hdr.msg_iovlen = 1;
+    }
+
+    int numReceived = 0;
+    do {
+        numReceived = recvmmsg((int)socketDescriptor, _ring->headers.data(), _capacity, MSG_DONTWAIT, nullptr);
+    } while (numReceived < 0 && errno == EINTR);
+
+    if (numReceived < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+
+    return numReceived;
+}
+
+const char* ReceiveBatch::getData(int index) const {
+    return reinterpret_cast<const char*>(_ring->vectors[index].iov_base);
+}
+
+int ReceiveBatch::getSize(int index) const {
+    // a datagram larger than a ring slot was truncated and can't be a valid udt packet
+    if (_ring->headers[index].msg_hdr.msg_flags & MSG_TRUNC) {
+        return 0;
+    }
+    return (int)_ring->headers[index].msg_len;
+}
+
+HifiSockAddr ReceiveBatch::getSenderSockAddr(int index) const {
+    return HifiSockAddr(reinterpret_cast<const sockaddr*>(&_ring->addresses[index]));
+}
+
+#else
+
+struct ReceiveBatch::Ring {};
+
+bool ReceiveBatch::isSupported() {
+    return false;
+}
+
+ReceiveBatch::ReceiveBatch(int batchSize) : _capacity(0) {}
+
+int ReceiveBatch::receive(qintptr socketDescriptor) {
+    return -1;
+}
+
+const char* ReceiveBatch::getData(int index) const {
+    return nullptr;
+}
+
+int ReceiveBatch::getSize(int index) const {
+    return 0;
+}
+
+HifiSockAddr ReceiveBatch::getSenderSockAddr(int index) const {
+    return HifiSockAddr();
+}
+
+#endif
+
+ReceiveBatch::~ReceiveBatch() {
+}
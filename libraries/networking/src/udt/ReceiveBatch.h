@@ -0,0 +1,56 @@
+//
+//  ReceiveBatch.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ReceiveBatch_h
+#define hifi_ReceiveBatch_h
+
+#include <memory>
+
+#include <QtCore/QtGlobal>
+
+#include "../HifiSockAddr.h"
+
+namespace udt {
+
+// Drains a UDP socket several datagrams per system call (recvmmsg on Linux).
+// The ring of MAX_PACKET_SIZE receive buffers is allocated once and reused for every batch,
+// so the datagrams returned by getData are only valid until the next call to receive.
+class ReceiveBatch {
+public:
+    static const int DEFAULT_BATCH_SIZE = 64;
+
+    // true if the platform has a batched receive call, otherwise receive always returns -1
+    static bool isSupported();
+
+    ReceiveBatch(int batchSize = DEFAULT_BATCH_SIZE);
+    ~ReceiveBatch();
+
+    // reads up to getCapacity() datagrams without blocking
+    // returns the number of datagrams read, 0 if none were pending, or -1 on error
+    int receive(qintptr socketDescriptor);
+
+    int getCapacity() const { return _capacity; }
+
+    const char* getData(int index) const;
+    int getSize(int index) const;
+    HifiSockAddr getSenderSockAddr(int index) const;
+
+private:
+    struct Ring;
+
+    int _capacity { 0 };
+    std::unique_ptr<Ring> _ring;
+};
+
+} // namespace udt
+
+#endif // hifi_ReceiveBatch_h
@@ -0,0 +1,235 @@
+//
+//  SendBatch.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendBatch.h"
+
+#include <algorithm>
+#include <vector>
+
+#if defined(Q_OS_LINUX)
+#include <errno.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#endif
+
+#include "Constants.h"
+
+using namespace udt;
+
+#if defined(Q_OS_LINUX)
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+// the kernel refuses GSO messages with more than 64 segments or a payload that doesn't fit in one IPv4 datagram
+static const int MAX_SEGMENTS_PER_MESSAGE = 64;
+static const int MAX_BYTES_PER_MESSAGE = 65507;
+
+struct SendBatch::Messages {
+    struct Entry {
+        sockaddr_in address;
+        int offset { 0 };
+        int length { 0 };
+        int segmentSize { 0 };
+        int numSegments { 0 };
+        bool isClosed { false }; // a short final segment was added, nothing else can follow it
+    };
+
+    union Control {
+        cmsghdr header;
+        char buffer[CMSG_SPACE(sizeof(uint16_t))];
+    };
+
+    std::unique_ptr<char[]> arena;
+    int arenaSize { 0 };
+
+    std::vector<Entry> entries;
+    std::vector<mmsghdr> headers;
+    std::vector<iovec> vectors;
+    std::vector<Control> controls;
+};
+
+bool SendBatch::isSupported() {
+    return true;
+}
+
+SendBatch::SendBatch(int batchSize) :
+    _capacity(std::max(batchSize, 1)),
+    _messages(new Messages())
+{
+    _messages->arena.reset(new char[_capacity * MAX_PACKET_SIZE]);
+    _messages->entries.reserve(_capacity);
+    _messages->headers.resize(_capacity);
+    _messages->vectors.resize(_capacity);
+    _messages->controls.resize(_capacity);
+}
+
+bool SendBatch::append(const char* data, qint64 size, const HifiSockAddr& sockAddr) {
+    if (isFull() || size <= 0 || size > MAX_PACKET_SIZE
+        || sockAddr.getAddress().protocol() != QAbstractSocket::IPv4Protocol) {
+        return false;
+    }
+
+    auto& entries = _messages->entries;
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(sockaddr_in));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(sockAddr.getPort());
+    address.sin_addr.s_addr = htonl(sockAddr.getAddress().toIPv4Address());
+
+    char* destination = _messages->arena.get() + _messages->arenaSize;
+    memcpy(destination, data, size);
+    _messages->arenaSize += (int)size;
+    ++_numDatagrams;
+
+    if (_segmentationOffloadEnabled && !entries.empty()) {
+        // datagrams are stored back to back, so a run to the same destination is already contiguous in the arena
+        auto& last = entries.back();
+        if (!last.isClosed && last.address.sin_addr.s_addr == address.sin_addr.s_addr
+            && last.address.sin_port == address.sin_port && size <= last.segmentSize
+            && last.numSegments < MAX_SEGMENTS_PER_MESSAGE && last.length + size <= MAX_BYTES_PER_MESSAGE) {
+            last.length += (int)size;
+            ++last.numSegments;
+            last.isClosed = size < last.segmentSize;
+            return true;
+        }
+    }
+
+    Messages::Entry entry;
+    entry.address = address;
+    entry.offset = (int)(destination - _messages->arena.get());
+    entry.length = (int)size;
+    entry.segmentSize = (int)size;
+    entry.numSegments = 1;
+    entries.push_back(entry);
+
+    return true;
+}
+
+SendBatch::FlushStats SendBatch::flush(qintptr socketDescriptor) {
+    FlushStats stats;
+
+    auto& entries = _messages->entries;
+    const int numMessages = (int)entries.size();
+
+    for (int i = 0; i < numMessages; ++i) {
+        auto& entry = entries[i];
+        auto& header = _messages->headers[i];
+        auto& vector = _messages->vectors[i];
+
+        memset(&header, 0, sizeof(mmsghdr));
+        vector.iov_base = _messages->arena.get() + entry.offset;
+        vector.iov_len = entry.length;
+
+        header.msg_hdr.msg_name = &entry.address;
+        header.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        header.msg_hdr.msg_iov = &vector;
+        header.msg_hdr.msg_iovlen = 1;
+
+        if (entry.numSegments > 1) {
+            auto& control = _messages->controls[i];
+            memset(&control, 0, sizeof(Messages::Control));
+            header.msg_hdr.msg_control = control.buffer;
+            header.msg_hdr.msg_controllen = sizeof(control.buffer);
+
+            cmsghdr* controlMessage = CMSG_FIRSTHDR(&header.msg_hdr);
+            controlMessage->cmsg_level = SOL_UDP;
+            controlMessage->cmsg_type = UDP_SEGMENT;
+            controlMessage->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            uint16_t segmentSize = (uint16_t)entry.segmentSize;
+            memcpy(CMSG_DATA(controlMessage), &segmentSize, sizeof(uint16_t));
+        }
+    }
+
+    int numSent = 0;
+    while (numSent < numMessages) {
+        int result = sendmmsg((int)socketDescriptor, _messages->headers.data() + numSent, numMessages - numSent, 0);
+        ++stats.systemCalls;
+
+        if (result > 0) {
+            for (int i = numSent; i < numSent + result; ++i) {
+                stats.datagrams += entries[i].numSegments;
+            }
+            numSent += result;
+            continue;
+        }
+
+        if (errno == EINTR) {
+            continue;
+        }
+
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            // the socket send buffer is full, like a failed writeDatagram the remaining datagrams are dropped
+            for (int i = numSent; i < numMessages; ++i) {
+                stats.failedDatagrams += entries[i].numSegments;
+            }
+            break;
+        }
+
+        auto& failed = entries[numSent];
+        if (failed.numSegments > 1) {
+            // the kernel or the interface can't do segmentation offload, stop coalescing and send the run one by one
+            _segmentationOffloadEnabled = false;
+
+            const char* segment = _messages->arena.get() + failed.offset;
+            int remaining = failed.length;
+            while (remaining > 0) {
+                int segmentSize = std::min(remaining, failed.segmentSize);
+                auto bytesSent = sendto((int)socketDescriptor, segment, segmentSize, 0,
+                                        reinterpret_cast<const sockaddr*>(&failed.address), sizeof(sockaddr_in));
+                ++stats.systemCalls;
+                if (bytesSent < 0) {
+                    ++stats.failedDatagrams;
+                } else {
+                    ++stats.datagrams;
+                }
+                segment += segmentSize;
+                remaining -= segmentSize;
+            }
+        } else {
+            ++stats.failedDatagrams;
+        }
+        ++numSent;
+    }
+
+    entries.clear();
+    _messages->arenaSize = 0;
+    _numDatagrams = 0;
+
+    return stats;
+}
+
+#else
+
+struct SendBatch::Messages {};
+
+bool SendBatch::isSupported() {
+    return false;
+}
+
+SendBatch::SendBatch(int batchSize) : _capacity(0) {}
+
+bool SendBatch::append(const char* data, qint64 size, const HifiSockAddr& sockAddr) {
+    return false;
+}
+
+SendBatch::FlushStats SendBatch::flush(qintptr socketDescriptor) {
+    return FlushStats();
+}
+
+#endif
+
+SendBatch::~SendBatch() {
+}
@@ -0,0 +1,68 @@
+//
+//  SendBatch.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SendBatch_h
+#define hifi_SendBatch_h
+
+#include <memory>
+
+#include <QtCore/QtGlobal>
+
+#include "../HifiSockAddr.h"
+
+namespace udt {
+
+// Accumulates outgoing datagrams and writes them several per system call (sendmmsg on Linux).
+// Consecutive equally sized datagrams to the same destination are coalesced into a single
+// UDP generic segmentation offload (GSO) message when the kernel supports it.
+class SendBatch {
+public:
+    static const int DEFAULT_BATCH_SIZE = 64;
+
+    struct FlushStats {
+        int datagrams { 0 };
+        int systemCalls { 0 };
+        int failedDatagrams { 0 };
+    };
+
+    // true if the platform has a batched send call, otherwise append always returns false
+    static bool isSupported();
+
+    SendBatch(int batchSize = DEFAULT_BATCH_SIZE);
+    ~SendBatch();
+
+    // copies the datagram into the batch
+    // returns false if the datagram can't be batched (full batch or unsupported address), it must then be sent directly
+    bool append(const char* data, qint64 size, const HifiSockAddr& sockAddr);
+
+    // writes every queued datagram to the socket and empties the batch
+    FlushStats flush(qintptr socketDescriptor);
+
+    bool isEmpty() const { return _numDatagrams == 0; }
+    bool isFull() const { return _numDatagrams == _capacity; }
+    int getCapacity() const { return _capacity; }
+
+    void setSegmentationOffloadEnabled(bool enabled) { _segmentationOffloadEnabled = enabled; }
+    bool isSegmentationOffloadEnabled() const { return _segmentationOffloadEnabled; }
+
+private:
+    struct Messages;
+
+    int _capacity { 0 };
+    int _numDatagrams { 0 };
+    bool _segmentationOffloadEnabled { true };
+    std::unique_ptr<Messages> _messages;
+};
+
+} // namespace udt
+
+#endif // hifi_SendBatch_h
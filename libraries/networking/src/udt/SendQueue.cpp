@@ -17,6 +17,7 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
 #include <QtCore/QJsonObject>
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 
 #include <LogHandler.h>
@@ -28,6 +29,7 @@
 #include "Packet.h"
 #include "PacketList.h"
 #include "../UserActivityLogger.h"
+#include "SendQueueScheduler.h"
 #include "Socket.h"
 #include <Trace.h>
 #include <Profile.h>
@@ -65,6 +67,26 @@ private:
 const microseconds SendQueue::MAXIMUM_ESTIMATED_TIMEOUT = seconds(5);
 const microseconds SendQueue::MINIMUM_ESTIMATED_TIMEOUT = milliseconds(10);
 
+static const auto HANDSHAKE_RESEND_INTERVAL = milliseconds(100);
+static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = seconds(5);
+
+static SendQueue::SchedulingMode defaultSchedulingMode() {
+    static const QString SEND_QUEUE_MODE_ENV = "HIFI_UDT_SEND_QUEUE_MODE";
+    auto mode = QProcessEnvironment::systemEnvironment().value(SEND_QUEUE_MODE_ENV);
+    return mode.compare("scheduled", Qt::CaseInsensitive) == 0 ?
+        SendQueue::SchedulingMode::Scheduled : SendQueue::SchedulingMode::Threaded;
+}
+
+static std::atomic<SendQueue::SchedulingMode> schedulingMode { defaultSchedulingMode() };
+
+SendQueue::SchedulingMode SendQueue::getSchedulingMode() {
+    return schedulingMode;
+}
+
+void SendQueue::setSchedulingMode(SchedulingMode mode) {
+    schedulingMode = mode;
+}
+
 std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destination, SequenceNumber currentSequenceNumber,
                                              MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK) {
     Q_ASSERT_X(socket, "SendQueue::create", "Must be called with a valid Socket*");
@@ -72,6 +94,13 @@ std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destin
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination, currentSequenceNumber,
                                                           currentMessageNumber, hasReceivedHandshakeACK));
 
+    if (getSchedulingMode() == SchedulingMode::Scheduled) {
+        // the queue stays on the caller's thread and the shared scheduler workers drive its send loop
+        queue->_isScheduled = true;
+        SendQueueScheduler::getInstance().add(queue.get());
+        return queue;
+    }
+
     // Setup queue private thread
     QThread* thread = new QThread();
     QString name = "Networking: SendQueue " + destination.objectName();
@@ -111,10 +140,10 @@ SendQueue::~SendQueue() {
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
+    // wake the send loop in case it is sleeping waiting for packets
+    wakeUp();
     
-    if (!thread()->isRunning() && _state == State::NotStarted) {
+    if (!_isScheduled && !thread()->isRunning() && _state == State::NotStarted) {
         thread()->start();
     }
 }
@@ -122,10 +151,10 @@ void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
+    // wake the send loop in case it is sleeping waiting for packets
+    wakeUp();
     
-    if (!thread()->isRunning() && _state == State::NotStarted) {
+    if (!_isScheduled && !thread()->isRunning() && _state == State::NotStarted) {
         thread()->start();
     }
 }
@@ -138,6 +167,14 @@ void SendQueue::stop() {
     _handshakeACKCondition.notify_one();
     _emptyCondition.notify_one();
 }
+
+void SendQueue::wakeUp() {
+    if (_isScheduled) {
+        SendQueueScheduler::getInstance().wake(this);
+    } else {
+        _emptyCondition.notify_one();
+    }
+}
     
 int SendQueue::sendPacket(const Packet& packet) {
     _lastPacketSentAt = std::chrono::high_resolution_clock::now();
@@ -167,8 +204,8 @@ void SendQueue::ack(SequenceNumber ack) {
     
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // wake the send loop in case it is sleeping with a full congestion window
+    wakeUp();
 }
 
 void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
@@ -177,27 +214,30 @@ void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
         _naks.insert(ack, ack);
     }
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the send loop in case it is sleeping waiting for losses to re-send
+    wakeUp();
 }
 
 void SendQueue::sendHandshake() {
     std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
     if (!_hasReceivedHandshakeACK) {
         // we haven't received a handshake ACK from the client, send another now
-        // if the handshake hasn't been completed, then the initial sequence number
-        // should be the current sequence number + 1
-        SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
-        auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
-        handshakePacket->writePrimitive(initialSequenceNumber);
-        _socket->writeBasePacket(*handshakePacket, _destination);
+        sendHandshakePacket();
         
         // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
         _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
     }
 }
 
+void SendQueue::sendHandshakePacket() {
+    // if the handshake hasn't been completed, then the initial sequence number
+    // should be the current sequence number + 1
+    SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
+    auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
+    handshakePacket->writePrimitive(initialSequenceNumber);
+    _socket->writeBasePacket(*handshakePacket, _destination);
+}
+
 void SendQueue::handshakeACK() {
     {
         std::lock_guard<std::mutex> locker { _handshakeMutex };
@@ -205,7 +245,11 @@ void SendQueue::handshakeACK() {
     }
 
     // Notify on the handshake ACK condition
-    _handshakeACKCondition.notify_one();
+    if (_isScheduled) {
+        wakeUp();
+    } else {
+        _handshakeACKCondition.notify_one();
+    }
 }
 
 SequenceNumber SendQueue::getNextSequenceNumber() {
@@ -272,6 +316,7 @@ void SendQueue::run() {
 
         // Keep processing events
         QCoreApplication::sendPostedEvents(this);
+        applyPendingDestinationAddress();
         
         // Once we're here we've either received the handshake ACK or it's going to be time to re-send a handshake.
         // Either way let's continue processing - no packets will be sent if no handshake ACK has been received.
@@ -293,6 +338,7 @@ void SendQueue::run() {
         
         // since we're a while loop, give the thread a chance to process events
         QCoreApplication::sendPostedEvents(this);
+        applyPendingDestinationAddress();
         
         // we just processed events so check now if we were just told to stop
         // If the send queue has been innactive, skip the sleep for
@@ -358,6 +404,143 @@ void SendQueue::run() {
     }
 }
 
+bool SendQueue::step(p_high_resolution_clock::time_point now, p_high_resolution_clock::time_point& nextStepAt) {
+    // this mirrors run(), with every blocking wait replaced by the deadline handed back to the scheduler
+
+    if (_state == State::NotStarted) {
+        _state = State::Running;
+        _nextHandshakeAt = now;
+    }
+
+    if (_state != State::Running) {
+        return false;
+    }
+
+    applyPendingDestinationAddress();
+
+    if (!_hasReceivedHandshakeACK) {
+        if (now >= _nextHandshakeAt) {
+            sendHandshakePacket();
+            _nextHandshakeAt = now + HANDSHAKE_RESEND_INTERVAL;
+        }
+
+        // pacing starts from the moment the handshake is ACKed
+        _nextPacketTimestamp = now;
+        nextStepAt = _nextHandshakeAt;
+        return true;
+    }
+
+    // send whatever is due, yielding to the other queues after a burst
+    static const int MAX_PACKETS_PER_STEP = 64;
+
+    for (int i = 0; i < MAX_PACKETS_PER_STEP; ++i) {
+        if (_state != State::Running) {
+            return false;
+        }
+
+        if (_packetSendPeriod > 0 && now < _nextPacketTimestamp) {
+            nextStepAt = _nextPacketTimestamp;
+            return true;
+        }
+
+        bool attemptedToSendPacket = maybeResendPacket();
+
+        auto newPacketCount = 0;
+        if (!attemptedToSendPacket) {
+            newPacketCount = maybeSendNewPacket();
+            attemptedToSendPacket = (newPacketCount > 0);
+        }
+
+        if (!attemptedToSendPacket) {
+            return stepWhileIdle(now, nextStepAt);
+        }
+
+        _wait = Wait::None;
+
+        if (_packetSendPeriod > 0) {
+            // push the next packet timestamp forwards by the current packet send period
+            auto nextPacketDelta = std::chrono::microseconds((newPacketCount == 2 ? 2 : 1) * _packetSendPeriod);
+            _nextPacketTimestamp += nextPacketDelta;
+
+            // as in run(), never let nextPacketTimestamp make us wait for more than nextPacketDelta
+            if (_nextPacketTimestamp - now > nextPacketDelta) {
+                _nextPacketTimestamp = now + nextPacketDelta;
+            }
+        }
+
+        now = p_high_resolution_clock::now();
+    }
+
+    nextStepAt = now;
+    return true;
+}
+
+bool SendQueue::stepWhileIdle(p_high_resolution_clock::time_point now, p_high_resolution_clock::time_point& nextStepAt) {
+    // the scheduled equivalent of isInactive: nothing was sent, so work out what we are waiting for and until when
+    using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
+    DoubleLock doubleLock(_packets.getLock(), _naksLock);
+    DoubleLock::Lock locker(doubleLock, std::try_to_lock);
+
+    if (!locker.owns_lock() || !((_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty())) {
+        // something is being queued right now, come back around
+        _wait = Wait::None;
+        nextStepAt = now;
+        return true;
+    }
+
+    if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
+        // we've sent the client as much data as we have (and they've ACKed it)
+        // either wait for new data to send or 5 seconds before cleaning up the queue
+        if (_wait != Wait::ForData) {
+            _wait = Wait::ForData;
+            _waitDeadline = now + EMPTY_QUEUES_INACTIVE_TIMEOUT;
+        }
+
+        if (now >= _waitDeadline) {
+            locker.unlock();
+            deactivate();
+            return false;
+        }
+
+        nextStepAt = _waitDeadline;
+        return true;
+    }
+
+    // We think the client is still waiting for data (based on the sequence number gap)
+    // Let's wait either for a response from the client or until the estimated timeout has elapsed
+    auto estimatedTimeout = std::chrono::microseconds(_estimatedTimeout);
+    estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, estimatedTimeout));
+
+    if (_wait != Wait::ForACK) {
+        _wait = Wait::ForACK;
+        _waitDeadline = now + estimatedTimeout;
+        nextStepAt = _waitDeadline;
+        return true;
+    }
+
+    auto sinceLastPacketSent = std::chrono::high_resolution_clock::now() - _lastPacketSentAt;
+
+    if ((now >= _waitDeadline || sinceLastPacketSent > estimatedTimeout)
+        && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
+        // after a timeout if we still have sent packets that the client hasn't ACKed we add them to the loss list
+        _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
+
+        locker.unlock();
+
+        _wait = Wait::None;
+        emit timeout();
+
+        nextStepAt = now;
+        return true;
+    }
+
+    if (now >= _waitDeadline) {
+        _waitDeadline = now + estimatedTimeout;
+    }
+    nextStepAt = _waitDeadline;
+    return true;
+}
+
 int SendQueue::maybeSendNewPacket() {
     if (!isFlowWindowFull()) {
         // we didn't re-send a packet, so time to send a new one
@@ -484,8 +667,6 @@ bool SendQueue::isInactive(bool attemptedToSendPacket) {
             if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
                 // we've sent the client as much data as we have (and they've ACKed it)
                 // either wait for new data to send or 5 seconds before cleaning up the queue
-                static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
-                
                 // use our condition_variable_any to wait
                 auto cvStatus = _emptyCondition.wait_for(locker, EMPTY_QUEUES_INACTIVE_TIMEOUT);
                 
@@ -562,5 +743,16 @@ bool SendQueue::isFlowWindowFull() const {
 }
 
 void SendQueue::updateDestinationAddress(HifiSockAddr newAddress) {
-    _destination = newAddress;
+    // picked up by the send loop, which may be running on a scheduler thread
+    std::lock_guard<std::mutex> locker(_destinationMutex);
+    _pendingDestination = newAddress;
+    _hasPendingDestination = true;
+}
+
+void SendQueue::applyPendingDestinationAddress() {
+    if (_hasPendingDestination) {
+        std::lock_guard<std::mutex> locker(_destinationMutex);
+        _destination = _pendingDestination;
+        _hasPendingDestination = false;
+    }
 }
@@ -39,6 +39,7 @@ class ControlPacket;
 class Packet;
 class PacketList;
 class Socket;
+class SendQueueScheduler;
     
 class SendQueue : public QObject {
     Q_OBJECT
@@ -49,6 +50,17 @@ public:
         Running,
         Stopped
     };
+
+    // Threaded queues each run their send loop on a dedicated QThread.
+    // Scheduled queues are stepped by the shared SendQueueScheduler worker threads.
+    enum class SchedulingMode {
+        Threaded,
+        Scheduled
+    };
+
+    // the mode used for queues created from now on, defaults to Threaded unless HIFI_UDT_SEND_QUEUE_MODE=scheduled
+    static SchedulingMode getSchedulingMode();
+    static void setSchedulingMode(SchedulingMode mode);
     
     static std::unique_ptr<SendQueue> create(Socket* socket, HifiSockAddr destination,
                                              SequenceNumber currentSequenceNumber, MessageNumber currentMessageNumber,
@@ -68,6 +80,8 @@ public:
     void setPacketSendPeriod(int newPeriod) { _packetSendPeriod = newPeriod; }
     
     void setEstimatedTimeout(int estimatedTimeout) { _estimatedTimeout = estimatedTimeout; }
+
+    bool isScheduled() const { return _isScheduled; }
     
 public slots:
     void stop();
@@ -93,8 +107,19 @@ private:
               MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK);
     SendQueue(SendQueue& other) = delete;
     SendQueue(SendQueue&& other) = delete;
+
+    friend class SendQueueScheduler;
+
+    // runs the part of the send loop that is due and sets the time the queue wants to be stepped again
+    // returns false once the queue has stopped
+    bool step(p_high_resolution_clock::time_point now, p_high_resolution_clock::time_point& nextStepAt);
+    bool stepWhileIdle(p_high_resolution_clock::time_point now, p_high_resolution_clock::time_point& nextStepAt);
+
+    void wakeUp(); // wakes the send loop after new packets, ACKs or losses
+    void applyPendingDestinationAddress();
     
     void sendHandshake();
+    void sendHandshakePacket();
     
     int sendPacket(const Packet& packet);
     bool sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket, SequenceNumber sequenceNumber);
@@ -142,6 +167,23 @@ private:
 
     std::chrono::high_resolution_clock::time_point _lastPacketSentAt;
 
+    std::mutex _destinationMutex; // Protects the pending destination address
+    std::atomic<bool> _hasPendingDestination { false };
+    HifiSockAddr _pendingDestination;
+
+    bool _isScheduled { false };
+
+    // Scheduled mode loop state, only touched by the scheduler worker currently stepping this queue
+    enum class Wait {
+        None,
+        ForData, // everything sent has been ACKed, waiting for new packets before going inactive
+        ForACK // waiting on the receiver until the estimated timeout
+    };
+    Wait _wait { Wait::None };
+    p_high_resolution_clock::time_point _waitDeadline;
+    p_high_resolution_clock::time_point _nextHandshakeAt;
+    p_high_resolution_clock::time_point _nextPacketTimestamp;
+
     static const std::chrono::microseconds MAXIMUM_ESTIMATED_TIMEOUT;
     static const std::chrono::microseconds MINIMUM_ESTIMATED_TIMEOUT;
 };
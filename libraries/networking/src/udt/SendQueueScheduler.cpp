@@ -0,0 +1,233 @@
+//
+//  SendQueueScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendQueueScheduler.h"
+
+#include <algorithm>
+
+#include <QtCore/QProcessEnvironment>
+
+#include <ThreadHelpers.h>
+
+#include "../NetworkLogging.h"
+#include "SendQueue.h"
+
+using namespace udt;
+using namespace std::chrono;
+
+// 100us ticks keep the wheel coarse enough to be cheap to sweep, SendQueue::step catches up on
+// any packets whose send time passed between ticks so pacing holds on average
+static const int TICK_USECS = 100;
+static const int NUM_WHEEL_SLOTS = 4096; // about 410ms per revolution, later deadlines wait extra rounds
+
+SendQueueScheduler& SendQueueScheduler::getInstance() {
+    static SendQueueScheduler* instance = [] {
+        static const QString SCHEDULER_THREADS_ENV = "HIFI_UDT_SEND_SCHEDULER_THREADS";
+        static const int MIN_THREADS = 2;
+
+        int numThreads = std::max(MIN_THREADS, (int)std::thread::hardware_concurrency() / 4);
+
+        auto environment = QProcessEnvironment::systemEnvironment();
+        if (environment.contains(SCHEDULER_THREADS_ENV)) {
+            bool ok = false;
+            int requestedThreads = environment.value(SCHEDULER_THREADS_ENV).toInt(&ok);
+            if (ok && requestedThreads > 0) {
+                numThreads = requestedThreads;
+            }
+        }
+
+        return new SendQueueScheduler(numThreads);
+    }();
+
+    return *instance;
+}
+
+SendQueueScheduler::SendQueueScheduler(int numThreads) :
+    _epoch(p_high_resolution_clock::now()),
+    _wheel(NUM_WHEEL_SLOTS)
+{
+    qCDebug(networking) << "Starting SendQueue scheduler with" << numThreads << "threads";
+
+    for (int i = 0; i < numThreads; ++i) {
+        _workers.emplace_back([this, i] {
+            setThreadName("Networking: SendQueueScheduler " + std::to_string(i));
+            run();
+        });
+    }
+}
+
+SendQueueScheduler::~SendQueueScheduler() {
+    {
+        Lock lock(_mutex);
+        _stopping = true;
+    }
+    _workCondition.notify_all();
+
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+void SendQueueScheduler::add(SendQueue* queue) {
+    Lock lock(_mutex);
+    auto& record = _records[queue];
+    schedule(queue, record, _currentTick);
+}
+
+void SendQueueScheduler::wake(SendQueue* queue) {
+    Lock lock(_mutex);
+    auto it = _records.find(queue);
+    if (it == _records.end()) {
+        return;
+    }
+
+    auto& record = it->second;
+    if (record.isStepping) {
+        // the worker stepping it will put it straight back in the ready list
+        record.wasWoken = true;
+    } else if (!record.isScheduled || record.tick > _currentTick) {
+        schedule(queue, record, _currentTick);
+    }
+    // otherwise it is already in the ready list
+}
+
+void SendQueueScheduler::remove(SendQueue* queue) {
+    Lock lock(_mutex);
+    _idleCondition.wait(lock, [&] {
+        auto it = _records.find(queue);
+        return it == _records.end() || !it->second.isStepping;
+    });
+
+    _records.erase(queue);
+    _ready.erase(std::remove(_ready.begin(), _ready.end(), queue), _ready.end());
+    // any wheel entries for the queue are now stale and are dropped when swept
+}
+
+uint64_t SendQueueScheduler::tickFor(TimePoint timePoint) const {
+    if (timePoint <= _epoch) {
+        return 0;
+    }
+    return (uint64_t)duration_cast<microseconds>(timePoint - _epoch).count() / TICK_USECS;
+}
+
+SendQueueScheduler::TimePoint SendQueueScheduler::timeFor(uint64_t tick) const {
+    return _epoch + microseconds(tick * TICK_USECS);
+}
+
+void SendQueueScheduler::schedule(SendQueue* queue, Record& record, uint64_t tick) {
+    record.isScheduled = true;
+    record.tick = std::max(tick, _currentTick);
+    ++record.generation;
+
+    if (record.tick <= _currentTick) {
+        _ready.push_back(queue);
+    } else {
+        _wheel[record.tick % NUM_WHEEL_SLOTS].push_back({ queue, record.tick, record.generation });
+        ++_numWheelEntries;
+    }
+
+    _workCondition.notify_one();
+}
+
+void SendQueueScheduler::advanceWheel(uint64_t nowTick) {
+    if (nowTick <= _currentTick) {
+        return;
+    }
+
+    // a full revolution visits every slot, no matter how far behind we are
+    uint64_t numSlotsToSweep = std::min(nowTick - _currentTick, (uint64_t)NUM_WHEEL_SLOTS);
+
+    for (uint64_t i = 1; i <= numSlotsToSweep; ++i) {
+        auto& slot = _wheel[(_currentTick + i) % NUM_WHEEL_SLOTS];
+
+        size_t j = 0;
+        while (j < slot.size()) {
+            const auto& entry = slot[j];
+            auto it = _records.find(entry.queue);
+            bool isStale = it == _records.end() || !it->second.isScheduled || it->second.generation != entry.generation;
+
+            if (isStale || entry.tick <= nowTick) {
+                if (!isStale) {
+                    _ready.push_back(entry.queue);
+                }
+                slot[j] = slot.back();
+                slot.pop_back();
+                --_numWheelEntries;
+            } else {
+                // due on a later revolution
+                ++j;
+            }
+        }
+    }
+
+    _currentTick = nowTick;
+}
+
+bool SendQueueScheduler::findNextTick(uint64_t& nextTick) const {
+    if (_numWheelEntries == 0) {
+        return false;
+    }
+
+    for (uint64_t i = 1; i <= (uint64_t)NUM_WHEEL_SLOTS; ++i) {
+        if (!_wheel[(_currentTick + i) % NUM_WHEEL_SLOTS].empty()) {
+            nextTick = _currentTick + i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void SendQueueScheduler::run() {
+    Lock lock(_mutex);
+
+    while (!_stopping) {
+        advanceWheel(tickFor(p_high_resolution_clock::now()));
+
+        if (_ready.empty()) {
+            uint64_t nextTick;
+            if (findNextTick(nextTick)) {
+                _workCondition.wait_until(lock, timeFor(nextTick));
+            } else {
+                _workCondition.wait(lock);
+            }
+            continue;
+        }
+
+        SendQueue* queue = _ready.front();
+        _ready.pop_front();
+
+        auto it = _records.find(queue);
+        if (it == _records.end()) {
+            continue;
+        }
+
+        it->second.isScheduled = false;
+        it->second.isStepping = true;
+        it->second.wasWoken = false;
+
+        lock.unlock();
+
+        TimePoint nextStepAt;
+        bool keepScheduled = queue->step(p_high_resolution_clock::now(), nextStepAt);
+
+        lock.lock();
+
+        // remove() waits for isStepping to clear, so the record is still here
+        auto& record = _records[queue];
+        record.isStepping = false;
+
+        if (keepScheduled) {
+            schedule(queue, record, record.wasWoken ? _currentTick : tickFor(nextStepAt));
+        }
+
+        _idleCondition.notify_all();
+    }
+}
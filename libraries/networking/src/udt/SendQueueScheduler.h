@@ -0,0 +1,97 @@
+//
+//  SendQueueScheduler.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SendQueueScheduler_h
+#define hifi_SendQueueScheduler_h
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <PortableHighResolutionClock.h>
+
+namespace udt {
+
+class SendQueue;
+
+// Drives every scheduled SendQueue from a small fixed set of worker threads.
+// Queues are kept in a hashed timer wheel keyed on the time they next need to send, retransmit or time out,
+// and a worker calls SendQueue::step when that deadline is reached or when the queue is woken by new data, ACKs or NAKs.
+// A queue is never stepped by more than one worker at a time.
+class SendQueueScheduler {
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+    using TimePoint = p_high_resolution_clock::time_point;
+
+public:
+    static SendQueueScheduler& getInstance();
+
+    SendQueueScheduler(int numThreads);
+    ~SendQueueScheduler();
+
+    int getNumThreads() const { return (int)_workers.size(); }
+
+    // registers the queue and steps it as soon as possible
+    void add(SendQueue* queue);
+
+    // steps the queue as soon as possible, even if its deadline has not been reached
+    void wake(SendQueue* queue);
+
+    // unregisters the queue, blocking until no worker is stepping it
+    void remove(SendQueue* queue);
+
+private:
+    struct Record {
+        uint64_t tick { 0 };
+        uint32_t generation { 0 }; // bumped on every reschedule, so stale wheel entries can be skipped
+        bool isScheduled { false };
+        bool isStepping { false };
+        bool wasWoken { false }; // woken while a worker was stepping it
+    };
+
+    struct WheelEntry {
+        SendQueue* queue;
+        uint64_t tick;
+        uint32_t generation;
+    };
+
+    void run();
+
+    uint64_t tickFor(TimePoint timePoint) const;
+    TimePoint timeFor(uint64_t tick) const;
+
+    void schedule(SendQueue* queue, Record& record, uint64_t tick); // requires _mutex
+    void advanceWheel(uint64_t nowTick); // requires _mutex
+    bool findNextTick(uint64_t& nextTick) const; // requires _mutex
+
+    Mutex _mutex;
+    std::condition_variable _workCondition;
+    std::condition_variable _idleCondition;
+
+    TimePoint _epoch;
+    uint64_t _currentTick { 0 };
+    size_t _numWheelEntries { 0 };
+    std::vector<std::vector<WheelEntry>> _wheel;
+    std::deque<SendQueue*> _ready;
+    std::unordered_map<SendQueue*, Record> _records;
+
+    bool _stopping { false };
+    std::vector<std::thread> _workers;
+};
+
+}
+
+#endif // hifi_SendQueueScheduler_h
@@ -15,6 +15,7 @@
 #include <sys/socket.h>
 #endif
 
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 
 #include <shared/QtHelpers.h>
@@ -38,6 +39,35 @@ using namespace udt;
 #include <netinet/in.h>
 #endif
 
+namespace {
+    // the send batch being filled by the calling thread and a weak handle on the socket it was started for, so that
+    // the batch of a socket destroyed before it flushed is dropped rather than written by a socket at the same address
+    struct ThreadSendBatch {
+        std::unique_ptr<SendBatch> batch;
+        std::weak_ptr<Socket*> socketHandle;
+        bool isOpen { false };
+
+        Socket* getSocket() {
+            if (!isOpen) {
+                return nullptr;
+            }
+            auto handle = socketHandle.lock();
+            if (!handle) {
+                // the datagrams of a destroyed socket have nowhere to go
+                batch.reset();
+                close();
+                return nullptr;
+            }
+            return *handle;
+        }
+
+        void close() {
+            socketHandle.reset();
+            isOpen = false;
+        }
+    };
+    thread_local ThreadSendBatch threadSendBatch;
+}
 
 Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
@@ -56,6 +86,21 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     const int READY_READ_BACKUP_CHECK_MSECS = 2 * 1000;
     connect(_readyReadBackupTimer, &QTimer::timeout, this, &Socket::checkForReadyReadBackup);
     _readyReadBackupTimer->start(READY_READ_BACKUP_CHECK_MSECS);
+
+    static const QString BATCHED_RECEIVE_ENV = "HIFI_UDT_BATCHED_RECEIVE";
+    if (QProcessEnvironment::systemEnvironment().contains(BATCHED_RECEIVE_ENV)) {
+        setBatchedReceiveEnabled(true);
+    }
+
+    static const QString BATCHED_SEND_ENV = "HIFI_UDT_BATCHED_SEND";
+    if (QProcessEnvironment::systemEnvironment().contains(BATCHED_SEND_ENV)) {
+        setBatchedSendEnabled(true);
+    }
+}
+
+Socket::~Socket() {
+    // a batch left open on this thread is written, the ones on other threads are dropped when they see the handle expire
+    flushSendBatch();
 }
 
 void Socket::bind(const QHostAddress& address, quint16 port) {
@@ -243,6 +288,17 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
         qCDebug(networking) << "Attempt to writeDatagram when in unbound state to" << sockAddr;
         return -1;
     }
+
+    if (threadSendBatch.getSocket() == this) {
+        auto& batch = *threadSendBatch.batch;
+        if (batch.isFull()) {
+            writeSendBatch(batch);
+        }
+        if (batch.append(datagram.constData(), datagram.size(), sockAddr)) {
+            return datagram.size();
+        }
+    }
+
     qint64 bytesWritten = _udpSocket.writeDatagram(datagram, sockAddr.getAddress(), sockAddr.getPort());
     int pending = _udpSocket.bytesToWrite();
     if (bytesWritten < 0 || pending) {
@@ -371,6 +427,11 @@ void Socket::readPendingDatagrams() {
     const auto abortTime = system_clock::now() + MAX_PROCESS_TIME;
     int packetSizeWithHeader = -1;
 
+    if (!_batchedReceiveEnabled && _receiveBatch) {
+        // batched receive was disabled since the last read
+        _receiveBatch.reset();
+    }
+
     while (_udpSocket.hasPendingDatagrams() &&
            (packetSizeWithHeader = _udpSocket.pendingDatagramSize()) != -1) {
         if (system_clock::now() > abortTime) {
@@ -410,73 +471,143 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
-            }
+        if (_batchedReceiveEnabled) {
+            // the datagram above went through QUdpSocket so that it re-arms its read notifier,
+            // everything else that is pending is drained in batches
+            readPendingDatagramBatches(abortTime);
+            break;
+        }
+    }
+}
 
-            continue;
+void Socket::readPendingDatagramBatches(std::chrono::system_clock::time_point abortTime) {
+    using namespace std::chrono;
+
+    if (!_receiveBatch) {
+        _receiveBatch.reset(new ReceiveBatch());
+    }
+
+    const auto socketDescriptor = _udpSocket.socketDescriptor();
+
+    while (system_clock::now() <= abortTime) {
+        int numReceived = _receiveBatch->receive(socketDescriptor);
+
+        if (numReceived <= 0) {
+            if (numReceived < 0) {
+                qCDebug(networking) << "Socket::readPendingDatagramBatches failed to receive batch, falling back to"
+                    << "QUdpSocket reads";
+                _batchedReceiveEnabled = false;
+                _receiveBatch.reset();
+            }
+            break;
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        _readyReadBackupTimer->start();
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+        // every datagram in the batch arrived by the time the system call returned
+        auto receiveTime = p_high_resolution_clock::now();
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+        ++_receivedBatches;
+        _receivedBatchedDatagrams += numReceived;
+        if (numReceived > _largestReceivedBatch) {
+            _largestReceivedBatch = numReceived;
+        }
+
+        for (int i = 0; i < numReceived; ++i) {
+            int packetSizeWithHeader = _receiveBatch->getSize(i);
+            HifiSockAddr senderSockAddr = _receiveBatch->getSenderSockAddr(i);
+
+            _lastPacketSizeRead = packetSizeWithHeader;
+            _lastPacketSockAddr = senderSockAddr;
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
+            if (packetSizeWithHeader <= 0) {
+                continue;
             }
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
+            // the ring is reused by the next batch, so the packet gets its own right-sized copy
+            auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+            memcpy(buffer.get(), _receiveBatch->getData(i), packetSizeWithHeader);
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+            processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+        }
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+        if (numReceived < _receiveBatch->getCapacity()) {
+            // the socket has been drained
+            break;
+        }
+    }
+}
+
+void Socket::processDatagram(std::unique_ptr<char[]> buffer, int packetSizeWithHeader, const HifiSockAddr& senderSockAddr,
+                             p_high_resolution_clock::time_point receiveTime) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        }
+
+        return;
+    }
+
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
+
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr, true);
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
+        // save the sequence number in case this is the packet that sticks readyRead
+        _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            auto connection = findOrCreateConnection(senderSockAddr, true);
+
+            if (packet->isReliable()) {
+                // if this was a reliable packet then signal the matching connection with the sequence number
+
+                if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                              packet->getDataSize(),
+                                                                              packet->getPayloadSize())) {
+                    // the connection could not be created or indicated that we should not continue processing this packet
 #ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
+                    qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                        << ", type" << NLPacket::typeInHeader(*packet);
 #endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
+                    return;
                 }
+            } else if (connection) {
+                connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                            packet->getPayloadSize());
+            }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
+            if (packet->isPartOfMessage()) {
+                auto connection = findOrCreateConnection(senderSockAddr, true);
+                if (connection) {
+                    connection->queueReceivedMessagePacket(std::move(packet));
                 }
+            } else if (_packetHandler) {
+                // call the verified packet callback to let it handle this packet
+                _packetHandler(std::move(packet));
             }
         }
     }
@@ -516,6 +647,96 @@ ConnectionStats::Stats Socket::sampleStatsForConnection(const HifiSockAddr& dest
     }
 }
 
+void Socket::setBatchedReceiveEnabled(bool enabled) {
+    if (enabled && !ReceiveBatch::isSupported()) {
+        qCWarning(networking) << "Batched receive is not supported on this platform, using QUdpSocket reads";
+        return;
+    }
+
+    if (enabled != _batchedReceiveEnabled) {
+        qCDebug(networking) << (enabled ? "Enabling" : "Disabling") << "batched receive of up to"
+            << ReceiveBatch::DEFAULT_BATCH_SIZE << "datagrams";
+        _batchedReceiveEnabled = enabled;
+    }
+}
+
+Socket::ReceiveBatchStats Socket::sampleReceiveBatchStats() {
+    ReceiveBatchStats stats;
+    stats.batches = _receivedBatches.exchange(0);
+    stats.datagrams = _receivedBatchedDatagrams.exchange(0);
+    stats.largestBatch = _largestReceivedBatch.exchange(0);
+    return stats;
+}
+
+void Socket::setBatchedSendEnabled(bool enabled) {
+    if (enabled && !SendBatch::isSupported()) {
+        qCWarning(networking) << "Batched send is not supported on this platform, using QUdpSocket writes";
+        return;
+    }
+
+    if (enabled != _batchedSendEnabled) {
+        qCDebug(networking) << (enabled ? "Enabling" : "Disabling") << "batched send of up to"
+            << SendBatch::DEFAULT_BATCH_SIZE << "datagrams";
+        _batchedSendEnabled = enabled;
+    }
+}
+
+void Socket::beginSendBatch(int batchSize) {
+    if (!_batchedSendEnabled) {
+        return;
+    }
+
+    Socket* batchSocket = threadSendBatch.getSocket();
+    if (batchSocket && batchSocket != this) {
+        // a batch for another socket is open on this thread, it must be written before we take it over
+        batchSocket->flushSendBatch();
+    }
+
+    if (!threadSendBatch.batch || threadSendBatch.batch->getCapacity() != std::max(batchSize, 1)) {
+        if (batchSocket == this) {
+            writeSendBatch(*threadSendBatch.batch);
+        }
+        threadSendBatch.batch.reset(new SendBatch(batchSize));
+    }
+    threadSendBatch.socketHandle = _sendBatchHandle;
+    threadSendBatch.isOpen = true;
+}
+
+void Socket::flushSendBatch() {
+    if (threadSendBatch.getSocket() != this) {
+        return;
+    }
+
+    writeSendBatch(*threadSendBatch.batch);
+    threadSendBatch.close();
+}
+
+void Socket::writeSendBatch(SendBatch& batch) {
+    if (batch.isEmpty()) {
+        return;
+    }
+
+    auto stats = batch.flush(_udpSocket.socketDescriptor());
+
+    ++_sentBatches;
+    _sentBatchedDatagrams += stats.datagrams;
+    _sendBatchSystemCalls += stats.systemCalls;
+
+    if (stats.failedDatagrams > 0) {
+        _failedBatchedDatagrams += stats.failedDatagrams;
+        HIFI_FCDEBUG(networking(), "udt::Socket::writeSendBatch failed to write" << stats.failedDatagrams << "datagrams");
+    }
+}
+
+Socket::SendBatchStats Socket::sampleSendBatchStats() {
+    SendBatchStats stats;
+    stats.batches = _sentBatches.exchange(0);
+    stats.datagrams = _sentBatchedDatagrams.exchange(0);
+    stats.systemCalls = _sendBatchSystemCalls.exchange(0);
+    stats.failedDatagrams = _failedBatchedDatagrams.exchange(0);
+    return stats;
+}
+
 Socket::StatsVector Socket::sampleStatsForAllConnections() {
     StatsVector result;
     Lock connectionsLock(_connectionsHashMutex);
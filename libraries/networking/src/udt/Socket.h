@@ -14,8 +14,11 @@
 #ifndef hifi_Socket_h
 #define hifi_Socket_h
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <unordered_map>
+#include <memory>
 #include <mutex>
 #include <list>
 
@@ -26,6 +29,8 @@
 #include "../HifiSockAddr.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
+#include "ReceiveBatch.h"
+#include "SendBatch.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -54,8 +59,22 @@ class Socket : public QObject {
 
 public:
     using StatsVector = std::vector<std::pair<HifiSockAddr, ConnectionStats::Stats>>;
+
+    struct ReceiveBatchStats {
+        uint64_t batches { 0 };
+        uint64_t datagrams { 0 };
+        int largestBatch { 0 };
+    };
+
+    struct SendBatchStats {
+        uint64_t batches { 0 };
+        uint64_t datagrams { 0 };
+        uint64_t systemCalls { 0 };
+        uint64_t failedDatagrams { 0 };
+    };
     
     Socket(QObject* object = 0, bool shouldChangeSocketOptions = true);
+    ~Socket();
     
     quint16 localPort() const { return _udpSocket.localPort(); }
     
@@ -89,6 +108,20 @@ public:
     
     StatsVector sampleStatsForAllConnections();
 
+    // batched receive drains the socket with one system call per ReceiveBatch (Linux only)
+    void setBatchedReceiveEnabled(bool enabled);
+    bool isBatchedReceiveEnabled() const { return _batchedReceiveEnabled; }
+    ReceiveBatchStats sampleReceiveBatchStats();
+
+    // batched send queues unreliable datagrams written from the calling thread between beginSendBatch and
+    // flushSendBatch and writes them with as few system calls as possible (Linux only, otherwise these are no-ops)
+    // the batch is written whenever batchSize datagrams are queued
+    void setBatchedSendEnabled(bool enabled);
+    bool isBatchedSendEnabled() const { return _batchedSendEnabled; }
+    void beginSendBatch(int batchSize = SendBatch::DEFAULT_BATCH_SIZE);
+    void flushSendBatch();
+    SendBatchStats sampleSendBatchStats();
+
 #if (PR_BUILD || DEV_BUILD)
     void sendFakedHandshakeRequest(const HifiSockAddr& sockAddr);
 #endif
@@ -111,6 +144,11 @@ private slots:
 private:
     void setSystemBufferSizes();
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreation = false);
+
+    void writeSendBatch(SendBatch& batch);
+    void readPendingDatagramBatches(std::chrono::system_clock::time_point abortTime);
+    void processDatagram(std::unique_ptr<char[]> buffer, int packetSizeWithHeader, const HifiSockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime);
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
     ConnectionStats::Stats sampleStatsForConnection(const HifiSockAddr& destination);
@@ -146,6 +184,21 @@ private:
     int _lastPacketSizeRead { 0 };
     SequenceNumber _lastReceivedSequenceNumber;
     HifiSockAddr _lastPacketSockAddr;
+
+    // the flag can be set from any thread, the batch is only created and dropped on the socket's thread
+    std::atomic<bool> _batchedReceiveEnabled { false };
+    std::unique_ptr<ReceiveBatch> _receiveBatch;
+    std::atomic<uint64_t> _receivedBatches { 0 };
+    std::atomic<uint64_t> _receivedBatchedDatagrams { 0 };
+    std::atomic<int> _largestReceivedBatch { 0 };
+
+    std::atomic<bool> _batchedSendEnabled { false };
+    // the thread send batches hold it weakly, to find out that the socket they were started for is gone
+    std::shared_ptr<Socket*> _sendBatchHandle { std::make_shared<Socket*>(this) };
+    std::atomic<uint64_t> _sentBatches { 0 };
+    std::atomic<uint64_t> _sentBatchedDatagrams { 0 };
+    std::atomic<uint64_t> _sendBatchSystemCalls { 0 };
+    std::atomic<uint64_t> _failedBatchedDatagrams { 0 };
     
     friend UDTTest;
 };
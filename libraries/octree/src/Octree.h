@@ -15,6 +15,7 @@
 #include <memory>
 #include <set>
 #include <stdint.h>
+#include <vector>
 
 #include <QHash>
 #include <QObject>
@@ -26,6 +27,7 @@
 
 #include "OctreeElement.h"
 #include "OctreeElementBag.h"
+#include "OctreeJournal.h"
 #include "OctreePacketData.h"
 #include "OctreeSceneStats.h"
 #include "OctreeUtils.h"
@@ -37,6 +39,13 @@ class OctreePacketData;
 class Shape;
 using OctreePointer = std::shared_ptr<Octree>;
 
+/// An edit read from an inbound edit packet, to be applied to the tree later
+class OctreeDecodedEdit {
+public:
+    virtual ~OctreeDecodedEdit() {}
+};
+using OctreeDecodedEditPointer = std::unique_ptr<OctreeDecodedEdit>;
+
 extern QVector<QString> PERSIST_EXTENSIONS;
 
 /// derive from this class to use the Octree::recurseTreeWithOperator() method
@@ -138,6 +147,15 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
+
+    // The edits of the types a tree decodes ahead are read without the tree lock by decodeEditPacketData(), and applied
+    // later by applyDecodedEdit() with the tree write locked, so that the lock is only held for the changes to the tree
+    virtual bool decodesEditPacketType(PacketType packetType) const { return false; }
+    virtual int decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                     const SharedNodePointer& sourceNode, OctreeDecodedEditPointer& decodedEdit) { return 0; }
+    // called without the tree lock on each batch of decoded edits, just before the batch is applied
+    virtual void prepareDecodedEdits(std::vector<OctreeDecodedEditPointer>& decodedEdits) { }
+    virtual void applyDecodedEdit(OctreeDecodedEdit& decodedEdit) { }
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
@@ -223,6 +241,15 @@ public:
     bool readJSONFromGzippedFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) = 0;
 
+    // Incremental persistence, see OctreeJournal
+    virtual void setJournalingEnabled(bool enabled) { }
+    // moves the changes made since the last call into records, returns false if only a full snapshot can capture them
+    virtual bool takeJournalRecords(std::vector<OctreeJournal::Record>& records) { return false; }
+    // forgets the changes made so far, once a full snapshot has captured them
+    virtual void clearJournalChanges() { }
+    // replays the records of a journal on top of the snapshot they belong to, the tree must be write locked
+    virtual bool applyJournalRecords(const std::vector<OctreeJournal::Record>& records) { return false; }
+
     uint64_t getOctreeElementsCount();
 
     bool getShouldReaverage() const { return _shouldReaverage; }
@@ -260,6 +287,8 @@ public:
     virtual quint64 getAverageFilterTime() const { return 0; }
 
     void incrementPersistDataVersion() { _persistDataVersion++; }
+    QUuid getPersistID() const { return _persistID; }
+    int getPersistDataVersion() const { return _persistDataVersion; }
 
 
 protected:
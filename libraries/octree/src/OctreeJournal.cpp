@@ -0,0 +1,160 @@
+//
+//  OctreeJournal.cpp
+//  libraries/octree/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeJournal.h"
+
+#include <QDataStream>
+#include <QFile>
+
+#include "OctreeLogging.h"
+
+static const quint32 JOURNAL_MAGIC = 0x484A524E; // "HJRN"
+static const quint16 JOURNAL_FORMAT_VERSION = 1;
+
+static const int UUID_SIZE_BYTES = 16;
+static const int HEADER_SIZE_BYTES = sizeof(quint32) + sizeof(quint16) + UUID_SIZE_BYTES + sizeof(qint32);
+static const int RECORD_HEADER_SIZE_BYTES = sizeof(quint32) + sizeof(quint16);
+static const int RECORD_BODY_MIN_SIZE_BYTES = sizeof(quint8) + UUID_SIZE_BYTES;
+
+bool OctreeJournal::reset(const QUuid& snapshotID, int snapshotVersion) {
+    _size = 0;
+    _numRecords = 0;
+
+    QFile file(_filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(octree) << "Couldn't reset journal" << _filename << file.errorString();
+        return false;
+    }
+
+    QByteArray header;
+    QDataStream stream(&header, QIODevice::WriteOnly);
+    stream << JOURNAL_MAGIC << JOURNAL_FORMAT_VERSION;
+    stream.writeRawData(snapshotID.toRfc4122().constData(), UUID_SIZE_BYTES);
+    stream << (qint32)snapshotVersion;
+
+    if (file.write(header) != header.size() || !file.flush()) {
+        qCWarning(octree) << "Couldn't write journal header to" << _filename << file.errorString();
+        return false;
+    }
+    _size = header.size();
+    return true;
+}
+
+bool OctreeJournal::append(const std::vector<Record>& records) {
+    if (records.empty()) {
+        return true;
+    }
+    if (_size < HEADER_SIZE_BYTES) {
+        return false;
+    }
+
+    // frame every record up front, so that the whole batch goes out in a single write
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    for (const auto& record : records) {
+        QByteArray body;
+        body.reserve(RECORD_BODY_MIN_SIZE_BYTES + record.payload.size());
+        body.append((char)record.operation);
+        body.append(record.id.toRfc4122());
+        body.append(record.payload);
+
+        stream << (quint32)body.size() << qChecksum(body.constData(), body.size());
+        stream.writeRawData(body.constData(), body.size());
+    }
+
+    QFile file(_filename);
+    if (!file.open(QIODevice::ReadWrite)) {
+        qCWarning(octree) << "Couldn't open journal" << _filename << file.errorString();
+        return false;
+    }
+
+    // write from the end of the last good record, dropping whatever a failed append may have left behind
+    if ((file.size() > _size && !file.resize(_size)) || !file.seek(_size) || file.write(data) != data.size() ||
+        !file.flush()) {
+        qCWarning(octree) << "Couldn't append to journal" << _filename << file.errorString();
+        return false;
+    }
+
+    _size += data.size();
+    _numRecords += (int)records.size();
+    return true;
+}
+
+bool OctreeJournal::read(const QUuid& snapshotID, int snapshotVersion, std::vector<Record>& records) {
+    _size = 0;
+    _numRecords = 0;
+
+    QFile file(_filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QByteArray data = file.readAll();
+    file.close();
+
+    QDataStream stream(data);
+    quint32 magic;
+    quint16 formatVersion;
+    QByteArray id(UUID_SIZE_BYTES, 0);
+    qint32 version;
+    stream >> magic >> formatVersion;
+    stream.readRawData(id.data(), UUID_SIZE_BYTES);
+    stream >> version;
+
+    if (stream.status() != QDataStream::Ok || magic != JOURNAL_MAGIC || formatVersion != JOURNAL_FORMAT_VERSION) {
+        qCWarning(octree) << "Ignoring invalid journal" << _filename;
+        return false;
+    }
+    if (QUuid::fromRfc4122(id) != snapshotID || version != snapshotVersion) {
+        qCDebug(octree) << "Ignoring journal" << _filename << "for another snapshot: ID(" << QUuid::fromRfc4122(id)
+            << ") DataVersion(" << version << ")";
+        return false;
+    }
+
+    int offset = HEADER_SIZE_BYTES;
+    while (offset + RECORD_HEADER_SIZE_BYTES <= data.size()) {
+        quint32 bodySize;
+        quint16 checksum;
+        stream >> bodySize >> checksum;
+
+        int bodyOffset = offset + RECORD_HEADER_SIZE_BYTES;
+        if (bodySize < (quint32)RECORD_BODY_MIN_SIZE_BYTES || bodySize > (quint32)(data.size() - bodyOffset)) {
+            break;
+        }
+        const char* body = data.constData() + bodyOffset;
+        if (qChecksum(body, bodySize) != checksum) {
+            break;
+        }
+
+        Record record;
+        record.operation = (Operation)body[0];
+        record.id = QUuid::fromRfc4122(QByteArray::fromRawData(body + 1, UUID_SIZE_BYTES));
+        record.payload = QByteArray(body + RECORD_BODY_MIN_SIZE_BYTES, bodySize - RECORD_BODY_MIN_SIZE_BYTES);
+        records.push_back(record);
+
+        stream.skipRawData(bodySize);
+        offset = bodyOffset + bodySize;
+        ++_numRecords;
+    }
+
+    if (offset < data.size()) {
+        qCWarning(octree) << "Journal" << _filename << "ends with" << data.size() - offset
+            << "bytes of incomplete records, they will be dropped";
+    }
+
+    // later appends go after the last good record
+    _size = offset;
+    return true;
+}
+
+void OctreeJournal::remove() {
+    _size = 0;
+    _numRecords = 0;
+    QFile::remove(_filename);
+}
@@ -0,0 +1,62 @@
+//
+//  OctreeJournal.h
+//  libraries/octree/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeJournal_h
+#define hifi_OctreeJournal_h
+
+#include <vector>
+
+#include <QByteArray>
+#include <QString>
+#include <QUuid>
+
+// Append-only binary log of the changes made to an octree since its last snapshot.
+//
+// The journal starts with the ID and data version of the snapshot it applies to, so that a journal left behind by an
+// older or replaced snapshot is never replayed on top of a newer one. Each record is framed with its length and a
+// checksum, and reading stops at the first incomplete or damaged record, which is what a crash mid-append leaves.
+class OctreeJournal {
+public:
+    enum class Operation : quint8 {
+        Upsert = 1,
+        Delete = 2
+    };
+
+    struct Record {
+        Operation operation;
+        QUuid id;
+        QByteArray payload; // the serialized item, empty for deletes
+    };
+
+    OctreeJournal(const QString& filename) : _filename(filename) { }
+
+    QString getFilename() const { return _filename; }
+
+    // starts an empty journal for the given snapshot, replacing any previous one
+    bool reset(const QUuid& snapshotID, int snapshotVersion);
+
+    // appends the records and flushes them, the journal must have been reset or read first
+    bool append(const std::vector<Record>& records);
+
+    // reads the records of the journal, as long as it belongs to the given snapshot
+    bool read(const QUuid& snapshotID, int snapshotVersion, std::vector<Record>& records);
+
+    void remove();
+
+    qint64 getSize() const { return _size; }
+    int getNumRecords() const { return _numRecords; }
+
+private:
+    QString _filename;
+    qint64 _size { 0 };
+    int _numRecords { 0 };
+};
+
+#endif // hifi_OctreeJournal_h
@@ -11,6 +11,7 @@
 
 #include "OctreePersistThread.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -23,6 +24,7 @@
 #include <QDir>
 #include <QDirIterator>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QJsonDocument>
@@ -38,11 +40,16 @@
 #include "OctreeDataUtils.h"
 
 constexpr std::chrono::seconds OctreePersistThread::DEFAULT_PERSIST_INTERVAL { 30 };
+constexpr std::chrono::seconds OctreePersistThread::DEFAULT_COMPACTION_INTERVAL { 600 };
 constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
 
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
 
+// the snapshot is gzipped and the journal isn't, so let the journal grow a few times larger before compacting it
+constexpr qint64 JOURNAL_TO_SNAPSHOT_SIZE_RATIO { 4 };
+constexpr qint64 MIN_JOURNAL_COMPACTION_SIZE_BYTES { 1000 * 1000 };
+
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, std::chrono::milliseconds persistInterval,
                                          bool debugTimestampNow, QString persistAsFileType) :
     _tree(tree),
@@ -60,6 +67,15 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     _filename = sansExt + "." + _persistAsFileType;
 }
 
+void OctreePersistThread::setJournaling(bool enabled, std::chrono::milliseconds compactionInterval) {
+    if (enabled) {
+        _journal.reset(new OctreeJournal(_filename + ".journal"));
+        _compactionInterval = compactionInterval;
+    } else {
+        _journal.reset();
+    }
+}
+
 void OctreePersistThread::start() {
     cleanupOldReplacementBackups();
 
@@ -163,12 +179,26 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
         _tree->pruneTree();
     });
 
+    if (_journal) {
+        replayJournal();
+    }
+
     _cachedJSONData.clear();
     quint64 loadDone = usecTimestampNow();
     _loadTimeUSecs = loadDone - loadStarted;
 
     _tree->clearDirtyBit(); // the tree is clean since we just loaded it
 
+    if (_journal) {
+        _snapshotSize = QFileInfo(_filename).size();
+        _lastCompaction = std::chrono::steady_clock::now();
+        _tree->setJournalingEnabled(true);
+        if (_needsCompaction) {
+            // fold the replayed changes into a new snapshot at the next persist
+            _tree->setDirtyBit();
+        }
+    }
+
     unsigned long nodeCount = OctreeElement::getNodeCount();
     unsigned long internalNodeCount = OctreeElement::getInternalNodeCount();
     unsigned long leafNodeCount = OctreeElement::getLeafNodeCount();
@@ -214,6 +244,11 @@ QString OctreePersistThread::getPersistFileMimeType() const {
 void OctreePersistThread::replaceData(QByteArray data) {
     backupCurrentFile();
 
+    if (_journal) {
+        // the journal belongs to the data being replaced
+        _journal->remove();
+    }
+
     QFile currentFile { _filename };
     if (currentFile.open(QIODevice::WriteOnly)) {
         currentFile.write(data);
@@ -259,6 +294,11 @@ void OctreePersistThread::process() {
 
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
+    if (_journal && _journal->getNumRecords() > 0) {
+        // leave a complete snapshot behind, and with the DS
+        _needsCompaction = true;
+        _tree->setDirtyBit();
+    }
     persist();
     qCDebug(octree) << "Persist thread done with about to finish...";
 }
@@ -304,6 +344,9 @@ void OctreePersistThread::cleanupOldReplacementBackups() {
 
 void OctreePersistThread::persist() {
     if (_tree->isDirty() && _initialLoadComplete) {
+        if (_journal && !shouldCompact() && persistToJournal()) {
+            return;
+        }
 
         _tree->withWriteLock([&] {
             qCDebug(octree) << "pruning Octree before saving...";
@@ -313,18 +356,79 @@ void OctreePersistThread::persist() {
 
         _tree->incrementPersistDataVersion();
 
+        if (_journal) {
+            // the snapshot captures every change made from here on, a journal for it starts out empty
+            _tree->clearJournalChanges();
+        }
+
         qCDebug(octree) << "Saving Octree data to:" << _filename;
         if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
             _tree->clearDirtyBit(); // tree is clean after saving
             qCDebug(octree) << "DONE persisting Octree data to" << _filename;
+
+            if (_journal) {
+                _journal->reset(_tree->getPersistID(), _tree->getPersistDataVersion());
+                _snapshotSize = QFileInfo(_filename).size();
+                _lastCompaction = std::chrono::steady_clock::now();
+                _needsCompaction = false;
+            }
         } else {
             qCWarning(octree) << "Failed to persist Octree data to" << _filename;
+
+            // the cleared changes are only in the tree now, so the journal can't be trusted until the next snapshot
+            _needsCompaction = true;
         }
 
         sendLatestEntityDataToDS();
     }
 }
 
+bool OctreePersistThread::shouldCompact() const {
+    qint64 maxJournalSize = std::max(_snapshotSize * JOURNAL_TO_SNAPSHOT_SIZE_RATIO, MIN_JOURNAL_COMPACTION_SIZE_BYTES);
+    return _needsCompaction || std::chrono::steady_clock::now() - _lastCompaction > _compactionInterval ||
+        _journal->getSize() > maxJournalSize;
+}
+
+bool OctreePersistThread::persistToJournal() {
+    // changes made while the records are taken dirty the tree again
+    _tree->clearDirtyBit();
+
+    std::vector<OctreeJournal::Record> records;
+    if (!_tree->takeJournalRecords(records) || !_journal->append(records)) {
+        _tree->setDirtyBit();
+        return false;
+    }
+
+    if (!records.empty()) {
+        qCDebug(octree) << "Journaled" << records.size() << "changes to" << _journal->getFilename();
+    }
+    return true;
+}
+
+void OctreePersistThread::replayJournal() {
+    std::vector<OctreeJournal::Record> records;
+    if (!_journal->read(_tree->getPersistID(), _tree->getPersistDataVersion(), records)) {
+        // no journal for this snapshot, start one
+        _journal->reset(_tree->getPersistID(), _tree->getPersistDataVersion());
+        return;
+    }
+    if (records.empty()) {
+        return;
+    }
+
+    qCDebug(octree) << "Replaying" << records.size() << "journaled changes from" << _journal->getFilename();
+    bool success;
+    _tree->withWriteLock([&] {
+        PerformanceWarning warn(true, "Replaying Octree Journal", true);
+        success = _tree->applyJournalRecords(records);
+    });
+    if (!success) {
+        qCWarning(octree) << "Some journaled changes could not be replayed from" << _journal->getFilename();
+    }
+
+    _needsCompaction = true;
+}
+
 void OctreePersistThread::sendLatestEntityDataToDS() {
     qDebug() << "Sending latest entity data to DS";
     auto nodeList = DependencyManager::get<NodeList>();
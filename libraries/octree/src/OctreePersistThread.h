@@ -14,9 +14,12 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <memory>
+
 #include <QString>
 #include <GenericThread.h>
 #include "Octree.h"
+#include "OctreeJournal.h"
 
 class OctreePersistThread : public QObject {
     Q_OBJECT
@@ -31,6 +34,7 @@ public:
     };
 
     static const std::chrono::seconds DEFAULT_PERSIST_INTERVAL;
+    static const std::chrono::seconds DEFAULT_COMPACTION_INTERVAL;
 
     OctreePersistThread(OctreePointer tree,
                         const QString& filename,
@@ -47,6 +51,10 @@ public:
 
     void aboutToFinish(); /// call this to inform the persist thread that the owner is about to finish to support final persist
 
+    /// Persist the changes to a journal next to the persist file, and only rewrite the whole file on compaction.
+    /// Must be called before start().
+    void setJournaling(bool enabled, std::chrono::milliseconds compactionInterval = DEFAULT_COMPACTION_INTERVAL);
+
 public slots:
     void start();
 
@@ -59,6 +67,9 @@ protected slots:
 
 protected:
     void persist();
+    bool persistToJournal();
+    bool shouldCompact() const;
+    void replayJournal();
     bool backupCurrentFile();
     void cleanupOldReplacementBackups();
 
@@ -79,6 +90,12 @@ private:
 
     QString _persistAsFileType;
     QByteArray _cachedJSONData;
+
+    std::unique_ptr<OctreeJournal> _journal;
+    std::chrono::milliseconds _compactionInterval { DEFAULT_COMPACTION_INTERVAL };
+    std::chrono::steady_clock::time_point _lastCompaction;
+    qint64 _snapshotSize { 0 };
+    bool _needsCompaction { false };
 };
 
 #endif // hifi_OctreePersistThread_h
@@ -14,6 +14,10 @@
 #include "impl/FileClip.h"
 #include "impl/BufferClip.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QBuffer>
@@ -54,8 +58,11 @@ float Clip::position() const {
     return Frame::frameTimeToSeconds(positionFrameTime());
 }
 
+static_assert(sizeof(Clip::FrameIndexEntry) == 16, "Frame index entries are written as they are laid out");
+static_assert(sizeof(Clip::FrameIndexFooter) == 16, "Frame index footers are written as they are laid out");
+
 // FIXME move to frame?
-bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
+bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true, FrameSize* writtenSize = nullptr) {
     if (frame.type == Frame::TYPE_INVALID) {
         qWarning() << "Attempting to write invalid frame";
         return true;
@@ -80,6 +87,9 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
     if (written != sizeof(uint16_t)) {
         return false;
     }
+    if (writtenSize) {
+        *writtenSize = dataSize;
+    }
 
     if (dataSize != 0) {
         written = output.write(frameData);
@@ -92,6 +102,10 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
 
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
+const uint32_t Clip::FRAME_INDEX_MAGIC = 0x58444946; // "FIDX"
+
+static const size_t FRAME_HEADER_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize);
+static const size_t MAX_INDEX_ENTRIES_PER_FRAME = std::numeric_limits<FrameSize>::max() / sizeof(Clip::FrameIndexEntry);
 
 bool Clip::write(QIODevice& output) {
     auto frameTypes = Frame::getFrameTypes();
@@ -109,13 +123,39 @@ bool Clip::write(QIODevice& output) {
     if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
         return false;
     }
+    quint64 fileOffset = FRAME_HEADER_SIZE + headerFrameData.size();
 
     seek(0);
 
+    std::vector<FrameIndexEntry> index;
+    index.reserve(frameCount());
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
-        if (!writeFrame(output, *frame)) {
+        if (frame->type == Frame::TYPE_INVALID) {
+            continue;
+        }
+        FrameIndexEntry entry;
+        entry.timeOffset = frame->timeOffset;
+        entry.type = frame->type;
+        entry.fileOffset = fileOffset + FRAME_HEADER_SIZE;
+        if (!writeFrame(output, *frame, true, &entry.size)) {
             return false;
         }
+        fileOffset = entry.fileOffset + entry.size;
+        index.push_back(entry);
     }
-    return true;
+
+    // The index frames are never compressed, so that they can be read in place
+    FrameIndexFooter footer;
+    footer.magic = FRAME_INDEX_MAGIC;
+    footer.frameCount = (uint32_t)index.size();
+    footer.indexOffset = fileOffset;
+    for (size_t i = 0; i < index.size(); i += MAX_INDEX_ENTRIES_PER_FRAME) {
+        size_t numEntries = std::min(index.size() - i, MAX_INDEX_ENTRIES_PER_FRAME);
+        QByteArray indexData = QByteArray::fromRawData((const char*)&index[i], (int)(numEntries * sizeof(FrameIndexEntry)));
+        if (!writeFrame(output, Frame({ Frame::TYPE_INDEX, 0, indexData }), false)) {
+            return false;
+        }
+    }
+    QByteArray footerData = QByteArray::fromRawData((const char*)&footer, sizeof(FrameIndexFooter));
+    return writeFrame(output, Frame({ Frame::TYPE_INDEX, 0, footerData }), false);
 }
@@ -47,6 +47,9 @@ public:
     virtual void skipFrame() = 0;
     virtual void addFrame(FrameConstPointer) = 0;
 
+    // whether more frames are still being loaded, such as from the network, past the end of the clip so far
+    virtual bool isLoading() const { return false; }
+
     bool write(QIODevice& output);
 
     static Pointer fromFile(const QString& filePath);
@@ -57,6 +60,21 @@ public:
     static const QString FRAME_TYPE_MAP;
     static const QString FRAME_COMREPSSION_FLAG;
 
+    // The clip files end with an index of the frames, so that they can be read without scanning every frame:
+    // index frames holding a FrameIndexEntry per frame, then a footer frame holding a FrameIndexFooter.
+    struct FrameIndexEntry {
+        Frame::Time timeOffset;
+        FrameType type;
+        FrameSize size;
+        quint64 fileOffset; // of the frame data
+    };
+    struct FrameIndexFooter {
+        uint32_t magic;
+        uint32_t frameCount;
+        quint64 indexOffset; // of the first index frame
+    };
+    static const uint32_t FRAME_INDEX_MAGIC;
+
 protected:
     friend class WrapperClip;
     using Mutex = std::recursive_mutex;
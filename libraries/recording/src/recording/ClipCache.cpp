@@ -10,12 +10,18 @@
 
 #include <QThread>
 
+#include <NetworkingConstants.h>
 #include <shared/QtHelpers.h>
 
 #include "impl/PointerClip.h"
 #include "Logging.h"
 
 using namespace recording;
+
+// enough of a recording to start playing it, the rest is downloaded in bigger parts while it plays
+static const int64_t FIRST_PART_SIZE = 256 * 1024;
+static const int64_t PART_SIZE = 2 * 1024 * 1024;
+
 NetworkClipLoader::NetworkClipLoader(const QUrl& url) :
     Resource(url),
     _clip(std::make_shared<NetworkClip>(url)) {
@@ -24,17 +30,94 @@ NetworkClipLoader::NetworkClipLoader(const QUrl& url) :
         _startedLoading = false;
         _failedToLoad = true;
     }
+    _requestByteRange.fromInclusive = 0;
+    _requestByteRange.toExclusive = FIRST_PART_SIZE;
+}
+
+NetworkClipLoader::~NetworkClipLoader() {
+    // a clip playing from a loader that is evicted plays as far as it was downloaded
+    if (_clip->isLoading()) {
+        _clip->appendData(QByteArray(), true);
+    }
 }
 
 void NetworkClip::init(const QByteArray& clipData) {
+    Locker lock(_mutex);
     _clipData = clipData;
+    _isLoading = false;
     PointerClip::init((uchar*)_clipData.data(), _clipData.size());
 }
 
+void NetworkClip::appendData(const QByteArray& clipData, bool isLastPart) {
+    Locker lock(_mutex);
+    _clipData.append(clipData);
+    _isLoading = !isLastPart;
+    PointerClip::appendData((uchar*)_clipData.data(), _clipData.size());
+}
+
+void NetworkClip::clear() {
+    Locker lock(_mutex);
+    _clipData.clear();
+    _isLoading = true;
+    PointerClip::reset();
+}
+
+bool NetworkClip::isLoading() const {
+    Locker lock(_mutex);
+    return _isLoading;
+}
+
 void NetworkClipLoader::downloadFinished(const QByteArray& data) {
-    _clip->init(data);
-    finishedLoading(true);
-    emit clipLoaded();
+    int64_t requestedSize = _requestByteRange.size();
+    auto scheme = _activeUrl.scheme();
+    bool isHTTP = scheme == HIFI_URL_SCHEME_HTTP || scheme == HIFI_URL_SCHEME_HTTPS;
+    // servers that don't support ranges send the whole clip
+    if (data.size() > requestedSize || (isHTTP && _request && !_request->getRangeRequestSuccessful())) {
+        _clip->init(data);
+        _bytesLoaded = data.size();
+    } else {
+        if (_requestByteRange.fromInclusive == 0) {
+            _clip->clear();
+            _bytesLoaded = 0;
+        }
+        _clip->appendData(data, data.size() < requestedSize);
+        _bytesLoaded += data.size();
+    }
+
+    if (!_loaded) {
+        finishedLoading(true);
+        emit clipLoaded();
+    }
+
+    if (_clip->isLoading()) {
+        requestNextPart();
+    }
+}
+
+void NetworkClipLoader::requestNextPart() {
+    _requestByteRange.fromInclusive = _bytesLoaded;
+    _requestByteRange.toExclusive = _bytesLoaded + PART_SIZE;
+    init(false);
+    // the request that downloaded the last part is only cleaned up after this returns
+    QMetaObject::invokeMethod(this, "attemptRequest", Qt::QueuedConnection);
+}
+
+bool NetworkClipLoader::handleFailedRequest(ResourceRequest::Result result) {
+    if (_loaded) {
+        // the clip plays as far as it was downloaded, which is all of it when the last part ended right at its end
+        if (result != ResourceRequest::InvalidByteRange) {
+            qCWarning(recordingLog) << "Failed to load the rest of the recording at" << _url << "after" << _bytesLoaded << "bytes";
+        }
+        _clip->appendData(QByteArray(), true);
+        return false;
+    }
+    return Resource::handleFailedRequest(result);
+}
+
+void NetworkClipLoader::refresh() {
+    _requestByteRange.fromInclusive = 0;
+    _requestByteRange.toExclusive = FIRST_PART_SIZE;
+    Resource::refresh();
 }
 
 ClipCache::ClipCache(QObject* parent) :
@@ -23,27 +23,43 @@ public:
     NetworkClip(const QUrl& url) : _url(url) {}
     virtual void init(const QByteArray& clipData);
     virtual QString getName() const override { return _url.toString(); }
+    virtual bool isLoading() const override;
+
+    // starts a clip that is downloaded in parts
+    void clear();
+    // adds the next part of a clip being downloaded, the frames it completes can be played right away
+    void appendData(const QByteArray& clipData, bool isLastPart);
 
 private:
     QByteArray _clipData;
     QUrl _url;
+    bool _isLoading { false };
 };
 
+// Downloads a clip in parts, so that playback can start once the first part is in
 class NetworkClipLoader : public Resource {
     Q_OBJECT
 public:
     NetworkClipLoader(const QUrl& url);
     NetworkClipLoader(const NetworkClipLoader& other) : Resource(other), _clip(other._clip) {}
+    ~NetworkClipLoader();
 
     virtual void downloadFinished(const QByteArray& data) override;
+    virtual void refresh() override;
     ClipPointer getClip() { return _clip; }
     bool completed() { return _failedToLoad || isLoaded(); }
 
 signals:
     void clipLoaded();
 
+protected:
+    virtual bool handleFailedRequest(ResourceRequest::Result result) override;
+
 private:
+    void requestNextPart();
+
     const NetworkClip::Pointer _clip;
+    size_t _bytesLoaded { 0 };
 };
 
 using NetworkClipLoaderPointer = QSharedPointer<NetworkClipLoader>;
@@ -33,7 +33,6 @@ void Deck::queueClip(ClipPointer clip, float timeOffset) {
 
     // FIXME disabling multiple clips for now
     _clips.clear();
-    _length = 0.0f;
 
     // if the time offset is not zero, wrap in an OffsetClip
     if (timeOffset != 0.0f) {
@@ -41,8 +40,6 @@ void Deck::queueClip(ClipPointer clip, float timeOffset) {
     }
 
     _clips.push_back(clip);
-
-    _length = std::max(_length, clip->duration());
 }
 
 void Deck::play() { 
@@ -107,9 +104,19 @@ void Deck::setVolume(float volume) {
     _volume = std::min(std::max(volume, 0.0f), 1.0f);
 }
 
+static const int LOADING_CLIP_WAIT_MSECS = 50;
 static const Frame::Time MIN_FRAME_WAIT_INTERVAL = Frame::secondsToFrameTime(0.001f);
 static const Frame::Time MAX_FRAME_PROCESSING_TIME = Frame::secondsToFrameTime(0.004f);
 
+bool Deck::isLoadingClips() const {
+    for (const auto& clip : _clips) {
+        if (clip->isLoading()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void Deck::processFrames() {
     if (qApp->thread() != QThread::currentThread()) {
         qWarning() << "Processing frames must only happen on the main thread.";
@@ -150,6 +157,13 @@ void Deck::processFrames() {
     }
 
     if (!nextClip) {
+        if (isLoadingClips()) {
+            // Wait at the current position for the frames that are still loading
+            _startEpoch = Frame::epochForFrameTime(_position);
+            _timer.singleShot(LOADING_CLIP_WAIT_MSECS, this, &Deck::processFrames);
+            return;
+        }
+
         // No more frames available, so handle the end of playback
         if (_loop) {
             // If we have looping enabled, start the playback over
@@ -231,7 +245,12 @@ void Deck::stop() {
 
 float Deck::length() const { 
     Locker lock(_mutex);
-    return _length;
+    // clips that are still loading get longer
+    float length = 0.0f;
+    for (const auto& clip : _clips) {
+        length = std::max(length, clip->duration());
+    }
+    return length;
 }
 
 void Deck::loop(bool enable) { 
@@ -69,6 +69,7 @@ private:
     using Locker = std::unique_lock<Mutex>;
 
     ClipPointer getNextClip();
+    bool isLoadingClips() const;
     void processFrames();
 
     mutable Mutex _mutex;
@@ -78,7 +79,6 @@ private:
     Frame::Time _position { 0 };
     bool _pause { true };
     bool _loop { false };
-    float _length { 0 };
     float _volume { 1.0f };
 };
 
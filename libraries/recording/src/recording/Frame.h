@@ -36,6 +36,8 @@ struct FrameHeader {
 
     static const FrameType TYPE_INVALID = 0xFFFF;
     static const FrameType TYPE_HEADER = 0x0;
+    // the frame time index at the end of a clip, see Clip::write
+    static const FrameType TYPE_INDEX = 0xFFFE;
 
     static Time secondsToFrameTime(float seconds);
     static float frameTimeToSeconds(Time frameTime);
@@ -29,7 +29,12 @@ FileClip::FileClip(const QString& fileName) : _file(fileName) {
         qCWarning(recordingLog) << "Unable to open file " << fileName;
         return;
     }
+    // the frames are read in place from the map, with the index at the end of the file only its pages are read here
     auto mappedFile = _file.map(0, size, QFile::MapPrivateOption);
+    if (!mappedFile) {
+        qCWarning(recordingLog) << "Unable to map file " << fileName;
+        return;
+    }
     init(mappedFile, size);
 }
 
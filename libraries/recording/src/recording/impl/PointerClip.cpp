@@ -9,6 +9,7 @@
 #include "PointerClip.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include <QtCore/QDebug>
 #include <QtCore/QJsonDocument>
@@ -44,41 +45,30 @@ FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
     return results;
 }
 
-
-PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size) {
-    PointerFrameHeaderList results;
-    auto current = start;
-    auto end = current + size;
-    // Read all the frame headers
-    // FIXME move to Frame::readHeader?
-    while (end - current >= PointerClip::MINIMUM_FRAME_SIZE) {
-        PointerFrameHeader header;
-        memcpy(&(header.type), current, sizeof(FrameType));
-        current += sizeof(FrameType);
-        memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
-        current += sizeof(Frame::Time);
-        memcpy(&(header.size), current, sizeof(FrameSize));
-        current += sizeof(FrameSize);
-        header.fileOffset = current - start;
-        if (end - current < header.size) {
-            break;
-        }
-        current += header.size;
-        results.push_back(header);
+// Reads the header of the frame at offset, if the frame is complete
+// FIXME move to Frame::readHeader?
+static bool readFrameHeader(const uchar* start, size_t size, size_t offset, PointerFrameHeader& header) {
+    if (offset > size || size - offset < (size_t)PointerClip::MINIMUM_FRAME_SIZE) {
+        return false;
     }
-    qDebug(recordingLog) << "Parsed source data into " << results.size() << " frames";
-//    int i = 0;
-//    for (const auto& frameHeader : results) {
-//        qDebug(recordingLog) << "Frame " << i++ << " time " << frameHeader.timeOffset << " Type " << frameHeader.type;
-//    }
-    return results;
+    auto current = start + offset;
+    memcpy(&(header.type), current, sizeof(FrameType));
+    current += sizeof(FrameType);
+    memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
+    current += sizeof(Frame::Time);
+    memcpy(&(header.size), current, sizeof(FrameSize));
+    current += sizeof(FrameSize);
+    header.fileOffset = current - start;
+    return size - header.fileOffset >= header.size;
 }
 
 void PointerClip::reset() {
     _frames.clear();
     _data = nullptr;
     _size = 0;
+    _parsedSize = 0;
     _header = QJsonDocument();
+    _translationMap.clear();
 }
 
 void PointerClip::init(uchar* data, size_t size) {
@@ -87,53 +77,132 @@ void PointerClip::init(uchar* data, size_t size) {
     _data = data;
     _size = size;
 
-    auto parsedFrameHeaders = parseFrameHeaders(data, size);
-    // Verify that at least one frame exists and that the first frame is a header
-    if (0 == parsedFrameHeaders.size()) {
-        qWarning() << "No frames found, invalid file";
+    // Verify that the first frame is a header
+    if (!readHeader()) {
+        qWarning() << "Missing header frame, invalid file";
         reset();
         return;
     }
 
-    // Grab the file header
-    {
-        auto fileHeaderFrameHeader = *parsedFrameHeaders.begin();
-        parsedFrameHeaders.pop_front();
-        if (fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
-            qWarning() << "Missing header frame, invalid file";
-            reset();
-            return;
-        }
+    if (_translationMap.empty()) {
+        qWarning() << "Header missing frame type map, invalid file";
+        reset();
+        return;
+    }
+
+    // Files written without an index are read frame by frame
+    if (!readFrameIndex()) {
+        parseFrameHeaders();
+    }
+}
+
+void PointerClip::appendData(uchar* data, size_t size) {
+    _data = data;
+    _size = size;
+    if (_parsedSize == 0 && !readHeader()) {
+        // wait for the rest of the header
+        return;
+    }
+    parseFrameHeaders();
+}
 
-        QByteArray fileHeaderData((char*)_data + fileHeaderFrameHeader.fileOffset, fileHeaderFrameHeader.size);
-        _header = QJsonDocument::fromBinaryData(fileHeaderData);
+bool PointerClip::readHeader() {
+    PointerFrameHeader fileHeaderFrameHeader;
+    if (!readFrameHeader(_data, _size, 0, fileHeaderFrameHeader) || fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
+        return false;
     }
 
+    QByteArray fileHeaderData((char*)_data + fileHeaderFrameHeader.fileOffset, fileHeaderFrameHeader.size);
+    _header = QJsonDocument::fromBinaryData(fileHeaderData);
+
     // Check for compression
-    {
-        _compressed = _header.object()[FRAME_COMREPSSION_FLAG].toBool();
+    _compressed = _header.object()[FRAME_COMREPSSION_FLAG].toBool();
+
+    // Find the type enum translation map, to fix up the frame headers
+    _translationMap = parseTranslationMap(_header);
+
+    _parsedSize = fileHeaderFrameHeader.fileOffset + fileHeaderFrameHeader.size;
+    return true;
+}
+
+bool PointerClip::readFrameIndex() {
+    static const size_t FOOTER_FRAME_SIZE = MINIMUM_FRAME_SIZE + sizeof(FrameIndexFooter);
+    if (_size < _parsedSize + FOOTER_FRAME_SIZE) {
+        return false;
+    }
+
+    size_t indexEnd = _size - FOOTER_FRAME_SIZE;
+    PointerFrameHeader footerFrameHeader;
+    if (!readFrameHeader(_data, _size, indexEnd, footerFrameHeader) || footerFrameHeader.type != Frame::TYPE_INDEX ||
+        footerFrameHeader.size != sizeof(FrameIndexFooter)) {
+        return false;
+    }
+    FrameIndexFooter footer;
+    memcpy(&footer, _data + footerFrameHeader.fileOffset, sizeof(FrameIndexFooter));
+    if (footer.magic != FRAME_INDEX_MAGIC || footer.indexOffset < _parsedSize || footer.indexOffset > indexEnd) {
+        return false;
+    }
+    // the entries are all between the index offset and the footer, a larger count can't be right
+    if (footer.frameCount > (indexEnd - footer.indexOffset) / sizeof(FrameIndexEntry)) {
+        return false;
     }
 
-    // Find the type enum translation map and fix up the frame headers
-    {
-        FrameTranslationMap translationMap = parseTranslationMap(_header);
-        if (translationMap.empty()) {
-            qWarning() << "Header missing frame type map, invalid file";
-            reset();
-            return;
+    std::vector<PointerFrameHeader> frames;
+    frames.reserve(footer.frameCount);
+    size_t numEntries = 0;
+    size_t offset = footer.indexOffset;
+    while (offset < indexEnd) {
+        PointerFrameHeader indexFrameHeader;
+        if (!readFrameHeader(_data, indexEnd, offset, indexFrameHeader) || indexFrameHeader.type != Frame::TYPE_INDEX ||
+            indexFrameHeader.size % sizeof(FrameIndexEntry) != 0) {
+            return false;
         }
 
-        // Update the loaded headers with the frame data
-        _frames.reserve(parsedFrameHeaders.size());
-        for (auto& frameHeader : parsedFrameHeaders) {
-            if (!translationMap.contains(frameHeader.type)) {
+        auto entries = _data + indexFrameHeader.fileOffset;
+        for (size_t i = 0; i < indexFrameHeader.size / sizeof(FrameIndexEntry); ++i) {
+            FrameIndexEntry entry;
+            memcpy(&entry, entries + i * sizeof(FrameIndexEntry), sizeof(FrameIndexEntry));
+            // the end of the frame isn't computed, it could wrap around
+            if (entry.fileOffset < _parsedSize || entry.fileOffset > footer.indexOffset ||
+                entry.size > footer.indexOffset - entry.fileOffset) {
+                return false;
+            }
+            ++numEntries;
+            if (!_translationMap.contains(entry.type)) {
                 continue;
             }
-            frameHeader.type = translationMap[frameHeader.type];
-            _frames.push_back(frameHeader);
+            PointerFrameHeader frameHeader;
+            frameHeader.type = _translationMap[entry.type];
+            frameHeader.timeOffset = entry.timeOffset;
+            frameHeader.size = entry.size;
+            frameHeader.fileOffset = entry.fileOffset;
+            frames.push_back(frameHeader);
         }
+        offset = indexFrameHeader.fileOffset + indexFrameHeader.size;
     }
+    if (numEntries != footer.frameCount) {
+        return false;
+    }
+
+    _frames.swap(frames);
+    _parsedSize = _size;
+    qDebug(recordingLog) << "Read the index of " << _frames.size() << " frames";
+    return true;
+}
 
+void PointerClip::parseFrameHeaders() {
+    // Read all the frame headers
+    size_t numFrames = _frames.size();
+    PointerFrameHeader frameHeader;
+    while (readFrameHeader(_data, _size, _parsedSize, frameHeader)) {
+        _parsedSize = frameHeader.fileOffset + frameHeader.size;
+        if (!_translationMap.contains(frameHeader.type)) {
+            continue;
+        }
+        frameHeader.type = _translationMap[frameHeader.type];
+        _frames.push_back(frameHeader);
+    }
+    qDebug(recordingLog) << "Parsed source data into " << _frames.size() - numFrames << " frames";
 }
 
 // Internal only function, needs no locking
@@ -15,20 +15,17 @@
 #include <mutex>
 
 #include <QtCore/QJsonDocument>
+#include <QtCore/QMap>
 
 #include "../Frame.h"
 
 namespace recording {
 
 struct PointerFrameHeader : public FrameHeader {
-    FrameType type;
-    Frame::Time timeOffset;
     uint16_t size;
     quint64 fileOffset;
 };
 
-using PointerFrameHeaderList = std::list<PointerFrameHeader>;
-
 class PointerClip : public ArrayClip<PointerFrameHeader> {
 public:
     using Pointer = std::shared_ptr<PointerClip>;
@@ -47,10 +44,22 @@ public:
 protected:
     void reset() override;
     virtual FrameConstPointer readFrame(size_t index) const override;
+
+    // Reads the frames of data that has grown from the same start, such as while it downloads, past the frames already
+    // read.  The index at the end of a clip is only used for the complete data given to init.
+    void appendData(uchar* data, size_t size);
+
     QJsonDocument _header;
     uchar* _data { nullptr };
     size_t _size { 0 };
+    size_t _parsedSize { 0 };
     bool _compressed { true };
+    QMap<FrameType, FrameType> _translationMap;
+
+private:
+    bool readHeader();
+    bool readFrameIndex();
+    void parseFrameHeaders();
 };
 
 }
@@ -42,6 +42,10 @@ void WrapperClip::skipFrame() {
     _wrappedClip->skipFrame();
 }
 
+bool WrapperClip::isLoading() const {
+    return _wrappedClip->isLoading();
+}
+
 void WrapperClip::reset() {
     _wrappedClip->reset();
 }
@@ -35,6 +35,7 @@ public:
     virtual FrameConstPointer nextFrame() override;
     virtual void skipFrame() override;
     virtual void addFrame(FrameConstPointer) override;
+    virtual bool isLoading() const override;
 
 protected:
     virtual void reset() override;
@@ -12,8 +12,10 @@
 #include "ScriptEngine.h"
 
 #include <chrono>
+#include <limits>
 #include <thread>
 
+#include <QtCore/QAbstractEventDispatcher>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QEventLoop>
 #include <QtCore/QFileInfo>
@@ -225,7 +227,6 @@ ScriptEngine::ScriptEngine(Context context, const QString& scriptContents, const
     BaseScriptEngine(),
     _context(context),
     _scriptContents(scriptContents),
-    _timerFunctionMap(),
     _fileNameString(fileNameString),
     _arrayBufferClass(new ArrayBufferClass(this)),
     _assetScriptingInterface(new AssetScriptingInterface(this))
@@ -256,6 +257,14 @@ ScriptEngine::ScriptEngine(Context context, const QString& scriptContents, const
         }
     }, Qt::DirectConnection);
 
+    _timerClock.start();
+    _timerWheelTimer = new QTimer(this);
+    _timerWheelTimer->setSingleShot(true);
+    _timerWheelTimer->setTimerType(Qt::PreciseTimer);
+    connect(_timerWheelTimer, &QTimer::timeout, this, &ScriptEngine::processTimers);
+    // make sure the timers stop when the script does
+    connect(this, &ScriptEngine::scriptEnding, _timerWheelTimer, &QTimer::stop);
+
     setProcessEventsInterval(MSECS_PER_SECOND);
     if (isEntityServerScript()) {
         qCDebug(scriptengine) << "isEntityServerScript() -- limiting maxRetries to 1";
@@ -1300,6 +1309,22 @@ void ScriptEngine::run() {
 
     std::chrono::microseconds totalUpdates(0);
 
+    // the thread is idle while its event dispatcher is blocked waiting for events
+    quint64 blockedSince = 0;
+    QMetaObject::Connection aboutToBlockConnection;
+    QMetaObject::Connection awakeConnection;
+    if (auto eventDispatcher = QAbstractEventDispatcher::instance()) {
+        aboutToBlockConnection = connect(eventDispatcher, &QAbstractEventDispatcher::aboutToBlock, this, [&blockedSince] {
+            blockedSince = usecTimestampNow();
+        }, Qt::DirectConnection);
+        awakeConnection = connect(eventDispatcher, &QAbstractEventDispatcher::awake, this, [this, &blockedSince] {
+            if (blockedSince != 0) {
+                _idleUsecs += usecTimestampNow() - blockedSince;
+                blockedSince = 0;
+            }
+        }, Qt::DirectConnection);
+    }
+
     // TODO: Integrate this with signals/slots instead of reimplementing throttling for ScriptEngine
     while (!_isFinished) {
         auto beforeSleep = clock::now();
@@ -1377,6 +1402,13 @@ void ScriptEngine::run() {
             break;
         }
 
+        // fire the timers that expired while the events were being processed
+        processTimers();
+
+        if (_isFinished) {
+            break;
+        }
+
         if (!_isFinished && entityScriptingInterface->getEntityPacketSender()->serversExist()) {
             // release the queue of edit entity messages.
             entityScriptingInterface->getEntityPacketSender()->releaseQueuedMessages();
@@ -1415,6 +1447,9 @@ void ScriptEngine::run() {
     }
     scriptInfoMessage("Script Engine stopping:" + getFilename());
 
+    disconnect(aboutToBlockConnection);
+    disconnect(awakeConnection);
+
     stopAllTimers(); // make sure all our timers are stopped if the script is ending
     emit scriptEnding();
 
@@ -1447,32 +1482,17 @@ void ScriptEngine::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptEngine::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    int j {0};
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
-        qCDebug(scriptengine) << getFilename() << "stopAllTimers[" << j++ << "]";
-        stopTimer(timer);
-    }
+    _timerWheel.clear();
+    _timerFunctionMap.clear();
+    _timerWheelTimer->stop();
 }
 
 void ScriptEngine::stopAllTimersForEntityScript(const EntityItemID& entityID) {
-     // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    while (i.hasNext()) {
-        i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
-            continue;
-        }
-        QTimer* timer = i.key();
-        toDelete << timer; // don't delete while we're iterating. save it.
-    }
-    for (auto timer:toDelete) { // now reap 'em
-        stopTimer(timer);
+    std::vector<TimerWheel::TimerID> removed;
+    _timerWheel.removeOwner(entityID, removed);
+    for (auto timerID : removed) {
+        _timerFunctionMap.remove(timerID);
     }
-
 }
 
 void ScriptEngine::stop(bool marshal) {
@@ -1525,88 +1545,107 @@ void ScriptEngine::updateMemoryCost(const qint64& deltaSize) {
     }
 }
 
-void ScriptEngine::timerFired() {
+void ScriptEngine::processTimers() {
     {
         QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
         if (!scriptEngines || scriptEngines->isStopped()) {
-            scriptWarningMessage("Script.timerFired() while shutting down is ignored... parent script:" + getFilename());
+            if (!_timerWheel.isEmpty()) {
+                scriptWarningMessage("Script.timerFired() while shutting down is ignored... parent script:" + getFilename());
+            }
             return; // bail early
         }
     }
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
+    // a timer callback can end up here again by processing events, so it doesn't get the shared list of expired timers
+    std::vector<TimerWheel::TimerID> expiredTimers;
+    std::swap(expiredTimers, _expiredTimers);
+    _timerWheel.advance(_timerClock.elapsed(), expiredTimers);
 
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
-    }
+    for (auto timerID : expiredTimers) {
+        // an earlier callback may have stopped this timer
+        auto timerIt = _timerFunctionMap.find(timerID);
+        if (timerIt == _timerFunctionMap.end()) {
+            continue;
+        }
+        CallbackData timerData = timerIt.value();
 
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
-        PROFILE_RANGE(script, __FUNCTION__);
-        auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
-        auto postTimer = p_high_resolution_clock::now();
-        auto elapsed = (postTimer - preTimer);
-        _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
-    } else {
-        qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        if (!_timerWheel.contains(timerID)) {
+            // this timer is done, we can forget it
+            _timerFunctionMap.erase(timerIt);
+        }
+
+        // call the associated JS function, if it exists
+        if (timerData.function.isValid()) {
+            PROFILE_RANGE(script, "timerFired");
+            auto preTimer = p_high_resolution_clock::now();
+            callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+            auto postTimer = p_high_resolution_clock::now();
+            auto elapsed = (postTimer - preTimer);
+            _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        } else {
+            qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        }
     }
-}
 
-QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
+    expiredTimers.clear();
+    std::swap(expiredTimers, _expiredTimers);
 
-    // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
-    static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
-    }
+    scheduleTimers();
+}
 
-    connect(newTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
+void ScriptEngine::scheduleTimers() {
+    quint64 nextExpiry;
+    if (!_timerWheel.getNextExpiry(nextExpiry)) {
+        _timerWheelTimer->stop();
+        return;
+    }
+    quint64 now = (quint64)_timerClock.elapsed();
+    int delay = nextExpiry > now ? (int)std::min(nextExpiry - now, (quint64)std::numeric_limits<int>::max()) : 0;
 
-    // make sure the timer stops when the script does
-    connect(this, &ScriptEngine::scriptEnding, newTimer, &QTimer::stop);
+    // only ever bring the wake up forward, most new timers expire after the next one anyway
+    if (!_timerWheelTimer->isActive() || delay < _timerWheelTimer->remainingTime()) {
+        _timerWheelTimer->start(delay);
+    }
+}
 
+QVariant ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
+    // add the timer to the wheel and the map, the wheel owns it on behalf of the defining entity so that unloading
+    // the entity script can stop its timers without looking at the others
+    quint32 interval = (quint32)std::max(intervalMS, 0);
+    auto timerID = _timerWheel.add((quint64)_timerClock.elapsed() + interval, interval, isSingleShot, currentEntityIdentifier);
 
     CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
-    _timerFunctionMap.insert(newTimer, timerData);
+    _timerFunctionMap.insert(timerID, timerData);
 
-    newTimer->start(intervalMS);
-    return newTimer;
+    scheduleTimers();
+    return QVariant((double)timerID);
 }
 
-QObject* ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
+QVariant ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
     QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
     if (!scriptEngines || scriptEngines->isStopped()) {
         scriptWarningMessage("Script.setInterval() while shutting down is ignored... parent script:" + getFilename());
-        return NULL; // bail early
+        return QVariant(); // bail early
     }
 
     return setupTimerWithInterval(function, intervalMS, false);
 }
 
-QObject* ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
+QVariant ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
     QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
     if (!scriptEngines || scriptEngines->isStopped()) {
         scriptWarningMessage("Script.setTimeout() while shutting down is ignored... parent script:" + getFilename());
-        return NULL; // bail early
+        return QVariant(); // bail early
     }
 
     return setupTimerWithInterval(function, timeoutMS, true);
 }
 
-void ScriptEngine::stopTimer(QTimer *timer) {
-    if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
-        _timerFunctionMap.remove(timer);
-        delete timer;
+void ScriptEngine::stopTimer(TimerWheel::TimerID timerID) {
+    if (_timerFunctionMap.remove(timerID) > 0) {
+        _timerWheel.remove(timerID);
     } else {
-        qCDebug(scriptengine) << "stopTimer -- not in _timerFunctionMap" << timer;
+        qCDebug(scriptengine) << "stopTimer -- not in _timerFunctionMap" << timerID;
     }
 }
 
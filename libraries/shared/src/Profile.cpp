@@ -39,13 +39,7 @@ Q_LOGGING_CATEGORY(trace_baker, "trace.baker")
 #endif
 
 static bool tracingEnabled() {
-    if (!DependencyManager::isSet<tracing::Tracer>()) {
-        return false;
-    }
-
-    // Cheers, love! The cavalry's here!
-    auto tracer = DependencyManager::get<tracing::Tracer>();
-    return (tracer && tracer->isEnabled());
+    return tracing::enabled();
 }
 
 DurationBase::DurationBase(const QLoggingCategory& category, const QString& name) : _name(name), _category(category) {
@@ -57,10 +51,17 @@ Duration::Duration(const QLoggingCategory& category,
                    uint64_t payload,
                    const QVariantMap& baseArgs) :
     DurationBase(category, name) {
-    if (tracingEnabled() && category.isDebugEnabled()) {
-        QVariantMap args = baseArgs;
-        args["nv_payload"] = QVariant::fromValue(payload);
-        tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+    tracing::EnabledTracer tracer;
+    if (tracer && category.isDebugEnabled()) {
+        static const QString NV_PAYLOAD = "nv_payload";
+        if (baseArgs.empty()) {
+            // the common case, which doesn't need an argument map
+            tracer->traceEvent(_category, _name, tracing::DurationBegin, tracing::Tracer::now(), NV_PAYLOAD, (double)payload);
+        } else {
+            QVariantMap args = baseArgs;
+            args[NV_PAYLOAD] = QVariant::fromValue(payload);
+            tracer->traceEvent(_category, _name, tracing::DurationBegin, "", args);
+        }
 
 #if defined(NSIGHT_TRACING)
         nvtxEventAttributes_t eventAttrib{ 0 };
@@ -79,8 +80,9 @@ Duration::Duration(const QLoggingCategory& category,
 }
 
 Duration::~Duration() {
-    if (tracingEnabled() && _category.isDebugEnabled()) {
-        tracing::traceEvent(_category, _name, tracing::DurationEnd);
+    tracing::EnabledTracer tracer;
+    if (tracer && _category.isDebugEnabled()) {
+        tracer->traceEvent(_category, _name, tracing::DurationEnd);
 #ifdef NSIGHT_TRACING
         nvtxRangePop();
 #endif
@@ -0,0 +1,94 @@
+//
+//  SpatialHashGrid.cpp
+//  libraries/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatialHashGrid.h"
+
+#include <algorithm>
+#include <cassert>
+
+static const float MIN_CELL_SIZE = 0.001f;
+
+// 21 bits per axis, offset so that negative cells pack as positive values
+static const int CELL_BITS = 21;
+static const int64_t CELL_OFFSET = 1 << (CELL_BITS - 1);
+static const int64_t CELL_MASK = (1 << CELL_BITS) - 1;
+
+SpatialHashGrid::SpatialHashGrid(float cellSize) {
+    setCellSize(cellSize);
+}
+
+void SpatialHashGrid::clear() {
+    _points.clear();
+    _cells.clear();
+}
+
+void SpatialHashGrid::setCellSize(float cellSize) {
+    assert(_points.empty());
+    _cellSize = std::max(cellSize, MIN_CELL_SIZE);
+    _inverseCellSize = 1.0f / _cellSize;
+}
+
+void SpatialHashGrid::insert(Index index, const glm::vec3& position) {
+    _points.push_back({ keyFor(cellFor(position)), index, position });
+}
+
+void SpatialHashGrid::build() {
+    std::sort(_points.begin(), _points.end(), [](const Point& a, const Point& b) {
+        return a.key < b.key;
+    });
+
+    _cells.clear();
+    _cells.reserve(_points.size());
+
+    uint32_t begin = 0;
+    while (begin < (uint32_t)_points.size()) {
+        uint32_t end = begin + 1;
+        while (end < (uint32_t)_points.size() && _points[end].key == _points[begin].key) {
+            ++end;
+        }
+        _cells.emplace(_points[begin].key, std::make_pair(begin, end));
+        begin = end;
+    }
+}
+
+void SpatialHashGrid::selectCandidates(const glm::vec3& center, float radius, const std::vector<Index>& alwaysIncluded,
+                                       const std::vector<Index>& sampled, size_t numSamples, size_t& cursor,
+                                       std::vector<Index>& candidates) const {
+    candidates.clear();
+
+    findInRadius(center, radius, [&](Index index, const glm::vec3&) {
+        candidates.push_back(index);
+    });
+
+    candidates.insert(candidates.end(), alwaysIncluded.begin(), alwaysIncluded.end());
+
+    if (!sampled.empty()) {
+        numSamples = std::min(sampled.size(), numSamples);
+        for (size_t i = 0; i < numSamples; ++i) {
+            candidates.push_back(sampled[(cursor + i) % sampled.size()]);
+        }
+        cursor = (cursor + numSamples) % sampled.size();
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
+
+SpatialHashGrid::Cell SpatialHashGrid::cellFor(const glm::vec3& position) const {
+    return Cell(glm::floor(position * _inverseCellSize));
+}
+
+SpatialHashGrid::CellKey SpatialHashGrid::keyFor(const Cell& cell) {
+    // cells beyond the packable range wrap around and share keys with far away cells,
+    // which findInRadius tolerates since it checks the distance to every point
+    return (CellKey)(((int64_t)cell.x + CELL_OFFSET) & CELL_MASK)
+        | ((CellKey)(((int64_t)cell.y + CELL_OFFSET) & CELL_MASK) << CELL_BITS)
+        | ((CellKey)(((int64_t)cell.z + CELL_OFFSET) & CELL_MASK) << (2 * CELL_BITS));
+}
@@ -0,0 +1,102 @@
+//
+//  SpatialHashGrid.h
+//  libraries/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SpatialHashGrid_h
+#define hifi_SpatialHashGrid_h
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Uniform grid over a set of points, meant to be rebuilt from scratch every frame.
+// Only occupied cells are stored, so the grid is unbounded and its memory is proportional to the number of points.
+// Points are identified by an index chosen by the caller, typically the point's position in some other container.
+class SpatialHashGrid {
+public:
+    using Index = uint32_t;
+
+    SpatialHashGrid(float cellSize = 1.0f);
+
+    // clears the grid, the cell size can only change while it is empty
+    void clear();
+    void setCellSize(float cellSize);
+    float getCellSize() const { return _cellSize; }
+
+    // points are only queryable once build() has been called
+    void insert(Index index, const glm::vec3& position);
+    void build();
+
+    size_t size() const { return _points.size(); }
+    bool isEmpty() const { return _points.empty(); }
+
+    // calls functor(index, position) for every point within radius of center
+    template <typename F>
+    void findInRadius(const glm::vec3& center, float radius, F&& functor) const;
+
+    // Fills candidates, sorted and without duplicates, with the points within radius of center, the ones always included,
+    // and numSamples of the sampled ones starting at cursor.  The cursor is advanced past the samples, so that a caller
+    // keeping it across frames still visits every sampled point every so many frames.
+    void selectCandidates(const glm::vec3& center, float radius, const std::vector<Index>& alwaysIncluded,
+                          const std::vector<Index>& sampled, size_t numSamples, size_t& cursor,
+                          std::vector<Index>& candidates) const;
+
+private:
+    using CellKey = uint64_t;
+    using Cell = glm::ivec3;
+
+    struct Point {
+        CellKey key;
+        Index index;
+        glm::vec3 position;
+    };
+
+    Cell cellFor(const glm::vec3& position) const;
+    static CellKey keyFor(const Cell& cell);
+
+    float _cellSize;
+    float _inverseCellSize;
+
+    // points sorted by cell, and where each occupied cell's run of points starts and ends
+    std::vector<Point> _points;
+    std::unordered_map<CellKey, std::pair<uint32_t, uint32_t>> _cells;
+};
+
+template <typename F>
+void SpatialHashGrid::findInRadius(const glm::vec3& center, float radius, F&& functor) const {
+    const Cell minCell = cellFor(center - glm::vec3(radius));
+    const Cell maxCell = cellFor(center + glm::vec3(radius));
+    const float radiusSquared = radius * radius;
+
+    for (int x = minCell.x; x <= maxCell.x; ++x) {
+        for (int y = minCell.y; y <= maxCell.y; ++y) {
+            for (int z = minCell.z; z <= maxCell.z; ++z) {
+                auto it = _cells.find(keyFor(Cell(x, y, z)));
+                if (it == _cells.end()) {
+                    continue;
+                }
+
+                for (uint32_t i = it->second.first; i < it->second.second; ++i) {
+                    const Point& point = _points[i];
+                    glm::vec3 offset = point.position - center;
+                    if (glm::dot(offset, offset) <= radiusSquared) {
+                        functor(point.index, point.position);
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif // hifi_SpatialHashGrid_h
@@ -0,0 +1,260 @@
+//
+//  TimerWheel.cpp
+//  libraries/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+const TimerWheel::TimerID TimerWheel::INVALID_TIMER;
+const quint32 TimerWheel::NONE;
+
+TimerWheel::TimerID TimerWheel::add(quint64 expiryMsecs, quint32 intervalMsecs, bool isSingleShot, const QUuid& owner) {
+    quint32 index;
+    if (_freeTimers.empty()) {
+        index = (quint32)_timers.size();
+        _timers.emplace_back();
+    } else {
+        index = _freeTimers.back();
+        _freeTimers.pop_back();
+    }
+
+    Timer& timer = _timers[index];
+    // the slot of the current time was already processed, so the earliest a new timer can expire is on the next one
+    timer.expiry = std::max(expiryMsecs, _now + 1);
+    timer.interval = intervalMsecs;
+    timer.isSingleShot = isSingleShot;
+    timer.isActive = true;
+    timer.generation = timer.generation < MAX_GENERATION ? timer.generation + 1 : 1;
+    timer.owner = owner;
+
+    auto ownerIt = _ownerTimers.find(owner);
+    timer.previousOfOwner = NONE;
+    if (ownerIt != _ownerTimers.end()) {
+        timer.nextOfOwner = ownerIt.value();
+        _timers[ownerIt.value()].previousOfOwner = index;
+        ownerIt.value() = index;
+    } else {
+        timer.nextOfOwner = NONE;
+        _ownerTimers.insert(owner, index);
+    }
+
+    insert(index);
+    ++_numTimers;
+    return makeID(index, timer.generation);
+}
+
+quint32 TimerWheel::find(TimerID timerID) const {
+    quint32 index = (quint32)(timerID & UINT32_MAX);
+    quint32 generation = (quint32)(timerID >> 32);
+    if (index >= _timers.size() || !_timers[index].isActive || _timers[index].generation != generation) {
+        return NONE;
+    }
+    return index;
+}
+
+bool TimerWheel::remove(TimerID timerID) {
+    quint32 index = find(timerID);
+    if (index == NONE) {
+        return false;
+    }
+    unlink(index);
+    release(index);
+    return true;
+}
+
+void TimerWheel::removeOwner(const QUuid& owner, std::vector<TimerID>& removed) {
+    auto ownerIt = _ownerTimers.find(owner);
+    if (ownerIt == _ownerTimers.end()) {
+        return;
+    }
+    quint32 index = ownerIt.value();
+    _ownerTimers.erase(ownerIt);
+
+    while (index != NONE) {
+        Timer& timer = _timers[index];
+        quint32 next = timer.nextOfOwner;
+        removed.push_back(makeID(index, timer.generation));
+        unlink(index);
+        timer.isActive = false;
+        timer.owner = QUuid();
+        _freeTimers.push_back(index);
+        --_numTimers;
+        index = next;
+    }
+}
+
+void TimerWheel::clear() {
+    for (quint32 index = 0; index < _timers.size(); ++index) {
+        Timer& timer = _timers[index];
+        if (timer.isActive) {
+            timer.isActive = false;
+            timer.owner = QUuid();
+            _freeTimers.push_back(index);
+        }
+    }
+    _slots.fill(NONE);
+    _numTimersPerLevel.fill(0);
+    _ownerTimers.clear();
+    _numTimers = 0;
+}
+
+void TimerWheel::insert(quint32 index) {
+    Timer& timer = _timers[index];
+    quint64 delta = timer.expiry > _now ? timer.expiry - _now : 0;
+
+    // timers further away than the wheel reaches wait in the last slot it does, and get placed again from there
+    quint64 expiry = timer.expiry;
+    if (delta > MAX_DELTA) {
+        delta = MAX_DELTA;
+        expiry = _now + MAX_DELTA;
+    }
+
+    int level = 0;
+    while (level < NUM_LEVELS - 1 && delta >= (1ULL << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+    int slot = level * NUM_SLOTS + (int)((expiry >> (SLOT_BITS * level)) & SLOT_MASK);
+
+    timer.slot = (quint16)slot;
+    timer.previous = NONE;
+    timer.next = _slots[slot];
+    if (timer.next != NONE) {
+        _timers[timer.next].previous = index;
+    }
+    _slots[slot] = index;
+    ++_numTimersPerLevel[level];
+}
+
+void TimerWheel::unlink(quint32 index) {
+    Timer& timer = _timers[index];
+    if (timer.previous != NONE) {
+        _timers[timer.previous].next = timer.next;
+    } else {
+        _slots[timer.slot] = timer.next;
+    }
+    if (timer.next != NONE) {
+        _timers[timer.next].previous = timer.previous;
+    }
+    --_numTimersPerLevel[timer.slot / NUM_SLOTS];
+}
+
+void TimerWheel::release(quint32 index) {
+    Timer& timer = _timers[index];
+    if (timer.previousOfOwner != NONE) {
+        _timers[timer.previousOfOwner].nextOfOwner = timer.nextOfOwner;
+    } else if (timer.nextOfOwner != NONE) {
+        _ownerTimers[timer.owner] = timer.nextOfOwner;
+    } else {
+        _ownerTimers.remove(timer.owner);
+    }
+    if (timer.nextOfOwner != NONE) {
+        _timers[timer.nextOfOwner].previousOfOwner = timer.previousOfOwner;
+    }
+
+    timer.isActive = false;
+    timer.owner = QUuid();
+    _freeTimers.push_back(index);
+    --_numTimers;
+}
+
+quint32 TimerWheel::detachSlot(int slot) {
+    quint32 first = _slots[slot];
+    _slots[slot] = NONE;
+    for (quint32 index = first; index != NONE; index = _timers[index].next) {
+        --_numTimersPerLevel[slot / NUM_SLOTS];
+    }
+    return first;
+}
+
+void TimerWheel::cascade(int level) {
+    int slotInLevel = (int)((_now >> (SLOT_BITS * level)) & SLOT_MASK);
+    if (slotInLevel == 0 && level < NUM_LEVELS - 1) {
+        cascade(level + 1);
+    }
+
+    quint32 index = detachSlot(level * NUM_SLOTS + slotInLevel);
+    while (index != NONE) {
+        quint32 next = _timers[index].next;
+        insert(index);
+        index = next;
+    }
+}
+
+void TimerWheel::advance(quint64 nowMsecs, std::vector<TimerID>& expired) {
+    while (_now < nowMsecs) {
+        if (_numTimers == 0) {
+            _now = nowMsecs;
+            break;
+        }
+
+        // nothing can expire before the next cascade when the lowest level is empty, so skip straight to it
+        if (_numTimersPerLevel[0] == 0) {
+            quint64 lastBeforeCascade = _now | SLOT_MASK;
+            if (lastBeforeCascade >= nowMsecs) {
+                _now = nowMsecs;
+                break;
+            }
+            _now = lastBeforeCascade;
+        }
+
+        ++_now;
+        int slot = (int)(_now & SLOT_MASK);
+        if (slot == 0) {
+            cascade(1);
+        }
+
+        quint32 index = detachSlot(slot);
+        while (index != NONE) {
+            Timer& timer = _timers[index];
+            quint32 next = timer.next;
+            if (timer.expiry > _now) {
+                // parked in the last slot the wheel reaches
+                insert(index);
+            } else {
+                expired.push_back(makeID(index, timer.generation));
+                if (timer.isSingleShot) {
+                    release(index);
+                } else {
+                    timer.expiry += std::max(timer.interval, (quint32)1);
+                    if (timer.expiry <= nowMsecs) {
+                        timer.expiry = nowMsecs + std::max(timer.interval, (quint32)1);
+                    }
+                    insert(index);
+                }
+            }
+            index = next;
+        }
+    }
+}
+
+bool TimerWheel::getNextExpiry(quint64& expiryMsecs) const {
+    if (_numTimers == 0) {
+        return false;
+    }
+
+    // timers in the higher levels only get to the lowest one when the levels below them wrap around, the earliest
+    // they can expire
+    int level = 1;
+    while (level < NUM_LEVELS && _numTimersPerLevel[level] == 0) {
+        ++level;
+    }
+    quint64 nextCascade = level < NUM_LEVELS ? (_now | ((1ULL << (SLOT_BITS * level)) - 1)) + 1 : UINT64_MAX;
+
+    if (_numTimersPerLevel[0] > 0) {
+        for (quint64 time = _now + 1; time < _now + NUM_SLOTS && time < nextCascade; ++time) {
+            if (_slots[time & SLOT_MASK] != NONE) {
+                expiryMsecs = time;
+                return true;
+            }
+        }
+    }
+    expiryMsecs = nextCascade;
+    return true;
+}
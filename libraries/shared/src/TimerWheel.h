@@ -0,0 +1,105 @@
+//
+//  TimerWheel.h
+//  libraries/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_TimerWheel_h
+#define hifi_TimerWheel_h
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QUuid>
+
+// Hierarchical timing wheel for large numbers of millisecond timers.
+//
+// Timers are kept in four levels of 256 slots, each level 256 times coarser than the one below, and move down a level
+// whenever the wheel below wraps around. Adding and removing a timer is O(1) and advancing the wheel costs one step per
+// elapsed millisecond, whatever the number of timers. Timers also belong to an owner, all the timers of an owner can
+// be removed without looking at the others.
+//
+// The wheel doesn't read any clock, the caller passes the current time in msecs to add() and advance().
+//
+// TimerWheel is not thread-safe!
+class TimerWheel {
+public:
+    // fits in the 53 bits of a double, so that it can be handed to scripts as a number
+    using TimerID = quint64;
+    static const TimerID INVALID_TIMER = 0;
+
+    TimerWheel(quint64 nowMsecs = 0) : _now(nowMsecs) { _slots.fill(NONE); }
+
+    quint64 getTime() const { return _now; }
+    size_t getNumTimers() const { return _numTimers; }
+    bool isEmpty() const { return _numTimers == 0; }
+
+    // a single shot timer is removed once expired, an interval timer is rescheduled intervalMsecs after its expiry
+    TimerID add(quint64 expiryMsecs, quint32 intervalMsecs, bool isSingleShot, const QUuid& owner = QUuid());
+
+    bool contains(TimerID timerID) const { return find(timerID) != NONE; }
+    bool remove(TimerID timerID);
+
+    // removes all the timers of an owner, and appends their IDs to removed
+    void removeOwner(const QUuid& owner, std::vector<TimerID>& removed);
+    void clear();
+
+    // moves the wheel to nowMsecs, and appends the timers that expired in between to expired, earliest first
+    // an interval timer that fell behind only expires once, and its next expiry is counted from nowMsecs
+    void advance(quint64 nowMsecs, std::vector<TimerID>& expired);
+
+    // the time of the next expiry, or an earlier time at which the wheel needs to be advanced to get to it
+    // returns false if there are no timers
+    bool getNextExpiry(quint64& expiryMsecs) const;
+
+private:
+    static const int SLOT_BITS = 8;
+    static const int NUM_SLOTS = 1 << SLOT_BITS;
+    static const quint64 SLOT_MASK = NUM_SLOTS - 1;
+    static const int NUM_LEVELS = 4;
+    static const quint64 MAX_DELTA = (1ULL << (SLOT_BITS * NUM_LEVELS)) - 1;
+    static const quint32 NONE = UINT32_MAX;
+    static const quint32 MAX_GENERATION = (1U << 21) - 1;
+
+    struct Timer {
+        quint64 expiry { 0 };
+        quint32 interval { 0 };
+        quint32 generation { 0 };
+        bool isSingleShot { false };
+        bool isActive { false };
+        quint16 slot { 0 };
+        quint32 previous { NONE };
+        quint32 next { NONE };
+        QUuid owner;
+        quint32 previousOfOwner { NONE };
+        quint32 nextOfOwner { NONE };
+    };
+
+    static TimerID makeID(quint32 index, quint32 generation) { return ((TimerID)generation << 32) | index; }
+    quint32 find(TimerID timerID) const;
+
+    void insert(quint32 index);
+    void unlink(quint32 index);
+    void release(quint32 index);
+    quint32 detachSlot(int slot);
+    void cascade(int level);
+
+    quint64 _now;
+    size_t _numTimers { 0 };
+    std::array<quint32, NUM_LEVELS * NUM_SLOTS> _slots;
+    std::array<size_t, NUM_LEVELS> _numTimersPerLevel {{ 0, 0, 0, 0 }};
+    std::vector<Timer> _timers;
+    std::vector<quint32> _freeTimers;
+    QHash<QUuid, quint32> _ownerTimers; // first timer of each owner
+};
+
+#endif // hifi_TimerWheel_h
@@ -8,7 +8,11 @@
 
 #include "Trace.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
+#include <limits>
+#include <thread>
 
 #include <QtCore/QDebug>
 #include <QtCore/QCoreApplication>
@@ -22,6 +26,7 @@
 #include <QtCore/QTemporaryFile>
 #include <QtCore/QDataStream>
 #include <QtCore/QTextStream>
+#include <QtCore/QtEndian>
 
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonDocument>
@@ -36,211 +41,724 @@
 
 using namespace tracing;
 
+// a power of two, so that the position in the ring buffer is a mask of the event count
+const size_t Tracer::EVENTS_PER_THREAD = 1 << 15;
+// 32 bytes per event, the payloads being those of the events with string ids or arguments that aren't numbers
+const size_t Tracer::PAYLOAD_BYTES_PER_THREAD = 1 << 20;
+// the names are those of the code, this only bounds the ones built at run time
+const size_t Tracer::MAX_INTERNED_STRINGS = 1 << 16;
+const QString Tracer::BINARY_TRACE_EXTENSION = ".hftrace";
+
+std::atomic<Tracer*> Tracer::_enabledTracer { nullptr };
+
+static const uint32_t BINARY_TRACE_MAGIC = 0x52544648; // "HFTR"
+static const uint32_t BINARY_TRACE_VERSION = 2;
+
+// distinguishes the tracers that were created, so that the threads don't reuse the ring buffers of a previous one
+static std::atomic<uint64_t> nextTracerGeneration { 1 };
+
+namespace tracing {
+
+// The events recorded by one thread.  Only that thread writes to the ring buffers, publishing each event with the
+// release of the head, while serialize reads them from another thread.
+class TraceThreadEvents {
+public:
+    TraceThreadEvents(uint64_t generation, int64_t threadID) :
+        generation(generation), threadID(threadID), _events(new TraceRecord[Tracer::EVENTS_PER_THREAD]),
+        _payloads(new char[Tracer::PAYLOAD_BYTES_PER_THREAD]) {}
+
+    void push(TraceRecord& record, const QByteArray& payload) {
+        if (!payload.isEmpty()) {
+            // the end is moved before the payload is written, so that serialize knows which payloads it overwrites
+            uint64_t payloadStart = _payloadEnd.load(std::memory_order_relaxed);
+            _payloadEnd.store(payloadStart + payload.size(), std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            size_t position = payloadStart & (Tracer::PAYLOAD_BYTES_PER_THREAD - 1);
+            size_t firstPartSize = std::min((size_t)payload.size(), Tracer::PAYLOAD_BYTES_PER_THREAD - position);
+            memcpy(&_payloads[position], payload.constData(), firstPartSize);
+            memcpy(&_payloads[0], payload.constData() + firstPartSize, payload.size() - firstPartSize);
+            record.payloadOffset = payloadStart;
+            record.payloadSize = (uint32_t)payload.size();
+        }
+
+        uint64_t head = _head.load(std::memory_order_relaxed);
+        _events[head & (Tracer::EVENTS_PER_THREAD - 1)] = record;
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    // copies the events recorded between startTime and stopTime, oldest first, skipping the ones overwritten while
+    // they were copied, or whose payloads were
+    void copyEvents(int64_t startTime, int64_t stopTime, std::vector<TraceRecordCopy>& events) const {
+        uint64_t head = _head.load(std::memory_order_acquire);
+        uint64_t first = head > Tracer::EVENTS_PER_THREAD ? head - Tracer::EVENTS_PER_THREAD : 0;
+        std::vector<TraceRecord> copied;
+        copied.reserve(head - first);
+        for (uint64_t i = first; i < head; ++i) {
+            copied.push_back(_events[i & (Tracer::EVENTS_PER_THREAD - 1)]);
+        }
+        QByteArray payloads(_payloads.get(), (int)Tracer::PAYLOAD_BYTES_PER_THREAD);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t headAfterCopy = _head.load(std::memory_order_relaxed);
+        uint64_t payloadEndAfterCopy = _payloadEnd.load(std::memory_order_relaxed);
+        // the event being written after headAfterCopy overwrites the oldest one too
+        uint64_t firstValid = headAfterCopy >= Tracer::EVENTS_PER_THREAD ? headAfterCopy - Tracer::EVENTS_PER_THREAD + 1 : 0;
+        uint64_t firstValidPayload = payloadEndAfterCopy > Tracer::PAYLOAD_BYTES_PER_THREAD ?
+            payloadEndAfterCopy - Tracer::PAYLOAD_BYTES_PER_THREAD : 0;
+        for (uint64_t i = std::max(first, firstValid); i < head; ++i) {
+            const auto& record = copied[i - first];
+            if (record.timestamp < startTime || record.timestamp > stopTime ||
+                (record.payloadSize > 0 && record.payloadOffset < firstValidPayload)) {
+                continue;
+            }
+            TraceRecordCopy event { record, QByteArray() };
+            if (record.payloadSize > 0) {
+                int position = (int)(record.payloadOffset & (Tracer::PAYLOAD_BYTES_PER_THREAD - 1));
+                event.payload = payloads.mid(position, record.payloadSize);
+                event.payload.append(payloads.constData(), (int)record.payloadSize - event.payload.size());
+            }
+            events.push_back(event);
+        }
+    }
+
+    const uint64_t generation;
+    const int64_t threadID;
+
+    // the strings this thread interned, so that it only takes the strings lock for new ones
+    QHash<QString, uint32_t> strings;
+    QHash<const QLoggingCategory*, uint32_t> categories;
+
+private:
+    std::unique_ptr<TraceRecord[]> _events;
+    std::atomic<uint64_t> _head { 0 };
+    std::unique_ptr<char[]> _payloads;
+    std::atomic<uint64_t> _payloadEnd { 0 };
+};
+
+}
+
+// the tracers that weren't destroyed, by generation, so that a thread that exits only hands its events to a tracer
+// that is still there
+static std::mutex liveTracersMutex;
+static QHash<uint64_t, Tracer*> liveTracers;
+
+namespace tracing {
+
+// Owns the ring buffers of the current thread.  They take a few megabytes, so when the thread exits the events that may
+// still be serialized are copied out of them, and they are freed.
+class ThreadEventsOwner {
+public:
+    ~ThreadEventsOwner() { Tracer::releaseThreadEvents(events); }
+
+    std::shared_ptr<TraceThreadEvents> events;
+};
+
+}
+
+static thread_local ThreadEventsOwner currentThreadEvents;
+
+namespace tracing {
+
+// The tracer held by the EnabledTracer of a thread, published so that the tracer's destructor can wait until the threads
+// that loaded it before it was disabled are done with it.
+class TracerUse {
+public:
+    TracerUse();
+    ~TracerUse();
+
+    std::atomic<Tracer*> tracer { nullptr };
+    // the EnabledTracer instances of the thread that hold the tracer
+    int holders { 0 };
+};
+
+}
+
+static std::mutex tracerUsesMutex;
+static std::vector<TracerUse*> tracerUses;
+static thread_local TracerUse currentTracerUse;
+
+TracerUse::TracerUse() {
+    std::lock_guard<std::mutex> guard(tracerUsesMutex);
+    tracerUses.push_back(this);
+}
+
+TracerUse::~TracerUse() {
+    std::lock_guard<std::mutex> guard(tracerUsesMutex);
+    tracerUses.erase(std::remove(tracerUses.begin(), tracerUses.end(), this), tracerUses.end());
+}
+
+void EnabledTracer::acquire() {
+    TracerUse& use = currentTracerUse;
+    if (use.holders > 0) {
+        // this thread already holds it
+        _tracer = use.tracer.load(std::memory_order_relaxed);
+        use.holders++;
+        return;
+    }
+
+    // the tracer is published before it is loaded again, so that the destructor either waits for this thread or
+    // disabled it before it was loaded
+    Tracer* tracer = Tracer::_enabledTracer.load();
+    while (tracer) {
+        use.tracer.store(tracer);
+        Tracer* enabledTracer = Tracer::_enabledTracer.load();
+        if (enabledTracer == tracer) {
+            _tracer = tracer;
+            use.holders = 1;
+            return;
+        }
+        tracer = enabledTracer;
+    }
+    use.tracer.store(nullptr, std::memory_order_release);
+}
+
+void EnabledTracer::release() {
+    TracerUse& use = currentTracerUse;
+    if (--use.holders == 0) {
+        use.tracer.store(nullptr, std::memory_order_release);
+    }
+}
+
 bool tracing::enabled() {
-    return DependencyManager::get<Tracer>()->isEnabled();
+    return Tracer::_enabledTracer.load(std::memory_order_relaxed) != nullptr;
+}
+
+Tracer::Tracer() : _generation(nextTracerGeneration++) {
+    // index 0 is the empty string, for the events whose strings couldn't be interned
+    uint32_t index;
+    intern(QString(), index);
+    std::lock_guard<std::mutex> guard(liveTracersMutex);
+    liveTracers.insert(_generation, this);
+}
+
+Tracer::~Tracer() {
+    {
+        std::lock_guard<std::mutex> guard(liveTracersMutex);
+        liveTracers.remove(_generation);
+    }
+    Tracer* self = this;
+    _enabledTracer.compare_exchange_strong(self, nullptr);
+
+    // the threads that loaded this tracer before it was disabled may still be recording an event
+    std::lock_guard<std::mutex> guard(tracerUsesMutex);
+    for (const auto& use : tracerUses) {
+        while (use->tracer.load() == this) {
+            std::this_thread::yield();
+        }
+    }
 }
 
 void Tracer::startTracing() {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
     if (_enabled) {
         qWarning() << "Tried to enable tracer, but already enabled";
         return;
     }
 
-    _events.clear();
+    // the events of a previous trace stay in the ring buffers, but they're older than the start time
+    {
+        std::lock_guard<std::mutex> guard(_threadsMutex);
+        _exitedThreads.clear();
+    }
+    _startTime = now();
+    _stopTime = std::numeric_limits<int64_t>::max();
     _enabled = true;
+    _enabledTracer = this;
 }
 
 void Tracer::stopTracing() {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
     if (!_enabled) {
         qWarning() << "Cannot stop tracing, already disabled";
         return;
     }
     _enabled = false;
+    Tracer* self = this;
+    _enabledTracer.compare_exchange_strong(self, nullptr);
+    _stopTime = now();
 }
 
-void TraceEvent::writeJson(QTextStream& out) const {
-#if 0
-    // FIXME QJsonObject serialization is very slow, so we should be using manual JSON serialization
-    out << "{";
-    out << "\"name\":\"" << name << "\",";
-    out << "\"cat\":\"" << category.categoryName() << "\",";
-    out << "\"ph\":\"" << QString(type) << "\",";
-    out << "\"ts\":\"" << timestamp << "\",";
-    out << "\"pid\":\"" << processID << "\",";
-    out << "\"tid\":\"" << threadID << "\"";
-    //if (!extra.empty()) {
-    //    auto it = extra.begin();
-    //    for (; it != extra.end(); it++) {
-    //        ev[it.key()] = QJsonValue::fromVariant(it.value());
-    //    }
-    //}
-    //if (!args.empty()) {
-    //    out << ",\"args\":'
-    //}
-    out << '}';
-#else
-    QJsonObject ev {
-        { "name", QJsonValue(name) },
-        { "cat", category.categoryName() },
-        { "ph", QString(type) },
-        { "ts", timestamp },
-        { "pid", processID },
-        { "tid", threadID }
-    };
+bool Tracer::intern(const QString& string, uint32_t& index, bool isBounded) {
+    std::lock_guard<std::mutex> guard(_stringsMutex);
+    auto itr = _stringIndices.find(string);
+    if (itr != _stringIndices.end()) {
+        index = itr.value();
+        return true;
+    }
+    if (isBounded && _strings.size() >= MAX_INTERNED_STRINGS) {
+        _isStringsTableFull = true;
+        return false;
+    }
+    index = (uint32_t)_strings.size();
+    _strings.push_back(string);
+    _stringIndices.insert(string, index);
+    return true;
+}
+
+bool Tracer::internCached(TraceThreadEvents* events, const QString& string, uint32_t& index) {
+    if (!events) {
+        return intern(string, index);
+    }
+    auto itr = events->strings.find(string);
+    if (itr != events->strings.end()) {
+        index = itr.value();
+        return true;
+    }
+    if (_isStringsTableFull.load(std::memory_order_relaxed) || !intern(string, index)) {
+        return false;
+    }
+    events->strings.insert(string, index);
+    return true;
+}
+
+TraceThreadEvents& Tracer::getThreadEvents() {
+    auto& events = currentThreadEvents.events;
+    if (!events || events->generation != _generation) {
+        releaseThreadEvents(events);
+        events = std::make_shared<TraceThreadEvents>(_generation, int64_t(QThread::currentThreadId()));
+        std::lock_guard<std::mutex> guard(_threadsMutex);
+        _threads.push_back(events);
+    }
+    return *events;
+}
+
+void Tracer::releaseThreadEvents(std::shared_ptr<TraceThreadEvents>& events) {
+    if (!events) {
+        return;
+    }
+    {
+        // held until the events are handed over, so that the tracer isn't destroyed meanwhile
+        std::lock_guard<std::mutex> guard(liveTracersMutex);
+        Tracer* tracer = liveTracers.value(events->generation, nullptr);
+        if (tracer) {
+            tracer->keepExitedThreadEvents(*events);
+        }
+    }
+    events.reset();
+}
+
+void Tracer::keepExitedThreadEvents(const TraceThreadEvents& events) {
+    std::vector<TraceRecordCopy> records;
+    events.copyEvents(_startTime, _enabled ? std::numeric_limits<int64_t>::max() : (int64_t)_stopTime, records);
+
+    std::lock_guard<std::mutex> guard(_threadsMutex);
+    _threads.erase(std::remove_if(_threads.begin(), _threads.end(),
+        [&](const std::shared_ptr<TraceThreadEvents>& thread) { return thread.get() == &events; }), _threads.end());
+    if (!records.empty()) {
+        _exitedThreads.emplace_back(events.threadID, std::move(records));
+    }
+}
+
+static bool isNumeric(const QVariant& value) {
+    switch ((QMetaType::Type)value.userType()) {
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Float:
+        case QMetaType::Double:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// the strings of the payload are each written as their size followed by their UTF-8 bytes
+static void appendPayload(QByteArray& payload, const QByteArray& bytes) {
+    uchar size[sizeof(quint32)];
+    qToLittleEndian<quint32>((quint32)bytes.size(), size);
+    payload.append(reinterpret_cast<const char*>(size), sizeof(size));
+    payload.append(bytes);
+}
+
+static QByteArray takePayload(const QByteArray& payload, int& position) {
+    if (position + (int)sizeof(quint32) > payload.size()) {
+        return QByteArray();
+    }
+    quint32 size = qFromLittleEndian<quint32>(reinterpret_cast<const uchar*>(payload.constData() + position));
+    position += sizeof(quint32);
+    if (size > (quint32)(payload.size() - position)) {
+        position = payload.size();
+        return QByteArray();
+    }
+    QByteArray bytes = payload.mid(position, size);
+    position += size;
+    return bytes;
+}
+
+static QByteArray toJson(const QVariantMap& map) {
+    return QJsonDocument(QJsonObject::fromVariantMap(map)).toJson(QJsonDocument::Compact);
+}
+
+TraceThreadEvents* Tracer::getEventsFor(EventType type) {
+    // metadata events are kept apart, so the threads that only name themselves don't get ring buffers
+    return (type == Metadata) ? nullptr : &getThreadEvents();
+}
+
+// the name and the id go first in the payload, followed by the arguments
+void Tracer::startRecord(TraceThreadEvents* events, TraceRecord& record, QByteArray& payload,
+        const QLoggingCategory& category, const QString& name, EventType type, int64_t timestamp, const QString& id) {
+    record.timestamp = timestamp;
+    record.type = type;
+    if (!internCached(events, name, record.nameIndex)) {
+        record.flags |= TraceRecord::NAME_PAYLOAD;
+        appendPayload(payload, name.toUtf8());
+    }
+
+    // the categories are declared by the code, they aren't bounded
+    if (!events) {
+        intern(category.categoryName(), record.categoryIndex, false);
+    } else {
+        auto categoryItr = events->categories.find(&category);
+        if (categoryItr != events->categories.end()) {
+            record.categoryIndex = categoryItr.value();
+        } else {
+            intern(category.categoryName(), record.categoryIndex, false);
+            events->categories.insert(&category, record.categoryIndex);
+        }
+    }
+
     if (!id.isEmpty()) {
-        ev["id"] = id;
+        record.flags |= TraceRecord::HAS_ID;
+        bool isNumber = false;
+        record.id = id.toULongLong(&isNumber);
+        if (!isNumber || QString::number(record.id) != id) {
+            record.flags |= TraceRecord::STRING_ID;
+            record.id = 0;
+            appendPayload(payload, id.toUtf8());
+        }
     }
-    if (!args.empty()) {
-        ev["args"] = QJsonObject::fromVariantMap(args);
+}
+
+void Tracer::addArgs(TraceThreadEvents* events, TraceRecord& record, QByteArray& payload,
+        const QVariantMap& args, const QVariantMap& extra) {
+    // a few numeric arguments, such as the values of a counter, are kept inline
+    bool isInline = args.size() <= TraceRecord::MAX_INLINE_ARGS;
+    for (auto it = args.cbegin(); isInline && it != args.cend(); ++it) {
+        isInline = isNumeric(it.value()) && internCached(events, it.key(), record.argNameIndices[record.numArgs]);
+        record.argValues[record.numArgs++] = it.value().toDouble();
+    }
+    if (!isInline) {
+        record.numArgs = 0;
+        record.flags |= TraceRecord::JSON_ARGS;
+        appendPayload(payload, toJson(args));
     }
     if (!extra.empty()) {
-        auto it = extra.begin();
-        for (; it != extra.end(); it++) {
-            ev[it.key()] = QJsonValue::fromVariant(it.value());
-        }
+        record.flags |= TraceRecord::JSON_EXTRA;
+        appendPayload(payload, toJson(extra));
     }
-    out << QJsonDocument(ev).toJson(QJsonDocument::Compact);
-#endif
 }
 
-void Tracer::serialize(const QString& filename) {
-    QString fullPath = FileUtils::replaceDateTimeTokens(filename);
-    fullPath = FileUtils::computeDocumentPath(fullPath);
-    if (!FileUtils::canCreateFile(fullPath)) {
+void Tracer::addRecord(TraceThreadEvents* events, TraceRecord& record, const QByteArray& payload) {
+    if (!events) {
+        std::lock_guard<std::mutex> guard(_threadsMutex);
+        _metadataEvents.emplace_back(int64_t(QThread::currentThreadId()), TraceRecordCopy { record, payload });
+        return;
+    }
+
+    if ((size_t)payload.size() > Tracer::PAYLOAD_BYTES_PER_THREAD / 2) {
+        // it would overwrite most of the others, the event is dropped
         return;
     }
+    events->push(record, payload);
+}
 
-    std::list<TraceEvent> currentEvents;
+static void writeRecord(QDataStream& out, const TraceRecordCopy& event) {
+    const auto& record = event.record;
+    out << (qint64)record.timestamp << (quint64)record.id << record.nameIndex << record.categoryIndex;
+    out << (qint8)record.type << record.flags << record.numArgs;
+    for (int i = 0; i < record.numArgs; ++i) {
+        out << record.argNameIndices[i] << record.argValues[i];
+    }
+    out << event.payload;
+}
+
+static void readRecord(QDataStream& in, TraceRecordCopy& event) {
+    auto& record = event.record;
+    qint64 timestamp;
+    quint64 id;
+    qint8 type;
+    in >> timestamp >> id >> record.nameIndex >> record.categoryIndex;
+    in >> type >> record.flags >> record.numArgs;
+    if (record.numArgs > TraceRecord::MAX_INLINE_ARGS) {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return;
+    }
+    for (int i = 0; i < record.numArgs; ++i) {
+        in >> record.argNameIndices[i] >> record.argValues[i];
+    }
+    in >> event.payload;
+    record.timestamp = timestamp;
+    record.id = id;
+    record.type = (char)type;
+}
+
+// The binary dump holds the interned strings, then the events of each thread and the metadata events, all little
+// endian:
+//   magic, version, process ID
+//   string count, strings
+//   thread count, then for each thread: thread ID, event count, events
+//   metadata count, then for each: thread ID, event
+// with each event followed by its inline arguments and its payload
+QByteArray Tracer::toBinary() {
+    std::vector<std::shared_ptr<TraceThreadEvents>> threads;
+    std::vector<std::pair<int64_t, std::vector<TraceRecordCopy>>> threadRecords;
+    std::vector<std::pair<int64_t, TraceRecordCopy>> metadataEvents;
     {
-        std::lock_guard<std::mutex> guard(_eventsMutex);
-        currentEvents.swap(_events);
-        for (auto& event : _metadataEvents) {
-            currentEvents.push_back(event);
-        }
+        std::lock_guard<std::mutex> guard(_threadsMutex);
+        threads = _threads;
+        threadRecords = _exitedThreads;
+        metadataEvents = _metadataEvents;
+    }
+
+    int64_t startTime = _startTime;
+    int64_t stopTime = _enabled ? std::numeric_limits<int64_t>::max() : (int64_t)_stopTime;
+    // the threads that exited kept the events of the trace as it was then, it may have been stopped since
+    for (auto& thread : threadRecords) {
+        auto& records = thread.second;
+        records.erase(std::remove_if(records.begin(), records.end(), [&](const TraceRecordCopy& event) {
+            return event.record.timestamp < startTime || event.record.timestamp > stopTime;
+        }), records.end());
+    }
+    for (const auto& thread : threads) {
+        threadRecords.emplace_back(thread->threadID, std::vector<TraceRecordCopy>());
+        thread->copyEvents(startTime, stopTime, threadRecords.back().second);
     }
 
-    // If we can't open a temp file for writing, fail early
     QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out << BINARY_TRACE_MAGIC << BINARY_TRACE_VERSION << (qint64)QCoreApplication::applicationPid();
+
+    // the strings are copied after the events, so that they hold every string the events refer to
     {
-        QTextStream out(&data);
-        out << "[\n";
-        bool first = true;
-        for (const auto& event : currentEvents) {
-            if (first) {
-                first = false;
-            } else {
-                out << ",\n";
+        std::lock_guard<std::mutex> guard(_stringsMutex);
+        out << (quint32)_strings.size();
+        for (const auto& string : _strings) {
+            out << string;
+        }
+    }
+
+    out << (quint32)threadRecords.size();
+    for (const auto& thread : threadRecords) {
+        out << (qint64)thread.first << (quint32)thread.second.size();
+        for (const auto& event : thread.second) {
+            writeRecord(out, event);
+        }
+    }
+
+    out << (quint32)metadataEvents.size();
+    for (const auto& event : metadataEvents) {
+        out << (qint64)event.first;
+        writeRecord(out, event.second);
+    }
+    return data;
+}
+
+bool Tracer::binaryToJson(const QByteArray& binary, QByteArray& json) {
+    QDataStream in(binary);
+    in.setByteOrder(QDataStream::LittleEndian);
+
+    quint32 magic, version;
+    qint64 processID;
+    in >> magic >> version >> processID;
+    if (in.status() != QDataStream::Ok || magic != BINARY_TRACE_MAGIC || version != BINARY_TRACE_VERSION) {
+        qCWarning(shared) << "Not a binary trace, or of an unknown version";
+        return false;
+    }
+
+    quint32 stringCount;
+    in >> stringCount;
+    QVector<QString> strings;
+    for (quint32 i = 0; i < stringCount && in.status() == QDataStream::Ok; ++i) {
+        QString string;
+        in >> string;
+        strings.push_back(string);
+    }
+
+    // the arguments that aren't numeric are JSON, often the same for the events of a counter
+    QHash<QByteArray, QJsonObject> parsedObjects;
+    auto objectOf = [&](const QByteArray& bytes) {
+        auto itr = parsedObjects.find(bytes);
+        if (itr == parsedObjects.end()) {
+            itr = parsedObjects.insert(bytes, QJsonDocument::fromJson(bytes).object());
+        }
+        return itr.value();
+    };
+
+    bool first = true;
+    QTextStream out(&json);
+    out << "[\n";
+    auto writeEvent = [&](qint64 threadID, const TraceRecordCopy& event) {
+        const auto& record = event.record;
+        int position = 0;
+        QString name = (record.flags & TraceRecord::NAME_PAYLOAD) ?
+            QString::fromUtf8(takePayload(event.payload, position)) : strings.value(record.nameIndex);
+        QJsonObject ev {
+            { "name", QJsonValue(name) },
+            { "cat", strings.value(record.categoryIndex) },
+            { "ph", QString(QLatin1Char(record.type)) },
+            { "ts", (qint64)record.timestamp },
+            { "pid", processID },
+            { "tid", threadID }
+        };
+        if (record.flags & TraceRecord::HAS_ID) {
+            ev["id"] = (record.flags & TraceRecord::STRING_ID) ?
+                QString::fromUtf8(takePayload(event.payload, position)) : QString::number(record.id);
+        }
+        if (record.flags & TraceRecord::JSON_ARGS) {
+            ev["args"] = objectOf(takePayload(event.payload, position));
+        } else if (record.numArgs > 0) {
+            QJsonObject args;
+            for (int i = 0; i < record.numArgs; ++i) {
+                args[strings.value(record.argNameIndices[i])] = record.argValues[i];
+            }
+            ev["args"] = args;
+        }
+        if (record.flags & TraceRecord::JSON_EXTRA) {
+            QJsonObject extra = objectOf(takePayload(event.payload, position));
+            for (auto it = extra.begin(); it != extra.end(); it++) {
+                ev[it.key()] = it.value();
+            }
+        }
+        if (first) {
+            first = false;
+        } else {
+            out << ",\n";
+        }
+        out << QJsonDocument(ev).toJson(QJsonDocument::Compact);
+    };
+
+    quint32 threadCount;
+    in >> threadCount;
+    for (quint32 i = 0; i < threadCount && in.status() == QDataStream::Ok; ++i) {
+        qint64 threadID;
+        quint32 eventCount;
+        in >> threadID >> eventCount;
+        for (quint32 j = 0; j < eventCount && in.status() == QDataStream::Ok; ++j) {
+            TraceRecordCopy event;
+            readRecord(in, event);
+            if (in.status() == QDataStream::Ok) {
+                writeEvent(threadID, event);
             }
-            event.writeJson(out);
         }
-        out << "\n]";
     }
 
+    quint32 metadataCount;
+    in >> metadataCount;
+    for (quint32 i = 0; i < metadataCount && in.status() == QDataStream::Ok; ++i) {
+        qint64 threadID;
+        TraceRecordCopy event;
+        in >> threadID;
+        readRecord(in, event);
+        if (in.status() == QDataStream::Ok) {
+            writeEvent(threadID, event);
+        }
+    }
+    out << "\n]";
+    out.flush();
+
+    if (in.status() != QDataStream::Ok) {
+        qCWarning(shared) << "Binary trace is truncated";
+        return false;
+    }
+    return true;
+}
+
+static bool writeTraceFile(const QString& fullPath, QByteArray data) {
     if (fullPath.endsWith(".gz")) {
         QByteArray compressed;
         gzip(data, compressed);
         data = compressed;
     }
 
-    {
-        QFile file(fullPath);
-        if (!file.open(QIODevice::WriteOnly)) {
-            qDebug(shared) << "failed to open file '" << fullPath << "'";
-            return;
-        }
-        file.write(data);
-        file.close();
+    QFile file(fullPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug(shared) << "failed to open file '" << fullPath << "'";
+        return false;
     }
+    file.write(data);
+    file.close();
+    return true;
+}
 
-#if 0
-    QByteArray data;
-    {
+void Tracer::serialize(const QString& filename) {
+    QString fullPath = FileUtils::replaceDateTimeTokens(filename);
+    fullPath = FileUtils::computeDocumentPath(fullPath);
+    if (!FileUtils::canCreateFile(fullPath)) {
+        return;
+    }
 
-        // "traceEvents":[
-        // {"args":{"nv_payload":0},"cat":"hifi.render","name":"render::Scene::processTransactionQueue","ph":"B","pid":14796,"tid":21636,"ts":68795933487}
+    QByteArray data = toBinary();
+    if (!fullPath.endsWith(BINARY_TRACE_EXTENSION)) {
+        QByteArray json;
+        binaryToJson(data, json);
+        data = json;
+    }
+    writeTraceFile(fullPath, data);
+}
 
-        QJsonArray traceEvents;
+bool Tracer::convertToJson(const QString& binaryFile, const QString& jsonFile) {
+    QFile file(binaryFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(shared) << "failed to open file '" << binaryFile << "'";
+        return false;
+    }
 
-        QJsonDocument document {
-            QJsonObject {
-                { "traceEvents", traceEvents },
-                { "otherData", QJsonObject {
-                    { "version", QString { "High Fidelity Interface v1.0" } +BuildInfo::VERSION }
-                } }
-            }
-        };
-        data = document.toJson(QJsonDocument::Compact);
+    QByteArray json;
+    if (!binaryToJson(file.readAll(), json)) {
+        return false;
     }
-#endif
+    return writeTraceFile(jsonFile, json);
 }
 
 int64_t Tracer::now() {
     return std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
 }
 
-void Tracer::traceEvent(const QLoggingCategory& category,
-    const QString& name, EventType type,
-    qint64 timestamp, qint64 processID, qint64 threadID,
-    const QString& id,
+void Tracer::traceEvent(const QLoggingCategory& category, 
+    const QString& name, EventType type, const QString& id, 
     const QVariantMap& args, const QVariantMap& extra) {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
-
-    // We always want to store metadata events even if tracing is not enabled so that when
-    // tracing is enabled we will be able to associate that metadata with that trace.
-    // Metadata events should be used sparingly - as of 12/30/16 the Chrome Tracing
-    // spec only supports thread+process metadata, so we should only expect to see metadata
-    // events created when a new thread or process is created.
     if (!_enabled && type != Metadata) {
         return;
     }
 
-    if (type == Metadata) {
-        _metadataEvents.push_back({
-            id,
-            name,
-            type,
-            timestamp,
-            processID,
-            threadID,
-            category,
-            args,
-            extra
-        });
-    } else {
-        _events.push_back({
-            id,
-            name,
-            type,
-            timestamp,
-            processID,
-            threadID,
-            category,
-            args,
-            extra
-        });
-    }
+    traceEvent(category, name, type, now(), id, args, extra);
 }
 
 void Tracer::traceEvent(const QLoggingCategory& category, 
-    const QString& name, EventType type, const QString& id, 
+    const QString& name, EventType type, int64_t timestamp, const QString& id, 
     const QVariantMap& args, const QVariantMap& extra) {
+    // We always want to store metadata events even if tracing is not enabled so that when
+    // tracing is enabled we will be able to associate that metadata with that trace.
+    // Metadata events should be used sparingly - as of 12/30/16 the Chrome Tracing
+    // spec only supports thread+process metadata, so we should only expect to see metadata
+    // events created when a new thread or process is created.
     if (!_enabled && type != Metadata) {
         return;
     }
 
-    traceEvent(category, name, type, now(), id, args, extra);
+    TraceThreadEvents* events = getEventsFor(type);
+    TraceRecord record;
+    QByteArray payload;
+    startRecord(events, record, payload, category, name, type, timestamp, id);
+    addArgs(events, record, payload, args, extra);
+    addRecord(events, record, payload);
 }
 
-void Tracer::traceEvent(const QLoggingCategory& category, 
-    const QString& name, EventType type, int64_t timestamp, const QString& id, 
-    const QVariantMap& args, const QVariantMap& extra) {
+void Tracer::traceEvent(const QLoggingCategory& category, const QString& name, EventType type, int64_t timestamp,
+    const QString& argName, double argValue) {
     if (!_enabled && type != Metadata) {
         return;
     }
 
-    auto processID = QCoreApplication::applicationPid();
-    auto threadID = int64_t(QThread::currentThreadId());
-    traceEvent(category, name, type, timestamp, processID, threadID, id, args, extra);
+    TraceThreadEvents* events = getEventsFor(type);
+    TraceRecord record;
+    QByteArray payload;
+    startRecord(events, record, payload, category, name, type, timestamp, QString());
+    if (internCached(events, argName, record.argNameIndices[0])) {
+        record.numArgs = 1;
+        record.argValues[0] = argValue;
+    } else {
+        record.flags |= TraceRecord::JSON_ARGS;
+        appendPayload(payload, toJson({ { argName, argValue } }));
+    }
+    addRecord(events, record, payload);
 }
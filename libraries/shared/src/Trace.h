@@ -10,8 +10,11 @@
 #ifndef hifi_Trace_h
 #define hifi_Trace_h
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QString>
 #include <QtCore/QVariantMap>
@@ -62,22 +65,61 @@ enum EventType : char {
     ContextLeave = ')'
 };
 
-struct TraceEvent {
-    QString id;
-    QString name;
-    EventType type;
-    qint64 timestamp;
-    qint64 processID;
-    qint64 threadID;
-    const QLoggingCategory& category;
-    QVariantMap args;
-    QVariantMap extra;
-
-    void writeJson(QTextStream& out) const;
+// An event as it is kept in the ring buffers.  Its name and category are interned, as are the names of up to
+// MAX_INLINE_ARGS numeric arguments kept inline.  The strings that aren't interned, such as string ids and JSON
+// arguments, are in its payload, which the thread writes to a ring buffer of its own.
+struct TraceRecord {
+    enum Flags : uint8_t {
+        HAS_ID = 1,
+        STRING_ID = 2, // the id is a string in the payload, rather than a number
+        NAME_PAYLOAD = 4, // the name is in the payload, the strings table being full
+        JSON_ARGS = 8, // the arguments are JSON in the payload, rather than the numArgs inline ones
+        JSON_EXTRA = 16 // the extra fields of the event are JSON in the payload
+    };
+    static const int MAX_INLINE_ARGS = 2;
+
+    int64_t timestamp { 0 };
+    uint64_t id { 0 };
+    uint64_t payloadOffset { 0 }; // the position of the payload in the payloads written by the thread
+    double argValues[MAX_INLINE_ARGS] { };
+    uint32_t argNameIndices[MAX_INLINE_ARGS] { };
+    uint32_t nameIndex { 0 };
+    uint32_t categoryIndex { 0 };
+    uint32_t payloadSize { 0 };
+    char type { 0 };
+    uint8_t flags { 0 };
+    uint8_t numArgs { 0 };
 };
 
+// A record with its payload, as copied out of the ring buffers
+struct TraceRecordCopy {
+    TraceRecord record;
+    QByteArray payload;
+};
+
+class TraceThreadEvents;
+class ThreadEventsOwner;
+class EnabledTracer;
+
+// Records the events of each thread in a ring buffer of its own, so that tracing doesn't take a lock on the threads it
+// measures.  Names and categories are interned, each thread keeping a cache of the ones it used, up to
+// MAX_INTERNED_STRINGS strings.  The ring buffers keep the last EVENTS_PER_THREAD events of each thread and the last
+// PAYLOAD_BYTES_PER_THREAD bytes of their payloads, older ones are overwritten.  When a thread exits, its ring buffers
+// are freed and the events of the trace they held are kept until the next one starts.
 class Tracer : public Dependency {
+    friend class ThreadEventsOwner;
+    friend class EnabledTracer;
+    friend bool enabled();
 public:
+    static const size_t EVENTS_PER_THREAD;
+    static const size_t PAYLOAD_BYTES_PER_THREAD;
+    static const size_t MAX_INTERNED_STRINGS;
+    // the extension of the compact binary dumps written by serialize, that convertToJson turns into Chrome trace JSON
+    static const QString BINARY_TRACE_EXTENSION;
+
+    Tracer();
+    ~Tracer();
+
     static int64_t now();
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
@@ -90,26 +132,89 @@ public:
         const QString& id = "", 
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
+    // an event with a single numeric argument, which doesn't build an argument map
+    void traceEvent(const QLoggingCategory& category, const QString& name, EventType type, int64_t timestamp,
+        const QString& argName, double argValue);
+
     void startTracing();
     void stopTracing();
+
+    // writes a binary dump when the file ends with BINARY_TRACE_EXTENSION, and Chrome trace JSON otherwise
     void serialize(const QString& file);
     bool isEnabled() const { return _enabled; }
 
+    static bool convertToJson(const QString& binaryFile, const QString& jsonFile);
+
 private:
-    void traceEvent(const QLoggingCategory& category, 
-        const QString& name, EventType type,
-        qint64 timestamp, qint64 processID, qint64 threadID,
-        const QString& id = "",
-        const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
+    TraceThreadEvents* getEventsFor(EventType type);
+    void startRecord(TraceThreadEvents* events, TraceRecord& record, QByteArray& payload,
+        const QLoggingCategory& category, const QString& name, EventType type, int64_t timestamp, const QString& id);
+    void addArgs(TraceThreadEvents* events, TraceRecord& record, QByteArray& payload,
+        const QVariantMap& args, const QVariantMap& extra);
+    void addRecord(TraceThreadEvents* events, TraceRecord& record, const QByteArray& payload);
+    bool intern(const QString& string, uint32_t& index, bool isBounded = true);
+    bool internCached(TraceThreadEvents* events, const QString& string, uint32_t& index);
+    TraceThreadEvents& getThreadEvents();
+    static void releaseThreadEvents(std::shared_ptr<TraceThreadEvents>& events);
+    void keepExitedThreadEvents(const TraceThreadEvents& events);
+    QByteArray toBinary();
+    static bool binaryToJson(const QByteArray& binary, QByteArray& json);
+
+    static std::atomic<Tracer*> _enabledTracer;
+
+    const uint64_t _generation;
+    std::atomic<bool> _enabled { false };
+    std::atomic<int64_t> _startTime { 0 };
+    std::atomic<int64_t> _stopTime { 0 };
+
+    std::mutex _stringsMutex;
+    QHash<QString, uint32_t> _stringIndices;
+    std::vector<QString> _strings;
+    // read without the lock, so that the threads don't take it for every string that isn't interned once it is full
+    std::atomic<bool> _isStringsTableFull { false };
+
+    // guards the threads, the events of those that exited, and the metadata events, which are kept whether tracing is
+    // enabled or not
+    std::mutex _threadsMutex;
+    std::vector<std::shared_ptr<TraceThreadEvents>> _threads;
+    std::vector<std::pair<int64_t, std::vector<TraceRecordCopy>>> _exitedThreads;
+    std::vector<std::pair<int64_t, TraceRecordCopy>> _metadataEvents;
+};
 
-    bool _enabled { false };
-    std::list<TraceEvent> _events;
-    std::list<TraceEvent> _metadataEvents;
-    std::mutex _eventsMutex;
+// The tracer that is enabled, if any, without going through the DependencyManager.  It is held until this goes out of
+// scope, the tracer's destructor waiting for the threads that hold it, so this is meant for recording an event or two.
+class EnabledTracer {
+public:
+    EnabledTracer() {
+        if (Tracer::_enabledTracer.load(std::memory_order_relaxed)) {
+            acquire();
+        }
+    }
+    ~EnabledTracer() {
+        if (_tracer) {
+            release();
+        }
+    }
+    EnabledTracer(const EnabledTracer&) = delete;
+    EnabledTracer& operator=(const EnabledTracer&) = delete;
+
+    explicit operator bool() const { return _tracer != nullptr; }
+    Tracer* operator->() const { return _tracer; }
+
+private:
+    void acquire();
+    void release();
+
+    Tracer* _tracer { nullptr };
 };
 
 inline void traceEvent(const QLoggingCategory& category, int64_t timestamp, const QString& name, EventType type, const QString& id = "", const QVariantMap& args = {}, const QVariantMap& extra = {}) {
-    if (!DependencyManager::isSet<Tracer>()) {
+    EnabledTracer enabledTracer;
+    if (enabledTracer) {
+        enabledTracer->traceEvent(category, name, type, timestamp, id, args, extra);
+        return;
+    }
+    if (type != Metadata || !DependencyManager::isSet<Tracer>()) {
         return;
     }
     const auto& tracer = DependencyManager::get<Tracer>();
@@ -119,7 +224,12 @@ inline void traceEvent(const QLoggingCategory& category, int64_t timestamp, cons
 }
 
 inline void traceEvent(const QLoggingCategory& category, const QString& name, EventType type, const QString& id = "", const QVariantMap& args = {}, const QVariantMap& extra = {}) {
-    if (!DependencyManager::isSet<Tracer>()) {
+    EnabledTracer enabledTracer;
+    if (enabledTracer) {
+        enabledTracer->traceEvent(category, name, type, id, args, extra);
+        return;
+    }
+    if (type != Metadata || !DependencyManager::isSet<Tracer>()) {
         return;
     }
     const auto& tracer = DependencyManager::get<Tracer>();
@@ -0,0 +1,264 @@
+//
+//  WorkStealingPool.cpp
+//  libraries/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "ThreadHelpers.h"
+
+using namespace std::chrono;
+
+// enough chunks for stealing to even out uneven items, few enough to keep neighbouring items together
+static const size_t CHUNKS_PER_WORKER = 8;
+
+// frames tend to follow each other closely, so idle workers spin this long before going to sleep
+static const microseconds SPIN_DURATION { 50 };
+
+static uint64_t packChunks(uint32_t head, uint32_t tail) {
+    return (uint64_t)head | ((uint64_t)tail << 32);
+}
+
+static uint32_t chunksHead(uint64_t chunks) {
+    return (uint32_t)chunks;
+}
+
+static uint32_t chunksTail(uint64_t chunks) {
+    return (uint32_t)(chunks >> 32);
+}
+
+WorkStealingPool::WorkStealingPool(const std::string& name, int numWorkers) :
+    _name(name),
+    _statsStart(Clock::now())
+{
+    resize(numWorkers);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    resize(0);
+}
+
+void WorkStealingPool::setNumWorkers(int numWorkers) {
+    resize(std::max(numWorkers, 1));
+}
+
+void WorkStealingPool::resize(int numWorkers) {
+    assert(!_job);
+
+    // stop the threads of the extra workers
+    for (int i = numWorkers; i < (int)_workers.size(); ++i) {
+        auto& worker = *_workers[i];
+        {
+            Lock lock(worker.mutex);
+            worker.stop = true;
+        }
+        worker.condition.notify_one();
+
+        if (worker.thread.joinable()) {
+            worker.thread.join();
+        }
+    }
+    if (numWorkers < (int)_workers.size()) {
+        _workers.resize(numWorkers);
+    }
+
+    // the first worker is the thread calling run(), the others get their own
+    while ((int)_workers.size() < numWorkers) {
+        int index = (int)_workers.size();
+        _workers.emplace_back(new Worker());
+
+        if (index > 0) {
+            Worker* worker = _workers.back().get();
+            worker->thread = std::thread([this, worker, index] {
+                setThreadName(_name + " " + std::to_string(index));
+                runWorker(*worker, index);
+            });
+        }
+    }
+}
+
+void WorkStealingPool::run(const Job& job) {
+    assert(job.run);
+    if (job.numItems == 0 || _workers.empty()) {
+        return;
+    }
+
+    size_t numWorkers = _workers.size();
+    _chunkSize = job.chunkSize > 0 ? job.chunkSize
+                                   : std::max((size_t)1, (job.numItems + numWorkers * CHUNKS_PER_WORKER - 1) /
+                                                         (numWorkers * CHUNKS_PER_WORKER));
+    size_t numChunks = (job.numItems + _chunkSize - 1) / _chunkSize;
+    assert(numChunks <= UINT32_MAX);
+
+    // hand out contiguous shares of the chunks, to as many workers as there are chunks
+    _numActive = (int)std::min(numWorkers, numChunks);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        uint64_t chunks = 0;
+        if ((int)i < _numActive) {
+            chunks = packChunks((uint32_t)(i * numChunks / _numActive), (uint32_t)((i + 1) * numChunks / _numActive));
+        }
+        _workers[i]->chunks.store(chunks, std::memory_order_relaxed);
+    }
+
+    _job = &job;
+    _numBusy.store(_numActive);
+    _frameStart = Clock::now();
+    ++_frame;
+
+    for (int i = 1; i < _numActive; ++i) {
+        auto& worker = *_workers[i];
+        worker.frame.store(_frame);
+        if (worker.isSleeping.load()) {
+            Lock lock(worker.mutex);
+            worker.condition.notify_one();
+        }
+    }
+
+    // work alongside the others, stealing from any that are slow to wake up
+    runFrame(0);
+
+    auto spinEnd = Clock::now() + SPIN_DURATION;
+    while (_numBusy.load() > 0 && Clock::now() < spinEnd) {
+        std::this_thread::yield();
+    }
+    if (_numBusy.load() > 0) {
+        Lock lock(_doneMutex);
+        _isWaiting.store(true);
+        _doneCondition.wait(lock, [&] {
+            return _numBusy.load() == 0;
+        });
+        _isWaiting.store(false);
+    }
+
+    _job = nullptr;
+}
+
+void WorkStealingPool::runWorker(Worker& worker, int index) {
+    uint64_t lastFrame = 0;
+
+    while (true) {
+        auto spinEnd = Clock::now() + SPIN_DURATION;
+        while (worker.frame.load() == lastFrame && Clock::now() < spinEnd) {
+            std::this_thread::yield();
+        }
+
+        {
+            Lock lock(worker.mutex);
+            worker.isSleeping.store(true);
+            worker.condition.wait(lock, [&] {
+                return worker.stop || worker.frame.load() != lastFrame;
+            });
+            worker.isSleeping.store(false);
+
+            if (worker.stop) {
+                return;
+            }
+        }
+
+        lastFrame = worker.frame.load();
+        runFrame(index);
+    }
+}
+
+void WorkStealingPool::runFrame(int index) {
+    auto& worker = *_workers[index];
+    const Job& job = *_job;
+
+    auto start = Clock::now();
+    worker.stats.wakeUpUsecs += duration_cast<microseconds>(start - _frameStart).count();
+
+    bool hasBegun = false;
+    uint32_t chunk;
+    while (popChunk(worker, chunk) || stealChunk(index, chunk)) {
+        if (!hasBegun) {
+            hasBegun = true;
+            if (job.begin) {
+                job.begin(index);
+            }
+        }
+
+        size_t first = chunk * _chunkSize;
+        job.run(index, first, std::min(first + _chunkSize, job.numItems));
+        ++worker.stats.numChunks;
+    }
+
+    if (hasBegun && job.end) {
+        job.end(index);
+    }
+
+    worker.stats.busyUsecs += duration_cast<microseconds>(Clock::now() - start).count();
+    ++worker.stats.numFrames;
+
+    if (_numBusy.fetch_sub(1) == 1 && _isWaiting.load()) {
+        Lock lock(_doneMutex);
+        _doneCondition.notify_one();
+    }
+}
+
+bool WorkStealingPool::popChunk(Worker& worker, uint32_t& chunk) {
+    uint64_t chunks = worker.chunks.load(std::memory_order_relaxed);
+    while (chunksHead(chunks) < chunksTail(chunks)) {
+        if (worker.chunks.compare_exchange_weak(chunks, packChunks(chunksHead(chunks) + 1, chunksTail(chunks)))) {
+            chunk = chunksHead(chunks);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkStealingPool::stealChunk(int thief, uint32_t& chunk) {
+    for (int i = 1; i < _numActive; ++i) {
+        auto& victim = *_workers[(thief + i) % _numActive];
+
+        uint64_t chunks = victim.chunks.load(std::memory_order_relaxed);
+        while (chunksHead(chunks) < chunksTail(chunks)) {
+            // take the back half, the victim keeps going from the front
+            uint32_t head = chunksHead(chunks);
+            uint32_t tail = chunksTail(chunks);
+            uint32_t stolenHead = tail - (tail - head + 1) / 2;
+
+            if (victim.chunks.compare_exchange_weak(chunks, packChunks(head, stolenHead))) {
+                // our own chunks ran out, so no one else is taking from them
+                auto& worker = *_workers[thief];
+                worker.chunks.store(packChunks(stolenHead + 1, tail));
+                ++worker.stats.numSteals;
+
+                chunk = stolenHead;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::resetStats() {
+    for (auto& worker : _workers) {
+        worker->stats = WorkerStats();
+    }
+    _statsStart = Clock::now();
+}
+
+QJsonObject WorkStealingPool::getStatsObject() const {
+    double elapsedUsecs = (double)duration_cast<microseconds>(Clock::now() - _statsStart).count();
+
+    QJsonObject statsObject;
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        const auto& stats = _workers[i]->stats;
+
+        QJsonObject workerObject;
+        workerObject["1_utilization_%"] = elapsedUsecs > 0.0 ? 100.0 * stats.busyUsecs / elapsedUsecs : 0.0;
+        workerObject["2_avg_wake_up_us"] = stats.numFrames > 0 ? (double)stats.wakeUpUsecs / stats.numFrames : 0.0;
+        workerObject["3_chunks"] = (qint64)stats.numChunks;
+        workerObject["4_steals"] = (qint64)stats.numSteals;
+        statsObject[QString("worker_%1").arg(i)] = workerObject;
+    }
+    return statsObject;
+}
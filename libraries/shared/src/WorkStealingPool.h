@@ -0,0 +1,116 @@
+//
+//  WorkStealingPool.h
+//  libraries/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_WorkStealingPool_h
+#define hifi_WorkStealingPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+
+#include "PortableHighResolutionClock.h"
+
+// Runs frames of indexed work over a fixed set of workers.
+//
+// The items of a frame are cut into chunks and each worker starts with a contiguous share of them. Workers that run out
+// steal half of what remains of another worker's share, so uneven items still balance while neighbouring items mostly
+// stay on the same worker. Worker 0 is the thread calling run(), the others are owned by the pool, and only as many
+// workers as there are chunks are woken up for a frame.
+//
+// WorkStealingPool is not thread-safe! run() and the configuration methods must be called from a single thread.
+class WorkStealingPool {
+public:
+    struct Job {
+        size_t numItems { 0 };
+        size_t chunkSize { 0 }; // 0 picks a size giving each worker a few chunks
+
+        // called on a worker before its first chunk and after its last one, only if it processed any
+        std::function<void(int worker)> begin;
+        std::function<void(int worker, size_t begin, size_t end)> run;
+        std::function<void(int worker)> end;
+    };
+
+    struct WorkerStats {
+        uint64_t busyUsecs { 0 };
+        uint64_t wakeUpUsecs { 0 }; // from run() being called to the worker picking up the frame
+        uint32_t numFrames { 0 };
+        uint32_t numChunks { 0 };
+        uint32_t numSteals { 0 };
+    };
+
+    WorkStealingPool(const std::string& name, int numWorkers = 1);
+    ~WorkStealingPool();
+
+    void setNumWorkers(int numWorkers);
+    int getNumWorkers() const { return (int)_workers.size(); }
+
+    // blocks until every item of the job has been processed
+    void run(const Job& job);
+
+    const WorkerStats& getWorkerStats(int worker) const { return _workers[worker]->stats; }
+    void resetStats();
+
+    // per worker utilization, wake-up latency and steal counts since the last reset
+    QJsonObject getStatsObject() const;
+
+private:
+    using Clock = p_high_resolution_clock;
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+
+    struct Worker {
+        // the worker's remaining chunks, as [head, tail) packed in the low and high 32 bits
+        std::atomic<uint64_t> chunks { 0 };
+
+        std::atomic<uint64_t> frame { 0 };
+        std::atomic<bool> isSleeping { false };
+        bool stop { false }; // guarded by mutex
+        Mutex mutex;
+        std::condition_variable condition;
+        std::thread thread;
+
+        WorkerStats stats;
+    };
+
+    void resize(int numWorkers);
+    void runWorker(Worker& worker, int index);
+    void runFrame(int index);
+    bool popChunk(Worker& worker, uint32_t& chunk);
+    bool stealChunk(int thief, uint32_t& chunk);
+
+    std::string _name;
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    // frame state
+    const Job* _job { nullptr };
+    size_t _chunkSize { 1 };
+    uint64_t _frame { 0 };
+    int _numActive { 0 };
+    Clock::time_point _frameStart;
+
+    std::atomic<int> _numBusy { 0 };
+    std::atomic<bool> _isWaiting { false };
+    Mutex _doneMutex;
+    std::condition_variable _doneCondition;
+
+    Clock::time_point _statsStart;
+};
+
+#endif // hifi_WorkStealingPool_h
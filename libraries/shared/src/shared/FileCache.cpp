@@ -101,7 +101,7 @@ void FileCache::initialize() {
         auto sort = QDir::SortFlags(QDir::Time);
         auto files = dir.entryList(nameFilters, filters, sort);
 
-        // load persisted files
+        // load persisted files, only evicting the ones over budget once all of them are known
         foreach(QString filename, files) {
             const Key key = filename.section('.', 0, 0).toStdString();
             const std::string filepath = dir.filePath(filename).toStdString();
@@ -116,6 +116,7 @@ void FileCache::initialize() {
     }
 
     _initialized = true;
+    clean();
 }
 
 std::unique_ptr<File> FileCache::createFile(Metadata&& metadata, const std::string& filepath) {
@@ -230,7 +231,9 @@ void FileCache::addUnusedFile(const FilePointer& file) {
     _unusedFiles.insert(file);
     _numUnusedFiles += 1;
     _unusedFilesSize += file->getLength();
-    clean();
+    if (_initialized) {
+        clean();
+    }
 
     emit dirty();
 }
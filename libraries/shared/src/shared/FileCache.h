@@ -10,6 +10,7 @@
 #ifndef hifi_FileCache_h
 #define hifi_FileCache_h
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <cstddef>
@@ -102,6 +103,9 @@ public:
     /// create a file
     virtual std::unique_ptr<File> createFile(Metadata&& metadata, const std::string& filepath);
 
+protected:
+    const std::string& getDirpath() const { return _dirpath; }
+
 private:
     using Mutex = std::recursive_mutex;
     using Lock = std::unique_lock<Mutex>;
@@ -159,6 +163,9 @@ protected:
     /// when constructed, the file has already been created/written
     File(Metadata&& metadata, const std::string& filepath);
 
+    /// for caches that keep track of use on their own, a file is only evicted after those used later
+    void setLastUsed(int64_t lastUsed) { _modified = std::max(lastUsed, _modified); }
+
 private:
     friend class FileCache;
     friend struct FilePointerComparator;
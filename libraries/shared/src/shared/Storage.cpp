@@ -69,8 +69,8 @@ StoragePointer FileStorage::create(const QString& filename, size_t size, const u
     return std::make_shared<FileStorage>(filename);
 }
 
-FileStorage::FileStorage(const QString& filename) : _file(filename) {
-    bool opened = _file.open(QFile::ReadWrite | QFile::Unbuffered);
+FileStorage::FileStorage(const QString& filename, bool readOnly) : _file(filename) {
+    bool opened = !readOnly && _file.open(QFile::ReadWrite | QFile::Unbuffered);
     if (opened) {
         _hasWriteAccess = true;
     } else {
@@ -61,7 +61,8 @@ namespace storage {
     class FileStorage : public Storage {
     public:
         static StoragePointer create(const QString& filename, size_t size, const uint8_t* data);
-        FileStorage(const QString& filename);
+        // read only storages never map the file for writing, even when it could be opened for it
+        FileStorage(const QString& filename, bool readOnly = false);
         ~FileStorage();
         // Prevent copying
         FileStorage(const FileStorage& other) = delete;
@@ -0,0 +1,78 @@
+//
+//  Space_avx2.cpp
+//  libraries/workload/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stdint.h>
+#include <immintrin.h>
+
+//
+// Classifies 8 proxies at a time against every region sphere of every view.
+// Same result as classifyRegions_ref, the tail is done one proxy at a time.
+//
+void classifyRegions_AVX2(const float* centersX, const float* centersY, const float* centersZ, const float* radii,
+                          uint8_t* regions, int numProxies, const float* regionSpheres, int numViews, int numRegions) {
+
+    int i = 0;
+    for (; i + 8 <= numProxies; i += 8) {
+        __m256 x = _mm256_loadu_ps(centersX + i);
+        __m256 y = _mm256_loadu_ps(centersY + i);
+        __m256 z = _mm256_loadu_ps(centersZ + i);
+        __m256 r = _mm256_loadu_ps(radii + i);
+
+        __m256i region = _mm256_set1_epi32(numRegions);
+
+        // walk the regions outwards in, so the innermost overlapped one is written last
+        for (int k = numRegions - 1; k >= 0; --k) {
+            __m256 overlaps = _mm256_setzero_ps();
+
+            for (int j = 0; j < numViews; ++j) {
+                const float* sphere = regionSpheres + 4 * (k * numViews + j);
+
+                __m256 dx = _mm256_sub_ps(x, _mm256_broadcast_ss(sphere + 0));
+                __m256 dy = _mm256_sub_ps(y, _mm256_broadcast_ss(sphere + 1));
+                __m256 dz = _mm256_sub_ps(z, _mm256_broadcast_ss(sphere + 2));
+                __m256 touchDistance = _mm256_add_ps(r, _mm256_broadcast_ss(sphere + 3));
+
+                __m256 distance2 = _mm256_mul_ps(dx, dx);
+                distance2 = _mm256_fmadd_ps(dy, dy, distance2);
+                distance2 = _mm256_fmadd_ps(dz, dz, distance2);
+
+                overlaps = _mm256_or_ps(overlaps, _mm256_cmp_ps(distance2, _mm256_mul_ps(touchDistance, touchDistance), _CMP_LT_OQ));
+            }
+
+            region = _mm256_blendv_epi8(region, _mm256_set1_epi32(k), _mm256_castps_si256(overlaps));
+        }
+
+        // narrow the 8 x int32 regions down to 8 bytes
+        __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(region), _mm256_extracti128_si256(region, 1));
+        packed = _mm_packus_epi16(packed, packed);
+        _mm_storel_epi64((__m128i*)(regions + i), packed);
+    }
+
+    for (; i < numProxies; ++i) {
+        uint8_t region = (uint8_t)numRegions;
+        for (int k = numRegions - 1; k >= 0; --k) {
+            for (int j = 0; j < numViews; ++j) {
+                const float* sphere = regionSpheres + 4 * (k * numViews + j);
+                float dx = centersX[i] - sphere[0];
+                float dy = centersY[i] - sphere[1];
+                float dz = centersZ[i] - sphere[2];
+                float touchDistance = radii[i] + sphere[3];
+                if (dx * dx + dy * dy + dz * dz < touchDistance * touchDistance) {
+                    region = (uint8_t)k;
+                }
+            }
+        }
+        regions[i] = region;
+    }
+}
+
+#endif
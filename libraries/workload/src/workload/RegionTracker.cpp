@@ -13,11 +13,14 @@
 //
 #include "RegionTracker.h"
 
+#include <algorithm>
+
 #include "Region.h"
 
 using namespace workload;
 
 void RegionTracker::configure(const Config& config) {
+    _numClassificationThreads = config.numClassificationThreads;
 }
 
 void RegionTracker::run(const WorkloadContextPointer& context, Outputs& outputs) {
@@ -30,6 +33,10 @@ void RegionTracker::run(const WorkloadContextPointer& context, Outputs& outputs)
 
     auto space = context->_space;
     if (space) {
+        if (space->getNumClassificationThreads() != std::max(_numClassificationThreads, 1)) {
+            space->setNumClassificationThreads(_numClassificationThreads);
+        }
+
         //Changes changes;
         space->categorizeAndGetChanges(outChanges);
 
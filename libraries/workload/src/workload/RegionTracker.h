@@ -22,8 +22,14 @@ namespace workload {
 
     class RegionTrackerConfig : public Job::Config {
         Q_OBJECT
+        Q_PROPERTY(int numClassificationThreads MEMBER numClassificationThreads NOTIFY dirty)
     public:
         RegionTrackerConfig() : Job::Config(true) {}
+
+        int numClassificationThreads { 1 };
+
+    signals:
+        void dirty();
     };
 
     class RegionTracker {
@@ -38,6 +44,7 @@ namespace workload {
         void run(const workload::WorkloadContextPointer& renderContext, Outputs& outputs);
 
     protected:
+        int _numClassificationThreads { 1 };
     };
 } // namespace workload
 
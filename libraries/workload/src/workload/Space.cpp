@@ -18,19 +18,111 @@
 
 #include <glm/gtx/quaternion.hpp>
 
+#include <WorkStealingPool.h>
+
 using namespace workload;
 
+// Classifies proxies [0, numProxies) against the region spheres, which are laid out region major:
+// sphere j of region k is at regionSpheres[4 * (k * numViews + j)]. A proxy gets the first region any view overlaps.
+static void classifyRegions_ref(const float* centersX, const float* centersY, const float* centersZ, const float* radii,
+                                uint8_t* regions, int numProxies, const float* regionSpheres, int numViews, int numRegions) {
+    for (int i = 0; i < numProxies; ++i) {
+        regions[i] = (uint8_t)numRegions;
+    }
+    // walk the regions outwards in, so the innermost overlapped one is written last
+    for (int k = numRegions - 1; k >= 0; --k) {
+        for (int j = 0; j < numViews; ++j) {
+            const float* sphere = regionSpheres + 4 * (k * numViews + j);
+            float x = sphere[0];
+            float y = sphere[1];
+            float z = sphere[2];
+            float r = sphere[3];
+            // no early out, so that compilers can vectorize the loop
+            for (int i = 0; i < numProxies; ++i) {
+                float dx = centersX[i] - x;
+                float dy = centersY[i] - y;
+                float dz = centersZ[i] - z;
+                float touchDistance = radii[i] + r;
+                bool overlaps = dx * dx + dy * dy + dz * dz < touchDistance * touchDistance;
+                regions[i] = overlaps ? (uint8_t)k : regions[i];
+            }
+        }
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+//
+// Runtime CPU dispatch
+//
+
+#include <CPUDetect.h>
+
+void classifyRegions_AVX2(const float* centersX, const float* centersY, const float* centersZ, const float* radii,
+                          uint8_t* regions, int numProxies, const float* regionSpheres, int numViews, int numRegions);
+
+static void classifyRegions(const float* centersX, const float* centersY, const float* centersZ, const float* radii,
+                            uint8_t* regions, int numProxies, const float* regionSpheres, int numViews, int numRegions) {
+    static auto f = cpuSupportsAVX2() ? classifyRegions_AVX2 : classifyRegions_ref;
+    (*f)(centersX, centersY, centersZ, radii, regions, numProxies, regionSpheres, numViews, numRegions);  // dispatch
+}
+
+#else
+
+static auto& classifyRegions = classifyRegions_ref;
+
+#endif
+
+// large enough to amortize handing a chunk to another thread, small enough to balance a few hundred thousand proxies
+static const size_t CLASSIFICATION_CHUNK_SIZE = 4096;
+
 Space::Space() : Collection() {
 }
 
+Space::~Space() {
+}
+
+void Space::setNumClassificationThreads(int numThreads) {
+    std::unique_lock<std::mutex> lock(_proxiesMutex);
+    if (numThreads <= 1) {
+        _classificationPool.reset();
+    } else if (_classificationPool) {
+        _classificationPool->setNumWorkers(numThreads);
+    } else {
+        _classificationPool.reset(new WorkStealingPool("Workload Classifier", numThreads));
+    }
+}
+
+int Space::getNumClassificationThreads() const {
+    std::unique_lock<std::mutex> lock(_proxiesMutex);
+    return _classificationPool ? _classificationPool->getNumWorkers() : 1;
+}
+
+void Space::resizeProxies(size_t numProxies) {
+    _proxies.resize(numProxies);
+    _owners.resize(numProxies);
+    _centersX.resize(numProxies, 0.0f);
+    _centersY.resize(numProxies, 0.0f);
+    _centersZ.resize(numProxies, 0.0f);
+    _radii.resize(numProxies, 0.0f);
+    _newRegions.resize(numProxies);
+}
+
+void Space::setProxySphere(ProxyID id, const Sphere& sphere) {
+    _proxies[id].sphere = sphere;
+    _centersX[id] = sphere.x;
+    _centersY[id] = sphere.y;
+    _centersZ[id] = sphere.z;
+    _radii[id] = sphere.w;
+}
+
 void Space::processTransactionFrame(const Transaction& transaction) {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
     // Here we should be able to check the value of last ProxyID allocated
     // and allocate new proxies accordingly
     ProxyID maxID = _IDAllocator.getNumAllocatedIndices();
     if (maxID > (Index) _proxies.size()) {
-        _proxies.resize(maxID + 100); // allocate the maxId and more
-        _owners.resize(maxID + 100);
+        resizeProxies(maxID + 100); // allocate the maxId and more
     }
     // Now we know for sure that we have enough items in the array to
     // capture anything coming from the transaction
@@ -52,7 +144,7 @@ void Space::processResets(const Transaction::Resets& transactions) {
         auto& item = _proxies[proxyID];
 
         // Reset the item with a new payload
-        item.sphere = (std::get<1>(reset));
+        setProxySphere(proxyID, std::get<1>(reset));
         item.prevRegion = item.region = Region::UNKNOWN;
 
         _owners[proxyID] = (std::get<2>(reset));
@@ -82,37 +174,52 @@ void Space::processUpdates(const Transaction::Updates& transactions) {
             continue;
         }
 
-        // Access the true item
-        auto& item = _proxies[updateID];
-
         // Update the item
-        item.sphere = (std::get<1>(update));
+        setProxySphere(updateID, std::get<1>(update));
     }
 }
 
+void Space::classifyProxies(uint32_t begin, uint32_t end) {
+    ::classifyRegions(_centersX.data() + begin, _centersY.data() + begin, _centersZ.data() + begin, _radii.data() + begin,
+                      _newRegions.data() + begin, (int)(end - begin), _regionSpheres.data(), (int)_views.size(),
+                      Region::NUM_TRACKED_REGIONS);
+}
+
 void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
     uint32_t numProxies = (uint32_t)_proxies.size();
     uint32_t numViews = (uint32_t)_views.size();
+
+    _regionSpheres.resize(4 * Region::NUM_TRACKED_REGIONS * numViews);
+    for (uint32_t k = 0; k < Region::NUM_TRACKED_REGIONS; ++k) {
+        for (uint32_t j = 0; j < numViews; ++j) {
+            const Sphere& sphere = _views[j].regions[k];
+            float* regionSphere = _regionSpheres.data() + 4 * (k * numViews + j);
+            regionSphere[0] = sphere.x;
+            regionSphere[1] = sphere.y;
+            regionSphere[2] = sphere.z;
+            regionSphere[3] = sphere.w;
+        }
+    }
+
+    // every slot gets classified, including free ones, which is cheaper than skipping them in the kernel
+    if (_classificationPool && numProxies > CLASSIFICATION_CHUNK_SIZE) {
+        WorkStealingPool::Job job;
+        job.numItems = numProxies;
+        job.chunkSize = CLASSIFICATION_CHUNK_SIZE;
+        job.run = [this](int worker, size_t begin, size_t end) {
+            classifyProxies((uint32_t)begin, (uint32_t)end);
+        };
+        _classificationPool->run(job);
+    } else {
+        classifyProxies(0, numProxies);
+    }
+
     for (uint32_t i = 0; i < numProxies; ++i) {
         Proxy& proxy = _proxies[i];
         if (proxy.region < Region::INVALID) {
-            glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
-            float proxyRadius = proxy.sphere.w;
-            uint8_t region = Region::R4;
-            for (uint32_t j = 0; j < numViews; ++j) {
-                auto& view = _views[j];
-                // for each 'view' we need only increment 'k' below the current value of 'region'
-                for (uint8_t k = 0; k < region; ++k) {
-                    float touchDistance = proxyRadius + view.regions[k].w;
-                    if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
-                        region = k;
-                        break;
-                    }
-                }
-            }
             proxy.prevRegion = proxy.region;
-            proxy.region = region;
+            proxy.region = _newRegions[i];
             if (proxy.region != proxy.prevRegion) {
                 changes.emplace_back(Space::Change((int32_t)i, proxy.region, proxy.prevRegion));
             }
@@ -161,6 +268,11 @@ void Space::clear() {
     _IDAllocator.clear();
     _proxies.clear();
     _owners.clear();
+    _centersX.clear();
+    _centersY.clear();
+    _centersZ.clear();
+    _radii.clear();
+    _newRegions.clear();
     _views.clear();
 }
 
@@ -21,6 +21,8 @@
 
 #include "Transaction.h"
 
+class WorkStealingPool;
+
 namespace workload {
 
 class Space : public Collection {
@@ -36,6 +38,7 @@ public:
     };
 
     Space();
+    ~Space();
 
     void setViews(const Views& views);
 
@@ -46,6 +49,10 @@ public:
     uint32_t getNumAllocatedProxies() const { return (uint32_t)(_IDAllocator.getNumAllocatedIndices()); }
 
     void categorizeAndGetChanges(std::vector<Change>& changes);
+
+    // proxies are classified in chunks spread over this many threads, including the calling one
+    void setNumClassificationThreads(int numThreads);
+    int getNumClassificationThreads() const;
     uint32_t copyProxyValues(Proxy* proxies, uint32_t numDestProxies) const;
     uint32_t copySelectedProxyValues(Proxy::Vector& proxies, const workload::indexed_container::Indices& indices) const;
 
@@ -60,11 +67,25 @@ private:
     void processRemoves(const Transaction::Removes& transactions);
     void processUpdates(const Transaction::Updates& transactions);
 
+    void resizeProxies(size_t numProxies);
+    void setProxySphere(ProxyID id, const Sphere& sphere);
+    void classifyProxies(uint32_t begin, uint32_t end);
+
     // The database of proxies is protected for editing by a mutex
     mutable std::mutex _proxiesMutex;
     Proxy::Vector _proxies;
     std::vector<Owner> _owners;
 
+    // the proxy spheres again, as structure of arrays for the classification kernel
+    std::vector<float> _centersX;
+    std::vector<float> _centersY;
+    std::vector<float> _centersZ;
+    std::vector<float> _radii;
+    std::vector<uint8_t> _newRegions;
+    std::vector<float> _regionSpheres; // x, y, z, radius of every tracked region of every view, region major
+
+    std::unique_ptr<WorkStealingPool> _classificationPool;
+
     Views _views;
 };
 
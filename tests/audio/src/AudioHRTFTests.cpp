@@ -0,0 +1,62 @@
+//
+//  AudioHRTFTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioHRTFTests.h"
+
+#include <cmath>
+
+#include <AudioHRTF.h>
+
+QTEST_MAIN(AudioHRTFTests)
+
+static const int HRTF_SUBJECT = 0;
+
+static void makeTone(int16_t* samples) {
+    for (int i = 0; i < HRTF_BLOCK; ++i) {
+        samples[i] = (int16_t)(8192.0f * sinf(i * 0.1f));
+    }
+}
+
+static bool isSilent(const float* output) {
+    for (int i = 0; i < 2 * HRTF_BLOCK; ++i) {
+        if (output[i] != 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AudioHRTFTests::testGainAdjustment() {
+    int16_t input[HRTF_BLOCK];
+    makeTone(input);
+
+    AudioHRTF hrtf;
+    QVERIFY(!hrtf.hasGainAdjustment());
+
+    float output[2 * HRTF_BLOCK] = {};
+    hrtf.render(input, output, HRTF_SUBJECT, 0.5f, 20.0f, 1.0f, HRTF_BLOCK);
+    QVERIFY(!isSilent(output));
+
+    // setting the default gain back is not an adjustment
+    hrtf.setGainAdjustment(0.5f);
+    QVERIFY(hrtf.hasGainAdjustment());
+    hrtf.setGainAdjustment(1.0f);
+    QVERIFY(!hrtf.hasGainAdjustment());
+
+    // a muted source is heard as silence, from its first frame on a fresh HRTF
+    AudioHRTF mutedHRTF;
+    mutedHRTF.setGainAdjustment(0.0f);
+    QVERIFY(mutedHRTF.hasGainAdjustment());
+    for (int frame = 0; frame < 4; ++frame) {
+        float mutedOutput[2 * HRTF_BLOCK] = {};
+        mutedHRTF.render(input, mutedOutput, HRTF_SUBJECT, 0.5f, 20.0f, 1.0f, HRTF_BLOCK);
+        QVERIFY(isSilent(mutedOutput));
+    }
+}
@@ -0,0 +1,24 @@
+//
+//  AudioHRTFTests.h
+//  tests/audio/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioHRTFTests_h
+#define hifi_AudioHRTFTests_h
+
+#include <QtTest/QtTest>
+
+class AudioHRTFTests : public QObject {
+    Q_OBJECT
+private slots:
+    // the audio mixer keeps a source out of a listener's premix beds once the listener adjusted its gain, and the
+    // listener then hears it through its HRTF, which applies that gain
+    void testGainAdjustment();
+};
+
+#endif // hifi_AudioHRTFTests_h
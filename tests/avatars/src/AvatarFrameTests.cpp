@@ -0,0 +1,231 @@
+//
+//  AvatarFrameTests.cpp
+//  tests/avatars/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarFrameTests.h"
+
+#include <algorithm>
+
+#include <QtCore/QElapsedTimer>
+
+#include <AvatarData.h>
+#include <AvatarFrameCodec.h>
+
+QTEST_GUILESS_MAIN(AvatarFrameTests)
+
+static const QString AVATAR_FRAME_BENCHMARK_FRAMES_ENV = "HIFI_AVATAR_FRAME_BENCHMARK_FRAMES";
+
+static const int NUM_JOINTS = 80;
+// the joints of the spine and limbs move, the fingers and face mostly don't
+static const int NUM_MOVING_JOINTS = 30;
+static const float ROTATION_TOLERANCE = 0.001f;
+static const float TRANSLATION_TOLERANCE = 0.001f;
+
+static JointData makeJoint(int index, int frameNumber) {
+    JointData joint;
+    float angle = index < NUM_MOVING_JOINTS ? 0.05f * frameNumber + 0.1f * index : 0.1f * index;
+    joint.rotation = glm::angleAxis(angle, glm::normalize(glm::vec3(1.0f, 0.5f * index, 0.25f)));
+    joint.translation = glm::vec3(0.0f, 0.1f + 0.002f * index, 0.01f * (index % 3));
+    joint.rotationIsDefaultPose = false;
+    joint.translationIsDefaultPose = index % 4 == 0;
+    return joint;
+}
+
+static AvatarFrame makeFrame(int frameNumber) {
+    AvatarFrame frame;
+    frame.identity["skeletonModelURL"] = "http://example.com/avatar.fst";
+    frame.identity["displayName"] = "Recorded";
+    frame.hasBasis = true;
+    frame.basis.setTranslation(glm::vec3(10.0f, 0.0f, -5.0f));
+    frame.relative.setTranslation(glm::vec3(0.01f * frameNumber, 0.0f, 0.0f));
+    frame.relative.setRotation(glm::angleAxis(0.01f * frameNumber + 0.2f, glm::vec3(0.0f, 1.0f, 0.0f)));
+    frame.scale = 1.5f;
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        frame.joints.push_back(makeJoint(i, frameNumber));
+    }
+    frame.hasHead = true;
+    frame.hasHeadOrientation = true;
+    frame.headOrientation = glm::angleAxis(0.02f * frameNumber + 0.3f, glm::normalize(glm::vec3(0.2f, 1.0f, 0.1f)));
+    frame.hasLookAt = true;
+    frame.relativeLookAt = glm::vec3(0.0f, 0.0f, -2.0f);
+    frame.blendshapes.resize(20);
+    frame.blendshapes[3] = 0.5f;
+    frame.blendshapes[7] = 0.25f * (frameNumber % 4);
+    return frame;
+}
+
+static void compareFrames(const AvatarFrame& decoded, const AvatarFrame& expected) {
+    QCOMPARE(decoded.identity, expected.identity);
+    QCOMPARE(decoded.hasBasis, expected.hasBasis);
+    QVERIFY(glm::distance(decoded.basis.getTranslation(), expected.basis.getTranslation()) < TRANSLATION_TOLERANCE);
+    QVERIFY(glm::distance(decoded.relative.getTranslation(), expected.relative.getTranslation()) < TRANSLATION_TOLERANCE);
+    QVERIFY(1.0f - fabsf(glm::dot(decoded.relative.getRotation(), expected.relative.getRotation())) < ROTATION_TOLERANCE);
+    QCOMPARE(decoded.scale, expected.scale);
+    QCOMPARE(decoded.joints.size(), expected.joints.size());
+    for (int i = 0; i < expected.joints.size(); i++) {
+        const JointData& joint = decoded.joints[i];
+        const JointData& expectedJoint = expected.joints[i];
+        QVERIFY(1.0f - fabsf(glm::dot(joint.rotation, expectedJoint.rotation)) < ROTATION_TOLERANCE);
+        QVERIFY(glm::distance(joint.translation, expectedJoint.translation) < TRANSLATION_TOLERANCE);
+        QCOMPARE(joint.rotationIsDefaultPose, expectedJoint.rotationIsDefaultPose);
+        QCOMPARE(joint.translationIsDefaultPose, expectedJoint.translationIsDefaultPose);
+    }
+    QCOMPARE(decoded.hasHead, expected.hasHead);
+    QCOMPARE(decoded.hasHeadOrientation, expected.hasHeadOrientation);
+    if (expected.hasHeadOrientation) {
+        QVERIFY(1.0f - fabsf(glm::dot(decoded.headOrientation, expected.headOrientation)) < ROTATION_TOLERANCE);
+    }
+    QCOMPARE(decoded.hasLookAt, expected.hasLookAt);
+    QVERIFY(glm::distance(decoded.relativeLookAt, expected.relativeLookAt) < TRANSLATION_TOLERANCE);
+    for (int i = 0; i < expected.blendshapes.size(); i++) {
+        float coefficient = i < decoded.blendshapes.size() ? decoded.blendshapes[i] : 0.0f;
+        QVERIFY(fabsf(coefficient - expected.blendshapes[i]) < TRANSLATION_TOLERANCE);
+    }
+}
+
+void AvatarFrameTests::testRoundTrip() {
+    AvatarFrameEncoder encoder;
+    AvatarFrameDecoder decoder;
+    AvatarFrame frame = makeFrame(0);
+    QCOMPARE(decoder.decode(encoder.encode(frame)), AvatarFrameDecoder::Decoded);
+    QVERIFY(decoder.hasIdentity());
+    compareFrames(decoder.getFrame(), frame);
+
+    QCOMPARE(decoder.decode(QByteArray("\x7f", 1)), AvatarFrameDecoder::Invalid);
+    QCOMPARE(decoder.decode(encoder.encode(frame).left(20)), AvatarFrameDecoder::Invalid);
+}
+
+void AvatarFrameTests::testDeltaFrames() {
+    const int KEYFRAME_INTERVAL = 10;
+    AvatarFrameEncoder encoder(KEYFRAME_INTERVAL);
+    AvatarFrameDecoder decoder;
+    QByteArray keyframe;
+    for (int i = 0; i < 3 * KEYFRAME_INTERVAL; i++) {
+        AvatarFrame frame = makeFrame(i);
+        QByteArray data = encoder.encode(frame);
+        if (i == 0) {
+            keyframe = data;
+        } else if (i % KEYFRAME_INTERVAL != 0) {
+            // the still joints and the identity are left out
+            QVERIFY(data.size() < keyframe.size() / 2);
+        }
+        QCOMPARE(decoder.decode(data), AvatarFrameDecoder::Decoded);
+        QCOMPARE(decoder.hasIdentity(), i % KEYFRAME_INTERVAL == 0);
+        compareFrames(decoder.getFrame(), frame);
+    }
+
+    // a new skeleton needs a keyframe
+    AvatarFrame frame = makeFrame(3 * KEYFRAME_INTERVAL + 1);
+    frame.joints.resize(NUM_JOINTS / 2);
+    QCOMPARE(decoder.decode(encoder.encode(frame)), AvatarFrameDecoder::Decoded);
+    QVERIFY(decoder.hasIdentity());
+    compareFrames(decoder.getFrame(), frame);
+}
+
+void AvatarFrameTests::testSkipsUntilKeyframe() {
+    const int KEYFRAME_INTERVAL = 5;
+    AvatarFrameEncoder encoder(KEYFRAME_INTERVAL);
+    std::vector<QByteArray> frames;
+    for (int i = 0; i < 2 * KEYFRAME_INTERVAL; i++) {
+        frames.push_back(encoder.encode(makeFrame(i)));
+    }
+
+    AvatarFrameDecoder decoder;
+    QCOMPARE(decoder.decode(frames[0]), AvatarFrameDecoder::Decoded);
+    // a seek over frame 1
+    for (int i = 2; i < KEYFRAME_INTERVAL; i++) {
+        QCOMPARE(decoder.decode(frames[i]), AvatarFrameDecoder::Skipped);
+    }
+    QCOMPARE(decoder.decode(frames[KEYFRAME_INTERVAL]), AvatarFrameDecoder::Decoded);
+    compareFrames(decoder.getFrame(), makeFrame(KEYFRAME_INTERVAL));
+    QCOMPARE(decoder.decode(frames[KEYFRAME_INTERVAL + 1]), AvatarFrameDecoder::Decoded);
+    compareFrames(decoder.getFrame(), makeFrame(KEYFRAME_INTERVAL + 1));
+
+    decoder.reset();
+    QCOMPARE(decoder.decode(frames[KEYFRAME_INTERVAL + 2]), AvatarFrameDecoder::Skipped);
+}
+
+void AvatarFrameTests::testConvertLegacyFrame() {
+    AvatarFrame expected = makeFrame(3);
+    AvatarData recorded;
+    recorded.setRecordingBasis(std::make_shared<Transform>(expected.basis));
+    recorded.setRawJointData(expected.joints);
+    QByteArray legacyFrame = AvatarData::toFrame(recorded);
+
+    AvatarData avatar;
+    AvatarFrameEncoder encoder;
+    AvatarFrameDecoder decoder;
+    QCOMPARE(decoder.decode(encoder.convertLegacyFrame(legacyFrame, avatar)), AvatarFrameDecoder::Decoded);
+    const AvatarFrame& frame = decoder.getFrame();
+    QVERIFY(frame.hasBasis);
+    QVERIFY(glm::distance(frame.basis.getTranslation(), expected.basis.getTranslation()) < TRANSLATION_TOLERANCE);
+    QCOMPARE(frame.joints.size(), expected.joints.size());
+    for (int i = 0; i < expected.joints.size(); i++) {
+        QVERIFY(1.0f - fabsf(glm::dot(frame.joints[i].rotation, expected.joints[i].rotation)) < ROTATION_TOLERANCE);
+    }
+}
+
+void AvatarFrameTests::benchmarkFrames() {
+    int numFrames = 900;
+    auto environment = QProcessEnvironment::systemEnvironment();
+    if (environment.contains(AVATAR_FRAME_BENCHMARK_FRAMES_ENV)) {
+        numFrames = std::max(environment.value(AVATAR_FRAME_BENCHMARK_FRAMES_ENV).toInt(), 1);
+    }
+
+    std::vector<QByteArray> legacyFrames;
+    std::vector<QByteArray> binaryFrames;
+    size_t legacyBytes = 0;
+    size_t binaryBytes = 0;
+    {
+        AvatarData recorded;
+        AvatarFrameEncoder encoder;
+        recorded.setRecordingBasis(std::make_shared<Transform>());
+        for (int i = 0; i < numFrames; i++) {
+            AvatarFrame frame = makeFrame(i);
+            recorded.setRawJointData(frame.joints);
+            recorded.setWorldPosition(frame.relative.getTranslation());
+            legacyFrames.push_back(AvatarData::toFrame(recorded));
+            binaryFrames.push_back(encoder.encode(recorded));
+            legacyBytes += legacyFrames.back().size();
+            binaryBytes += binaryFrames.back().size();
+        }
+    }
+
+    qint64 legacyNsecs;
+    {
+        AvatarData playback;
+        QElapsedTimer timer;
+        timer.start();
+        for (const auto& frameData : legacyFrames) {
+            AvatarData::fromFrame(frameData, playback);
+        }
+        legacyNsecs = timer.nsecsElapsed();
+        QCOMPARE(playback.getRawJointData().size(), NUM_JOINTS);
+    }
+
+    qint64 binaryNsecs;
+    {
+        AvatarData playback;
+        AvatarFrameDecoder decoder;
+        QElapsedTimer timer;
+        timer.start();
+        for (const auto& frameData : binaryFrames) {
+            if (decoder.decode(frameData) == AvatarFrameDecoder::Decoded) {
+                playback.fromAvatarFrame(decoder.getFrame(), decoder.hasIdentity());
+            }
+        }
+        binaryNsecs = timer.nsecsElapsed();
+        QCOMPARE(playback.getRawJointData().size(), NUM_JOINTS);
+    }
+
+    qDebug() << "avatar frames:" << numFrames << "joints:" << NUM_JOINTS;
+    qDebug() << "legacy bytes/frame:" << legacyBytes / numFrames << "decode usecs/frame:" << (double)legacyNsecs / (1000.0 * numFrames);
+    qDebug() << "binary bytes/frame:" << binaryBytes / numFrames << "decode usecs/frame:" << (double)binaryNsecs / (1000.0 * numFrames);
+    QVERIFY(binaryBytes < legacyBytes);
+}
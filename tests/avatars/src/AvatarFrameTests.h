@@ -0,0 +1,31 @@
+//
+//  AvatarFrameTests.h
+//  tests/avatars/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarFrameTests_h
+#define hifi_AvatarFrameTests_h
+
+#include <QtTest/QtTest>
+
+class AvatarFrameTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRoundTrip();
+    void testDeltaFrames();
+    void testSkipsUntilKeyframe();
+    void testConvertLegacyFrame();
+
+    // Records an avatar moving for a while in the legacy JSON frames and in the binary frames, and reports the bytes
+    // per frame and the microseconds to decode a frame of each. The number of frames can be set with
+    // HIFI_AVATAR_FRAME_BENCHMARK_FRAMES.
+    void benchmarkFrames();
+};
+
+#endif // hifi_AvatarFrameTests_h
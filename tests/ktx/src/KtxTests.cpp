@@ -15,6 +15,10 @@
 #include <ktx/KTX.h>
 #include <gpu/Texture.h>
 #include <image/Image.h>
+#include <material-networking/KTXCache.h>
+#include <NumericalConstants.h>
+#include <SettingManager.h>
+#include <shared/FileCache.h>
 
 
 QTEST_GUILESS_MAIN(KtxTests)
@@ -31,9 +35,12 @@ QString getRootPath() {
 }
 
 void KtxTests::initTestCase() {
+    // the KTX cache keeps its version in the settings, it would be wiped on every initialization without them
+    DependencyManager::set<Setting::Manager>();
 }
 
 void KtxTests::cleanupTestCase() {
+    DependencyManager::destroy<Setting::Manager>();
 }
 
 void KtxTests::testKhronosCompressionFunctions() {
@@ -142,6 +149,201 @@ void KtxTests::testKtxSerialization() {
     testTexture->setKtxBacking(TEST_IMAGE_KTX.fileName().toStdString());
 }
 
+// folder of .ktx files to load, such as the KTX cache of a client after visiting a domain
+static const QString KTX_BENCHMARK_DIR_ENV = "HIFI_KTX_BENCHMARK_DIR";
+// number of copies of the test image to load when no folder is given
+static const QString KTX_BENCHMARK_TEXTURES_ENV = "HIFI_KTX_BENCHMARK_TEXTURES";
+
+static QByteArray serializeTestTexture(const QImage& image, const std::string& name) {
+    std::atomic<bool> abortSignal { false };
+    auto texture = image::TextureUsage::process2DTextureColorFromImage(QImage(image), name, true, abortSignal);
+    auto ktxMemory = texture ? gpu::Texture::serialize(*texture) : ktx::KTXUniquePointer();
+    if (!ktxMemory) {
+        return QByteArray();
+    }
+    const auto& storage = ktxMemory->getStorage();
+    return QByteArray(reinterpret_cast<const char*>(storage->data()), (int)storage->size());
+}
+
+static KTXCache::DescriptorPointer parseDescriptor(const QByteArray& data) {
+    auto ktxPointer = ktx::KTX::create(std::make_shared<storage::MemoryStorage>(data.size(), reinterpret_cast<const uint8_t*>(data.constData())));
+    return ktxPointer ? std::make_shared<const ktx::KTXDescriptor>(ktxPointer->toDescriptor()) : nullptr;
+}
+
+static bool isSameDescriptor(const ktx::KTXDescriptor& descriptor, const ktx::KTXDescriptor& other) {
+    if (memcmp(&descriptor.header, &other.header, sizeof(ktx::Header)) != 0 ||
+        descriptor.keyValues.size() != other.keyValues.size() || descriptor.images.size() != other.images.size()) {
+        return false;
+    }
+    auto otherKeyValue = other.keyValues.cbegin();
+    for (const auto& keyValue : descriptor.keyValues) {
+        if (keyValue._key != otherKeyValue->_key || keyValue._value != otherKeyValue->_value) {
+            return false;
+        }
+        ++otherKeyValue;
+    }
+    for (size_t i = 0; i < descriptor.images.size(); ++i) {
+        const auto& image = descriptor.images[i];
+        const auto& otherImage = other.images[i];
+        if (image._numFaces != otherImage._numFaces || image._imageOffset != otherImage._imageOffset ||
+            image._faceSize != otherImage._faceSize || image._padding != otherImage._padding ||
+            image._faceOffsets != otherImage._faceOffsets) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void KtxTests::testKtxCachePersistence() {
+    const QString TEST_IMAGE = getRootPath() + "/scripts/developer/tests/cube_texture.png";
+    QImage image(TEST_IMAGE);
+    QVERIFY(!image.isNull());
+    auto largeKtx = serializeTestTexture(image, TEST_IMAGE.toStdString());
+    auto smallKtx = serializeTestTexture(image.scaled(image.size() / 2), TEST_IMAGE.toStdString());
+    QVERIFY(!largeKtx.isEmpty() && !smallKtx.isEmpty());
+    QVERIFY(largeKtx.size() != smallKtx.size());
+    auto largeDescriptor = parseDescriptor(largeKtx);
+    auto smallDescriptor = parseDescriptor(smallKtx);
+    QVERIFY(largeDescriptor && smallDescriptor);
+
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    auto overwriteFile = [&](const QString& filename, const QByteArray& data) {
+        QFile file(cacheDir.path() + "/" + filename);
+        return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(data) == data.size();
+    };
+
+    const std::string INDEXED_KEY = "indexed";
+    const std::string RESIZED_KEY = "resized";
+    const std::string TRUNCATED_KEY = "truncated";
+    const std::vector<std::string> KEYS { INDEXED_KEY, RESIZED_KEY, TRUNCATED_KEY };
+
+    // the descriptors are indexed as the files are first used, and the index is written when the cache is destroyed
+    {
+        auto ktxCache = std::make_shared<KTXCache>(cacheDir.path().toStdString(), "ktx");
+        ktxCache->initialize();
+        for (const auto& key : KEYS) {
+            QVERIFY(ktxCache->writeFile(largeKtx.constData(), cache::FileCache::Metadata(key, largeKtx.size())));
+            KTXCache::DescriptorPointer descriptor;
+            QVERIFY(ktxCache->getFile(key, descriptor));
+            QVERIFY(descriptor && isSameDescriptor(*descriptor, *largeDescriptor));
+        }
+    }
+    QVERIFY(QFileInfo(cacheDir.path() + "/" + KTXCache::INDEX_FILENAME).exists());
+
+    // a file with an invalid header but the indexed length still gets its descriptor, so it was not parsed,
+    // while files that changed length are parsed again
+    QByteArray invalidHeaderKtx = largeKtx;
+    memset(invalidHeaderKtx.data(), 0, sizeof(ktx::Header));
+    QVERIFY(!parseDescriptor(invalidHeaderKtx));
+    QVERIFY(overwriteFile(QString::fromStdString(INDEXED_KEY) + ".ktx", invalidHeaderKtx));
+    QVERIFY(overwriteFile(QString::fromStdString(RESIZED_KEY) + ".ktx", smallKtx));
+    QVERIFY(overwriteFile(QString::fromStdString(TRUNCATED_KEY) + ".ktx", largeKtx.left(largeKtx.size() / 2)));
+    {
+        auto ktxCache = std::make_shared<KTXCache>(cacheDir.path().toStdString(), "ktx");
+        ktxCache->initialize();
+
+        KTXCache::DescriptorPointer descriptor;
+        QVERIFY(ktxCache->getFile(INDEXED_KEY, descriptor));
+        QVERIFY(descriptor && isSameDescriptor(*descriptor, *largeDescriptor));
+
+        QVERIFY(ktxCache->getFile(RESIZED_KEY, descriptor));
+        QVERIFY(descriptor && isSameDescriptor(*descriptor, *smallDescriptor));
+
+        QVERIFY(ktxCache->getFile(TRUNCATED_KEY, descriptor));
+        QVERIFY(!descriptor);
+    }
+
+    // a corrupt index is ignored, the files are parsed again
+    QVERIFY(overwriteFile(KTXCache::INDEX_FILENAME, QByteArray(256, '\xff')));
+    {
+        auto ktxCache = std::make_shared<KTXCache>(cacheDir.path().toStdString(), "ktx");
+        ktxCache->initialize();
+
+        KTXCache::DescriptorPointer descriptor;
+        QVERIFY(ktxCache->getFile(INDEXED_KEY, descriptor));
+        QVERIFY(!descriptor);
+
+        QVERIFY(ktxCache->getFile(RESIZED_KEY, descriptor));
+        QVERIFY(descriptor && isSameDescriptor(*descriptor, *smallDescriptor));
+    }
+}
+
+void KtxTests::benchmarkTimeToFirstMip() {
+    auto environment = QProcessEnvironment::systemEnvironment();
+    std::vector<QByteArray> ktxFiles;
+    if (environment.contains(KTX_BENCHMARK_DIR_ENV)) {
+        auto fileInfoList = QDir(environment.value(KTX_BENCHMARK_DIR_ENV)).entryInfoList({ "*.ktx" }, QDir::Files);
+        for (const auto& fileInfo : fileInfoList) {
+            QFile file(fileInfo.filePath());
+            if (file.open(QIODevice::ReadOnly)) {
+                ktxFiles.push_back(file.readAll());
+            }
+        }
+    } else {
+        int numTextures = 200;
+        if (environment.contains(KTX_BENCHMARK_TEXTURES_ENV)) {
+            numTextures = std::max(environment.value(KTX_BENCHMARK_TEXTURES_ENV).toInt(), 1);
+        }
+        const QString TEST_IMAGE = getRootPath() + "/scripts/developer/tests/cube_texture.png";
+        std::atomic<bool> abortSignal { false };
+        auto testTexture = image::TextureUsage::process2DTextureColorFromImage(QImage(TEST_IMAGE), TEST_IMAGE.toStdString(), true, abortSignal);
+        QVERIFY(testTexture);
+        auto ktxMemory = gpu::Texture::serialize(*testTexture);
+        QVERIFY(ktxMemory.get());
+        const auto& storage = ktxMemory->getStorage();
+        ktxFiles.assign(numTextures, QByteArray(reinterpret_cast<const char*>(storage->data()), (int)storage->size()));
+    }
+    QVERIFY(!ktxFiles.empty());
+
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    auto fileCache = std::make_shared<cache::FileCache>(cacheDir.path().toStdString(), "ktx");
+    fileCache->initialize();
+
+    // the descriptors are what the KTX cache keeps in its index, taken when the files are written
+    std::vector<ktx::KTXDescriptor> descriptors;
+    for (size_t i = 0; i < ktxFiles.size(); ++i) {
+        const auto& data = ktxFiles[i];
+        auto ktxPointer = ktx::KTX::create(std::make_shared<storage::MemoryStorage>(data.size(), reinterpret_cast<const uint8_t*>(data.constData())));
+        QVERIFY(ktxPointer);
+        descriptors.push_back(ktxPointer->toDescriptor());
+        QVERIFY(fileCache->writeFile(data.constData(), cache::FileCache::Metadata(std::to_string(i), data.size())));
+    }
+
+    // the lowest resolution mip is the one requested first by the texture streaming
+    auto loadFirstMip = [](const gpu::TexturePointer& texture) {
+        return texture ? texture->accessStoredMipFace(texture->getNumMips() - 1) : gpu::PixelsPointer();
+    };
+
+    std::vector<gpu::PixelsPointer> parsedMips;
+    QElapsedTimer timer;
+    timer.start();
+    for (size_t i = 0; i < ktxFiles.size(); ++i) {
+        auto file = fileCache->getFile(std::to_string(i));
+        parsedMips.push_back(loadFirstMip(gpu::Texture::unserialize(file)));
+    }
+    auto parsedUsecs = timer.nsecsElapsed() / NSECS_PER_USEC;
+
+    std::vector<gpu::PixelsPointer> indexedMips;
+    timer.restart();
+    for (size_t i = 0; i < ktxFiles.size(); ++i) {
+        auto file = fileCache->getFile(std::to_string(i));
+        indexedMips.push_back(loadFirstMip(gpu::Texture::unserialize(file, descriptors[i])));
+    }
+    auto indexedUsecs = timer.nsecsElapsed() / NSECS_PER_USEC;
+
+    for (size_t i = 0; i < ktxFiles.size(); ++i) {
+        QVERIFY(parsedMips[i] && indexedMips[i]);
+        QCOMPARE(parsedMips[i]->size(), indexedMips[i]->size());
+        QVERIFY(0 == memcmp(parsedMips[i]->data(), indexedMips[i]->data(), parsedMips[i]->size()));
+    }
+
+    qDebug() << "Time to first mip of" << ktxFiles.size() << "textures:"
+             << (float)parsedUsecs / ktxFiles.size() << "usecs per texture parsing the files,"
+             << (float)indexedUsecs / ktxFiles.size() << "usecs per texture from the index";
+}
+
 #if 0
 
 static const QString TEST_FOLDER { "H:/ktx_cacheold" };
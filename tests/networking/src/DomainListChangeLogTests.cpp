@@ -0,0 +1,276 @@
+//
+//  DomainListChangeLogTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListChangeLogTests.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+#include <DomainListChangeLog.h>
+#include <Node.h>
+
+QTEST_MAIN(DomainListChangeLogTests)
+
+using Version = DomainListChangeLog::Version;
+
+static const QString DOMAIN_LIST_BENCHMARK_NODES_ENV = "HIFI_DOMAIN_LIST_BENCHMARK_NODES";
+
+namespace {
+
+// What the domain-server does with check-ins, minus the networking: it owns the nodes and builds their lists.
+class SyntheticDomain {
+public:
+    SyntheticDomain(size_t maxEntries = DomainListChangeLog::DEFAULT_MAX_ENTRIES) : _log(maxEntries) { }
+
+    QUuid addNode() {
+        QUuid id = QUuid::createUuid();
+        HifiSockAddr socket(QHostAddress::LocalHost, (quint16)(_nodes.size() + 1000));
+        _nodes[id] = SharedNodePointer::create(id, NodeType::Agent, socket, socket);
+        _log.nodeChanged(id, NodeType::Agent);
+        return id;
+    }
+
+    void removeNode(const QUuid& id) {
+        _nodes.erase(id);
+        _log.nodeRemoved(id, NodeType::Agent);
+    }
+
+    void updateNode(const QUuid& id) {
+        auto& node = _nodes[id];
+        NodePermissions permissions = node->getPermissions();
+        permissions.permissions ^= NodePermissions::Permission::canRezTemporaryEntities;
+        node->setPermissions(permissions);
+        _log.nodeChanged(id, NodeType::Agent);
+    }
+
+    // same layout as the body of a DomainList packet
+    QByteArray buildList(const QUuid& requester, Version knownVersion, bool& isDelta, Version& listVersion) const {
+        QByteArray list;
+        QDataStream stream(&list, QIODevice::WriteOnly);
+
+        std::vector<DomainListChangeLog::Change> changes;
+        isDelta = _log.getChangesSince(knownVersion, changes);
+        listVersion = _log.getVersion();
+
+        if (isDelta) {
+            for (const auto& change : changes) {
+                if (change.isRemoved) {
+                    stream << true << change.nodeID;
+                } else if (change.nodeID != requester) {
+                    auto it = _nodes.find(change.nodeID);
+                    if (it != _nodes.end()) {
+                        stream << false << *it->second.data() << _secret;
+                    }
+                }
+            }
+        } else {
+            for (const auto& node : _nodes) {
+                if (node.first != requester) {
+                    stream << *node.second.data() << _secret;
+                }
+            }
+        }
+        return list;
+    }
+
+    const std::map<QUuid, SharedNodePointer>& getNodes() const { return _nodes; }
+
+private:
+    DomainListChangeLog _log;
+    std::map<QUuid, SharedNodePointer> _nodes;
+    QUuid _secret { QUuid::createUuid() };
+};
+
+// What a node knows of the others, as far as the domain lists told it.
+struct SyntheticClient {
+    Version version { DomainListChangeLog::NO_VERSION };
+    std::map<QUuid, uint> permissions;
+
+    void applyList(const QByteArray& list, bool isDelta, Version listVersion) {
+        QDataStream stream(list);
+        if (!isDelta) {
+            permissions.clear();
+        }
+        while (!stream.atEnd()) {
+            bool isRemoved = false;
+            if (isDelta) {
+                stream >> isRemoved;
+            }
+            if (isRemoved) {
+                QUuid id;
+                stream >> id;
+                permissions.erase(id);
+            } else {
+                Node node(QUuid(), NodeType::Unassigned, HifiSockAddr(), HifiSockAddr());
+                QUuid secret;
+                stream >> node >> secret;
+                permissions[node.getUUID()] = (uint)node.getPermissions().permissions;
+            }
+        }
+        version = listVersion;
+    }
+
+    bool matches(const SyntheticDomain& domain, const QUuid& self) const {
+        size_t numOthers = 0;
+        for (const auto& node : domain.getNodes()) {
+            if (node.first == self) {
+                continue;
+            }
+            ++numOthers;
+            auto it = permissions.find(node.first);
+            if (it == permissions.end() || it->second != (uint)node.second->getPermissions().permissions) {
+                return false;
+            }
+        }
+        return numOthers == permissions.size();
+    }
+};
+
+}
+
+void DomainListChangeLogTests::testChangesSince() {
+    DomainListChangeLog log;
+    QUuid a = QUuid::createUuid();
+    QUuid b = QUuid::createUuid();
+
+    std::vector<DomainListChangeLog::Change> changes;
+    QVERIFY(!log.getChangesSince(DomainListChangeLog::NO_VERSION, changes));
+
+    log.nodeChanged(a, NodeType::Agent);
+    Version afterA = log.getVersion();
+    log.nodeChanged(b, NodeType::AudioMixer);
+    log.nodeChanged(a, NodeType::Agent);
+    log.nodeRemoved(b, NodeType::AudioMixer);
+
+    // a node's changes collapse into its latest one
+    QVERIFY(log.getChangesSince(afterA, changes));
+    QCOMPARE(changes.size(), (size_t)2);
+    QCOMPARE(changes[0].nodeID, a);
+    QVERIFY(!changes[0].isRemoved);
+    QCOMPARE(changes[1].nodeID, b);
+    QCOMPARE(changes[1].nodeType, NodeType::AudioMixer);
+    QVERIFY(changes[1].isRemoved);
+
+    // nothing changed since the current version
+    changes.clear();
+    QVERIFY(log.getChangesSince(log.getVersion(), changes));
+    QVERIFY(changes.empty());
+
+    // versions the log never handed out
+    QVERIFY(!log.getChangesSince(log.getVersion() + 1, changes));
+}
+
+void DomainListChangeLogTests::testFallsBackToFullList() {
+    SyntheticDomain domain(4);
+    QUuid self = domain.addNode();
+    std::vector<QUuid> others;
+    for (int i = 0; i < 3; ++i) {
+        others.push_back(domain.addNode());
+    }
+
+    SyntheticClient client;
+    bool isDelta;
+    Version listVersion;
+    client.applyList(domain.buildList(self, client.version, isDelta, listVersion), isDelta, listVersion);
+    QVERIFY(!isDelta);
+    QVERIFY(client.matches(domain, self));
+
+    domain.updateNode(others[0]);
+    domain.removeNode(others[1]);
+    client.applyList(domain.buildList(self, client.version, isDelta, listVersion), isDelta, listVersion);
+    QVERIFY(isDelta);
+    QVERIFY(client.matches(domain, self));
+
+    // more changes than the log keeps, while the node wasn't checking in
+    for (int i = 0; i < 5; ++i) {
+        domain.updateNode(others[2]);
+    }
+    client.applyList(domain.buildList(self, client.version, isDelta, listVersion), isDelta, listVersion);
+    QVERIFY(!isDelta);
+    QVERIFY(client.matches(domain, self));
+}
+
+void DomainListChangeLogTests::testSyntheticCheckIns() {
+    size_t numNodes = 300;
+    auto environment = QProcessEnvironment::systemEnvironment();
+    if (environment.contains(DOMAIN_LIST_BENCHMARK_NODES_ENV)) {
+        numNodes = (size_t)std::max(environment.value(DOMAIN_LIST_BENCHMARK_NODES_ENV).toInt(), 2);
+    }
+
+    // one check-in per node per tick, about 1% of the nodes joining, leaving or changing in between
+    const int NUM_TICKS = 30;
+    const size_t NUM_CHANGES_PER_TICK = std::max((size_t)1, numNodes / 100);
+    const int LOST_REPLY_PERCENT = 5;
+
+    std::mt19937 generator(42);
+    SyntheticDomain domain;
+    std::map<QUuid, SyntheticClient> clients;
+    for (size_t i = 0; i < numNodes; ++i) {
+        clients[domain.addNode()];
+    }
+
+    qint64 fullNsecs = 0;
+    qint64 deltaNsecs = 0;
+    qint64 fullBytes = 0;
+    qint64 deltaBytes = 0;
+    int numFullLists = 0;
+    int numDeltas = 0;
+
+    for (int tick = 0; tick < NUM_TICKS; ++tick) {
+        for (size_t i = 0; i < NUM_CHANGES_PER_TICK; ++i) {
+            if (clients.empty()) {
+                clients[domain.addNode()];
+                continue;
+            }
+            auto it = clients.begin();
+            std::advance(it, generator() % clients.size());
+            switch (generator() % 3) {
+                case 0:
+                    clients[domain.addNode()];
+                    break;
+                case 1:
+                    domain.removeNode(it->first);
+                    clients.erase(it);
+                    break;
+                default:
+                    domain.updateNode(it->first);
+                    break;
+            }
+        }
+
+        for (auto& client : clients) {
+            bool isDelta;
+            Version listVersion;
+
+            // what every check-in used to cost
+            QElapsedTimer timer;
+            timer.start();
+            fullBytes += domain.buildList(client.first, DomainListChangeLog::NO_VERSION, isDelta, listVersion).size();
+            fullNsecs += timer.nsecsElapsed();
+
+            timer.restart();
+            QByteArray list = domain.buildList(client.first, client.second.version, isDelta, listVersion);
+            deltaNsecs += timer.nsecsElapsed();
+            deltaBytes += list.size();
+            ++(isDelta ? numDeltas : numFullLists);
+
+            if ((int)(generator() % 100) < LOST_REPLY_PERCENT) {
+                continue;
+            }
+            client.second.applyList(list, isDelta, listVersion);
+            QVERIFY(client.second.matches(domain, client.first));
+        }
+    }
+
+    qDebug() << numNodes << "nodes," << numFullLists << "full lists and" << numDeltas << "deltas:"
+        << fullNsecs / 1000000.0 << "ms and" << fullBytes << "bytes with full lists only,"
+        << deltaNsecs / 1000000.0 << "ms and" << deltaBytes << "bytes with deltas";
+}
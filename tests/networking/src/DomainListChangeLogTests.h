@@ -0,0 +1,24 @@
+//
+//  DomainListChangeLogTests.h
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListChangeLogTests_h
+#define hifi_DomainListChangeLogTests_h
+
+#include <QtTest/QtTest>
+
+class DomainListChangeLogTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testChangesSince();
+    void testFallsBackToFullList();
+    void testSyntheticCheckIns();
+};
+
+#endif // hifi_DomainListChangeLogTests_h
@@ -0,0 +1,106 @@
+//
+//  NodeListTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NodeListTests.h"
+
+#include <vector>
+
+#include <DependencyManager.h>
+#include <DomainListChangeLog.h>
+#include <HMACAuth.h>
+#include <LimitedNodeList.h>
+#include <Node.h>
+#include <NodeList.h>
+#include <StatTracker.h>
+
+QTEST_MAIN(NodeListTests)
+
+void NodeListTests::initTestCase() {
+    DependencyManager::set<StatTracker>();
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::Agent, INVALID_PORT);
+}
+
+void NodeListTests::cleanupTestCase() {
+    DependencyManager::destroy<NodeList>();
+    DependencyManager::destroy<StatTracker>();
+}
+
+void NodeListTests::testDomainAuthenticationMethod() {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    nodeList->setDomainAuthenticationMethod(HMACAuth::SIPHASH);
+    QCOMPARE(nodeList->getAuthenticationMethod(), HMACAuth::SIPHASH);
+
+    // their hashes don't fit the verification hash of the packet headers
+    for (auto method : { HMACAuth::SHA1, HMACAuth::SHA224, HMACAuth::SHA256, HMACAuth::RIPEMD160 }) {
+        nodeList->setDomainAuthenticationMethod(method);
+        QCOMPARE(nodeList->getAuthenticationMethod(), HMACAuth::SIPHASH);
+    }
+
+    // from a newer domain server
+    nodeList->setDomainAuthenticationMethod(HMACAuth::SIPHASH + 1);
+    QCOMPARE(nodeList->getAuthenticationMethod(), HMACAuth::SIPHASH);
+    nodeList->setDomainAuthenticationMethod(255);
+    QCOMPARE(nodeList->getAuthenticationMethod(), HMACAuth::SIPHASH);
+
+    nodeList->setDomainAuthenticationMethod(HMACAuth::MD5);
+    QCOMPARE(nodeList->getAuthenticationMethod(), HMACAuth::MD5);
+}
+
+using Version = DomainListChangeLog::Version;
+
+// the body of a DomainList delta packet, with the changes of the given nodes
+static QByteArray createDelta(const std::vector<QUuid>& addedNodes, const std::vector<QUuid>& removedNodes) {
+    QByteArray delta;
+    QDataStream stream(&delta, QIODevice::WriteOnly);
+    for (const auto& nodeID : addedNodes) {
+        HifiSockAddr socket(QHostAddress::LocalHost, 1000);
+        Node node(nodeID, NodeType::Agent, socket, socket);
+        stream << false << node << QUuid::createUuid();
+    }
+    for (const auto& nodeID : removedNodes) {
+        stream << true << nodeID;
+    }
+    return delta;
+}
+
+void NodeListTests::testSplitDomainListDelta() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto applyList = [&](const QByteArray& list, DomainListChangeLog::ListType listType, Version baseVersion,
+                         Version listVersion, bool newConnection = false) {
+        QDataStream stream(list);
+        nodeList->applyDomainList(stream, list.size(), newConnection, (quint8)listType, baseVersion, listVersion);
+    };
+
+    applyList(QByteArray(), DomainListChangeLog::ListType::Full, DomainListChangeLog::NO_VERSION, 5, true);
+    QCOMPARE(nodeList->_domainListVersion.load(), (Version)5);
+
+    // a delta that didn't fit in one packet, its packets received out of order
+    QUuid firstNode = QUuid::createUuid();
+    QUuid secondNode = QUuid::createUuid();
+    applyList(createDelta({ secondNode }, {}), DomainListChangeLog::ListType::Delta, 5, 7);
+    applyList(createDelta({ firstNode }, {}), DomainListChangeLog::ListType::Delta, 5, 7);
+    QVERIFY(nodeList->nodeWithUUID(firstNode));
+    QVERIFY(nodeList->nodeWithUUID(secondNode));
+    QCOMPARE(nodeList->_domainListVersion.load(), (Version)7);
+
+    // a packet of an older delta doesn't undo the changes that followed it
+    applyList(createDelta({}, { firstNode }), DomainListChangeLog::ListType::Delta, 7, 8);
+    QVERIFY(!nodeList->nodeWithUUID(firstNode));
+    applyList(createDelta({ firstNode }, {}), DomainListChangeLog::ListType::Delta, 5, 7);
+    QVERIFY(!nodeList->nodeWithUUID(firstNode));
+    QCOMPARE(nodeList->_domainListVersion.load(), (Version)8);
+
+    // after missing a delta, the whole list is asked for
+    applyList(createDelta({ firstNode }, {}), DomainListChangeLog::ListType::Delta, 9, 10);
+    QVERIFY(!nodeList->nodeWithUUID(firstNode));
+    QCOMPARE(nodeList->_domainListVersion.load(), (Version)DomainListChangeLog::NO_VERSION);
+}
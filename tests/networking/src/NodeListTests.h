@@ -0,0 +1,25 @@
+//
+//  NodeListTests.h
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NodeListTests_h
+#define hifi_NodeListTests_h
+
+#include <QtTest/QtTest>
+
+class NodeListTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void testDomainAuthenticationMethod();
+    void testSplitDomainListDelta();
+};
+
+#endif // hifi_NodeListTests_h
@@ -0,0 +1,184 @@
+//
+//  PacketAuthenticationTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketAuthenticationTests.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <thread>
+#include <vector>
+
+#include <HMACAuth.h>
+#include <NLPacket.h>
+#include <NumericalConstants.h>
+#include <SipHash.h>
+
+QTEST_MAIN(PacketAuthenticationTests)
+
+static const QString PACKET_AUTH_BENCHMARK_PACKETS_ENV = "HIFI_PACKET_AUTH_BENCHMARK_PACKETS";
+
+// about the size of an avatar data packet
+static const int BENCHMARK_PAYLOAD_SIZE = 300;
+
+static std::unique_ptr<NLPacket> createSignedPacket(HMACAuth& hmacAuth, const QByteArray& payload) {
+    auto packet = NLPacket::create(PacketType::AvatarData);
+    packet->write(payload);
+    packet->writeSourceID(1);
+    packet->writeVerificationHash(hmacAuth);
+    return packet;
+}
+
+static bool isVerified(const NLPacket& packet, HMACAuth& hmacAuth) {
+    return NLPacket::verificationHashInHeader(packet) == NLPacket::hashForPacketAndHMAC(packet, hmacAuth);
+}
+
+void PacketAuthenticationTests::testSipHashVectors() {
+    // from the reference implementation, with the key 00 01 .. 0f and the message 00 01 .. of each length
+    struct Vector {
+        size_t length;
+        const char* hash;
+    };
+    const Vector VECTORS[] = {
+        { 0, "a3817f04ba25a8e66df67214c7550293" },
+        { 1, "da87c1d86b99af44347659119b22fc45" },
+        { 2, "8177228da4a45dc7fca38bdef60affe4" },
+        { 15, "5493e99933b0a8117e08ec0f97cfc3d9" },
+        { 63, "5150d1772f50834a503e069a973fbd7c" }
+    };
+
+    unsigned char key[SipHash::KEY_SIZE];
+    for (size_t i = 0; i < SipHash::KEY_SIZE; ++i) {
+        key[i] = (unsigned char)i;
+    }
+    unsigned char message[64];
+    for (size_t i = 0; i < sizeof(message); ++i) {
+        message[i] = (unsigned char)i;
+    }
+
+    uint64_t k0, k1;
+    SipHash::keyFromBytes(key, sizeof(key), k0, k1);
+    for (const auto& vector : VECTORS) {
+        unsigned char hash[SipHash::HASH_SIZE];
+        SipHash::hash128(k0, k1, message, vector.length, hash);
+        QCOMPARE(QByteArray((const char*)hash, sizeof(hash)).toHex(), QByteArray(vector.hash));
+    }
+
+    // the same through HMACAuth, as a whole and in pieces
+    HMACAuth hmacAuth(HMACAuth::SIPHASH);
+    hmacAuth.setKey((const char*)key, sizeof(key));
+    HMACAuth::HMACHash hash;
+    QVERIFY(hmacAuth.calculateHash(hash, (const char*)message, 63));
+    QCOMPARE(QByteArray((const char*)hash.data(), (int)hash.size()).toHex(), QByteArray(VECTORS[4].hash));
+    QVERIFY(hmacAuth.addData((const char*)message, 20));
+    QVERIFY(hmacAuth.addData((const char*)message + 20, 43));
+    QVERIFY(hmacAuth.result() == hash);
+}
+
+void PacketAuthenticationTests::testVerifyPackets() {
+    const QUuid secret = QUuid::createUuid();
+    const QByteArray payload(BENCHMARK_PAYLOAD_SIZE, 'x');
+
+    for (auto method : { HMACAuth::MD5, HMACAuth::SIPHASH }) {
+        HMACAuth sender(method);
+        sender.setKey(secret);
+        HMACAuth receiver(method);
+        receiver.setKey(secret);
+
+        auto packet = createSignedPacket(sender, payload);
+        QVERIFY(isVerified(*packet, receiver));
+
+        // a changed payload fails
+        packet->getPayload()[BENCHMARK_PAYLOAD_SIZE / 2] ^= 1;
+        QVERIFY(!isVerified(*packet, receiver));
+
+        // as does another secret
+        HMACAuth stranger(method);
+        stranger.setKey(QUuid::createUuid());
+        QVERIFY(!isVerified(*createSignedPacket(stranger, payload), receiver));
+    }
+}
+
+void PacketAuthenticationTests::testSwitchMethod() {
+    const QUuid secret = QUuid::createUuid();
+    const QByteArray payload(BENCHMARK_PAYLOAD_SIZE, 'x');
+
+    HMACAuth sender(HMACAuth::SIPHASH);
+    sender.setKey(secret);
+
+    // what a node does when the domain picks SipHash after its secret was set
+    HMACAuth receiver;
+    receiver.setKey(secret);
+    auto packet = createSignedPacket(sender, payload);
+    QVERIFY(!isVerified(*packet, receiver));
+    QVERIFY(receiver.setAuthMethod(HMACAuth::SIPHASH));
+    QCOMPARE(receiver.getAuthMethod(), HMACAuth::SIPHASH);
+    QVERIFY(isVerified(*packet, receiver));
+
+    // and back
+    QVERIFY(receiver.setAuthMethod(HMACAuth::MD5));
+    QVERIFY(sender.setAuthMethod(HMACAuth::MD5));
+    QVERIFY(isVerified(*createSignedPacket(sender, payload), receiver));
+}
+
+void PacketAuthenticationTests::benchmarkPacketsPerSecond() {
+    int numPackets = 100000;
+    auto environment = QProcessEnvironment::systemEnvironment();
+    if (environment.contains(PACKET_AUTH_BENCHMARK_PACKETS_ENV)) {
+        numPackets = std::max(environment.value(PACKET_AUTH_BENCHMARK_PACKETS_ENV).toInt(), 1);
+    }
+    const int numThreads = (int)std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+
+    const QUuid secret = QUuid::createUuid();
+    QByteArray payload(BENCHMARK_PAYLOAD_SIZE, '\0');
+    for (int i = 0; i < payload.size(); ++i) {
+        payload[i] = (char)(i * 7);
+    }
+
+    for (auto method : { HMACAuth::MD5, HMACAuth::SIPHASH }) {
+        HMACAuth hmacAuth(method);
+        hmacAuth.setKey(secret);
+
+        // the packets are built once, only the hashing is measured
+        std::vector<std::unique_ptr<NLPacket>> packets;
+        for (int i = 0; i < numThreads; ++i) {
+            packets.push_back(createSignedPacket(hmacAuth, payload));
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < numPackets; ++i) {
+            packets[0]->writeVerificationHash(hmacAuth);
+        }
+        double singleThreadRate = numPackets / (timer.nsecsElapsed() / (double)NSECS_PER_SECOND);
+
+        // mixer threads sending to the same node share its hash
+        timer.restart();
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < numThreads; ++thread) {
+            threads.emplace_back([&, thread] {
+                for (int i = 0; i < numPackets; ++i) {
+                    packets[thread]->writeVerificationHash(hmacAuth);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        double sharedRate = numThreads * numPackets / (timer.nsecsElapsed() / (double)NSECS_PER_SECOND);
+
+        for (const auto& packet : packets) {
+            QVERIFY(isVerified(*packet, hmacAuth));
+        }
+
+        qDebug() << (method == HMACAuth::SIPHASH ? "SipHash:" : "HMAC-MD5:")
+            << (qint64)singleThreadRate << "packets/s on one thread,"
+            << (qint64)sharedRate << "packets/s on" << numThreads << "threads sharing the node";
+    }
+}
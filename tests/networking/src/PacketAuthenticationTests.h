@@ -0,0 +1,28 @@
+//
+//  PacketAuthenticationTests.h
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketAuthenticationTests_h
+#define hifi_PacketAuthenticationTests_h
+
+#include <QtTest/QtTest>
+
+class PacketAuthenticationTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testSipHashVectors();
+    void testVerifyPackets();
+    void testSwitchMethod();
+
+    // Packets per second signed with each method, by one thread and by several threads sending to the same node.
+    // The number of packets can be set with HIFI_PACKET_AUTH_BENCHMARK_PACKETS.
+    void benchmarkPacketsPerSecond();
+};
+
+#endif // hifi_PacketAuthenticationTests_h
@@ -0,0 +1,84 @@
+//
+//  PacketDispatchPoolTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketDispatchPoolTests.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <PacketDispatchPool.h>
+
+QTEST_MAIN(PacketDispatchPoolTests)
+
+void PacketDispatchPoolTests::testOrderPerShard() {
+    const int NUM_SHARDS = 16;
+    const int NUM_PACKETS_PER_SHARD = 2000;
+
+    PacketDispatchPool pool("Test Dispatch", 4);
+
+    // each shard only ever runs on one worker, so its sequence needs no synchronization
+    std::vector<int> lastSequence(NUM_SHARDS, -1);
+    std::atomic<int> numOutOfOrder { 0 };
+    for (int sequence = 0; sequence < NUM_PACKETS_PER_SHARD; ++sequence) {
+        for (int shard = 0; shard < NUM_SHARDS; ++shard) {
+            pool.dispatch(shard, PacketType::MicrophoneAudioNoEcho, [&, shard, sequence] {
+                if (lastSequence[shard] != sequence - 1) {
+                    ++numOutOfOrder;
+                }
+                lastSequence[shard] = sequence;
+            });
+        }
+    }
+    pool.flush();
+
+    QCOMPARE(numOutOfOrder.load(), 0);
+    for (int shard = 0; shard < NUM_SHARDS; ++shard) {
+        QCOMPARE(lastSequence[shard], NUM_PACKETS_PER_SHARD - 1);
+    }
+}
+
+void PacketDispatchPoolTests::testFlush() {
+    PacketDispatchPool pool("Test Dispatch", 2);
+
+    std::atomic<int> numRun { 0 };
+    for (int shard = 0; shard < 8; ++shard) {
+        pool.dispatch(shard, PacketType::AvatarData, [&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            ++numRun;
+        });
+    }
+    pool.flush();
+    QCOMPARE(numRun.load(), 8);
+}
+
+void PacketDispatchPoolTests::testStats() {
+    PacketDispatchPool pool("Test Dispatch", 2);
+
+    for (int i = 0; i < 10; ++i) {
+        pool.dispatch(i, PacketType::AvatarData, [] { });
+    }
+    for (int i = 0; i < 5; ++i) {
+        pool.dispatch(i, PacketType::SilentAudioFrame, [] { });
+    }
+    pool.flush();
+
+    auto stats = pool.sampleStats();
+    QCOMPARE((int)stats.size(), 2);
+    for (const auto& typeStats : stats) {
+        QVERIFY(typeStats.first == PacketType::AvatarData || typeStats.first == PacketType::SilentAudioFrame);
+        QCOMPARE(typeStats.second.packets, (uint64_t)(typeStats.first == PacketType::AvatarData ? 10 : 5));
+        QVERIFY(typeStats.second.maxQueueDepth >= 1);
+        QVERIFY(typeStats.second.maxLatencyUsecs * typeStats.second.packets >= typeStats.second.latencyUsecs);
+    }
+
+    // sampling resets them
+    QVERIFY(pool.sampleStats().empty());
+}
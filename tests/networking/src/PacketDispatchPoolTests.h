@@ -0,0 +1,24 @@
+//
+//  PacketDispatchPoolTests.h
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketDispatchPoolTests_h
+#define hifi_PacketDispatchPoolTests_h
+
+#include <QtTest/QtTest>
+
+class PacketDispatchPoolTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testOrderPerShard();
+    void testFlush();
+    void testStats();
+};
+
+#endif // hifi_PacketDispatchPoolTests_h
@@ -0,0 +1,139 @@
+//
+//  EntityQueryFilterTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityQueryFilterTests.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <QJsonDocument>
+
+#include <EntityItem.h>
+#include <EntityItemProperties.h>
+#include <EntityQueryFilter.h>
+
+QTEST_MAIN(EntityQueryFilterTests)
+
+static const QString FILTER_BENCHMARK_ENTITIES_ENV = "HIFI_FILTER_BENCHMARK_ENTITIES";
+
+struct TestEntity {
+    EntityItemPointer entity;
+    bool isPriorityZone; // stands in for the zone members that ZoneEntityItem read directly
+};
+
+// how EntityItem and ZoneEntityItem walked the JSON filter for every entity, before it was compiled
+static bool matchesJSONFiltersByWalking(const TestEntity& testEntity, const QJsonObject& jsonFilters) {
+    static const QString SERVER_SCRIPTS_PROPERTY = "serverScripts";
+    static const QString ENTITY_TYPE_PROPERTY = "type";
+    static const QString AVATAR_PRIORITY_PROPERTY = "avatarPriority";
+
+    const EntityItemPointer& entity = testEntity.entity;
+    if (entity->getType() == EntityTypes::Zone) {
+        if (jsonFilters.contains(AVATAR_PRIORITY_PROPERTY) && jsonFilters[AVATAR_PRIORITY_PROPERTY].toBool()
+            && testEntity.isPriorityZone) {
+            return true;
+        }
+    }
+
+    foreach(const auto& property, jsonFilters.keys()) {
+        if (property == SERVER_SCRIPTS_PROPERTY && jsonFilters[property] == QString("+")) {
+            return entity->getServerScripts() != ENTITY_ITEM_DEFAULT_SERVER_SCRIPTS;
+        } else if (property == ENTITY_TYPE_PROPERTY) {
+            return (jsonFilters[property] == EntityTypes::getEntityTypeName(entity->getType()));
+        }
+    }
+    return true;
+}
+
+static std::vector<TestEntity> makeEntities(int count) {
+    std::vector<TestEntity> entities;
+    for (int i = 0; i < count; ++i) {
+        EntityItemProperties properties;
+        bool isPriorityZone = false;
+        EntityTypes::EntityType type = EntityTypes::Shape;
+        if (i % 4 == 0) {
+            type = EntityTypes::Zone;
+            if (i % 8 == 0) {
+                properties.setAvatarPriority(COMPONENT_MODE_ENABLED);
+                isPriorityZone = true;
+            }
+        }
+        if (i % 3 == 0) {
+            properties.setServerScripts("http://example.com/server.js");
+        }
+
+        auto entity = EntityTypes::constructEntityItem(type, EntityItemID(QUuid::createUuid()), properties);
+        entities.push_back({ entity, isPriorityZone });
+    }
+    return entities;
+}
+
+static std::vector<QJsonObject> makeFilters() {
+    return {
+        QJsonObject(),
+        QJsonObject { { "serverScripts", "+" } },
+        QJsonObject { { "serverScripts", "-" } },
+        QJsonObject { { "type", "Zone" } },
+        QJsonObject { { "type", "Shape" } },
+        QJsonObject { { "type", "NotAType" } },
+        QJsonObject { { "type", 3 } },
+        QJsonObject { { "avatarPriority", true } },
+        QJsonObject { { "avatarPriority", true }, { "type", "Shape" } },
+        QJsonObject { { "serverScripts", "+" }, { "type", "Zone" } },
+        QJsonObject { { "flags", QJsonObject { { "includeAncestors", true } } }, { "serverScripts", "+" } }
+    };
+}
+
+void EntityQueryFilterTests::testMatchesJSONFilters() {
+    auto entities = makeEntities(64);
+
+    for (const auto& jsonFilters : makeFilters()) {
+        EntityQueryFilter filter(jsonFilters);
+        QCOMPARE(filter.isEmpty(), jsonFilters.isEmpty());
+
+        for (const auto& testEntity : entities) {
+            bool expected = matchesJSONFiltersByWalking(testEntity, jsonFilters);
+            QCOMPARE(testEntity.entity->matchesQueryFilter(filter), expected);
+            QCOMPARE(testEntity.entity->matchesJSONFilters(jsonFilters), expected);
+        }
+    }
+}
+
+void EntityQueryFilterTests::benchmarkFilterCost() {
+    int numEntities = 10000;
+    auto environment = QProcessEnvironment::systemEnvironment();
+    if (environment.contains(FILTER_BENCHMARK_ENTITIES_ENV)) {
+        numEntities = std::max(environment.value(FILTER_BENCHMARK_ENTITIES_ENV).toInt(), 1);
+    }
+    auto entities = makeEntities(numEntities);
+
+    for (const auto& jsonFilters : makeFilters()) {
+        int walkedMatches = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (const auto& testEntity : entities) {
+            walkedMatches += matchesJSONFiltersByWalking(testEntity, jsonFilters) ? 1 : 0;
+        }
+        qint64 walkedNsecs = timer.nsecsElapsed();
+
+        int compiledMatches = 0;
+        timer.restart();
+        EntityQueryFilter filter(jsonFilters);
+        for (const auto& testEntity : entities) {
+            compiledMatches += testEntity.entity->matchesQueryFilter(filter) ? 1 : 0;
+        }
+        qint64 compiledNsecs = timer.nsecsElapsed();
+
+        QCOMPARE(compiledMatches, walkedMatches);
+        qDebug() << QJsonDocument(jsonFilters).toJson(QJsonDocument::Compact) << ":"
+            << (double)walkedNsecs / numEntities << "ns per entity walking the JSON,"
+            << (double)compiledNsecs / numEntities << "ns per entity compiled";
+    }
+}
@@ -0,0 +1,144 @@
+//
+//  OctreeJournalTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeJournalTests.h"
+
+#include <QTemporaryDir>
+
+#include <OctreeJournal.h>
+
+QTEST_MAIN(OctreeJournalTests)
+
+static std::vector<OctreeJournal::Record> makeRecords(int count) {
+    std::vector<OctreeJournal::Record> records;
+    for (int i = 0; i < count; ++i) {
+        if (i % 3 == 2) {
+            records.push_back({ OctreeJournal::Operation::Delete, QUuid::createUuid(), QByteArray() });
+        } else {
+            records.push_back({ OctreeJournal::Operation::Upsert, QUuid::createUuid(), QByteArray(10 * i + 1, (char)i) });
+        }
+    }
+    return records;
+}
+
+static void compareRecords(const std::vector<OctreeJournal::Record>& actual, const std::vector<OctreeJournal::Record>& expected) {
+    QCOMPARE(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        QVERIFY(actual[i].operation == expected[i].operation);
+        QCOMPARE(actual[i].id, expected[i].id);
+        QCOMPARE(actual[i].payload, expected[i].payload);
+    }
+}
+
+void OctreeJournalTests::testRoundTrip() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString filename = directory.filePath("models.json.gz.journal");
+
+    QUuid snapshotID = QUuid::createUuid();
+    const int SNAPSHOT_VERSION = 7;
+    auto records = makeRecords(10);
+    auto moreRecords = makeRecords(5);
+
+    {
+        OctreeJournal journal(filename);
+        QVERIFY(journal.reset(snapshotID, SNAPSHOT_VERSION));
+        QVERIFY(journal.append(records));
+        QVERIFY(journal.append(moreRecords));
+        QCOMPARE(journal.getNumRecords(), 15);
+        QCOMPARE(journal.getSize(), QFileInfo(filename).size());
+    }
+
+    records.insert(records.end(), moreRecords.begin(), moreRecords.end());
+
+    OctreeJournal journal(filename);
+    std::vector<OctreeJournal::Record> readRecords;
+    QVERIFY(journal.read(snapshotID, SNAPSHOT_VERSION, readRecords));
+    compareRecords(readRecords, records);
+    QCOMPARE(journal.getNumRecords(), 15);
+
+    // appending after a read continues the same journal
+    auto lastRecords = makeRecords(2);
+    QVERIFY(journal.append(lastRecords));
+    records.insert(records.end(), lastRecords.begin(), lastRecords.end());
+
+    readRecords.clear();
+    QVERIFY(OctreeJournal(filename).read(snapshotID, SNAPSHOT_VERSION, readRecords));
+    compareRecords(readRecords, records);
+}
+
+void OctreeJournalTests::testIgnoresOtherSnapshots() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString filename = directory.filePath("models.json.gz.journal");
+
+    QUuid snapshotID = QUuid::createUuid();
+    OctreeJournal journal(filename);
+    QVERIFY(journal.reset(snapshotID, 3));
+    QVERIFY(journal.append(makeRecords(4)));
+
+    std::vector<OctreeJournal::Record> records;
+    QVERIFY(!OctreeJournal(filename).read(snapshotID, 4, records));
+    QVERIFY(!OctreeJournal(filename).read(QUuid::createUuid(), 3, records));
+    QVERIFY(records.empty());
+
+    journal.remove();
+    QVERIFY(!QFile::exists(filename));
+    QVERIFY(!OctreeJournal(filename).read(snapshotID, 3, records));
+}
+
+void OctreeJournalTests::testDropsIncompleteRecords() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString filename = directory.filePath("models.json.gz.journal");
+
+    QUuid snapshotID = QUuid::createUuid();
+    auto records = makeRecords(6);
+    qint64 completeSize;
+    {
+        OctreeJournal journal(filename);
+        QVERIFY(journal.reset(snapshotID, 1));
+        QVERIFY(journal.append(records));
+        completeSize = journal.getSize();
+        QVERIFY(journal.append(makeRecords(1)));
+    }
+
+    // cut the last record short, as a crash in the middle of an append would
+    {
+        QFile file(filename);
+        QVERIFY(file.resize(completeSize + 5));
+    }
+
+    OctreeJournal journal(filename);
+    std::vector<OctreeJournal::Record> readRecords;
+    QVERIFY(journal.read(snapshotID, 1, readRecords));
+    compareRecords(readRecords, records);
+    QCOMPARE(journal.getSize(), completeSize);
+
+    // the next append replaces the incomplete record
+    auto moreRecords = makeRecords(3);
+    QVERIFY(journal.append(moreRecords));
+    records.insert(records.end(), moreRecords.begin(), moreRecords.end());
+
+    readRecords.clear();
+    QVERIFY(OctreeJournal(filename).read(snapshotID, 1, readRecords));
+    compareRecords(readRecords, records);
+
+    // a damaged record ends the journal as well
+    {
+        QFile file(filename);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.seek(completeSize + 10));
+        QVERIFY(file.write("garbage") == 7);
+    }
+    readRecords.clear();
+    QVERIFY(OctreeJournal(filename).read(snapshotID, 1, readRecords));
+    compareRecords(readRecords, std::vector<OctreeJournal::Record>(records.begin(), records.begin() + 6));
+}
@@ -0,0 +1,25 @@
+//
+//  OctreeJournalTests.h
+//  tests/octree/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeJournalTests_h
+#define hifi_OctreeJournalTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeJournalTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRoundTrip();
+    void testIgnoresOtherSnapshots();
+    void testDropsIncompleteRecords();
+};
+
+#endif // hifi_OctreeJournalTests_h
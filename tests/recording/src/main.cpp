@@ -19,6 +19,10 @@
 #include <QtCore/QTemporaryFile>
 #include <QtCore/QString>
 
+#include <cstddef>
+#include <limits>
+#include <vector>
+
 #if defined(__clang__)
 #pragma clang diagnostic pop
 #endif
@@ -119,10 +123,123 @@ void testClipOrdering() {
     Q_UNUSED(lastFrameTimeOffset); // FIXME - Unix build not yet upgraded to Qt 5.5.1 we can remove this once it is
 }
 
+void testFileIndex() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    // more frames than fit in one index frame
+    const int NUM_FRAMES = 10000;
+    auto writeClip = Clip::newClip();
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)(i * 10), QByteArray(i % 100, (char)i)));
+    }
+    Clip::toFile(fileName, writeClip);
+
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == (size_t)NUM_FRAMES);
+    readClip->seekFrameTime(5000);
+    QVERIFY(readClip->positionFrameTime() == 5000);
+    auto frame = readClip->nextFrame();
+    QVERIFY(frame->data == QByteArray(500 % 100, (char)500));
+    readClip->seek(0);
+    std::vector<FrameConstPointer> readFrames;
+    for (auto readFrame = readClip->nextFrame(); readFrame; readFrame = readClip->nextFrame()) {
+        readFrames.push_back(readFrame);
+    }
+    // unmap the file before changing it
+    readClip.reset();
+
+    // files without the index are read frame by frame
+    Clip::FrameIndexFooter footer;
+    QFile indexedFile(fileName);
+    QVERIFY(indexedFile.open(QIODevice::ReadWrite));
+    QVERIFY(indexedFile.seek(indexedFile.size() - sizeof(Clip::FrameIndexFooter)));
+    QVERIFY(indexedFile.read((char*)&footer, sizeof(Clip::FrameIndexFooter)) == sizeof(Clip::FrameIndexFooter));
+    QVERIFY(footer.magic == Clip::FRAME_INDEX_MAGIC);
+    QVERIFY(footer.frameCount == (uint32_t)NUM_FRAMES);
+    QVERIFY(indexedFile.resize(footer.indexOffset));
+    indexedFile.close();
+
+    auto scannedClip = Clip::fromFile(fileName);
+    QVERIFY(scannedClip != Clip::Pointer());
+    QVERIFY(scannedClip->frameCount() == (size_t)NUM_FRAMES);
+    scannedClip->seek(0);
+    for (const auto& readFrame : readFrames) {
+        auto scannedFrame = scannedClip->nextFrame();
+        QVERIFY(readFrame->timeOffset == scannedFrame->timeOffset);
+        QVERIFY(readFrame->data == scannedFrame->data);
+    }
+}
+
+void testCorruptFileIndex() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    const int NUM_FRAMES = 100;
+    auto writeClip = Clip::newClip();
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)(i * 10), QByteArray(i + 1, (char)i)));
+    }
+    Clip::toFile(fileName, writeClip);
+
+    QFile indexedFile(fileName);
+    QVERIFY(indexedFile.open(QIODevice::ReadWrite));
+    Clip::FrameIndexFooter footer;
+    qint64 footerOffset = indexedFile.size() - sizeof(Clip::FrameIndexFooter);
+    QVERIFY(indexedFile.seek(footerOffset));
+    QVERIFY(indexedFile.read((char*)&footer, sizeof(Clip::FrameIndexFooter)) == sizeof(Clip::FrameIndexFooter));
+    QVERIFY(footer.magic == Clip::FRAME_INDEX_MAGIC);
+
+    // an index that can't be right is ignored, and the frames are read one by one
+    auto verifyScanned = [&] {
+        auto readClip = Clip::fromFile(fileName);
+        QVERIFY(readClip != Clip::Pointer());
+        QVERIFY(readClip->frameCount() == (size_t)NUM_FRAMES);
+        readClip->seek(0);
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            auto frame = readClip->nextFrame();
+            QVERIFY(frame && frame->data == QByteArray(i + 1, (char)i));
+        }
+    };
+
+    // a frame offset whose end wraps around
+    qint64 entryOffset = footer.indexOffset + sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize) +
+        offsetof(Clip::FrameIndexEntry, fileOffset);
+    quint64 fileOffset;
+    QVERIFY(indexedFile.seek(entryOffset));
+    QVERIFY(indexedFile.read((char*)&fileOffset, sizeof(fileOffset)) == sizeof(fileOffset));
+    quint64 wrappingOffset = std::numeric_limits<quint64>::max() - 8;
+    QVERIFY(indexedFile.seek(entryOffset));
+    QVERIFY(indexedFile.write((const char*)&wrappingOffset, sizeof(wrappingOffset)) == sizeof(wrappingOffset));
+    indexedFile.flush();
+    verifyScanned();
+    QVERIFY(indexedFile.seek(entryOffset));
+    QVERIFY(indexedFile.write((const char*)&fileOffset, sizeof(fileOffset)) == sizeof(fileOffset));
+
+    // more frames than the index has room for
+    Clip::FrameIndexFooter corruptFooter = footer;
+    corruptFooter.frameCount = std::numeric_limits<uint32_t>::max();
+    QVERIFY(indexedFile.seek(footerOffset));
+    QVERIFY(indexedFile.write((const char*)&corruptFooter, sizeof(corruptFooter)) == sizeof(corruptFooter));
+    indexedFile.flush();
+    verifyScanned();
+}
+
 int main(int, const char**) {
     setupHifiApplication("Recording Test");
 
     testFrameTypeRegistration();
     testFilePersist();
     testClipOrdering();
+    testFileIndex();
+    testCorruptFileIndex();
 }
@@ -0,0 +1,190 @@
+//
+//  SpatialHashGridTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatialHashGridTests.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <SpatialHashGrid.h>
+
+QTEST_MAIN(SpatialHashGridTests)
+
+static const QString SCALE_TEST_COUNTS_ENV = "HIFI_SPATIAL_SCALE_TEST_COUNTS";
+
+// defaults of the avatar mixer's spatial index
+static const float NEIGHBORHOOD_RADIUS = 50.0f;
+static const size_t NUM_DISTANT_SAMPLES = 20;
+
+// one avatar per 20m x 20m, so crowds grow in area rather than in density
+static const float AREA_PER_AVATAR = 400.0f;
+
+static std::vector<SpatialHashGrid::Index> bruteForceFind(const std::vector<glm::vec3>& points,
+                                                          const glm::vec3& center, float radius) {
+    std::vector<SpatialHashGrid::Index> found;
+    for (size_t i = 0; i < points.size(); ++i) {
+        glm::vec3 offset = points[i] - center;
+        if (glm::dot(offset, offset) <= radius * radius) {
+            found.push_back((SpatialHashGrid::Index)i);
+        }
+    }
+    return found;
+}
+
+void SpatialHashGridTests::testFindInRadius() {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> coordinate(0.0f, 200.0f);
+
+    std::vector<glm::vec3> points;
+    SpatialHashGrid grid(10.0f);
+    for (int i = 0; i < 2000; ++i) {
+        points.emplace_back(coordinate(generator), coordinate(generator) * 0.05f, coordinate(generator));
+        grid.insert((SpatialHashGrid::Index)i, points.back());
+    }
+    grid.build();
+    QCOMPARE(grid.size(), points.size());
+
+    for (int i = 0; i < 100; ++i) {
+        glm::vec3 center(coordinate(generator), 0.0f, coordinate(generator));
+        float radius = coordinate(generator) * 0.2f;
+
+        std::vector<SpatialHashGrid::Index> found;
+        grid.findInRadius(center, radius, [&](SpatialHashGrid::Index index, const glm::vec3& position) {
+            QCOMPARE(position, points[index]);
+            found.push_back(index);
+        });
+        std::sort(found.begin(), found.end());
+
+        QCOMPARE(found, bruteForceFind(points, center, radius));
+    }
+}
+
+void SpatialHashGridTests::testNegativeCoordinates() {
+    SpatialHashGrid grid(5.0f);
+    grid.insert(0, glm::vec3(-0.5f, 0.0f, -0.5f));
+    grid.insert(1, glm::vec3(0.5f, 0.0f, 0.5f));
+    grid.insert(2, glm::vec3(-12.0f, -3.0f, 7.0f));
+    grid.insert(3, glm::vec3(-100.0f, 0.0f, 0.0f));
+    grid.build();
+
+    std::vector<SpatialHashGrid::Index> found;
+    grid.findInRadius(glm::vec3(-6.0f, 0.0f, 3.0f), 10.0f, [&](SpatialHashGrid::Index index, const glm::vec3&) {
+        found.push_back(index);
+    });
+    std::sort(found.begin(), found.end());
+
+    QCOMPARE(found, std::vector<SpatialHashGrid::Index>({ 0, 1, 2 }));
+}
+
+void SpatialHashGridTests::testSelectCandidates() {
+    SpatialHashGrid grid(10.0f);
+    std::vector<SpatialHashGrid::Index> all;
+    for (int i = 0; i < 10; ++i) {
+        grid.insert((SpatialHashGrid::Index)i, glm::vec3(i * 10.0f, 0.0f, 0.0f));
+        all.push_back((SpatialHashGrid::Index)i);
+    }
+    grid.build();
+
+    std::vector<SpatialHashGrid::Index> heroes { 9 };
+    std::vector<SpatialHashGrid::Index> candidates;
+    size_t cursor = 0;
+
+    // neighbors of 0 are 0 and 1, samples are 0 to 2, and the hero is always in
+    grid.selectCandidates(glm::vec3(0.0f), 10.0f, heroes, all, 3, cursor, candidates);
+    QCOMPARE(candidates, std::vector<SpatialHashGrid::Index>({ 0, 1, 2, 9 }));
+    QCOMPARE(cursor, (size_t)3);
+
+    // the samples wrap around the end of the sampled points
+    cursor = 8;
+    grid.selectCandidates(glm::vec3(50.0f, 0.0f, 0.0f), 5.0f, heroes, all, 3, cursor, candidates);
+    QCOMPARE(candidates, std::vector<SpatialHashGrid::Index>({ 0, 5, 8, 9 }));
+    QCOMPARE(cursor, (size_t)1);
+
+    // every point is sampled within size / samples calls
+    std::set<SpatialHashGrid::Index> visited;
+    cursor = 0;
+    for (int i = 0; i < 4; ++i) {
+        grid.selectCandidates(glm::vec3(-100.0f), 1.0f, {}, all, 3, cursor, candidates);
+        QVERIFY(std::is_sorted(candidates.begin(), candidates.end()));
+        visited.insert(candidates.begin(), candidates.end());
+    }
+    QCOMPARE(visited.size(), all.size());
+
+    // more samples than points selects each once
+    grid.selectCandidates(glm::vec3(-100.0f), 1.0f, {}, all, 25, cursor, candidates);
+    QCOMPARE(candidates, all);
+}
+
+void SpatialHashGridTests::testCandidateScaling() {
+    std::vector<int> counts { 50, 500, 5000 };
+
+    auto environment = QProcessEnvironment::systemEnvironment();
+    if (environment.contains(SCALE_TEST_COUNTS_ENV)) {
+        counts.clear();
+        for (const auto& count : environment.value(SCALE_TEST_COUNTS_ENV).split(',', QString::SkipEmptyParts)) {
+            counts.push_back(std::max(count.toInt(), 2));
+        }
+        std::sort(counts.begin(), counts.end());
+    }
+
+    std::mt19937 generator(1);
+    std::vector<double> work;
+
+    for (int count : counts) {
+        float side = sqrtf(count * AREA_PER_AVATAR);
+        std::uniform_real_distribution<float> coordinate(0.0f, side);
+
+        std::vector<glm::vec3> positions;
+        for (int i = 0; i < count; ++i) {
+            positions.emplace_back(coordinate(generator), 0.0f, coordinate(generator));
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+
+        SpatialHashGrid grid(NEIGHBORHOOD_RADIUS);
+        std::vector<SpatialHashGrid::Index> avatars;
+        for (int i = 0; i < count; ++i) {
+            grid.insert((SpatialHashGrid::Index)i, positions[i]);
+            avatars.push_back((SpatialHashGrid::Index)i);
+        }
+        grid.build();
+
+        std::vector<SpatialHashGrid::Index> noHeroes;
+        std::vector<SpatialHashGrid::Index> candidates;
+        size_t cursor = 0;
+        uint64_t numCandidates = 0;
+        for (int listener = 0; listener < count; ++listener) {
+            grid.selectCandidates(positions[listener], NEIGHBORHOOD_RADIUS, noHeroes, avatars, NUM_DISTANT_SAMPLES,
+                                  cursor, candidates);
+            numCandidates += candidates.size();
+        }
+
+        qint64 elapsed = timer.nsecsElapsed();
+        qDebug() << count << "avatars:" << numCandidates << "candidates,"
+            << (double)numCandidates / count << "per listener, against" << (uint64_t)count * (count - 1)
+            << "when sorting all of them -" << elapsed / 1000 << "us";
+
+        work.push_back((double)numCandidates);
+    }
+
+    // quadratic growth would have an exponent of 2, the candidates per listener are bounded by the crowd density
+    const double MAX_GROWTH_EXPONENT = 1.5;
+    for (size_t i = 1; i < counts.size(); ++i) {
+        if (counts[i] == counts[i - 1]) {
+            continue;
+        }
+        double exponent = log(work[i] / work[i - 1]) / log((double)counts[i] / counts[i - 1]);
+        qDebug() << "work grows as avatars ^" << exponent << "from" << counts[i - 1] << "to" << counts[i];
+        QVERIFY(exponent < MAX_GROWTH_EXPONENT);
+    }
+}
@@ -0,0 +1,30 @@
+//
+//  SpatialHashGridTests.h
+//  tests/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SpatialHashGridTests_h
+#define hifi_SpatialHashGridTests_h
+
+#include <QtTest/QtTest>
+
+class SpatialHashGridTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testFindInRadius();
+    void testNegativeCoordinates();
+    void testSelectCandidates();
+
+    // Selects avatar mixer sort candidates (neighbors within a radius plus a fixed number of distant samples) for
+    // every listener in crowds of growing size at constant density, and checks the work grows sub-quadratically.
+    // The crowd sizes can be set with HIFI_SPATIAL_SCALE_TEST_COUNTS, e.g. "100,1000,10000".
+    void testCandidateScaling();
+};
+
+#endif // hifi_SpatialHashGridTests_h
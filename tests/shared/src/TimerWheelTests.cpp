@@ -0,0 +1,298 @@
+//
+//  TimerWheelTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheelTests.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <QtCore/QTimer>
+
+#include <TimerWheel.h>
+
+QTEST_MAIN(TimerWheelTests)
+
+using TimerID = TimerWheel::TimerID;
+
+static const QString TIMER_WHEEL_BENCHMARK_TIMERS_ENV = "HIFI_TIMER_WHEEL_BENCHMARK_TIMERS";
+
+void TimerWheelTests::testExpiresInOrder() {
+    TimerWheel wheel(1000);
+    TimerID late = wheel.add(1000 + 70000, 0, true);
+    TimerID soon = wheel.add(1000 + 5, 0, true);
+    TimerID later = wheel.add(1000 + 300, 0, true);
+    TimerID now = wheel.add(1000, 0, true);
+    QCOMPARE(wheel.getNumTimers(), (size_t)4);
+
+    quint64 nextExpiry;
+    QVERIFY(wheel.getNextExpiry(nextExpiry));
+    QCOMPARE(nextExpiry, (quint64)1001);
+
+    std::vector<TimerID> expired;
+    wheel.advance(1004, expired);
+    QCOMPARE(expired, std::vector<TimerID>({ now }));
+
+    expired.clear();
+    wheel.advance(1000 + 100000, expired);
+    QCOMPARE(expired, std::vector<TimerID>({ soon, later, late }));
+    QVERIFY(wheel.isEmpty());
+    QVERIFY(!wheel.getNextExpiry(nextExpiry));
+}
+
+void TimerWheelTests::testIntervals() {
+    TimerWheel wheel;
+    TimerID interval = wheel.add(10, 10, false);
+
+    std::vector<TimerID> expired;
+    for (quint64 time = 1; time <= 100; ++time) {
+        wheel.advance(time, expired);
+    }
+    QCOMPARE(expired.size(), (size_t)10);
+    QVERIFY(wheel.contains(interval));
+
+    // falling behind expires the timer once, and starts over from there
+    expired.clear();
+    wheel.advance(1000, expired);
+    QCOMPARE(expired.size(), (size_t)1);
+    quint64 nextExpiry;
+    QVERIFY(wheel.getNextExpiry(nextExpiry));
+    QCOMPARE(nextExpiry, (quint64)1010);
+}
+
+void TimerWheelTests::testRemove() {
+    TimerWheel wheel;
+    QUuid entity = QUuid::createUuid();
+    QUuid otherEntity = QUuid::createUuid();
+
+    TimerID first = wheel.add(10, 0, true, entity);
+    TimerID second = wheel.add(20, 20, false, entity);
+    TimerID other = wheel.add(30, 0, true, otherEntity);
+    TimerID script = wheel.add(40, 0, true);
+
+    QVERIFY(wheel.remove(first));
+    QVERIFY(!wheel.remove(first));
+    QVERIFY(!wheel.contains(first));
+
+    // the slot gets reused by a new timer, which old IDs don't reach
+    TimerID reused = wheel.add(50, 0, true, entity);
+    QVERIFY(reused != first);
+    QVERIFY(!wheel.remove(first));
+
+    std::vector<TimerID> removed;
+    wheel.removeOwner(entity, removed);
+    std::sort(removed.begin(), removed.end());
+    std::vector<TimerID> expected({ second, reused });
+    std::sort(expected.begin(), expected.end());
+    QCOMPARE(removed, expected);
+
+    std::vector<TimerID> expired;
+    wheel.advance(100, expired);
+    QCOMPARE(expired, std::vector<TimerID>({ other, script }));
+    QVERIFY(wheel.isEmpty());
+}
+
+void TimerWheelTests::testMatchesReference() {
+    struct Timer {
+        quint64 expiry;
+        quint32 interval;
+        bool isSingleShot;
+        int owner;
+    };
+
+    std::mt19937 generator(7);
+    std::vector<QUuid> owners;
+    for (int i = 0; i < 16; ++i) {
+        owners.push_back(QUuid::createUuid());
+    }
+
+    quint64 now = 5000;
+    TimerWheel wheel(now);
+    std::map<TimerID, Timer> timers;
+
+    for (int step = 0; step < 50000; ++step) {
+        int operation = generator() % 10;
+        if (operation < 4) {
+            // mostly short timers, some crossing the higher levels of the wheel
+            quint64 delay = generator() % 4 == 0 ? generator() % 300000 : generator() % 600;
+            Timer timer { now + delay, (quint32)(generator() % 500), generator() % 2 == 0, (int)(generator() % owners.size()) };
+            TimerID timerID = wheel.add(timer.expiry, timer.interval, timer.isSingleShot, owners[timer.owner]);
+            timer.expiry = std::max(timer.expiry, now + 1);
+            timers[timerID] = timer;
+        } else if (operation == 4 && !timers.empty()) {
+            auto it = timers.begin();
+            std::advance(it, generator() % timers.size());
+            QVERIFY(wheel.remove(it->first));
+            timers.erase(it);
+        } else if (operation == 5 && generator() % 20 == 0) {
+            int owner = generator() % owners.size();
+            std::vector<TimerID> removed;
+            wheel.removeOwner(owners[owner], removed);
+            std::set<TimerID> expected;
+            for (auto it = timers.begin(); it != timers.end();) {
+                if (it->second.owner == owner) {
+                    expected.insert(it->first);
+                    it = timers.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            QCOMPARE(std::set<TimerID>(removed.begin(), removed.end()), expected);
+        } else {
+            quint64 target = now + (generator() % 30 == 0 ? generator() % 200000 : generator() % 40);
+
+            quint64 nextExpiry;
+            if (wheel.getNextExpiry(nextExpiry)) {
+                quint64 earliest = std::numeric_limits<quint64>::max();
+                for (const auto& timer : timers) {
+                    earliest = std::min(earliest, timer.second.expiry);
+                }
+                QVERIFY(nextExpiry <= earliest);
+            }
+
+            std::vector<TimerID> expired;
+            wheel.advance(target, expired);
+
+            std::multiset<TimerID> expected;
+            for (auto it = timers.begin(); it != timers.end();) {
+                Timer& timer = it->second;
+                if (timer.expiry <= target) {
+                    expected.insert(it->first);
+                    if (timer.isSingleShot) {
+                        it = timers.erase(it);
+                        continue;
+                    }
+                    quint32 interval = std::max(timer.interval, (quint32)1);
+                    timer.expiry += interval;
+                    if (timer.expiry <= target) {
+                        timer.expiry = target + interval;
+                    }
+                }
+                ++it;
+            }
+            QCOMPARE(std::multiset<TimerID>(expired.begin(), expired.end()), expected);
+            now = target;
+        }
+        QCOMPARE(wheel.getNumTimers(), timers.size());
+    }
+}
+
+void TimerWheelTests::benchmarkTimers() {
+    int numTimers = 50000;
+    auto environment = QProcessEnvironment::systemEnvironment();
+    if (environment.contains(TIMER_WHEEL_BENCHMARK_TIMERS_ENV)) {
+        numTimers = std::max(environment.value(TIMER_WHEEL_BENCHMARK_TIMERS_ENV).toInt(), 1);
+    }
+
+    // ten timers per entity script, half of them intervals, over the frames of a few seconds
+    const int TIMERS_PER_ENTITY = 10;
+    const quint64 NUM_FRAMES = 300;
+    const quint64 MSECS_PER_FRAME = 16;
+
+    std::vector<QUuid> entities;
+    for (int i = 0; i < (numTimers + TIMERS_PER_ENTITY - 1) / TIMERS_PER_ENTITY; ++i) {
+        entities.push_back(QUuid::createUuid());
+    }
+    std::vector<quint32> delays;
+    std::mt19937 generator(42);
+    for (int i = 0; i < numTimers; ++i) {
+        delays.push_back(10 + generator() % 5000);
+    }
+
+    qint64 wheelAddNsecs;
+    qint64 wheelRunNsecs;
+    qint64 wheelTeardownNsecs;
+    size_t numExpired = 0;
+    {
+        TimerWheel wheel;
+        QHash<TimerID, QUuid> callbacks;
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < numTimers; ++i) {
+            const QUuid& entity = entities[i / TIMERS_PER_ENTITY];
+            callbacks.insert(wheel.add(delays[i], delays[i], i % 2 == 0, entity), entity);
+        }
+        wheelAddNsecs = timer.nsecsElapsed();
+
+        timer.restart();
+        std::vector<TimerID> expired;
+        for (quint64 frame = 1; frame <= NUM_FRAMES; ++frame) {
+            wheel.advance(frame * MSECS_PER_FRAME, expired);
+            for (auto timerID : expired) {
+                if (!wheel.contains(timerID)) {
+                    callbacks.remove(timerID);
+                }
+            }
+            numExpired += expired.size();
+            expired.clear();
+        }
+        wheelRunNsecs = timer.nsecsElapsed();
+
+        timer.restart();
+        std::vector<TimerID> removed;
+        for (const auto& entity : entities) {
+            removed.clear();
+            wheel.removeOwner(entity, removed);
+            for (auto timerID : removed) {
+                callbacks.remove(timerID);
+            }
+        }
+        wheelTeardownNsecs = timer.nsecsElapsed();
+
+        QVERIFY(wheel.isEmpty());
+        QVERIFY(callbacks.isEmpty());
+    }
+    QVERIFY(numExpired > 0);
+
+    qint64 qtimerAddNsecs;
+    qint64 qtimerTeardownNsecs;
+    {
+        QHash<QTimer*, QUuid> callbacks;
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < numTimers; ++i) {
+            QTimer* qtimer = new QTimer();
+            qtimer->setSingleShot(i % 2 == 0);
+            qtimer->start(delays[i]);
+            callbacks.insert(qtimer, entities[i / TIMERS_PER_ENTITY]);
+        }
+        qtimerAddNsecs = timer.nsecsElapsed();
+
+        // unloading each entity script scanned all the timers of the engine
+        timer.restart();
+        for (const auto& entity : entities) {
+            QVector<QTimer*> toDelete;
+            for (auto it = callbacks.begin(); it != callbacks.end(); ++it) {
+                if (it.value() == entity) {
+                    toDelete << it.key();
+                }
+            }
+            for (auto qtimer : toDelete) {
+                qtimer->stop();
+                callbacks.remove(qtimer);
+                delete qtimer;
+            }
+        }
+        qtimerTeardownNsecs = timer.nsecsElapsed();
+
+        QVERIFY(callbacks.isEmpty());
+    }
+
+    qDebug() << numTimers << "timers on" << entities.size() << "entities:"
+        << "wheel add" << wheelAddNsecs / 1000000.0 << "ms, run" << NUM_FRAMES << "frames"
+        << wheelRunNsecs / 1000000.0 << "ms (" << numExpired << "expiries), teardown"
+        << wheelTeardownNsecs / 1000000.0 << "ms; QTimer add" << qtimerAddNsecs / 1000000.0 << "ms, teardown"
+        << qtimerTeardownNsecs / 1000000.0 << "ms";
+}
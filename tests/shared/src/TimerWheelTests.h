@@ -0,0 +1,31 @@
+//
+//  TimerWheelTests.h
+//  tests/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TimerWheelTests_h
+#define hifi_TimerWheelTests_h
+
+#include <QtTest/QtTest>
+
+class TimerWheelTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testExpiresInOrder();
+    void testIntervals();
+    void testRemove();
+    void testMatchesReference();
+
+    // Creates timers spread over the entity scripts of an engine, runs them for a while and tears the scripts down, on
+    // the wheel and on the QTimer per timer the script engine used before. The number of timers can be set with
+    // HIFI_TIMER_WHEEL_BENCHMARK_TIMERS.
+    void benchmarkTimers();
+};
+
+#endif // hifi_TimerWheelTests_h
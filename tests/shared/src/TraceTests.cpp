@@ -8,8 +8,15 @@
 
 #include "TraceTests.h"
 
+#include <atomic>
+#include <thread>
+
 #include <QtTest/QtTest>
 #include <QtGui/QDesktopServices>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
 
 #include <Profile.h>
 
@@ -45,3 +52,154 @@ void TraceTests::testTraceSerialization() {
     qDebug() << "Done";
 }
 
+
+void TraceTests::testBinaryTraceConversion() {
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    // metadata is kept even when it's recorded before tracing starts
+    PROFILE_SET_THREAD_NAME("TraceTestThread")
+    tracer->startTracing();
+    {
+        PROFILE_RANGE_EX(test, "BinaryEvent", 0xff00ff00, 42)
+        for (int i = 0; i < 100; ++i) {
+            PROFILE_COUNTER(test, "BinaryCounter", { { "i", i } })
+        }
+        // numeric arguments are kept inline up to MAX_INLINE_ARGS, the others go with the payload
+        PROFILE_COUNTER(test, "BinaryCpu", { { "system", 0.25 }, { "user", 0.5 } })
+        PROFILE_COUNTER(test, "BinaryMany", { { "a", 1 }, { "b", 2 }, { "c", 3 } })
+        PROFILE_INSTANT(test, "BinaryInstant", "t", { { "text", "value" } })
+        PROFILE_ASYNC_BEGIN(test, "BinaryAsync", "request-1")
+    }
+    tracer->stopTracing();
+    // not part of the trace
+    PROFILE_COUNTER(test, "BinaryCounter", { { "i", -1 } })
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString binaryFile = dir.filePath("testTrace" + tracing::Tracer::BINARY_TRACE_EXTENSION);
+    QString jsonFile = dir.filePath("testTrace.json");
+    tracer->serialize(binaryFile);
+    QVERIFY(tracing::Tracer::convertToJson(binaryFile, jsonFile));
+
+    QFile file(jsonFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    QJsonArray events = QJsonDocument::fromJson(file.readAll(), &error).array();
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    int counters = 0;
+    bool hasBegin = false, hasEnd = false, hasInstant = false, hasAsync = false, hasThreadName = false;
+    bool hasCpu = false, hasMany = false;
+    for (const auto& value : events) {
+        QJsonObject event = value.toObject();
+        QString name = event["name"].toString();
+        QString type = event["ph"].toString();
+        if (name == "BinaryCounter") {
+            QCOMPARE(event["cat"].toString(), QString("trace.test"));
+            QCOMPARE(event["args"].toObject()["i"].toInt(), counters);
+            counters++;
+        } else if (name == "BinaryCpu") {
+            QCOMPARE(event["args"].toObject()["system"].toDouble(), 0.25);
+            QCOMPARE(event["args"].toObject()["user"].toDouble(), 0.5);
+            hasCpu = true;
+        } else if (name == "BinaryMany") {
+            QCOMPARE(event["args"].toObject()["a"].toInt(), 1);
+            QCOMPARE(event["args"].toObject()["c"].toInt(), 3);
+            hasMany = true;
+        } else if (name == "BinaryEvent" && type == "B") {
+            QCOMPARE(event["args"].toObject()["nv_payload"].toInt(), 42);
+            hasBegin = true;
+        } else if (name == "BinaryEvent" && type == "E") {
+            hasEnd = true;
+        } else if (name == "BinaryInstant") {
+            QCOMPARE(event["args"].toObject()["text"].toString(), QString("value"));
+            QCOMPARE(event["s"].toString(), QString("t"));
+            hasInstant = true;
+        } else if (name == "BinaryAsync") {
+            QCOMPARE(event["id"].toString(), QString("request-1"));
+            hasAsync = true;
+        } else if (name == "thread_name") {
+            QCOMPARE(event["args"].toObject()["name"].toString(), QString("TraceTestThread"));
+            hasThreadName = true;
+        }
+    }
+    QCOMPARE(counters, 100);
+    QVERIFY(hasBegin && hasEnd && hasInstant && hasAsync && hasThreadName);
+    QVERIFY(hasCpu && hasMany);
+}
+
+void TraceTests::testExitedThreadEvents() {
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startTracing();
+    // the ring buffers of the thread are freed when it exits, its events are kept apart
+    std::thread thread([] {
+        for (int i = 0; i < 10; ++i) {
+            PROFILE_COUNTER(test, "ExitedCounter", { { "i", i } })
+        }
+    });
+    thread.join();
+    PROFILE_COUNTER(test, "MainCounter", { { "i", 0 } })
+    tracer->stopTracing();
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString binaryFile = dir.filePath("testTrace" + tracing::Tracer::BINARY_TRACE_EXTENSION);
+    QString jsonFile = dir.filePath("testTrace.json");
+    tracer->serialize(binaryFile);
+    QVERIFY(tracing::Tracer::convertToJson(binaryFile, jsonFile));
+
+    QFile file(jsonFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QJsonArray events = QJsonDocument::fromJson(file.readAll()).array();
+    int exitedCounters = 0, mainCounters = 0;
+    qint64 exitedThreadID = 0, mainThreadID = 0;
+    for (const auto& value : events) {
+        QJsonObject event = value.toObject();
+        if (event["name"].toString() == "ExitedCounter") {
+            QCOMPARE(event["args"].toObject()["i"].toInt(), exitedCounters);
+            exitedThreadID = (qint64)event["tid"].toDouble();
+            exitedCounters++;
+        } else if (event["name"].toString() == "MainCounter") {
+            mainThreadID = (qint64)event["tid"].toDouble();
+            mainCounters++;
+        }
+    }
+    QCOMPARE(exitedCounters, 10);
+    QCOMPARE(mainCounters, 1);
+    QVERIFY(exitedThreadID != mainThreadID);
+
+    // a new trace doesn't hold the events of the threads that exited during the previous one
+    tracer->startTracing();
+    tracer->stopTracing();
+    tracer->serialize(binaryFile);
+    QVERIFY(tracing::Tracer::convertToJson(binaryFile, jsonFile));
+    QFile secondFile(jsonFile);
+    QVERIFY(secondFile.open(QIODevice::ReadOnly));
+    QVERIFY(!secondFile.readAll().contains("ExitedCounter"));
+}
+
+void TraceTests::testDestroyWhileTracing() {
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startTracing();
+    std::atomic<bool> stop { false };
+    std::atomic<int> eventCount { 0 };
+    std::thread thread([&] {
+        while (!stop) {
+            PROFILE_COUNTER(test, "DestroyCounter", { { "i", 0 } })
+            eventCount++;
+        }
+    });
+    while (eventCount < 1000) {
+        std::this_thread::yield();
+    }
+
+    // the tracer is destroyed while the thread records events, its destructor waits for the one being recorded
+    tracer.reset();
+    DependencyManager::destroy<tracing::Tracer>();
+    QVERIFY(!tracing::enabled());
+    int countAfterDestroy = eventCount;
+    while (eventCount < countAfterDestroy + 1000) {
+        std::this_thread::yield();
+    }
+    stop = true;
+    thread.join();
+}
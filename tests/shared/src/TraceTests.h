@@ -15,6 +15,9 @@ class TraceTests : public QObject {
     Q_OBJECT
 private slots:
     void testTraceSerialization();
+    void testBinaryTraceConversion();
+    void testExitedThreadEvents();
+    void testDestroyWhileTracing();
 };
 
 #endif // hifi_TraceTests_h
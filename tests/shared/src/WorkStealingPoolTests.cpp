@@ -0,0 +1,270 @@
+//
+//  WorkStealingPoolTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkStealingPoolTests.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include <WorkStealingPool.h>
+
+QTEST_MAIN(WorkStealingPoolTests)
+
+static const QString WAKE_UP_BENCHMARK_FRAMES_ENV = "HIFI_WAKE_UP_BENCHMARK_FRAMES";
+
+// the nodes of a frame, as handed to the mixers' slave pools
+static const size_t NUM_BENCHMARK_ITEMS = 64;
+
+namespace {
+
+// The mixers' previous slave pool: every thread is woken each frame, and pops items from a shared queue.
+class BarrierPool {
+public:
+    BarrierPool(int numThreads) : _numThreads(numThreads), _numStarted(numThreads), _numFinished(numThreads) {
+        for (int i = 0; i < numThreads; ++i) {
+            _threads.emplace_back([this] { runThread(); });
+        }
+    }
+
+    ~BarrierPool() {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _stop = true;
+            _numStarted = 0;
+        }
+        _threadCondition.notify_all();
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+    }
+
+    void run(size_t numItems, const std::function<void(size_t)>& function) {
+        for (size_t i = 0; i < numItems; ++i) {
+            std::unique_lock<std::mutex> lock(_queueMutex);
+            _queue.push(i);
+        }
+        _function = &function;
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _numStarted = _numFinished = 0;
+        _threadCondition.notify_all();
+        _poolCondition.wait(lock, [&] {
+            return _numFinished == _numThreads;
+        });
+    }
+
+private:
+    void runThread() {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _threadCondition.wait(lock, [&] {
+                    return _numStarted != _numThreads;
+                });
+                ++_numStarted;
+                if (_stop) {
+                    return;
+                }
+            }
+
+            while (true) {
+                size_t item;
+                {
+                    std::unique_lock<std::mutex> lock(_queueMutex);
+                    if (_queue.empty()) {
+                        break;
+                    }
+                    item = _queue.front();
+                    _queue.pop();
+                }
+                (*_function)(item);
+            }
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                ++_numFinished;
+            }
+            _poolCondition.notify_one();
+        }
+    }
+
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _threadCondition;
+    std::condition_variable _poolCondition;
+    int _numThreads;
+    int _numStarted;
+    int _numFinished;
+    bool _stop { false };
+
+    std::mutex _queueMutex;
+    std::queue<size_t> _queue;
+    const std::function<void(size_t)>* _function { nullptr };
+};
+
+}
+
+void WorkStealingPoolTests::testRunsEveryItemOnce() {
+    for (int numWorkers : { 1, 2, 3, 8 }) {
+        WorkStealingPool pool("test", numWorkers);
+
+        for (size_t numItems : { 0, 1, 7, 100, 4099 }) {
+            for (size_t chunkSize : { 0, 1, 5 }) {
+                std::vector<std::atomic<int>> counts(numItems);
+                for (auto& count : counts) {
+                    count = 0;
+                }
+                std::vector<int> numBegins(numWorkers, 0);
+                std::vector<int> numEnds(numWorkers, 0);
+                std::atomic<int> numErrors { 0 };
+
+                WorkStealingPool::Job job;
+                job.numItems = numItems;
+                job.chunkSize = chunkSize;
+                job.begin = [&](int worker) {
+                    ++numBegins[worker];
+                };
+                job.run = [&](int worker, size_t begin, size_t end) {
+                    if (numBegins[worker] != 1 || numEnds[worker] != 0) {
+                        ++numErrors;
+                    }
+                    for (size_t i = begin; i < end; ++i) {
+                        ++counts[i];
+                    }
+                };
+                job.end = [&](int worker) {
+                    ++numEnds[worker];
+                };
+                pool.run(job);
+
+                QCOMPARE(numErrors.load(), 0);
+                for (size_t i = 0; i < numItems; ++i) {
+                    QCOMPARE(counts[i].load(), 1);
+                }
+                for (int i = 0; i < numWorkers; ++i) {
+                    QVERIFY(numBegins[i] <= 1);
+                    QCOMPARE(numBegins[i], numEnds[i]);
+                }
+            }
+        }
+    }
+}
+
+void WorkStealingPoolTests::testStealsFromBusyWorkers() {
+    const int NUM_WORKERS = 4;
+    WorkStealingPool pool("test", NUM_WORKERS);
+
+    // the first share of items is much slower than the rest, so the other workers have to take some of it
+    const size_t NUM_ITEMS = 400;
+    std::atomic<size_t> numItemsRun { 0 };
+
+    WorkStealingPool::Job job;
+    job.numItems = NUM_ITEMS;
+    job.chunkSize = 1;
+    job.run = [&](int worker, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (i < NUM_ITEMS / NUM_WORKERS) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            ++numItemsRun;
+        }
+    };
+    pool.run(job);
+
+    QCOMPARE(numItemsRun.load(), NUM_ITEMS);
+
+    uint32_t numSteals = 0;
+    uint32_t numChunks = 0;
+    for (int i = 0; i < NUM_WORKERS; ++i) {
+        numSteals += pool.getWorkerStats(i).numSteals;
+        numChunks += pool.getWorkerStats(i).numChunks;
+    }
+    QCOMPARE(numChunks, (uint32_t)NUM_ITEMS);
+    QVERIFY(numSteals > 0);
+}
+
+void WorkStealingPoolTests::testResize() {
+    WorkStealingPool pool("test", 4);
+
+    for (int numWorkers : { 2, 6, 1, 3 }) {
+        pool.setNumWorkers(numWorkers);
+        QCOMPARE(pool.getNumWorkers(), numWorkers);
+
+        std::atomic<size_t> numItemsRun { 0 };
+        std::atomic<int> maxWorker { 0 };
+        WorkStealingPool::Job job;
+        job.numItems = 1000;
+        job.run = [&](int worker, size_t begin, size_t end) {
+            numItemsRun += end - begin;
+            int previous = maxWorker.load();
+            while (worker > previous && !maxWorker.compare_exchange_weak(previous, worker)) {}
+        };
+        pool.run(job);
+
+        QCOMPARE(numItemsRun.load(), (size_t)1000);
+        QVERIFY(maxWorker.load() < numWorkers);
+    }
+}
+
+void WorkStealingPoolTests::benchmarkWakeUpLatency() {
+    int numFrames = 2000;
+    auto environment = QProcessEnvironment::systemEnvironment();
+    if (environment.contains(WAKE_UP_BENCHMARK_FRAMES_ENV)) {
+        numFrames = std::max(environment.value(WAKE_UP_BENCHMARK_FRAMES_ENV).toInt(), 1);
+    }
+
+    int maxThreads = std::max(2, std::min(QThread::idealThreadCount(), 8));
+
+    for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        std::atomic<size_t> numItemsRun { 0 };
+
+        qint64 barrierNsecs;
+        {
+            BarrierPool pool(numThreads);
+            std::function<void(size_t)> function = [&](size_t) {
+                ++numItemsRun;
+            };
+
+            QElapsedTimer timer;
+            timer.start();
+            for (int frame = 0; frame < numFrames; ++frame) {
+                pool.run(NUM_BENCHMARK_ITEMS, function);
+            }
+            barrierNsecs = timer.nsecsElapsed();
+        }
+
+        qint64 stealingNsecs;
+        {
+            WorkStealingPool pool("benchmark", numThreads);
+            WorkStealingPool::Job job;
+            job.numItems = NUM_BENCHMARK_ITEMS;
+            job.run = [&](int worker, size_t begin, size_t end) {
+                numItemsRun += end - begin;
+            };
+
+            QElapsedTimer timer;
+            timer.start();
+            for (int frame = 0; frame < numFrames; ++frame) {
+                pool.run(job);
+            }
+            stealingNsecs = timer.nsecsElapsed();
+        }
+
+        QCOMPARE(numItemsRun.load(), 2 * numFrames * NUM_BENCHMARK_ITEMS);
+
+        qDebug() << numThreads << "threads:" << barrierNsecs / 1000.0 / numFrames << "us per frame with a barrier pool,"
+            << stealingNsecs / 1000.0 / numFrames << "us per frame with the work stealing pool";
+    }
+}
@@ -0,0 +1,30 @@
+//
+//  WorkStealingPoolTests.h
+//  tests/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_WorkStealingPoolTests_h
+#define hifi_WorkStealingPoolTests_h
+
+#include <QtTest/QtTest>
+
+class WorkStealingPoolTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRunsEveryItemOnce();
+    void testStealsFromBusyWorkers();
+    void testResize();
+
+    // Times frames of near-empty work on the pool against the mixers' previous slave pools, which woke every thread
+    // through a condition variable and handed out nodes from a shared queue. The number of frames can be set with
+    // HIFI_WAKE_UP_BENCHMARK_FRAMES.
+    void benchmarkWakeUpLatency();
+};
+
+#endif // hifi_WorkStealingPoolTests_h
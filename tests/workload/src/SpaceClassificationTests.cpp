@@ -0,0 +1,220 @@
+//
+//  SpaceClassificationTests.cpp
+//  tests/workload/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpaceClassificationTests.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <glm/gtx/norm.hpp>
+
+#include <workload/Space.h>
+
+QTEST_MAIN(SpaceClassificationTests)
+
+using namespace workload;
+
+static const QString CLASSIFICATION_BENCHMARK_PROXIES_ENV = "HIFI_CLASSIFICATION_BENCHMARK_PROXIES";
+
+static const float WORLD_SIZE = 400.0f;
+static const float MAX_PROXY_RADIUS = 4.0f;
+
+// the kernels may fuse multiply-adds, so proxies this close to a region boundary could legitimately go either way
+static const float BOUNDARY_TOLERANCE = 1.0e-4f;
+
+namespace {
+
+Views makeViews(int numViews) {
+    Views views;
+    for (int i = 0; i < numViews; ++i) {
+        View view;
+        glm::vec3 origin(-50.0f + 100.0f * i, 0.0f, 20.0f * i);
+        view.regions[Region::R1] = Sphere(origin, 15.0f);
+        view.regions[Region::R2] = Sphere(origin, 40.0f);
+        view.regions[Region::R3] = Sphere(origin, 120.0f);
+        views.push_back(view);
+    }
+    return views;
+}
+
+bool isNearBoundary(const Sphere& proxy, const Views& views) {
+    for (const auto& view : views) {
+        for (uint32_t k = 0; k < Region::NUM_TRACKED_REGIONS; ++k) {
+            float touchDistance = proxy.w + view.regions[k].w;
+            float touchDistance2 = touchDistance * touchDistance;
+            float distance2 = glm::distance2(glm::vec3(proxy), glm::vec3(view.regions[k]));
+            if (fabsf(distance2 - touchDistance2) <= BOUNDARY_TOLERANCE * touchDistance2) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::vector<Sphere> makeProxies(size_t numProxies, const Views& views, std::mt19937& generator) {
+    std::uniform_real_distribution<float> position(-0.5f * WORLD_SIZE, 0.5f * WORLD_SIZE);
+    std::uniform_real_distribution<float> radius(0.0f, MAX_PROXY_RADIUS);
+
+    std::vector<Sphere> proxies;
+    proxies.reserve(numProxies);
+    while (proxies.size() < numProxies) {
+        Sphere proxy(position(generator), position(generator), position(generator), radius(generator));
+        if (!isNearBoundary(proxy, views)) {
+            proxies.push_back(proxy);
+        }
+    }
+    return proxies;
+}
+
+// the scalar array-of-structures loop Space used before the kernels, as the reference
+uint8_t classifyReference(const Sphere& proxy, const Views& views) {
+    glm::vec3 proxyCenter = glm::vec3(proxy);
+    float proxyRadius = proxy.w;
+    uint8_t region = Region::R4;
+    for (const auto& view : views) {
+        for (uint8_t k = 0; k < region; ++k) {
+            float touchDistance = proxyRadius + view.regions[k].w;
+            if (glm::distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
+                region = k;
+                break;
+            }
+        }
+    }
+    return region;
+}
+
+std::vector<ProxyID> addProxies(Space& space, const std::vector<Sphere>& proxies) {
+    std::vector<ProxyID> ids;
+    Transaction transaction;
+    for (const auto& proxy : proxies) {
+        ProxyID id = space.allocateID();
+        transaction.reset(id, proxy, Owner());
+        ids.push_back(id);
+    }
+    space.enqueueTransaction(std::move(transaction));
+    space.enqueueFrame();
+    space.processTransactionQueue();
+    return ids;
+}
+
+void verifyClassification(int numThreads) {
+    std::mt19937 generator(1234);
+    Views views = makeViews(2);
+
+    Space space;
+    space.setNumClassificationThreads(numThreads);
+    space.setViews(views);
+
+    // enough proxies for several chunks, and a count that isn't a multiple of the vector width
+    std::vector<Sphere> proxies = makeProxies(20011, views, generator);
+    std::vector<ProxyID> ids = addProxies(space, proxies);
+
+    std::vector<uint8_t> regions(proxies.size(), Region::UNKNOWN);
+    for (int frame = 0; frame < 3; ++frame) {
+        Changes changes;
+        space.categorizeAndGetChanges(changes);
+
+        size_t numExpectedChanges = 0;
+        for (size_t i = 0; i < proxies.size(); ++i) {
+            uint8_t expected = classifyReference(proxies[i], views);
+            QCOMPARE(space.getRegion(ids[i]), expected);
+            if (expected != regions[i]) {
+                ++numExpectedChanges;
+            }
+            regions[i] = expected;
+        }
+        QCOMPARE(changes.size(), numExpectedChanges);
+        for (const auto& change : changes) {
+            QCOMPARE(change.region, space.getRegion(change.proxyId));
+        }
+
+        // move half of the proxies, and take one away, for the next frame
+        std::vector<Sphere> moved = makeProxies(proxies.size() / 2, views, generator);
+        Transaction transaction;
+        for (size_t i = 0; i < moved.size(); ++i) {
+            proxies[2 * i] = moved[i];
+            transaction.update(ids[2 * i], moved[i]);
+        }
+        transaction.remove(ids.back());
+        ids.pop_back();
+        proxies.pop_back();
+        regions.pop_back();
+        space.enqueueTransaction(std::move(transaction));
+        space.enqueueFrame();
+        space.processTransactionQueue();
+    }
+}
+
+}
+
+void SpaceClassificationTests::testMatchesReference() {
+    verifyClassification(1);
+}
+
+void SpaceClassificationTests::testThreadedMatchesReference() {
+    verifyClassification(4);
+}
+
+void SpaceClassificationTests::benchmarkClassification() {
+    std::vector<size_t> proxyCounts { 10000, 50000, 200000 };
+    auto environment = QProcessEnvironment::systemEnvironment();
+    if (environment.contains(CLASSIFICATION_BENCHMARK_PROXIES_ENV)) {
+        proxyCounts = { (size_t)std::max(environment.value(CLASSIFICATION_BENCHMARK_PROXIES_ENV).toInt(), 1) };
+    }
+
+    const int NUM_FRAMES = 20;
+    int maxThreads = std::max(2, std::min(QThread::idealThreadCount(), 8));
+    std::mt19937 generator(5678);
+    Views views = makeViews(2);
+
+    for (size_t numProxies : proxyCounts) {
+        std::vector<Sphere> spheres = makeProxies(numProxies, views, generator);
+
+        // reference: the same work done the way Space used to, one proxy and one view at a time
+        Proxy::Vector proxies;
+        for (const auto& sphere : spheres) {
+            proxies.emplace_back(sphere);
+        }
+        size_t numReferenceChanges = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+            for (auto& proxy : proxies) {
+                proxy.prevRegion = proxy.region;
+                proxy.region = classifyReference(proxy.sphere, views);
+                if (proxy.region != proxy.prevRegion) {
+                    ++numReferenceChanges;
+                }
+            }
+        }
+        qint64 referenceNsecs = timer.nsecsElapsed();
+
+        for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+            Space space;
+            space.setNumClassificationThreads(numThreads);
+            space.setViews(views);
+            addProxies(space, spheres);
+
+            size_t numChanges = 0;
+            timer.restart();
+            for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+                Changes changes;
+                space.categorizeAndGetChanges(changes);
+                numChanges += changes.size();
+            }
+            qint64 nsecs = timer.nsecsElapsed();
+
+            QCOMPARE(numChanges, numReferenceChanges);
+            qDebug() << numProxies << "proxies," << numThreads << "threads:" << referenceNsecs / 1000.0 / NUM_FRAMES
+                << "us per frame with the scalar loop," << nsecs / 1000.0 / NUM_FRAMES << "us per frame with Space";
+        }
+    }
+}
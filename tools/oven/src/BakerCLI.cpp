@@ -18,6 +18,8 @@
 
 #include <unordered_map>
 
+#include <NumericalConstants.h>
+
 #include "OvenCLIApplication.h"
 #include "ModelBakingLoggingCategory.h"
 #include "baking/BakerLibrary.h"
@@ -25,16 +27,39 @@
 #include "TextureBaker.h"
 #include "MaterialBaker.h"
 
+static const std::unordered_map<QString, image::TextureUsage::Type> STRING_TO_TEXTURE_USAGE_TYPE_MAP {
+    { "default", image::TextureUsage::DEFAULT_TEXTURE },
+    { "strict", image::TextureUsage::STRICT_TEXTURE },
+    { "albedo", image::TextureUsage::ALBEDO_TEXTURE },
+    { "normal", image::TextureUsage::NORMAL_TEXTURE },
+    { "bump", image::TextureUsage::BUMP_TEXTURE },
+    { "specular", image::TextureUsage::SPECULAR_TEXTURE },
+    { "metallic", image::TextureUsage::METALLIC_TEXTURE },
+    { "roughness", image::TextureUsage::ROUGHNESS_TEXTURE },
+    { "gloss", image::TextureUsage::GLOSS_TEXTURE },
+    { "emissive", image::TextureUsage::EMISSIVE_TEXTURE },
+    { "cube", image::TextureUsage::SKY_TEXTURE },
+    { "skybox", image::TextureUsage::SKY_TEXTURE },
+    { "ambient", image::TextureUsage::AMBIENT_TEXTURE },
+    { "occlusion", image::TextureUsage::OCCLUSION_TEXTURE },
+    { "scattering", image::TextureUsage::SCATTERING_TEXTURE },
+    { "lightmap", image::TextureUsage::LIGHTMAP_TEXTURE },
+};
+
+static QUrl getInputUrl(const QUrl& inputUrl) {
+    // if the URL doesn't have a scheme, assume it is a local file
+    if (inputUrl.scheme() != "http" && inputUrl.scheme() != "https" && inputUrl.scheme() != "ftp" && inputUrl.scheme() != "file") {
+        return QUrl::fromLocalFile(inputUrl.toString());
+    }
+    return inputUrl;
+}
+
 BakerCLI::BakerCLI(OvenCLIApplication* parent) : QObject(parent) {
     
 }
 
 void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type) {
-
-    // if the URL doesn't have a scheme, assume it is a local file
-    if (inputUrl.scheme() != "http" && inputUrl.scheme() != "https" && inputUrl.scheme() != "ftp" && inputUrl.scheme() != "file") {
-        inputUrl = QUrl::fromLocalFile(inputUrl.toString());
-    }
+    inputUrl = getInputUrl(inputUrl);
 
     qDebug() << "Baking file type: " << type;
 
@@ -45,11 +70,28 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
 
     _outputPath = outputPath;
 
+    // the bake cache is keyed on the content of the input file
+    QByteArray inputContent;
+    if (_bakeCache.isEnabled() && inputUrl.isLocalFile()) {
+        QFile inputFile { inputUrl.toLocalFile() };
+        if (inputFile.open(QIODevice::ReadOnly)) {
+            inputContent = inputFile.readAll();
+        }
+    }
+    _bakeCacheKey.clear();
+
     // create our appropiate baker
     if (type == MODEL_EXTENSION || type == FBX_EXTENSION) {
         QUrl bakeableModelURL = getBakeableModelURL(inputUrl);
         if (!bakeableModelURL.isEmpty()) {
-            _baker = getModelBaker(bakeableModelURL, outputPath);
+            if (!inputContent.isEmpty()) {
+                _bakeCacheKey = OvenBakeCache::getModelKey(bakeableModelURL, inputContent);
+            }
+            auto modelBaker = getModelBaker(bakeableModelURL, outputPath);
+            if (modelBaker) {
+                modelBaker->setSourceContent(inputContent);
+            }
+            _baker = std::move(modelBaker);
             if (_baker) {
                 _baker->moveToThread(Oven::instance().getNextWorkerThread());
             }
@@ -69,31 +111,15 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
         auto extension = idx >= 0 ? url.mid(idx + 1).toLower() : "";
 
         if (QImageReader::supportedImageFormats().contains(extension.toLatin1())) {
-            static const std::unordered_map<QString, image::TextureUsage::Type> STRING_TO_TEXTURE_USAGE_TYPE_MAP {
-                { "default", image::TextureUsage::DEFAULT_TEXTURE },
-                { "strict", image::TextureUsage::STRICT_TEXTURE },
-                { "albedo", image::TextureUsage::ALBEDO_TEXTURE },
-                { "normal", image::TextureUsage::NORMAL_TEXTURE },
-                { "bump", image::TextureUsage::BUMP_TEXTURE },
-                { "specular", image::TextureUsage::SPECULAR_TEXTURE },
-                { "metallic", image::TextureUsage::METALLIC_TEXTURE },
-                { "roughness", image::TextureUsage::ROUGHNESS_TEXTURE },
-                { "gloss", image::TextureUsage::GLOSS_TEXTURE },
-                { "emissive", image::TextureUsage::EMISSIVE_TEXTURE },
-                { "cube", image::TextureUsage::SKY_TEXTURE },
-                { "skybox", image::TextureUsage::SKY_TEXTURE },
-                { "ambient", image::TextureUsage::AMBIENT_TEXTURE },
-                { "occlusion", image::TextureUsage::OCCLUSION_TEXTURE },
-                { "scattering", image::TextureUsage::SCATTERING_TEXTURE },
-                { "lightmap", image::TextureUsage::LIGHTMAP_TEXTURE },
-            };
-
             auto it = STRING_TO_TEXTURE_USAGE_TYPE_MAP.find(type);
             if (it == STRING_TO_TEXTURE_USAGE_TYPE_MAP.end()) {
                 qCDebug(model_baking) << "Unknown texture usage type:" << type;
                 QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
             }
-            _baker = std::unique_ptr<Baker> { new TextureBaker(inputUrl, it->second, outputPath) };
+            if (!inputContent.isEmpty()) {
+                _bakeCacheKey = OvenBakeCache::getTextureKey(it->second, inputContent);
+            }
+            _baker = std::unique_ptr<Baker> { new TextureBaker(inputUrl, it->second, outputPath, QString(), inputContent) };
             _baker->moveToThread(Oven::instance().getNextWorkerThread());
         }
     }
@@ -104,6 +130,14 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
         return;
     }
 
+    QString mainOutputPath;
+    if (!_bakeCacheKey.isEmpty() && _bakeCache.restore(_bakeCacheKey, _outputPath.absolutePath(), mainOutputPath)) {
+        qCDebug(model_baking) << "Restored" << inputUrl << "from the bake cache to" << mainOutputPath;
+        _baker.reset();
+        QCoreApplication::exit(OVEN_STATUS_CODE_SUCCESS);
+        return;
+    }
+
     // invoke the bake method on the baker thread
     QMetaObject::invokeMethod(_baker.get(), "bake");
 
@@ -113,6 +147,10 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
 
 void BakerCLI::handleFinishedBaker() {
     qCDebug(model_baking) << "Finished baking file.";
+    if (!_bakeCacheKey.isEmpty()) {
+        _bakeCache.store(_bakeCacheKey, *_baker, _outputPath.absolutePath());
+    }
+
     int exitCode = OVEN_STATUS_CODE_SUCCESS;
     // Do we need this?
     if (_baker->wasAborted()) {
@@ -127,3 +165,55 @@ void BakerCLI::handleFinishedBaker() {
     }
     QCoreApplication::exit(exitCode);
 }
+
+void BakerCLI::benchmarkTextures(QUrl inputUrl, const QString& outputPath, const QString& type, int numTextures) {
+    inputUrl = getInputUrl(inputUrl);
+
+    auto it = STRING_TO_TEXTURE_USAGE_TYPE_MAP.find(type.isEmpty() ? "default" : type);
+    if (it == STRING_TO_TEXTURE_USAGE_TYPE_MAP.end()) {
+        qCDebug(model_baking) << "Unknown texture usage type:" << type;
+        QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+        return;
+    }
+
+    qDebug() << "Benchmarking" << numTextures << "bakes of" << inputUrl << "with"
+        << image::getTextureCompressionThreadCount() << "compression threads";
+
+    // the same texture baked to its own folder by every baker, as many at once as the oven has worker threads
+    _outputPath = outputPath;
+    _benchmarkBakers.clear();
+    _numBenchmarkBakersFinished = 0;
+    for (int i = 0; i < numTextures; ++i) {
+        QDir bakerOutputPath = _outputPath.absoluteFilePath(QString::number(i));
+        bakerOutputPath.mkpath(".");
+
+        auto baker = std::unique_ptr<Baker> { new TextureBaker(inputUrl, it->second, bakerOutputPath) };
+        baker->moveToThread(Oven::instance().getNextWorkerThread());
+        connect(baker.get(), &Baker::finished, this, &BakerCLI::handleFinishedBenchmarkBaker);
+        _benchmarkBakers.push_back(std::move(baker));
+    }
+
+    _benchmarkTimer.start();
+    for (auto& baker : _benchmarkBakers) {
+        QMetaObject::invokeMethod(baker.get(), "bake");
+    }
+}
+
+void BakerCLI::handleFinishedBenchmarkBaker() {
+    if (++_numBenchmarkBakersFinished < _benchmarkBakers.size()) {
+        return;
+    }
+
+    double seconds = _benchmarkTimer.nsecsElapsed() / (double)NSECS_PER_SECOND;
+    int exitCode = OVEN_STATUS_CODE_SUCCESS;
+    for (auto& baker : _benchmarkBakers) {
+        if (baker->wasAborted() || baker->hasErrors()) {
+            qCDebug(model_baking) << "Failed to bake texture:" << baker->getErrors();
+            exitCode = OVEN_STATUS_CODE_FAIL;
+        }
+    }
+
+    qDebug() << "Baked" << _benchmarkBakers.size() << "textures in" << seconds << "s:"
+        << (seconds > 0.0 ? _benchmarkBakers.size() / seconds : 0.0) << "textures/s";
+    QCoreApplication::exit(exitCode);
+}
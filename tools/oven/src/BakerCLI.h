@@ -12,13 +12,16 @@
 #ifndef hifi_BakerCLI_h
 #define hifi_BakerCLI_h
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
 #include <QDir>
 #include <QUrl>
 
 #include <memory>
+#include <vector>
 
 #include "Baker.h"
+#include "OvenBakeCache.h"
 #include "OvenCLIApplication.h"
 
 static const int OVEN_STATUS_CODE_SUCCESS { 0 };
@@ -33,15 +36,29 @@ class BakerCLI : public QObject {
 public:
     BakerCLI(OvenCLIApplication* parent);
 
+    // files baked before are copied from the cache instead, only for local input files
+    void setBakeCachePath(const QString& bakeCachePath) { _bakeCache = OvenBakeCache(bakeCachePath); }
+
 public slots:
     void bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type = QString());
 
+    // bakes a texture numTextures times at once, and reports the number of textures baked per second
+    void benchmarkTextures(QUrl inputUrl, const QString& outputPath, const QString& type, int numTextures);
+
 private slots:
     void handleFinishedBaker();  
+    void handleFinishedBenchmarkBaker();
 
 private:
     QDir _outputPath;
     std::unique_ptr<Baker> _baker;
+
+    OvenBakeCache _bakeCache;
+    QString _bakeCacheKey;
+
+    std::vector<std::unique_ptr<Baker>> _benchmarkBakers;
+    size_t _numBenchmarkBakersFinished { 0 };
+    QElapsedTimer _benchmarkTimer;
 };
 
 #endif // hifi_BakerCLI_h
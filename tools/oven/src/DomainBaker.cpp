@@ -16,6 +16,10 @@
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QJsonObject>
+#include <QtNetwork/QNetworkReply>
+
+#include <NetworkAccessManager.h>
+#include <NetworkingConstants.h>
 
 #include "Gzip.h"
 #include "Oven.h"
@@ -23,10 +27,11 @@
 
 DomainBaker::DomainBaker(const QUrl& localModelFileURL, const QString& domainName,
                          const QString& baseOutputPath, const QUrl& destinationPath,
-                         bool shouldRebakeOriginals) :
+                         bool shouldRebakeOriginals, const QString& bakeCachePath) :
     _localEntitiesFileURL(localModelFileURL),
     _domainName(domainName),
     _baseOutputPath(baseOutputPath),
+    _bakeCache(bakeCachePath),
     _shouldRebakeOriginals(shouldRebakeOriginals)
 {
     // make sure the destination path has a trailing slash
@@ -149,39 +154,48 @@ void DomainBaker::addModelBaker(const QString& property, const QString& url, con
     QUrl bakeableModelURL = getBakeableModelURL(url);
     if (!bakeableModelURL.isEmpty() && (_shouldRebakeOriginals || !isModelBaked(bakeableModelURL))) {
         // setup a ModelBaker for this URL, as long as we don't already have one
-        bool haveBaker = _modelBakers.contains(bakeableModelURL);
-        if (!haveBaker) {
+        bool isNewModel = !_entitiesNeedingRewrite.contains(bakeableModelURL);
+
+        // add this QJsonValueRef to our multi hash so that we can easily re-write
+        // the model URL to the baked version once the baker is complete
+        _entitiesNeedingRewrite.insert(bakeableModelURL, { property, jsonRef });
+
+        if (!isNewModel) {
+            return;
+        }
+
+        auto getCacheKey = [url](const QByteArray& content) {
+            return OvenBakeCache::getModelKey(url, content);
+        };
+
+        startSubBake(bakeableModelURL, bakeableModelURL, false, getCacheKey, [this, bakeableModelURL, url](const QString& cacheKey, const QByteArray& content) {
             QSharedPointer<ModelBaker> baker = QSharedPointer<ModelBaker>(getModelBaker(bakeableModelURL, _contentOutputPath).release(), &Baker::deleteLater);
-            if (baker) {
-                // Hold on to the old url userinfo/query/fragment data so ModelBaker::getFullOutputMappingURL retains that data from the original model URL
-                // Note: The ModelBaker currently doesn't store this in the FST because the equal signs mess up FST parsing.
-                //       There is a small chance this could break a server workflow relying on the old behavior.
-                //       Url suffix is still propagated to the baked URL if the input URL is an FST.
-                //       Url suffix has always been stripped from the URL when loading the original model file to be baked.
-                baker->setOutputURLSuffix(url);
-
-                // make sure our handler is called when the baker is done
-                connect(baker.data(), &Baker::finished, this, &DomainBaker::handleFinishedModelBaker);
-
-                // insert it into our bakers hash so we hold a strong pointer to it
-                _modelBakers.insert(bakeableModelURL, baker);
-                haveBaker = true;
-
-                // move the baker to the baker thread
-                // and kickoff the bake
-                baker->moveToThread(Oven::instance().getNextWorkerThread());
-                QMetaObject::invokeMethod(baker.data(), "bake", Qt::QueuedConnection);
-
-                // keep track of the total number of baking entities
-                ++_totalNumberOfSubBakes;
+            if (!baker) {
+                return false;
             }
-        }
 
-        if (haveBaker) {
-            // add this QJsonValueRef to our multi hash so that we can easily re-write
-            // the model URL to the baked version once the baker is complete
-            _entitiesNeedingRewrite.insert(bakeableModelURL, { property, jsonRef });
-        }
+            // Hold on to the old url userinfo/query/fragment data so ModelBaker::getFullOutputMappingURL retains that data from the original model URL
+            // Note: The ModelBaker currently doesn't store this in the FST because the equal signs mess up FST parsing.
+            //       There is a small chance this could break a server workflow relying on the old behavior.
+            //       Url suffix is still propagated to the baked URL if the input URL is an FST.
+            //       Url suffix has always been stripped from the URL when loading the original model file to be baked.
+            baker->setOutputURLSuffix(url);
+
+            // the model was already loaded for its cache key, don't download it again
+            baker->setSourceContent(content);
+
+            // make sure our handler is called when the baker is done
+            connect(baker.data(), &Baker::finished, this, &DomainBaker::handleFinishedModelBaker);
+
+            // insert it into our bakers hash so we hold a strong pointer to it
+            _modelBakers.insert(bakeableModelURL, baker);
+
+            // move the baker to the baker thread
+            // and kickoff the bake
+            baker->moveToThread(Oven::instance().getNextWorkerThread());
+            QMetaObject::invokeMethod(baker.data(), "bake", Qt::QueuedConnection);
+            return true;
+        });
     }
 }
 
@@ -193,15 +207,30 @@ void DomainBaker::addTextureBaker(const QString& property, const QString& url, i
     if (QImageReader::supportedImageFormats().contains(extension.toLatin1())) {
         // grab a clean version of the URL without a query or fragment
         QUrl textureURL = QUrl(url).adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment);
-        TextureKey key = { textureURL, type };
+
+        // it doesn't really matter what this key is as long as it's consistent
+        QUrl rewriteKey = textureURL.toDisplayString() + "^" + QString::number(type);
+        bool isNewTexture = !_entitiesNeedingRewrite.contains(rewriteKey);
+
+        // add this QJsonValueRef to our multi hash so that it can re-write the texture URL
+        // to the baked version once the baker is complete
+        _entitiesNeedingRewrite.insert(rewriteKey, { property, jsonRef });
+
+        if (!isNewTexture) {
+            return;
+        }
+
+        auto getCacheKey = [type](const QByteArray& content) {
+            return OvenBakeCache::getTextureKey(type, content);
+        };
 
         // setup a texture baker for this URL, as long as we aren't baking a texture already
-        if (!_textureBakers.contains(key)) {
+        startSubBake(rewriteKey, textureURL, true, getCacheKey, [this, textureURL, type](const QString& cacheKey, const QByteArray& content) {
             auto baseTextureFileName = _textureFileNamer.createBaseTextureFileName(textureURL.fileName(), type);
 
-            // setup a baker for this texture
+            // setup a baker for this texture, with the texture we already loaded if we did
             QSharedPointer<TextureBaker> textureBaker {
-                new TextureBaker(textureURL, type, _contentOutputPath, baseTextureFileName),
+                new TextureBaker(textureURL, type, _contentOutputPath, baseTextureFileName, content),
                 &TextureBaker::deleteLater
             };
 
@@ -209,20 +238,13 @@ void DomainBaker::addTextureBaker(const QString& property, const QString& url, i
             connect(textureBaker.data(), &TextureBaker::finished, this, &DomainBaker::handleFinishedTextureBaker);
 
             // insert it into our bakers hash so we hold a strong pointer to it
-            _textureBakers.insert(key, textureBaker);
+            _textureBakers.insert({ textureURL, type }, textureBaker);
 
             // move the baker to a worker thread and kickoff the bake
             textureBaker->moveToThread(Oven::instance().getNextWorkerThread());
             QMetaObject::invokeMethod(textureBaker.data(), "bake", Qt::QueuedConnection);
-
-            // keep track of the total number of baking entities
-            ++_totalNumberOfSubBakes;
-        }
-
-        // add this QJsonValueRef to our multi hash so that it can re-write the texture URL
-        // to the baked version once the baker is complete
-        // it doesn't really matter what this key is as long as it's consistent
-        _entitiesNeedingRewrite.insert(textureURL.toDisplayString() + "^" + QString::number(type), { property, jsonRef });
+            return true;
+        });
     } else {
         qDebug() << "Texture extension not supported: " << extension;
     }
@@ -231,10 +253,18 @@ void DomainBaker::addTextureBaker(const QString& property, const QString& url, i
 void DomainBaker::addScriptBaker(const QString& property, const QString& url, const QJsonValueRef& jsonRef) {
     // grab a clean version of the URL without a query or fragment
     QUrl scriptURL = QUrl(url).adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment);
+    bool isNewScript = !_entitiesNeedingRewrite.contains(scriptURL);
 
-    // setup a script baker for this URL, as long as we aren't baking a script already
-    if (!_scriptBakers.contains(scriptURL)) {
+    // add this QJsonValueRef to our multi hash so that it can re-write the script URL
+    // to the baked version once the baker is complete
+    _entitiesNeedingRewrite.insert(scriptURL, { property, jsonRef });
 
+    if (!isNewScript) {
+        return;
+    }
+
+    // setup a script baker for this URL, as long as we aren't baking a script already
+    startSubBake(scriptURL, scriptURL, true, &OvenBakeCache::getScriptKey, [this, scriptURL](const QString& cacheKey, const QByteArray& content) {
         // setup a baker for this script
         QSharedPointer<JSBaker> scriptBaker {
             new JSBaker(scriptURL, _contentOutputPath),
@@ -250,14 +280,8 @@ void DomainBaker::addScriptBaker(const QString& property, const QString& url, co
         // move the baker to a worker thread and kickoff the bake
         scriptBaker->moveToThread(Oven::instance().getNextWorkerThread());
         QMetaObject::invokeMethod(scriptBaker.data(), "bake", Qt::QueuedConnection);
-
-        // keep track of the total number of baking entities
-        ++_totalNumberOfSubBakes;
-    }
-
-    // add this QJsonValueRef to our multi hash so that it can re-write the script URL
-    // to the baked version once the baker is complete
-    _entitiesNeedingRewrite.insert(scriptURL, { property, jsonRef });
+        return true;
+    });
 }
 
 void DomainBaker::addMaterialBaker(const QString& property, const QString& data, bool isURL, const QJsonValueRef& jsonRef, QUrl destinationPath) {
@@ -427,74 +451,201 @@ void DomainBaker::enumerateEntities() {
     emit bakeProgress(0, _totalNumberOfSubBakes);
 }
 
-void DomainBaker::handleFinishedModelBaker() {
-    auto baker = qobject_cast<ModelBaker*>(sender());
+void DomainBaker::startSubBake(const QUrl& rewriteKey, const QUrl& sourceURL, bool copyURLSuffix,
+                               CacheKeyGetter getCacheKey, BakerStarter startBaker) {
+    // keep track of the total number of baking entities
+    ++_totalNumberOfSubBakes;
 
-    if (baker) {
-        if (!baker->hasErrors()) {
-            // this ModelBaker is done and everything went according to plan
-            qDebug() << "Re-writing entity references to" << baker->getModelURL();
+    if (!_bakeCache.isEnabled()) {
+        if (!startBaker(QString(), QByteArray())) {
+            _entitiesNeedingRewrite.remove(rewriteKey);
+            --_totalNumberOfSubBakes;
+        }
+        return;
+    }
+
+    // the cache is keyed on the content of the source, so it needs to be loaded before we know if it was baked before
+    loadSource(sourceURL, [=](bool isLoaded, const QByteArray& content) {
+        QString cacheKey = isLoaded ? getCacheKey(content) : QString();
+
+        if (!cacheKey.isEmpty()) {
+            // the same content under another URL is baked once, and both URLs re-written to it
+            auto bakingIt = _rewriteKeysByCacheKey.find(cacheKey);
+            if (bakingIt != _rewriteKeysByCacheKey.end()) {
+                for (auto propertyEntityPair : _entitiesNeedingRewrite.values(rewriteKey)) {
+                    _entitiesNeedingRewrite.insert(bakingIt.value(), propertyEntityPair);
+                }
+                _entitiesNeedingRewrite.remove(rewriteKey);
+                ++_numDuplicates;
+                emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
+                return;
+            }
+
+            auto restoredIt = _restoredOutputsByCacheKey.find(cacheKey);
+            if (restoredIt != _restoredOutputsByCacheKey.end()) {
+                rewriteEntityReferences(rewriteKey, getDestinationURL(restoredIt.value()), true, copyURLSuffix);
+                ++_numDuplicates;
+                finishSubBake(rewriteKey);
+                return;
+            }
 
-            // setup a new URL using the prefix we were passed
-            auto relativeMappingFilePath = QDir(_contentOutputPath).relativeFilePath(baker->getFullOutputMappingURL().toString());
-            if (relativeMappingFilePath.startsWith("/")) {
-                relativeMappingFilePath = relativeMappingFilePath.right(relativeMappingFilePath.length() - 1);
+            // restored bakes get a folder of their own, so that they can't clash with the files of the bakes of this run
+            QString mainOutputPath;
+            if (_bakeCache.restore(cacheKey, QDir(_contentOutputPath).filePath(cacheKey.left(16)), mainOutputPath)) {
+                qDebug() << "Restored" << sourceURL << "from the bake cache";
+                _restoredOutputsByCacheKey.insert(cacheKey, mainOutputPath);
+                rewriteEntityReferences(rewriteKey, getDestinationURL(mainOutputPath), true, copyURLSuffix);
+                ++_numCacheHits;
+                finishSubBake(rewriteKey);
+                return;
             }
+        }
+
+        if (!startBaker(cacheKey, content)) {
+            finishSubBake(rewriteKey);
+        } else if (!cacheKey.isEmpty()) {
+            _rewriteKeysByCacheKey.insert(cacheKey, rewriteKey);
+            _cacheKeysByRewriteKey.insert(rewriteKey, cacheKey);
+        }
+    });
+}
+
+void DomainBaker::loadSource(const QUrl& sourceURL, std::function<void(bool isLoaded, const QByteArray& content)> handler) {
+    if (sourceURL.isLocalFile()) {
+        // handled once all the entities are enumerated, like the remote sources
+        QMetaObject::invokeMethod(this, [sourceURL, handler] {
+            QFile sourceFile { sourceURL.toLocalFile() };
+            bool isLoaded = sourceFile.open(QIODevice::ReadOnly);
+            handler(isLoaded, isLoaded ? sourceFile.readAll() : QByteArray());
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    auto& networkAccessManager = NetworkAccessManager::getInstance();
+
+    QNetworkRequest networkRequest;
+
+    // setup the request to follow re-directs and always hit the network
+    networkRequest.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+    networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    networkRequest.setHeader(QNetworkRequest::UserAgentHeader, NetworkingConstants::VIRCADIA_USER_AGENT);
+    networkRequest.setUrl(sourceURL);
+
+    auto networkReply = networkAccessManager.get(networkRequest);
+    connect(networkReply, &QNetworkReply::finished, this, [networkReply, handler] {
+        networkReply->deleteLater();
+
+        // a source that can't be downloaded goes to its baker anyway, which reports the error
+        bool isLoaded = networkReply->error() == QNetworkReply::NoError;
+        handler(isLoaded, isLoaded ? networkReply->readAll() : QByteArray());
+    });
+}
+
+void DomainBaker::storeInBakeCache(const QUrl& rewriteKey, const Baker& baker) {
+    QString cacheKey = _cacheKeysByRewriteKey.take(rewriteKey);
+    if (!cacheKey.isEmpty()) {
+        _rewriteKeysByCacheKey.remove(cacheKey);
+        _bakeCache.store(cacheKey, baker, _contentOutputPath);
+    }
+}
 
-            QUrl newURL = _destinationPath.resolved(relativeMappingFilePath);
-
-            // enumerate the QJsonRef values for the URL of this model from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(baker->getOriginalInputModelURL())) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
-
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
-
-                    // set the new URL as the value in our temp QJsonObject
-                    // The fragment, query, and user info from the original model URL should now be present on the filename in the FST file
-                    entity[property] = newURL.toString();
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
-
-                    // copy the fragment and query, and user info from the old model URL
+void DomainBaker::finishSubBake(const QUrl& rewriteKey) {
+    // remove the baked URL from the multi hash of entities needing a re-write
+    _entitiesNeedingRewrite.remove(rewriteKey);
+
+    // emit progress to tell listeners how many sub-bakes are done
+    emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
+
+    // check if this was the last one we needed to re-write and if we are done now
+    checkIfRewritingComplete();
+}
+
+QString DomainBaker::getDestinationURL(const QString& outputFilePath) const {
+    // setup a new URL using the prefix we were passed
+    auto relativeFilePath = QDir(_contentOutputPath).relativeFilePath(outputFilePath);
+    if (relativeFilePath.startsWith("/")) {
+        relativeFilePath = relativeFilePath.right(relativeFilePath.length() - 1);
+    }
+    return _destinationPath.resolved(relativeFilePath).toString();
+}
+
+void DomainBaker::rewriteEntityReferences(const QUrl& rewriteKey, const QString& newDataOrURL, bool isURL, bool copyURLSuffix) {
+    // enumerate the QJsonRef values for this URL from our multi hash of
+    // entity objects needing a URL re-write
+    for (auto propertyEntityPair : _entitiesNeedingRewrite.values(rewriteKey)) {
+        QString property = propertyEntityPair.first;
+        // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
+        auto entity = propertyEntityPair.second.toObject();
+
+        if (!property.contains(".")) {
+            // grab the old URL
+            QUrl oldURL = entity[property].toString();
+
+            // copy the fragment and query, and user info from the old URL
+            // The fragment, query, and user info from the original model URL are already present on the filename in the FST file
+            if (isURL) {
+                QUrl newURL = newDataOrURL;
+                if (copyURLSuffix) {
                     newURL.setQuery(oldURL.query());
                     newURL.setFragment(oldURL.fragment());
                     newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    oldObject[propertySplit[1]] = newURL.toString();
-                    entity[propertySplit[0]] = oldObject;
                 }
 
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
+                // set the new URL as the value in our temp QJsonObject
+                entity[property] = newURL.toString();
+            } else {
+                entity[property] = newDataOrURL;
             }
+        } else {
+            // Group property
+            QStringList propertySplit = property.split(".");
+            assert(propertySplit.length() == 2);
+            // grab the old URL
+            auto oldObject = entity[propertySplit[0]].toObject();
+            QUrl oldURL = oldObject[propertySplit[1]].toString();
+
+            // copy the fragment and query, and user info from the old URL
+            if (isURL) {
+                QUrl newURL = newDataOrURL;
+                newURL.setQuery(oldURL.query());
+                newURL.setFragment(oldURL.fragment());
+                newURL.setUserInfo(oldURL.userInfo());
+
+                // set the new URL as the value in our temp QJsonObject
+                oldObject[propertySplit[1]] = newURL.toString();
+            } else {
+                oldObject[propertySplit[1]] = newDataOrURL;
+            }
+            entity[propertySplit[0]] = oldObject;
+        }
+
+        // replace our temp object with the value referenced by our QJsonValueRef
+        propertyEntityPair.second = entity;
+    }
+}
+
+void DomainBaker::handleFinishedModelBaker() {
+    auto baker = qobject_cast<ModelBaker*>(sender());
+
+    if (baker) {
+        QUrl rewriteKey = baker->getOriginalInputModelURL();
+
+        if (!baker->hasErrors()) {
+            // this ModelBaker is done and everything went according to plan
+            qDebug() << "Re-writing entity references to" << baker->getModelURL();
+
+            rewriteEntityReferences(rewriteKey, getDestinationURL(baker->getFullOutputMappingURL().toString()), true, false);
         } else {
             // this model failed to bake - this doesn't fail the entire bake but we need to add
             // the errors from the model to our warnings
             _warningList << baker->getErrors();
         }
-
-        // remove the baked URL from the multi hash of entities needing a re-write
-        _entitiesNeedingRewrite.remove(baker->getOriginalInputModelURL());
+        storeInBakeCache(rewriteKey, *baker);
 
         // drop our shared pointer to this baker so that it gets cleaned up
-        _modelBakers.remove(baker->getOriginalInputModelURL());
-
-        // emit progress to tell listeners how many models we have baked
-        emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
+        _modelBakers.remove(rewriteKey);
 
-        // check if this was the last model we needed to re-write and if we are done now
-        checkIfRewritingComplete();
+        finishSubBake(rewriteKey);
     }
 }
 
@@ -508,69 +659,18 @@ void DomainBaker::handleFinishedTextureBaker() {
             // this TextureBaker is done and everything went according to plan
             qDebug() << "Re-writing entity references to" << baker->getTextureURL() << "with usage" << baker->getTextureType();
 
-            // setup a new URL using the prefix we were passed
-            auto relativeTextureFilePath = QDir(_contentOutputPath).relativeFilePath(baker->getMetaTextureFileName());
-            if (relativeTextureFilePath.startsWith("/")) {
-                relativeTextureFilePath = relativeTextureFilePath.right(relativeTextureFilePath.length() - 1);
-            }
-            auto newURL = _destinationPath.resolved(relativeTextureFilePath);
-
-            // enumerate the QJsonRef values for the URL of this texture from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(rewriteKey)) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
-
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
-
-                    // copy the fragment and query, and user info from the old texture URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    entity[property] = newURL.toString();
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
-
-                    // copy the fragment and query, and user info from the old texture URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    oldObject[propertySplit[1]] = newURL.toString();
-                    entity[propertySplit[0]] = oldObject;
-                }
-
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
-            }
+            rewriteEntityReferences(rewriteKey, getDestinationURL(baker->getMetaTextureFileName()), true, true);
         } else {
             // this texture failed to bake - this doesn't fail the entire bake but we need to add the errors from
             // the texture to our warnings
             _warningList << baker->getWarnings();
         }
-
-        // remove the baked URL from the multi hash of entities needing a re-write
-        _entitiesNeedingRewrite.remove(rewriteKey);
+        storeInBakeCache(rewriteKey, *baker);
 
         // drop our shared pointer to this baker so that it gets cleaned up
         _textureBakers.remove({ baker->getTextureURL(), baker->getTextureType() });
 
-        // emit progress to tell listeners how many textures we have baked
-        emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
-
-        // check if this was the last texture we needed to re-write and if we are done now
-        checkIfRewritingComplete();
+        finishSubBake(rewriteKey);
     }
 }
 
@@ -578,73 +678,24 @@ void DomainBaker::handleFinishedScriptBaker() {
     auto baker = qobject_cast<JSBaker*>(sender());
 
     if (baker) {
+        QUrl rewriteKey = baker->getJSPath();
+
         if (!baker->hasErrors()) {
             // this JSBaker is done and everything went according to plan
             qDebug() << "Re-writing entity references to" << baker->getJSPath();
 
-            // setup a new URL using the prefix we were passed
-            auto relativeScriptFilePath = QDir(_contentOutputPath).relativeFilePath(baker->getBakedJSFilePath());
-            if (relativeScriptFilePath.startsWith("/")) {
-                relativeScriptFilePath = relativeScriptFilePath.right(relativeScriptFilePath.length() - 1);
-            }
-            auto newURL = _destinationPath.resolved(relativeScriptFilePath);
-
-            // enumerate the QJsonRef values for the URL of this script from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(baker->getJSPath())) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
-
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
-
-                    // copy the fragment and query, and user info from the old script URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    entity[property] = newURL.toString();
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
-
-                    // copy the fragment and query, and user info from the old script URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    oldObject[propertySplit[1]] = newURL.toString();
-                    entity[propertySplit[0]] = oldObject;
-                }
-
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
-            }
+            rewriteEntityReferences(rewriteKey, getDestinationURL(baker->getBakedJSFilePath()), true, true);
         } else {
             // this script failed to bake - this doesn't fail the entire bake but we need to add
             // the errors from the script to our warnings
             _warningList << baker->getErrors();
         }
-
-        // remove the baked URL from the multi hash of entities needing a re-write
-        _entitiesNeedingRewrite.remove(baker->getJSPath());
+        storeInBakeCache(rewriteKey, *baker);
 
         // drop our shared pointer to this baker so that it gets cleaned up
         _scriptBakers.remove(baker->getJSPath());
 
-        // emit progress to tell listeners how many scripts we have baked
-        emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
-
-        // check if this was the last script we needed to re-write and if we are done now
-        checkIfRewritingComplete();
+        finishSubBake(rewriteKey);
     }
 }
 
@@ -652,71 +703,16 @@ void DomainBaker::handleFinishedMaterialBaker() {
     auto baker = qobject_cast<MaterialBaker*>(sender());
 
     if (baker) {
+        QUrl rewriteKey = baker->getMaterialData();
+
         if (!baker->hasErrors()) {
             // this MaterialBaker is done and everything went according to plan
             qDebug() << "Re-writing entity references to" << baker->getMaterialData();
 
-            QString newDataOrURL;
             if (baker->isURL()) {
-                // setup a new URL using the prefix we were passed
-                auto relativeMaterialFilePath = QDir(_contentOutputPath).relativeFilePath(baker->getBakedMaterialData());
-                if (relativeMaterialFilePath.startsWith("/")) {
-                    relativeMaterialFilePath = relativeMaterialFilePath.right(relativeMaterialFilePath.length() - 1);
-                }
-                newDataOrURL = _destinationPath.resolved(relativeMaterialFilePath).toDisplayString();
+                rewriteEntityReferences(rewriteKey, getDestinationURL(baker->getBakedMaterialData()), true, true);
             } else {
-                newDataOrURL = baker->getBakedMaterialData();
-            }
-
-            // enumerate the QJsonRef values for the URL of this material from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(baker->getMaterialData())) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
-
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
-
-                    // copy the fragment and query, and user info from the old material data
-                    if (baker->isURL()) {
-                        QUrl newURL = newDataOrURL;
-                        newURL.setQuery(oldURL.query());
-                        newURL.setFragment(oldURL.fragment());
-                        newURL.setUserInfo(oldURL.userInfo());
-
-                        // set the new URL as the value in our temp QJsonObject
-                        entity[property] = newURL.toString();
-                    } else {
-                        entity[property] = newDataOrURL;
-                    }
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
-
-                    // copy the fragment and query, and user info from the old material data
-                    if (baker->isURL()) {
-                        QUrl newURL = newDataOrURL;
-                        newURL.setQuery(oldURL.query());
-                        newURL.setFragment(oldURL.fragment());
-                        newURL.setUserInfo(oldURL.userInfo());
-
-                        // set the new URL as the value in our temp QJsonObject
-                        oldObject[propertySplit[1]] = newURL.toString();
-                        entity[propertySplit[0]] = oldObject;
-                    } else {
-                        oldObject[propertySplit[1]] = newDataOrURL;
-                        entity[propertySplit[0]] = oldObject;
-                    }
-                }
-
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
+                rewriteEntityReferences(rewriteKey, baker->getBakedMaterialData(), false, false);
             }
         } else {
             // this material failed to bake - this doesn't fail the entire bake but we need to add
@@ -724,17 +720,10 @@ void DomainBaker::handleFinishedMaterialBaker() {
             _warningList << baker->getErrors();
         }
 
-        // remove the baked URL from the multi hash of entities needing a re-write
-        _entitiesNeedingRewrite.remove(baker->getMaterialData());
-
         // drop our shared pointer to this baker so that it gets cleaned up
         _materialBakers.remove(baker->getMaterialData());
 
-        // emit progress to tell listeners how many materials we have baked
-        emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
-
-        // check if this was the last material we needed to re-write and if we are done now
-        checkIfRewritingComplete();
+        finishSubBake(rewriteKey);
     }
 }
 
@@ -746,6 +735,11 @@ void DomainBaker::checkIfRewritingComplete() {
             return;
         }
 
+        if (_bakeCache.isEnabled()) {
+            qDebug() << "Finished" << _totalNumberOfSubBakes << "sub-bakes," << _numCacheHits << "from the bake cache and"
+                << _numDuplicates << "duplicates of another URL";
+        }
+
         // we've now written out our new models file - time to say that we are finished up
         emit finished();
     }
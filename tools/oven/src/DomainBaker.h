@@ -18,10 +18,13 @@
 #include <QtCore/QUrl>
 #include <QtCore/QThread>
 
+#include <functional>
+
 #include "ModelBaker.h"
 #include "TextureBaker.h"
 #include "JSBaker.h"
 #include "MaterialBaker.h"
+#include "OvenBakeCache.h"
 
 class DomainBaker : public Baker {
     Q_OBJECT
@@ -31,7 +34,11 @@ public:
     // That means you must pass a usable running QThread when constructing a domain baker.
     DomainBaker(const QUrl& localEntitiesFileURL, const QString& domainName,
                 const QString& baseOutputPath, const QUrl& destinationPath,
-                bool shouldRebakeOriginals);
+                bool shouldRebakeOriginals, const QString& bakeCachePath = QString());
+
+    // sub-bakes restored from the bake cache, and ones skipped because another URL had the same content
+    int getNumCacheHits() const { return _numCacheHits; }
+    int getNumDuplicates() const { return _numDuplicates; }
 
 signals:
     void allModelsFinished();
@@ -51,6 +58,19 @@ private:
     void checkIfRewritingComplete();
     void writeNewEntitiesFile();
 
+    using CacheKeyGetter = std::function<QString(const QByteArray& content)>;
+    using BakerStarter = std::function<bool(const QString& cacheKey, const QByteArray& content)>;
+
+    // starts the bake of a source that isn't baked or loading already, from the cache when it is in there
+    void startSubBake(const QUrl& rewriteKey, const QUrl& sourceURL, bool copyURLSuffix,
+                      CacheKeyGetter getCacheKey, BakerStarter startBaker);
+    void loadSource(const QUrl& sourceURL, std::function<void(bool isLoaded, const QByteArray& content)> handler);
+    void storeInBakeCache(const QUrl& rewriteKey, const Baker& baker);
+    void finishSubBake(const QUrl& rewriteKey);
+
+    QString getDestinationURL(const QString& outputFilePath) const;
+    void rewriteEntityReferences(const QUrl& rewriteKey, const QString& newDataOrURL, bool isURL, bool copyURLSuffix);
+
     QUrl _localEntitiesFileURL;
     QString _domainName;
     QString _baseOutputPath;
@@ -74,6 +94,13 @@ private:
     int _totalNumberOfSubBakes { 0 };
     int _completedSubBakes { 0 };
 
+    OvenBakeCache _bakeCache;
+    QHash<QString, QUrl> _rewriteKeysByCacheKey; // bakes in progress
+    QHash<QString, QString> _restoredOutputsByCacheKey;
+    QHash<QUrl, QString> _cacheKeysByRewriteKey;
+    int _numCacheHits { 0 };
+    int _numDuplicates { 0 };
+
     bool _shouldRebakeOriginals { false };
 
     void addModelBaker(const QString& property, const QString& url, const QJsonValueRef& jsonRef);
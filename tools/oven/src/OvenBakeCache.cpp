@@ -0,0 +1,237 @@
+//
+//  OvenBakeCache.cpp
+//  tools/oven/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OvenBakeCache.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QUuid>
+
+#include "JSBaker.h"
+#include "ModelBaker.h"
+#include "TextureBaker.h"
+
+const int OvenBakeCache::BAKE_CACHE_VERSION;
+
+static const QString ENTRY_FILE_NAME = "entry.json";
+static const QString ENTRY_FILES_FOLDER_NAME = "files";
+static const QString ENTRY_VERSION_KEY = "version";
+static const QString ENTRY_MAIN_KEY = "main";
+static const QString ENTRY_FILES_KEY = "files";
+static const QString ENTRY_DEPENDENCIES_KEY = "dependencies";
+static const QString DEPENDENCY_URL_KEY = "url";
+static const QString DEPENDENCY_HASH_KEY = "sha256";
+
+OvenBakeCache::OvenBakeCache(const QString& cachePath) {
+    if (!cachePath.isEmpty()) {
+        if (QDir().mkpath(cachePath)) {
+            _cachePath = QDir(cachePath).absolutePath();
+        } else {
+            qWarning() << "Could not create bake cache folder" << cachePath << "- baking without the cache";
+        }
+    }
+}
+
+QString OvenBakeCache::getKey(const QString& bakerType, const QString& options, const QByteArray& content) {
+    QCryptographicHash hasher(QCryptographicHash::Sha256);
+    hasher.addData(QByteArray::number(BAKE_CACHE_VERSION));
+    hasher.addData(bakerType.toUtf8());
+    hasher.addData(QByteArray(1, '\0'));
+    hasher.addData(options.toUtf8());
+    hasher.addData(QByteArray(1, '\0'));
+    hasher.addData(content);
+    return hasher.result().toHex();
+}
+
+QString OvenBakeCache::getModelKey(const QUrl& modelURL, const QByteArray& content) {
+    // textures are found relative to the model, and the URL suffix ends up in the baked FST
+    QString options = modelURL.toString() + (TextureBaker::isCompressionEnabled() ? "^compressed" : "");
+    return getKey("model", options, content);
+}
+
+QString OvenBakeCache::getTextureKey(image::TextureUsage::Type type, const QByteArray& content) {
+    QString options = QString::number(type) + (TextureBaker::isCompressionEnabled() ? "^compressed" : "");
+    return getKey("texture", options, content);
+}
+
+QString OvenBakeCache::getScriptKey(const QByteArray& content) {
+    return getKey("script", QString(), content);
+}
+
+bool OvenBakeCache::areDependenciesUnchanged(const QJsonObject& entry) {
+    for (const auto& value : entry[ENTRY_DEPENDENCIES_KEY].toArray()) {
+        QJsonObject dependency = value.toObject();
+        QUrl url(dependency[DEPENDENCY_URL_KEY].toString());
+        QFile file(url.toLocalFile());
+        QByteArray hash = file.open(QIODevice::ReadOnly) ?
+            QCryptographicHash::hash(file.readAll(), QCryptographicHash::Sha256).toHex() : QByteArray();
+        if (hash != dependency[DEPENDENCY_HASH_KEY].toString().toLatin1()) {
+            qDebug() << "Bake cache entry is stale," << url << "changed since it was baked";
+            return false;
+        }
+    }
+    return true;
+}
+
+QJsonObject OvenBakeCache::readEntry(const QString& key) const {
+    QFile entryFile(QDir(QDir(_cachePath).filePath(key)).filePath(ENTRY_FILE_NAME));
+    if (!entryFile.open(QIODevice::ReadOnly)) {
+        return QJsonObject();
+    }
+    QJsonObject entry = QJsonDocument::fromJson(entryFile.readAll()).object();
+    if (entry[ENTRY_VERSION_KEY].toInt() != BAKE_CACHE_VERSION) {
+        return QJsonObject();
+    }
+    return entry;
+}
+
+bool OvenBakeCache::restore(const QString& key, const QString& outputDirectory, QString& mainOutputPath) const {
+    if (!isEnabled()) {
+        return false;
+    }
+
+    QJsonObject entry = readEntry(key);
+    if (entry.isEmpty() || !areDependenciesUnchanged(entry)) {
+        return false;
+    }
+    QDir entryDir(QDir(_cachePath).filePath(key));
+
+    QStringList files;
+    for (const auto& file : entry[ENTRY_FILES_KEY].toArray()) {
+        files << file.toString();
+    }
+
+    // like a bake would, replace the files of an earlier bake to the same folder
+    QDir targetDir(outputDirectory);
+    QDir filesDir(entryDir.filePath(ENTRY_FILES_FOLDER_NAME));
+    for (const auto& file : files) {
+        QString targetPath = targetDir.filePath(file);
+        QFile::remove(targetPath);
+        if (!QDir().mkpath(QFileInfo(targetPath).absolutePath()) || !QFile::copy(filesDir.filePath(file), targetPath)) {
+            qWarning() << "Could not restore" << file << "from bake cache entry" << key;
+            return false;
+        }
+    }
+
+    mainOutputPath = targetDir.filePath(entry[ENTRY_MAIN_KEY].toString());
+    return true;
+}
+
+bool OvenBakeCache::store(const QString& key, const Baker& baker, const QString& outputDirectory) const {
+    if (!isEnabled() || baker.hasErrors() || baker.wasAborted()) {
+        return false;
+    }
+
+    QDir outputDir(outputDirectory);
+    if (auto modelBaker = qobject_cast<const ModelBaker*>(&baker)) {
+        // the whole folder of the model, its original and the textures it baked included
+        QDir modelDir(modelBaker->getBakedOutputDir());
+        modelDir.cdUp();
+        QString mainOutputPath = outputDir.relativeFilePath(modelBaker->getFullOutputMappingURL().toString());
+        const auto& dependencyHashes = modelBaker->getDependencyHashes();
+        for (auto it = dependencyHashes.begin(); it != dependencyHashes.end(); ++it) {
+            if (!it.key().isLocalFile()) {
+                qDebug() << "Not adding" << mainOutputPath << "to the bake cache, it depends on the remote file" << it.key();
+                return false;
+            }
+        }
+        return store(key, outputDirectory, { outputDir.relativeFilePath(modelDir.absolutePath()) }, mainOutputPath,
+                     dependencyHashes);
+    } else if (auto textureBaker = qobject_cast<const TextureBaker*>(&baker)) {
+        QStringList outputPaths;
+        for (const auto& file : textureBaker->getOutputFiles()) {
+            outputPaths << outputDir.relativeFilePath(file);
+        }
+        return store(key, outputDirectory, outputPaths, outputDir.relativeFilePath(textureBaker->getMetaTextureFileName()));
+    } else if (auto scriptBaker = qobject_cast<const JSBaker*>(&baker)) {
+        QString mainOutputPath = outputDir.relativeFilePath(scriptBaker->getBakedJSFilePath());
+        return store(key, outputDirectory, { mainOutputPath }, mainOutputPath);
+    }
+    return false;
+}
+
+bool OvenBakeCache::store(const QString& key, const QString& outputDirectory, const QStringList& outputPaths,
+                          const QString& mainOutputPath, const QHash<QUrl, QByteArray>& dependencyHashes) const {
+    QDir cacheDir(_cachePath);
+    if (cacheDir.exists(key)) {
+        QJsonObject entry = readEntry(key);
+        if (!entry.isEmpty() && areDependenciesUnchanged(entry)) {
+            return true;
+        }
+        // replaced by this bake of the newer dependencies
+        QDir(cacheDir.filePath(key)).removeRecursively();
+    }
+
+    // fill a temporary folder, and only move it in place once complete
+    QString temporaryName = key + "-" + QUuid::createUuid().toString(QUuid::WithoutBraces);
+    QDir temporaryDir(cacheDir.filePath(temporaryName));
+    QDir filesDir(temporaryDir.filePath(ENTRY_FILES_FOLDER_NAME));
+    QDir outputDir(outputDirectory);
+
+    QStringList files;
+    for (const auto& outputPath : outputPaths) {
+        QFileInfo outputInfo(outputDir.filePath(outputPath));
+        if (outputInfo.isDir()) {
+            QDirIterator it(outputInfo.absoluteFilePath(), QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext()) {
+                files << outputDir.relativeFilePath(it.next());
+            }
+        } else if (outputInfo.isFile()) {
+            files << outputPath;
+        }
+    }
+
+    bool isCopied = !files.isEmpty();
+    QJsonArray filesArray;
+    for (const auto& file : files) {
+        QString copyPath = filesDir.filePath(file);
+        if (!QDir().mkpath(QFileInfo(copyPath).absolutePath()) || !QFile::copy(outputDir.filePath(file), copyPath)) {
+            isCopied = false;
+            break;
+        }
+        filesArray.append(file);
+    }
+
+    if (isCopied) {
+        QJsonObject entry;
+        entry[ENTRY_VERSION_KEY] = BAKE_CACHE_VERSION;
+        entry[ENTRY_MAIN_KEY] = mainOutputPath;
+        entry[ENTRY_FILES_KEY] = filesArray;
+
+        QJsonArray dependenciesArray;
+        for (auto it = dependencyHashes.begin(); it != dependencyHashes.end(); ++it) {
+            dependenciesArray.append(QJsonObject {
+                { DEPENDENCY_URL_KEY, it.key().toString() },
+                { DEPENDENCY_HASH_KEY, QString::fromLatin1(it.value().toHex()) }
+            });
+        }
+        entry[ENTRY_DEPENDENCIES_KEY] = dependenciesArray;
+
+        QFile entryFile(temporaryDir.filePath(ENTRY_FILE_NAME));
+        isCopied = entryFile.open(QIODevice::WriteOnly) && entryFile.write(QJsonDocument(entry).toJson()) != -1;
+    }
+
+    // another oven sharing the cache may have stored the same bake meanwhile, which is as good
+    if (!isCopied || !cacheDir.rename(temporaryName, key)) {
+        temporaryDir.removeRecursively();
+        if (!isCopied) {
+            qWarning() << "Could not add" << mainOutputPath << "to the bake cache";
+        }
+        return cacheDir.exists(key);
+    }
+    return true;
+}
@@ -0,0 +1,67 @@
+//
+//  OvenBakeCache.h
+//  tools/oven/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OvenBakeCache_h
+#define hifi_OvenBakeCache_h
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QUrl>
+
+#include <image/TextureProcessing.h>
+
+class Baker;
+
+// folder of the cache in the output folder of the oven, when not set otherwise
+static const QString BAKE_CACHE_FOLDER_NAME = "bake-cache";
+
+// Persistent store of finished bakes, keyed by the hash of the source content, the baker and its options.
+//
+// Each bake is kept in a folder of its own named after its key, with the files the baker output and an entry.json
+// listing them. Bakes are added by moving a complete folder in place, so several ovens can share the same cache.
+//
+// A model bake is keyed on its own file, and its entry lists the hashes of the other files it was baked from, such as
+// external textures, which must be unchanged for it to be restored. Only the dependencies on local files can be checked,
+// so models depending on remote ones aren't cached. Materials aren't cached, their output refers to the destination
+// path and folders of the bake they were in.
+class OvenBakeCache {
+public:
+    // bump when a baker changes its output, to ignore the bakes of older ovens
+    static const int BAKE_CACHE_VERSION = 2;
+
+    OvenBakeCache(const QString& cachePath = QString());
+
+    bool isEnabled() const { return !_cachePath.isEmpty(); }
+    QString getCachePath() const { return _cachePath; }
+
+    static QString getModelKey(const QUrl& modelURL, const QByteArray& content);
+    static QString getTextureKey(image::TextureUsage::Type type, const QByteArray& content);
+    static QString getScriptKey(const QByteArray& content);
+
+    // copies the files of a cached bake to outputDirectory, and sets mainOutputPath to the file the baked asset is
+    // referenced by
+    bool restore(const QString& key, const QString& outputDirectory, QString& mainOutputPath) const;
+
+    // adds the output of a baker that finished without errors, written under outputDirectory
+    bool store(const QString& key, const Baker& baker, const QString& outputDirectory) const;
+
+private:
+    static QString getKey(const QString& bakerType, const QString& options, const QByteArray& content);
+    static bool areDependenciesUnchanged(const QJsonObject& entry);
+    QJsonObject readEntry(const QString& key) const;
+    bool store(const QString& key, const QString& outputDirectory, const QStringList& outputPaths, const QString& mainOutputPath,
+               const QHash<QUrl, QByteArray>& dependencyHashes = QHash<QUrl, QByteArray>()) const;
+
+    QString _cachePath;
+};
+
+#endif // hifi_OvenBakeCache_h
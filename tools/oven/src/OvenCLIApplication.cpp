@@ -25,17 +25,29 @@ static const QString CLI_INPUT_PARAMETER = "i";
 static const QString CLI_OUTPUT_PARAMETER = "o";
 static const QString CLI_TYPE_PARAMETER = "t";
 static const QString CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER = "disable-texture-compression";
+static const QString CLI_TEXTURE_COMPRESSION_THREADS_PARAMETER = "texture-compression-threads";
+static const QString CLI_BENCHMARK_PARAMETER = "benchmark";
+static const QString CLI_BAKE_CACHE_PARAMETER = "bake-cache";
 
 QUrl OvenCLIApplication::_inputUrlParameter;
 QUrl OvenCLIApplication::_outputUrlParameter;
 QString OvenCLIApplication::_typeParameter;
+int OvenCLIApplication::_benchmarkParameter { 0 };
+QString OvenCLIApplication::_bakeCacheParameter;
 
 OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
 {
     BakerCLI* cli = new BakerCLI(this);
-    QMetaObject::invokeMethod(cli, "bakeFile", Qt::QueuedConnection, Q_ARG(QUrl, _inputUrlParameter),
-                              Q_ARG(QString, _outputUrlParameter.toString()), Q_ARG(QString, _typeParameter));
+    cli->setBakeCachePath(_bakeCacheParameter);
+    if (_benchmarkParameter > 0) {
+        QMetaObject::invokeMethod(cli, "benchmarkTextures", Qt::QueuedConnection, Q_ARG(QUrl, _inputUrlParameter),
+                                  Q_ARG(QString, _outputUrlParameter.toString()), Q_ARG(QString, _typeParameter),
+                                  Q_ARG(int, _benchmarkParameter));
+    } else {
+        QMetaObject::invokeMethod(cli, "bakeFile", Qt::QueuedConnection, Q_ARG(QUrl, _inputUrlParameter),
+                                  Q_ARG(QString, _outputUrlParameter.toString()), Q_ARG(QString, _typeParameter));
+    }
 }
 
 void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
@@ -47,7 +59,10 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
         { CLI_INPUT_PARAMETER, "Path to file that you would like to bake.", "input" },
         { CLI_OUTPUT_PARAMETER, "Path to folder that will be used as output.", "output" },
         { CLI_TYPE_PARAMETER, "Type of asset. [model|material]"/*|js]"*/, "type" },
-        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." }
+        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." },
+        { CLI_TEXTURE_COMPRESSION_THREADS_PARAMETER, "Number of threads shared by the textures being compressed.", "threads" },
+        { CLI_BENCHMARK_PARAMETER, "Bake the input texture this many times at once, and report the textures baked per second.", "count" },
+        { CLI_BAKE_CACHE_PARAMETER, "Folder of the bake cache, to skip input files that were baked before with the same options.", "folder" }
     });
 
     auto versionOption = parser.addVersionOption();
@@ -91,4 +106,16 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
         qDebug() << "Disabling texture compression";
         TextureBaker::setCompressionEnabled(false);
     }
+
+    if (parser.isSet(CLI_TEXTURE_COMPRESSION_THREADS_PARAMETER)) {
+        image::setTextureCompressionThreadCount(parser.value(CLI_TEXTURE_COMPRESSION_THREADS_PARAMETER).toInt());
+    }
+
+    if (parser.isSet(CLI_BENCHMARK_PARAMETER)) {
+        _benchmarkParameter = std::max(parser.value(CLI_BENCHMARK_PARAMETER).toInt(), 1);
+    }
+
+    if (parser.isSet(CLI_BAKE_CACHE_PARAMETER)) {
+        _bakeCacheParameter = QDir::fromNativeSeparators(parser.value(CLI_BAKE_CACHE_PARAMETER));
+    }
 }
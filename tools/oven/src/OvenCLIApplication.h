@@ -29,6 +29,8 @@ private:
     static QUrl _inputUrlParameter;
     static QUrl _outputUrlParameter;
     static QString _typeParameter;
+    static int _benchmarkParameter;
+    static QString _bakeCacheParameter;
 };
 
 #endif // hifi_OvenCLIApplication_h
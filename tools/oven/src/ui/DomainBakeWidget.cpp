@@ -212,7 +212,7 @@ void DomainBakeWidget::bakeButtonClicked() {
         auto domainBaker = std::unique_ptr<DomainBaker> {
                 new DomainBaker(fileToBakeURL, _domainNameLineEdit->text(),
                                 outputDirectory.absolutePath(), _destinationPathLineEdit->text(),
-                                _rebakeOriginalsCheckBox->isChecked())
+                                _rebakeOriginalsCheckBox->isChecked(), outputDirectory.absoluteFilePath(BAKE_CACHE_FOLDER_NAME))
         };
 
         // make sure we hear from the baker when it is done
@@ -280,6 +280,9 @@ void DomainBakeWidget::handleFinishedBaker() {
                 warnings.removeDuplicates();
 
                 resultsWindow->changeStatusForRow(resultRow, warnings.join("\n"));
+            } else if (baker->getNumCacheHits() + baker->getNumDuplicates() > 0) {
+                resultsWindow->changeStatusForRow(resultRow, QString("Success - %1 from the bake cache, %2 duplicates")
+                    .arg(baker->getNumCacheHits()).arg(baker->getNumDuplicates()));
             } else {
                 resultsWindow->changeStatusForRow(resultRow, "Success");
             }
@@ -0,0 +1,112 @@
+//
+//  RecordingConverterApp.cpp
+//  tools/recording-converter/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RecordingConverterApp.h"
+
+#include <QCommandLineParser>
+#include <QDebug>
+
+#include <AvatarData.h>
+#include <AvatarFrameCodec.h>
+#include <recording/Clip.h>
+#include <recording/Frame.h>
+
+RecordingConverterApp::RecordingConverterApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Vircadia Recording Converter");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input file", "filename.hfr");
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption outputFilenameOption("o", "output file", "filename.hfr");
+    parser.addOption(outputFilenameOption);
+
+    const QCommandLineOption keyframeIntervalOption("k", "frames between avatar keyframes", "frames",
+        QString::number(AvatarFrameEncoder::DEFAULT_KEYFRAME_INTERVAL));
+    parser.addOption(keyframeIntervalOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    if (!parser.isSet(inputFilenameOption) || !parser.isSet(outputFilenameOption)) {
+        qCritical() << "Both an input and an output file are required";
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    bool validInterval;
+    int keyframeInterval = parser.value(keyframeIntervalOption).toInt(&validInterval);
+    if (!validInterval || keyframeInterval < 1) {
+        qCritical() << "Invalid keyframe interval" << parser.value(keyframeIntervalOption);
+        _returnCode = 1;
+        return;
+    }
+
+    QString inputFilename = parser.value(inputFilenameOption);
+    auto input = recording::Clip::fromFile(inputFilename);
+    if (!input) {
+        qCritical() << "Failed to read recording " << inputFilename;
+        _returnCode = 2;
+        return;
+    }
+
+    const recording::FrameType LEGACY_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+    const recording::FrameType BINARY_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::BINARY_FRAME_NAME);
+
+    AvatarData avatar;
+    AvatarFrameEncoder encoder(keyframeInterval);
+    auto output = recording::Clip::newClip();
+    size_t legacyBytes = 0;
+    size_t binaryBytes = 0;
+    size_t numAvatarFrames = 0;
+
+    input->seekFrameTime(0);
+    for (auto frame = input->nextFrame(); frame; frame = input->nextFrame()) {
+        if (frame->type != LEGACY_FRAME_TYPE) {
+            output->addFrame(frame);
+            continue;
+        }
+
+        auto convertedFrame = std::make_shared<recording::Frame>();
+        convertedFrame->type = BINARY_FRAME_TYPE;
+        convertedFrame->timeOffset = frame->timeOffset;
+        convertedFrame->data = encoder.convertLegacyFrame(frame->data, avatar);
+        output->addFrame(convertedFrame);
+
+        legacyBytes += frame->data.size();
+        binaryBytes += convertedFrame->data.size();
+        numAvatarFrames++;
+    }
+
+    recording::Clip::toFile(parser.value(outputFilenameOption), output);
+
+    if (numAvatarFrames > 0) {
+        qDebug() << "Converted" << numAvatarFrames << "avatar frames, bytes/frame" << legacyBytes / numAvatarFrames
+            << "->" << binaryBytes / numAvatarFrames;
+    } else {
+        qDebug() << "No legacy avatar frames in" << inputFilename;
+    }
+}
+
+RecordingConverterApp::~RecordingConverterApp() {
+}
@@ -0,0 +1,29 @@
+//
+//  RecordingConverterApp.h
+//  tools/recording-converter/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RecordingConverterApp_h
+#define hifi_RecordingConverterApp_h
+
+#include <QCoreApplication>
+
+// Rewrites the avatar frames of a recording from the legacy JSON format to the binary frame format.
+class RecordingConverterApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    RecordingConverterApp(int argc, char* argv[]);
+    ~RecordingConverterApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif // hifi_RecordingConverterApp_h
@@ -0,0 +1,20 @@
+//
+//  main.cpp
+//  tools/recording-converter/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SharedUtil.h>
+
+#include "RecordingConverterApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Recording Converter");
+
+    RecordingConverterApp app(argc, argv);
+    return app.getReturnCode();
+}
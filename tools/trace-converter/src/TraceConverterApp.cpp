@@ -0,0 +1,59 @@
+//
+//  TraceConverterApp.cpp
+//  tools/trace-converter/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TraceConverterApp.h"
+
+#include <QCommandLineParser>
+#include <QDebug>
+
+#include <Trace.h>
+
+TraceConverterApp::TraceConverterApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Vircadia Trace Converter");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input file", "filename" + tracing::Tracer::BINARY_TRACE_EXTENSION);
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption outputFilenameOption("o", "output file", "filename.json[.gz]");
+    parser.addOption(outputFilenameOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    if (!parser.isSet(inputFilenameOption) || !parser.isSet(outputFilenameOption)) {
+        qCritical() << "Both an input and an output file are required";
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    QString inputFilename = parser.value(inputFilenameOption);
+    if (!tracing::Tracer::convertToJson(inputFilename, parser.value(outputFilenameOption))) {
+        qCritical() << "Failed to convert trace " << inputFilename;
+        _returnCode = 2;
+        return;
+    }
+}
+
+TraceConverterApp::~TraceConverterApp() {
+}
@@ -0,0 +1,29 @@
+//
+//  TraceConverterApp.h
+//  tools/trace-converter/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TraceConverterApp_h
+#define hifi_TraceConverterApp_h
+
+#include <QCoreApplication>
+
+// Converts the binary dumps of the tracer to Chrome trace JSON, gzipped when the output ends with .gz.
+class TraceConverterApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    TraceConverterApp(int argc, char* argv[]);
+    ~TraceConverterApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif // hifi_TraceConverterApp_h
@@ -11,11 +11,15 @@
 
 #include "UDTTest.h"
 
+#include <ctime>
+
 #include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
 
 #include <udt/Constants.h>
 #include <udt/Packet.h>
 #include <udt/PacketList.h>
+#include <udt/SendQueue.h>
 
 #include <LogHandler.h>
 
@@ -55,6 +59,13 @@ const QCommandLineOption MESSAGE_SEED {
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
+const QCommandLineOption SEND_QUEUE_MODE {
+    "send-queue-mode", "how reliable send queues are run: threaded (one thread each, default) or scheduled (shared pool)",
+    "threaded|scheduled"
+};
+const QCommandLineOption SEND_BATCH_SIZE {
+    "send-batch-size", "write unreliable packets in batches of this many datagrams (default is unbatched)", "packets"
+};
 
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
@@ -155,6 +166,27 @@ UDTTest::UDTTest(int& argc, char** argv) :
     }
     
     
+    if (_argumentParser.isSet(SEND_QUEUE_MODE)) {
+        QString mode = _argumentParser.value(SEND_QUEUE_MODE);
+        if (mode == "scheduled") {
+            udt::SendQueue::setSchedulingMode(udt::SendQueue::SchedulingMode::Scheduled);
+        } else if (mode == "threaded") {
+            udt::SendQueue::setSchedulingMode(udt::SendQueue::SchedulingMode::Threaded);
+        } else {
+            qCritical() << "Unknown send queue mode" << mode << "- expected threaded or scheduled.";
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        }
+    }
+
+    if (_argumentParser.isSet(SEND_BATCH_SIZE)) {
+        if (_sendReliable) {
+            qWarning() << "send-batch-size has no effect if not sending unreliable - it will be ignored";
+        } else {
+            _sendBatchSize = _argumentParser.value(SEND_BATCH_SIZE).toInt();
+            _socket.setBatchedSendEnabled(_sendBatchSize > 0);
+        }
+    }
+
     // in case we're an ordered sender or receiver setup our random number generator now
     static const int FIRST_MESSAGE_SEED = 742272;
     
@@ -224,7 +256,7 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, SEND_QUEUE_MODE, SEND_BATCH_SIZE
     });
     
     if (!_argumentParser.parse(arguments())) {
@@ -243,6 +275,12 @@ void UDTTest::sendInitialPackets() {
     static const int NUM_INITIAL_PACKETS = 500;
     
     int numPackets = std::max(NUM_INITIAL_PACKETS, _maxSendPackets);
+
+    if (!_sendReliable) {
+        // unreliable packets are fired off immediately, so time the burst to compare batched and unbatched writes
+        sendUnreliableBurst(numPackets);
+        return;
+    }
     
     for (int i = 0; i < numPackets; ++i) {
         sendPacket();
@@ -254,6 +292,38 @@ void UDTTest::sendInitialPackets() {
     }
 }
 
+void UDTTest::sendUnreliableBurst(int numPackets) {
+    QElapsedTimer wallTimer;
+    wallTimer.start();
+    std::clock_t cpuStart = std::clock();
+
+    _socket.sampleSendBatchStats();
+
+    int batchSize = _sendBatchSize > 0 ? _sendBatchSize : numPackets;
+    for (int i = 0; i < numPackets; i += batchSize) {
+        _socket.beginSendBatch(batchSize);
+        for (int j = i; j < std::min(i + batchSize, numPackets); ++j) {
+            sendPacket();
+        }
+        _socket.flushSendBatch();
+    }
+
+    double cpuMsecs = 1000.0 * (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    qint64 wallMsecs = wallTimer.elapsed();
+
+    // without batching every datagram is its own system call
+    qint64 systemCalls = numPackets;
+    if (_socket.isBatchedSendEnabled()) {
+        auto batchStats = _socket.sampleSendBatchStats();
+        systemCalls = batchStats.systemCalls + (numPackets - batchStats.datagrams - batchStats.failedDatagrams);
+    }
+
+    qDebug() << "Sent" << numPackets << "unreliable packets" << (_sendBatchSize > 0 ? "in batches of" : "unbatched")
+        << (_sendBatchSize > 0 ? QString::number(_sendBatchSize) : QString())
+        << "-" << wallMsecs << "ms wall," << cpuMsecs << "ms CPU," << systemCalls << "system calls,"
+        << (numPackets > 0 ? cpuMsecs * 1000.0 / numPackets : 0.0) << "us CPU per packet";
+}
+
 void UDTTest::sendPacket() {
     
     if (_maxSendPackets != -1 && _totalQueuedPackets > _maxSendPackets) {
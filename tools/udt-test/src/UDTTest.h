@@ -45,6 +45,7 @@ private:
     
     void sendInitialPackets(); // fills the queue with packets to start
     void sendPacket(); // constructs and sends a packet according to the test parameters
+    void sendUnreliableBurst(int numPackets); // sends and times unreliable packets, batched if requested
     
     QCommandLineParser _argumentParser;
     udt::Socket _socket;
@@ -61,6 +62,8 @@ private:
     
     int _messageSize { 10000000 }; // number of bytes per message while sending ordered
 
+    int _sendBatchSize { 0 }; // number of unreliable packets per send batch, 0 for unbatched
+
     std::unordered_map<udt::Packet::MessageNumber, std::unique_ptr<Message>> _pendingMessages;
     
     std::random_device _randomDevice;